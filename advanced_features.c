@@ -18,6 +18,7 @@
  */
 
 #include "net.h"
+#include <unistd.h>  // For STDOUT_FILENO
 
 /*
  * ============================================================================
@@ -36,10 +37,16 @@
  * 2. Calculate network address and broadcast address
  * 3. Enumerate all IPs from network+1 to broadcast-1
  * 
- * @param cidr_str: CIDR network string like "192.168.1.0/24"
+ * @param cidr_str: CIDR network string like "192.168.1.0/24" (or an IPv6 prefix)
  */
 void scan_network_range(const char *cidr_str)
 {
+    if (strchr(cidr_str, ':'))
+    {
+        scan_ipv6_range(cidr_str);
+        return;
+    }
+    
     printf("🔍 Network Range Scanner\n");
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     
@@ -52,18 +59,13 @@ void scan_network_range(const char *cidr_str)
         return;
     }
     
-    // Convert to subnet mask
-    char *mask_str = cidr_to_subnet_mask(prefix_len);
-    if (!mask_str) {
-        return;
-    }
-    
+    // Mask straight from the prefix table (no string round trip)
+    const char *mask_str = NET_PREFIX_TABLE[prefix_len].dotted;
+    unsigned int mask = NET_PREFIX_TABLE[prefix_len].mask;
     unsigned int network = ip_to_int(network_ip);
-    unsigned int mask = mask_to_int(mask_str);
     
     if (network == 0 || mask == 0) {
         printf("❌ Invalid network or mask\n");
-        free(mask_str);
         return;
     }
     
@@ -71,21 +73,25 @@ void scan_network_range(const char *cidr_str)
     unsigned int network_addr = calculate_network_address(network, mask);
     unsigned int broadcast_addr = calculate_broadcast_address(network_addr, mask);
     
-    // Calculate host count
+    // Host count from the prefix table (64-bit: a /1 holds 2^31 addresses)
     int host_bits = 32 - prefix_len;
-    int total_ips = 1;
-    for (int i = 0; i < host_bits; i++) {
-        total_ips *= 2;
-    }
+    unsigned long long total_ips = NET_PREFIX_TABLE[prefix_len].total;
+    
+    // Text forms are rendered once into stack buffers (no per-address malloc)
+    char net_str[NET_IPV4_STRLEN];
+    char bc_str[NET_IPV4_STRLEN];
+    char ip_str[NET_IPV4_STRLEN];
+    net_format_ipv4(network_addr, net_str);
+    net_format_ipv4(broadcast_addr, bc_str);
     
     printf("📊 Network Scan Summary:\n");
     printf("┌─────────────────────────────────────────────────────────┐\n");
     printf("│ Target Network:    %-36s │\n", cidr_str);
-    printf("│ Network Address:   %-36s │\n", int_to_ip(network_addr));
-    printf("│ Broadcast Address: %-36s │\n", int_to_ip(broadcast_addr));
+    printf("│ Network Address:   %-36s │\n", net_str);
+    printf("│ Broadcast Address: %-36s │\n", bc_str);
     printf("│ Subnet Mask:       %-36s │\n", mask_str);
     printf("│ Host Bits:         %-36d │\n", host_bits);
-    printf("│ Total IPs:         %-36d │\n", total_ips);
+    printf("│ Total IPs:         %-36llu │\n", total_ips);
     printf("└─────────────────────────────────────────────────────────┘\n");
     
     printf("\n🎯 IP Address Enumeration:\n");
@@ -94,81 +100,60 @@ void scan_network_range(const char *cidr_str)
     if (host_bits == 0) // /32 - single host
     {
         printf("📍 Single Host Network (/32):\n");
-        char *ip_str = int_to_ip(network_addr);
-        printf("   └─ %s (single host)\n", ip_str);
-        free(ip_str);
+        printf("   └─ %s (single host)\n", net_str);
     }
     else if (host_bits == 1) // /31 - point-to-point
     {
         printf("🔗 Point-to-Point Link (/31):\n");
-        char *ip1 = int_to_ip(network_addr);
-        char *ip2 = int_to_ip(broadcast_addr);
-        printf("   ├─ %s (first endpoint)\n", ip1);
-        printf("   └─ %s (second endpoint)\n", ip2);
-        free(ip1);
-        free(ip2);
+        printf("   ├─ %s (first endpoint)\n", net_str);
+        printf("   └─ %s (second endpoint)\n", bc_str);
     }
     else if (total_ips <= 64) // Small networks - show all IPs
     {
         printf("📋 Complete IP Listing:\n");
         
-        char *net_str = int_to_ip(network_addr);
-        char *bc_str = int_to_ip(broadcast_addr);
-        
         printf("   ├─ %s (network address) ❌\n", net_str);
         
         // Show all usable IPs
         for (unsigned int ip = network_addr + 1; ip < broadcast_addr; ip++) {
-            char *ip_str = int_to_ip(ip);
+            net_format_ipv4(ip, ip_str);
             printf("   ├─ %s (usable host)\n", ip_str);
-            free(ip_str);
         }
         
         printf("   └─ %s (broadcast address) ❌\n", bc_str);
-        
-        free(net_str);
-        free(bc_str);
     }
     else // Large networks - show summary
     {
         printf("📈 Large Network Summary (showing first/last 5 IPs):\n");
         
-        char *net_str = int_to_ip(network_addr);
-        char *bc_str = int_to_ip(broadcast_addr);
-        
         printf("   ├─ %s (network address) ❌\n", net_str);
         
         // Show first 5 usable IPs
         printf("   ├─ First 5 usable IPs:\n");
         for (int i = 1; i <= 5; i++) {
-            char *ip_str = int_to_ip(network_addr + i);
+            net_format_ipv4(network_addr + i, ip_str);
             printf("   │  ├─ %s\n", ip_str);
-            free(ip_str);
         }
         
-        printf("   │  └─ ... (%d more IPs) ...\n", total_ips - 12);
+        printf("   │  └─ ... (%llu more IPs) ...\n", total_ips - 12);
         
         // Show last 5 usable IPs
         printf("   ├─ Last 5 usable IPs:\n");
         for (int i = 5; i >= 1; i--) {
-            char *ip_str = int_to_ip(broadcast_addr - i);
+            net_format_ipv4(broadcast_addr - i, ip_str);
             printf("   │  ├─ %s\n", ip_str);
-            free(ip_str);
         }
         
         printf("   └─ %s (broadcast address) ❌\n", bc_str);
-        
-        free(net_str);
-        free(bc_str);
+        printf("   💡 Full listing: ./net --enumerate %s/%d\n", net_str, prefix_len);
     }
     
     printf("\n💡 Network Scanning Notes:\n");
     printf("   • ❌ = Not usable for hosts (network/broadcast)\n");
     printf("   • This is for educational purposes only\n");
     printf("   • Real network scanning requires proper authorization\n");
-    printf("   • Total usable hosts: %d\n", (total_ips > 2) ? total_ips - 2 : total_ips);
+    printf("   • Total usable hosts: %llu\n", (total_ips > 2) ? total_ips - 2 : total_ips);
     
-    free(mask_str);
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
 }
 
@@ -194,8 +179,8 @@ void scan_network_range(const char *cidr_str)
  */
 void split_network(const char *cidr_str, int num_subnets)
 {
-    printf("🔀 Subnet Splitting Calculator\n");
-    printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+    trace_printf("🔀 Subnet Splitting Calculator\n");
+    trace_printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     
     char network_ip[16];
     int prefix_len;
@@ -224,15 +209,36 @@ void split_network(const char *cidr_str, int num_subnets)
         subnet_bits++;
     }
     
-    // Calculate new prefix length
+    // Calculate new prefix length (/31 and /32 are valid, RFC 3021)
     int new_prefix = prefix_len + subnet_bits;
-    if (new_prefix > 30) {
-        printf("❌ Cannot split: would result in /%d (maximum practical is /30)\n", new_prefix);
+    if (new_prefix > 32) {
+        printf("❌ Cannot split: would result in /%d (longest prefix is /32)\n", new_prefix);
+        printf("💡 For unequal host counts use: ./net --vlsm %s <hosts-list>\n", cidr_str);
+        return;
+    }
+    
+    // Records: one network record per subnet, no trace
+    if (use_result_records())
+    {
+        unsigned int base = ip_to_int(network_ip) & NET_PREFIX_TABLE[prefix_len].mask;
+        unsigned int step = (unsigned int)(NET_PREFIX_TABLE[new_prefix].total);
+        ResultSink sink;
+        NetworkResult result;
+        char subnet[RESULT_INPUT_MAX];
+        
+        if (!result_sink_open(&sink, get_result_format(), STDOUT_FILENO)) return;
+        for (int i = 0; i < num_subnets; i++) {
+            size_t len = net_format_ipv4(base + (unsigned int)i * step, subnet);
+            len += (size_t)snprintf(subnet + len, sizeof(subnet) - len, "/%d", new_prefix);
+            unsigned int omit = network_result_parse(subnet, len, &result);
+            result_sink_emit(&sink, &RESULT_SCHEMA_NETWORK, &result, omit);
+        }
+        result_sink_close(&sink);
         return;
     }
     
     // Format new prefix string
-    char prefix_str[5];  // enough for "/32" + null terminator
+    char prefix_str[16];  // "/32" + null terminator, sized for any int
     snprintf(prefix_str, sizeof(prefix_str), "/%d", new_prefix);
     
     printf("📊 Splitting Analysis:\n");
@@ -245,72 +251,67 @@ void split_network(const char *cidr_str, int num_subnets)
     
     // Calculate original network details
     unsigned int network = ip_to_int(network_ip);
-    char *orig_mask_str = cidr_to_subnet_mask(prefix_len);
-    char *new_mask_str = cidr_to_subnet_mask(new_prefix);
+    const PrefixInfo *orig_info = &NET_PREFIX_TABLE[prefix_len];
+    const PrefixInfo *new_info = &NET_PREFIX_TABLE[new_prefix];
+    const char *orig_mask_str = orig_info->dotted;
+    const char *new_mask_str = new_info->dotted;
     
-    if (!orig_mask_str || !new_mask_str) {
-        printf("❌ Failed to calculate subnet masks\n");
-        if (orig_mask_str) free(orig_mask_str);
-        if (new_mask_str) free(new_mask_str);
-        return;
-    }
-    
-    // Calculate subnet size
+    // Calculate subnet size (64-bit: a /0 split in two is 2^31 per half)
     int host_bits = 32 - new_prefix;
-    int subnet_size = 1 << host_bits;  // 2^host_bits
-    int usable_ips = (host_bits > 1) ? subnet_size - 2 : subnet_size;
+    unsigned long long subnet_size = new_info->total;
+    unsigned long long usable_ips = new_info->usable;
     
     printf("\n📈 Subnet Details:\n");
     printf("┌─────────────────────────────────────────────────────────┐\n");
     printf("│ Original Subnet Mask: %-32s │\n", orig_mask_str);
     printf("│ New Subnet Mask:      %-32s │\n", new_mask_str);
-    printf("│ IPs per Subnet:       %-32d │\n", subnet_size);
-    printf("│ Usable IPs per Subnet: %-31d │\n", usable_ips);
+    printf("│ IPs per Subnet:       %-32llu │\n", subnet_size);
+    printf("│ Usable IPs per Subnet: %-31llu │\n", usable_ips);
     printf("│ Host Bits per Subnet:  %-31d │\n", host_bits);
     printf("└─────────────────────────────────────────────────────────┘\n");
     
     printf("\n🎯 Generated Subnets:\n");
     
     // Calculate network address (masked)
-    unsigned int network_addr = calculate_network_address(network, mask_to_int(orig_mask_str));
+    unsigned int network_addr = calculate_network_address(network, orig_info->mask);
+    
+    char subnet_str[NET_IPV4_STRLEN];
+    char broadcast_str[NET_IPV4_STRLEN];
+    char first_ip[NET_IPV4_STRLEN];
+    char last_ip[NET_IPV4_STRLEN];
     
     for (int i = 0; i < num_subnets; i++) {
-        unsigned int subnet_addr = network_addr + (i * subnet_size);
-        unsigned int broadcast_addr = subnet_addr + subnet_size - 1;
+        unsigned int subnet_addr = network_addr + (unsigned int)((unsigned long long)i * subnet_size);
+        unsigned int broadcast_addr = subnet_addr + (unsigned int)(subnet_size - 1);
         
-        char *subnet_str = int_to_ip(subnet_addr);
-        char *broadcast_str = int_to_ip(broadcast_addr);
+        net_format_ipv4(subnet_addr, subnet_str);
+        net_format_ipv4(broadcast_addr, broadcast_str);
         
         printf("   ├─ Subnet %d: %s/%d\n", i + 1, subnet_str, new_prefix);
         printf("   │  ├─ Network:   %s\n", subnet_str);
         printf("   │  ├─ Broadcast: %s\n", broadcast_str);
         
-        if (usable_ips > 0) {
-            char *first_ip = int_to_ip(subnet_addr + 1);
-            char *last_ip = int_to_ip(broadcast_addr - 1);
+        if (host_bits > 1) {
+            net_format_ipv4(subnet_addr + 1, first_ip);
+            net_format_ipv4(broadcast_addr - 1, last_ip);
             printf("   │  ├─ First IP:  %s\n", first_ip);
-            printf("   │  └─ Last IP:   %s (%d usable)\n", last_ip, usable_ips);
-            free(first_ip);
-            free(last_ip);
+            printf("   │  └─ Last IP:   %s (%llu usable)\n", last_ip, usable_ips);
+        } else if (host_bits == 1) {
+            printf("   │  └─ Point-to-point link (both addresses usable)\n");
         } else {
             printf("   │  └─ Single host subnet\n");
         }
         
         if (i < num_subnets - 1) printf("   │\n");
-        
-        free(subnet_str);
-        free(broadcast_str);
     }
     
     printf("\n💡 VLSM Educational Notes:\n");
     printf("   • VLSM allows efficient IP address allocation\n");
     printf("   • Each subnet is %s in size\n", new_mask_str);
-    printf("   • Total IPs allocated: %d (original had %d)\n", 
-           num_subnets * subnet_size, 1 << (32 - prefix_len));
+    printf("   • Total IPs allocated: %llu (original had %llu)\n", 
+           (unsigned long long)num_subnets * subnet_size, orig_info->total);
     printf("   • This technique reduces IP address waste\n");
     
-    free(orig_mask_str);
-    free(new_mask_str);
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
 }
 
@@ -322,87 +323,61 @@ void split_network(const char *cidr_str, int num_subnets)
  */
 
 /*
- * IPv6 address analysis and educational information
- * 
- * Provides comprehensive analysis of IPv6 addresses including:
- * - Address type detection (unicast, multicast, etc.)
- * - Scope identification (link-local, global, etc.)
- * - Educational information about IPv6 addressing
- * 
- * @param ipv6_str: IPv6 address string
+ * Prints the educational notes for an IPv6 address type
+ *
+ * @param type: Label from net_ipv6_type()
  */
-void analyze_ipv6_address(const char *ipv6_str)
+static void print_ipv6_type_notes(const char *type)
 {
-    printf("🌐 IPv6 Address Analysis\n");
-    printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
-    
-    printf("📍 Analyzing IPv6 Address: %s\n", ipv6_str);
-    
-    // Basic IPv6 validation (simplified)
-    int colons = 0;
-    int double_colon = 0;
-    const char *ptr = ipv6_str;
-    
-    while (*ptr) {
-        if (*ptr == ':') {
-            colons++;
-            if (*(ptr + 1) == ':') {
-                double_colon++;
-                ptr++; // Skip the second colon
-            }
-        }
-        ptr++;
-    }
-    
-    printf("\n🔍 Address Structure Analysis:\n");
-    printf("┌─────────────────────────────────────────────────────────┐\n");
-    printf("│ Format:           IPv6 (128-bit addressing)             │\n");
-    printf("│ Colon Count:      %-36d │\n", colons);
-    printf("│ Double Colon (::): %-35s │\n", double_colon > 0 ? "Present (compression)" : "Not present");
-    printf("│ Address Length:   %-36zu │\n", strlen(ipv6_str));
-    printf("└─────────────────────────────────────────────────────────┘\n");
-    
-    // Analyze address type based on prefix
-    printf("\n🏷️  IPv6 Address Type Classification:\n");
-    
-    if (strncmp(ipv6_str, "fe80:", 5) == 0 || strncmp(ipv6_str, "FE80:", 5) == 0) {
+    if (strcmp(type, "link-local") == 0) {
         printf("🔗 Link-Local Address (fe80::/10)\n");
         printf("   • Scope: Link-local (not routed)\n");
         printf("   • Use: Automatic configuration, neighbor discovery\n");
         printf("   • Valid only on local network segment\n");
     }
-    else if (strncmp(ipv6_str, "fc", 2) == 0 || strncmp(ipv6_str, "fd", 2) == 0 ||
-             strncmp(ipv6_str, "FC", 2) == 0 || strncmp(ipv6_str, "FD", 2) == 0) {
+    else if (strcmp(type, "unique-local") == 0) {
         printf("🏠 Unique Local Address (fc00::/7)\n");
         printf("   • Scope: Local (similar to IPv4 private addresses)\n");
         printf("   • Use: Private networks, not globally routed\n");
         printf("   • Locally administered\n");
     }
-    else if (strncmp(ipv6_str, "ff", 2) == 0 || strncmp(ipv6_str, "FF", 2) == 0) {
+    else if (strcmp(type, "multicast") == 0) {
         printf("📡 Multicast Address (ff00::/8)\n");
         printf("   • Scope: Multicast (one-to-many communication)\n");
         printf("   • Use: Group communication, routing protocols\n");
         printf("   • No broadcast in IPv6, only multicast\n");
     }
-    else if (strncmp(ipv6_str, "2001:db8:", 9) == 0) {
+    else if (strcmp(type, "documentation") == 0) {
         printf("📚 Documentation Address (2001:db8::/32)\n");
         printf("   • Scope: Documentation and examples only\n");
         printf("   • Use: RFC 3849 - reserved for documentation\n");
         printf("   • Should never appear in real networks\n");
     }
-    else if (strncmp(ipv6_str, "::1", 3) == 0 && strlen(ipv6_str) == 3) {
+    else if (strcmp(type, "loopback") == 0) {
         printf("🏠 Loopback Address (::1)\n");
         printf("   • Scope: Loopback (equivalent to 127.0.0.1)\n");
         printf("   • Use: Local machine communication\n");
         printf("   • Only one loopback address in IPv6\n");
     }
-    else if (strncmp(ipv6_str, "::", 2) == 0 && strlen(ipv6_str) == 2) {
+    else if (strcmp(type, "unspecified") == 0) {
         printf("🚫 Unspecified Address (::)\n");
         printf("   • Scope: Unspecified (equivalent to 0.0.0.0)\n");
         printf("   • Use: Indicates absence of address\n");
         printf("   • Used in address configuration\n");
     }
-    else if (ipv6_str[0] == '2' || ipv6_str[0] == '3') {
+    else if (strcmp(type, "ipv4-mapped") == 0) {
+        printf("🔁 IPv4-Mapped Address (::ffff:0:0/96)\n");
+        printf("   • Scope: Represents an IPv4 peer on a dual-stack socket\n");
+        printf("   • Use: IPv4 traffic seen through the IPv6 API\n");
+        printf("   • Never sent on the wire as IPv6\n");
+    }
+    else if (strcmp(type, "nat64") == 0) {
+        printf("🔀 NAT64 Address (64:ff9b::/96)\n");
+        printf("   • Scope: Global, translated by a NAT64 gateway\n");
+        printf("   • Use: IPv6-only hosts reaching IPv4 servers\n");
+        printf("   • Low 32 bits carry the IPv4 destination\n");
+    }
+    else if (strcmp(type, "global-unicast") == 0) {
         printf("🌍 Global Unicast Address (2000::/3)\n");
         printf("   • Scope: Global (routable on internet)\n");
         printf("   • Use: Public IPv6 addresses\n");
@@ -413,6 +388,90 @@ void analyze_ipv6_address(const char *ipv6_str)
         printf("   • May be reserved or special-purpose\n");
         printf("   • Check current IPv6 allocation standards\n");
     }
+}
+
+/*
+ * Formats the number of addresses in an IPv6 prefix
+ *
+ * Counts up to 2^63 are printed in full, larger ones as a power of two.
+ *
+ * @param prefix: Prefix length (0-128)
+ * @param buf: Destination buffer
+ * @param size: Size of buf
+ */
+void format_ipv6_count(int prefix, char *buf, size_t size)
+{
+    int host_bits = 128 - prefix;
+
+    if (host_bits < 64) snprintf(buf, size, "%llu", 1ULL << host_bits);
+    else snprintf(buf, size, "2^%d", host_bits);
+}
+
+/*
+ * IPv6 address analysis and educational information
+ * 
+ * Provides comprehensive analysis of IPv6 addresses including:
+ * - Canonical (RFC 5952) and fully expanded forms
+ * - Network, last address and size of the enclosing prefix
+ * - Address type detection (unicast, multicast, etc.)
+ * - Embedded IPv4 addresses (IPv4-mapped and NAT64 forms)
+ * 
+ * With --format or in the quiet profile a network6 record is written instead.
+ * 
+ * @param ipv6_str: IPv6 address, optionally with "/prefix" (default /128)
+ */
+void analyze_ipv6_address(const char *ipv6_str)
+{
+    // Records (--format or quiet profile): the same analysis, no trace
+    if (use_result_records())
+    {
+        emit_network6_result(ipv6_str);
+        return;
+    }
+    
+    NetIpv6 ip;
+    int prefix;
+
+    if (net_parse_ipv6_cidr(ipv6_str, &ip, &prefix) != NET_OK) {
+        printf("❌ Invalid IPv6 address: %s\n", ipv6_str);
+        return;
+    }
+
+    NetIpv6 network = net_ipv6_network(&ip, prefix);
+    NetIpv6 last = net_ipv6_last(&ip, prefix);
+    const char *type = net_ipv6_type(&ip);
+    char compressed[NET_IPV6_STRLEN], expanded[NET_IPV6_STRLEN];
+    char network_str[NET_IPV6_STRLEN], last_str[NET_IPV6_STRLEN];
+    char count[32], ipv4_str[16] = "";
+    unsigned int ipv4;
+
+    net_format_ipv6(&ip, compressed);
+    net_format_ipv6_full(&ip, expanded);
+    net_format_ipv6(&network, network_str);
+    net_format_ipv6(&last, last_str);
+    format_ipv6_count(prefix, count, sizeof(count));
+    if (net_ipv6_embedded_ipv4(&ip, &ipv4)) net_format_ipv4(ipv4, ipv4_str);
+
+    printf("🌐 IPv6 Address Analysis\n");
+    printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+    
+    printf("📍 Analyzing IPv6 Address: %s\n", ipv6_str);
+    
+    printf("\n🔍 Address Structure Analysis:\n");
+    printf("   ├─ Compressed:  %s\n", compressed);
+    printf("   ├─ Expanded:    %s\n", expanded);
+    if (ipv4_str[0])
+        printf("   ├─ Embedded IPv4: %s\n", ipv4_str);
+    printf("   └─ Prefix:      /%d\n", prefix);
+    
+    printf("\n📏 Prefix Range (/%d):\n", prefix);
+    printf("   ├─ Network:     %s/%d\n", network_str, prefix);
+    printf("   ├─ First:       %s\n", network_str);
+    printf("   ├─ Last:        %s\n", last_str);
+    printf("   └─ Addresses:   %s\n", count);
+    
+    printf("\n🏷️  IPv6 Address Type Classification:\n");
+    print_ipv6_type_notes(type);
     
     printf("\n📊 IPv6 vs IPv4 Comparison:\n");
     printf("┌─────────────────────────────────────────────────────────┐\n");
@@ -439,46 +498,71 @@ void analyze_ipv6_address(const char *ipv6_str)
  * IPv6 address format converter and educational display
  * 
  * Shows IPv6 addresses in different formats for educational purposes:
- * - Compressed form (using ::)
- * - Expanded form (full 128 bits)
- * - Binary representation
+ * - Compressed form (RFC 5952, using ::)
+ * - Expanded form (all 8 groups, 4 digits each)
+ * - Per-group hex and binary representation
+ * - IPv4-mapped form when the address embeds an IPv4 address
+ * 
+ * In the quiet profile a single key=value line is printed instead.
  * 
  * @param ipv6_str: IPv6 address string
  */
 void convert_ipv6_formats(const char *ipv6_str)
 {
+    NetIpv6 ip;
+
+    if (net_parse_ipv6(ipv6_str, &ip) != NET_OK) {
+        printf("❌ Invalid IPv6 address: %s\n", ipv6_str);
+        return;
+    }
+
+    char compressed[NET_IPV6_STRLEN], expanded[NET_IPV6_STRLEN];
+    char ipv4_str[16] = "";
+    unsigned int ipv4;
+
+    net_format_ipv6(&ip, compressed);
+    net_format_ipv6_full(&ip, expanded);
+    if (net_ipv6_embedded_ipv4(&ip, &ipv4)) net_format_ipv4(ipv4, ipv4_str);
+
+    if (is_quiet_mode()) {
+        printf("compressed=%s expanded=%s hex=%016llx%016llx",
+               compressed, expanded, (unsigned long long)ip.hi, (unsigned long long)ip.lo);
+        if (ipv4_str[0]) printf(" ipv4=%s", ipv4_str);
+        printf("\n");
+        return;
+    }
+
     printf("🔄 IPv6 Format Converter\n");
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     
     printf("📍 Converting IPv6 Address: %s\n", ipv6_str);
     
-    // This is a simplified example - real IPv6 parsing is more complex
     printf("\n🎨 Multiple Format Representations:\n");
-    printf("┌─────────────────────────────────────────────────────────┐\n");
-    printf("│ Original:          %-36s │\n", ipv6_str);
-    
-    // Show different possible representations (educational examples)
-    if (strstr(ipv6_str, "::") != NULL) {
-        printf("│ Format Type:       Compressed (using ::)                │\n");
-        printf("│ Compression:       Zero groups omitted                  │\n");
-    } else {
-        printf("│ Format Type:       Full/Expanded form                   │\n");
-        printf("│ Compression:       None (all groups shown)              │\n");
+    printf("   ├─ Original:    %s\n", ipv6_str);
+    printf("   ├─ Compressed:  %s\n", compressed);
+    printf("   ├─ Expanded:    %s\n", expanded);
+    printf("   ├─ Hex (128):   0x%016llx%016llx\n",
+           (unsigned long long)ip.hi, (unsigned long long)ip.lo);
+    if (ipv4_str[0]) {
+        printf("   ├─ Embedded IPv4: %s\n", ipv4_str);
+        printf("   ├─ IPv4-mapped: ::ffff:%s\n", ipv4_str);
+    }
+    printf("   └─ Type:        %s\n", net_ipv6_type(&ip));
+    
+    printf("\n🔢 Group Breakdown (8 × 16 bits):\n");
+    for (int g = 0; g < 8; g++) {
+        uint64_t half = g < 4 ? ip.hi : ip.lo;
+        unsigned int group = (unsigned int)(half >> (48 - 16 * (g % 4))) & 0xFFFF;
+        char bits[20];
+        int pos = 0;
+
+        for (int bit = 15; bit >= 0; bit--) {
+            bits[pos++] = (char)('0' + ((group >> bit) & 1));
+            if (bit % 4 == 0 && bit) bits[pos++] = ' ';
+        }
+        bits[pos] = '\0';
+        printf("   %s Group %d: %04x  %s\n", g < 7 ? "├─" : "└─", g + 1, group, bits);
     }
-    
-    printf("│ Address Family:    IPv6 (Internet Protocol version 6)   │\n");
-    printf("│ Bit Length:        128 bits (16 bytes)                  │\n");
-    printf("│ Group Count:       8 groups of 16 bits each             │\n");
-    printf("└─────────────────────────────────────────────────────────┘\n");
-    
-    printf("\n📚 Educational Examples:\n");
-    printf("┌─────────────────────────────────────────────────────────┐\n");
-    printf("│ Compressed:    2001:db8::1                              │\n");
-    printf("│ Expanded:      2001:0db8:0000:0000:0000:0000:0000:0001  │\n");
-    printf("│ Mixed:         ::ffff:192.168.1.1 (IPv4-mapped)        │\n");
-    printf("│ Loopback:      ::1 (equivalent to 127.0.0.1)            │\n");
-    printf("│ Unspecified:   :: (equivalent to 0.0.0.0)               │\n");
-    printf("└─────────────────────────────────────────────────────────┘\n");
     
     printf("\n🧮 IPv6 Structure Breakdown:\n");
     printf("   • Each group represents 16 bits (4 hex digits)\n");
@@ -0,0 +1,311 @@
+/*
+ * ============================================================================
+ * BATCH MODE - BULK IP / CIDR ANALYSIS
+ * ============================================================================
+ *
+ * This file implements the --batch mode, which analyzes newline-delimited
+ * input from a file or standard input in a single process. It performs the
+ * same calculations as print_ip_range(), analyze_cidr_network() and
+ * classify_ip_address(), but through the silent core API (net_core.c)
+ * instead of the educational trace, so millions of lines per second can
+ * be processed on one core.
+ *
+ * Accepted input lines (blank lines and '#' comments are skipped):
+ * - 192.168.1.10                 → address classification
+ * - 192.168.1.0/24               → CIDR network analysis
+ * - 192.168.1.10 255.255.255.0   → IP + subnet mask network analysis
+ *
+ * Output: one compact "key=value" line per input line, for example:
+ *   10.1.2.3 int=167838211 class=A type=private
+ *   10.0.0.0/8 network=10.0.0.0 prefix=8 mask=255.0.0.0 broadcast=...
+ *   bogus error=invalid
+ *
+ * With --format jsonl/csv/binary, each line becomes a NetworkResult record
+ * written through the result sink (result_sink.c) instead.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <unistd.h>
+
+/*
+ * ============================================================================
+ * COMPACT OUTPUT HELPERS
+ * ============================================================================
+ */
+
+static char *put_text(char *p, const char *text)
+{
+    while (*text) *p++ = *text++;
+    return p;
+}
+
+static char *put_uint(char *p, unsigned long long value)
+{
+    char digits[20];
+    int count = 0;
+
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    while (count > 0) *p++ = digits[--count];
+    return p;
+}
+
+static char *put_ipv4(char *p, unsigned int ip)
+{
+    return p + net_format_ipv4(ip, p);
+}
+
+/*
+ * ============================================================================
+ * LINE ANALYSIS
+ * ============================================================================
+ */
+
+/*
+ * Fills the network analysis fields for an address and prefix length
+ *
+ * Special cases follow print_ip_range():
+ * - /32: first = last = the host itself, 1 usable address
+ * - /31: both addresses usable (RFC 3021)
+ * - others: network + 1 through broadcast - 1
+ */
+static void fill_network_fields(NetworkResult *result, unsigned int ip, int prefix)
+{
+    const PrefixInfo *info = &NET_PREFIX_TABLE[prefix];
+
+    result->ip = ip;
+    result->network = ip & info->mask;
+    result->prefix = (unsigned int)prefix;
+    result->mask = info->mask;
+    result->broadcast = result->network | info->wildcard;
+    result->first = (prefix >= 31) ? result->network : result->network + 1;
+    result->last = (prefix >= 31) ? result->broadcast : result->broadcast - 1;
+    result->usable = info->usable;
+    unsigned char code = net_classify_ipv4(result->network);
+    result->net_class = net_class_label(code);
+    result->type = net_type_label(code);
+}
+
+/*
+ * Analyzes one input into a result struct
+ *
+ * - single address: ip, class and type (range fields omitted)
+ * - CIDR or "ip mask": every field but error
+ * - anything else: input and error only
+ *
+ * @param line: Input (trimmed, not NUL-terminated)
+ * @param len: Input length
+ * @param result: Filled in; input is truncated to RESULT_INPUT_MAX - 1 bytes
+ * @return: Omit mask for result_sink_emit()
+ */
+unsigned int network_result_parse(const char *line, size_t len, NetworkResult *result)
+{
+    const char *end = line + len;
+    unsigned int ip;
+    const char *p;
+    size_t echo = len < RESULT_INPUT_MAX ? len : RESULT_INPUT_MAX - 1;
+
+    memset(result, 0, sizeof(*result));
+    memcpy(result->input, line, echo);
+    result->input[echo] = '\0';
+
+    if (net_parse_ipv4_span(line, end, &ip, &p) != NET_OK) p = NULL;
+
+    if (!p) {
+        result->error = "invalid";
+    }
+    else if (p == end) {
+        // Single address: classification
+        unsigned char code = net_classify_ipv4(ip);
+        result->ip = ip;
+        result->net_class = net_class_label(code);
+        result->type = net_type_label(code);
+        return NETWORK_RESULT_RANGE | NETWORK_RESULT_ERROR;
+    }
+    else if (*p == '/') {
+        // CIDR notation: digits 0-32 must fill the rest of the line
+        int prefix = 0;
+        int digits = 0;
+        p++;
+        while (p < end && *p >= '0' && *p <= '9' && digits < 3) {
+            prefix = prefix * 10 + (*p - '0');
+            p++;
+            digits++;
+        }
+        if (digits == 0 || p != end || prefix > 32) {
+            result->error = "invalid-prefix";
+        } else {
+            fill_network_fields(result, ip, prefix);
+            return NETWORK_RESULT_ERROR;
+        }
+    }
+    else if (*p == ' ' || *p == '\t') {
+        // IP followed by dotted subnet mask
+        unsigned int mask;
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        if (net_parse_ipv4_span(p, end, &mask, &p) != NET_OK) p = NULL;
+        int prefix = p ? net_mask_to_prefix(mask) : -1;
+        if (!p || p != end || prefix < 0) {
+            result->error = "invalid-mask";
+        } else {
+            fill_network_fields(result, ip, prefix);
+            return NETWORK_RESULT_ERROR;
+        }
+    }
+    else {
+        result->error = "invalid";
+    }
+    return NETWORK_RESULT_ADDRESS | NETWORK_RESULT_RANGE;
+}
+
+/*
+ * Analyzes one input and formats its result fields
+ *
+ * Writes the text that follows the echoed input, e.g.
+ * " int=3232235777 class=C type=private" (no newline).
+ *
+ * @param line: Input (trimmed, not NUL-terminated)
+ * @param len: Input length
+ * @param w: Destination with room for BATCH_MAX_RESULT_LENGTH bytes
+ * @return: Number of bytes written
+ */
+size_t batch_format_result(const char *line, size_t len, char *w)
+{
+    NetworkResult result;
+    unsigned int omit = network_result_parse(line, len, &result);
+    char *start = w;
+
+    if (result.error) {
+        w = put_text(w, " error=");
+        w = put_text(w, result.error);
+    }
+    else if (omit & NETWORK_RESULT_RANGE) {
+        w = put_text(w, " int=");
+        w = put_uint(w, result.ip);
+        w = put_text(w, " class=");
+        w = put_text(w, result.net_class);
+        w = put_text(w, " type=");
+        w = put_text(w, result.type);
+    }
+    else {
+        w = put_text(w, " network=");
+        w = put_ipv4(w, result.network);
+        w = put_text(w, " prefix=");
+        w = put_uint(w, result.prefix);
+        w = put_text(w, " mask=");
+        w = put_text(w, NET_PREFIX_TABLE[result.prefix].dotted);
+        w = put_text(w, " broadcast=");
+        w = put_ipv4(w, result.broadcast);
+        w = put_text(w, " first=");
+        w = put_ipv4(w, result.first);
+        w = put_text(w, " last=");
+        w = put_ipv4(w, result.last);
+        w = put_text(w, " usable=");
+        w = put_uint(w, result.usable);
+        w = put_text(w, " class=");
+        w = put_text(w, result.net_class);
+        w = put_text(w, " type=");
+        w = put_text(w, result.type);
+    }
+    return (size_t)(w - start);
+}
+
+/*
+ * Analyzes one input line and appends the result line to the output
+ *
+ * @param out: Output buffer
+ * @param line: Input line (trimmed, not NUL-terminated)
+ * @param len: Line length
+ */
+static void batch_process_line(OutputBuffer *out, const char *line, size_t len)
+{
+    output_buffer_write(out, line, len);
+    char *w = output_buffer_reserve(out, BATCH_MAX_RESULT_LENGTH + 1);
+    size_t n = batch_format_result(line, len, w);
+    w[n] = '\n';
+    out->len += n + 1;
+}
+
+/*
+ * Trims surrounding blanks; returns 0 for lines to skip (blank or '#')
+ */
+static int batch_trim_line(const char **line, size_t *len)
+{
+    while (*len > 0 && (**line == ' ' || **line == '\t')) { (*line)++; (*len)--; }
+    while (*len > 0 && ((*line)[*len - 1] == ' ' || (*line)[*len - 1] == '\t')) (*len)--;
+    return *len > 0 && **line != '#';
+}
+
+/*
+ * Writes one network record per input line in the --format selected
+ *
+ * @param reader: Open input
+ * @return: Process exit status
+ */
+static int batch_emit_records(LineReader *reader)
+{
+    ResultSink sink;
+    NetworkResult result;
+
+    if (!result_sink_open(&sink, get_result_format(), STDOUT_FILENO)) return 1;
+
+    const char *line;
+    size_t len;
+    while (line_reader_next(reader, &line, &len))
+    {
+        if (!batch_trim_line(&line, &len)) continue;
+        unsigned int omit = network_result_parse(line, len, &result);
+        result_sink_emit(&sink, &RESULT_SCHEMA_NETWORK, &result, omit);
+    }
+
+    result_sink_close(&sink);
+    return reader->error ? 1 : 0;
+}
+
+/*
+ * ============================================================================
+ * BATCH MODE ENTRY POINT
+ * ============================================================================
+ */
+
+/*
+ * Runs the bulk analysis over every line of the input
+ *
+ * @param path: Input file, or NULL / "-" for standard input
+ * @return: Process exit status (0 on success, 1 if the input cannot be read)
+ */
+int run_batch_mode(const char *path)
+{
+    LineReader reader;
+    OutputBuffer out;
+
+    if (!line_reader_open(&reader, path)) return 1;
+    if (get_result_format() != RESULT_FORMAT_TEXT) {
+        int status = batch_emit_records(&reader);
+        line_reader_close(&reader);
+        return status;
+    }
+    if (!output_buffer_init(&out, STDOUT_FILENO, OUTPUT_BUFFER_SIZE)) {
+        line_reader_close(&reader);
+        return 1;
+    }
+
+    const char *line;
+    size_t len;
+    while (line_reader_next(&reader, &line, &len))
+    {
+        if (!batch_trim_line(&line, &len)) continue;
+        batch_process_line(&out, line, len);
+    }
+
+    int status = reader.error ? 1 : 0;
+    output_buffer_free(&out);
+    line_reader_close(&reader);
+    return status;
+}
@@ -0,0 +1,162 @@
+/*
+ * ============================================================================
+ * FIRST RESULT - STARTUP-TO-FIRST-RESULT LATENCY REGRESSION CHECK
+ * ============================================================================
+ *
+ * Runs the net binary the way a script does — stdout on a pipe, so the
+ * quiet profile is picked automatically — and measures, from fork() to
+ * the first byte read from the pipe, how long each offline mode takes to
+ * produce its first result. The median over several runs is compared
+ * against a limit; any mode over it (or exiting non-zero) fails the check.
+ *
+ * A reintroduced animation or progress bar costs hundreds of milliseconds,
+ * so a limit of a few tens of milliseconds catches it without being
+ * flaky on a loaded machine.
+ *
+ * Usage: bench/first_result [limit_ms] [path_to_net]
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/wait.h>
+
+#define FIRST_RESULT_RUNS        15
+#define FIRST_RESULT_LIMIT_MS    50.0
+#define FIRST_RESULT_MAX_ARGS    8
+
+typedef struct {
+    const char *name;
+    const char *args[FIRST_RESULT_MAX_ARGS];
+} LatencyCase;
+
+/* Offline modes only: nothing here touches the network */
+static const LatencyCase latency_cases[] = {
+    { "ip+mask",   { "192.168.1.10", "255.255.255.0", NULL } },
+    { "mask",      { "255.255.240.0", NULL } },
+    { "-l",        { "-l", "10.1.2.3/20", NULL } },
+    { "--cidr",    { "--cidr", "172.16.5.4/12", NULL } },
+    { "--class",   { "--class", "192.168.1.1", NULL } },
+    { "--check",   { "--check", "10.0.0.5", "10.0.0.0/8", NULL } },
+    { "--convert", { "--convert", "192.168.1.1", NULL } },
+    { "--scan",    { "--scan", "192.168.0.0/16", NULL } },
+    { "--split",   { "--split", "10.0.0.0/16", "24", NULL } },
+};
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Run one case once
+ * @param net: Path to the net binary
+ * @param lc: Case to run
+ * @param first_ms: Time from fork to the first byte on stdout
+ * @param total_ms: Time from fork to exit
+ * @return 1 if the run exited 0 and produced output, 0 otherwise
+ */
+static int run_once(const char *net, const LatencyCase *lc,
+                    double *first_ms, double *total_ms) {
+    const char *argv[FIRST_RESULT_MAX_ARGS + 2];
+    int fds[2];
+    char buf[4096];
+    ssize_t n;
+    int status, got = 0;
+    double t0;
+    pid_t pid;
+    int i;
+
+    argv[0] = net;
+    for (i = 0; lc->args[i]; i++) argv[i + 1] = lc->args[i];
+    argv[i + 1] = NULL;
+
+    if (pipe(fds) < 0) return 0;
+    t0 = now_ms();
+    pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return 0;
+    }
+    if (pid == 0) {
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(fds[1], STDOUT_FILENO);
+        if (devnull >= 0) dup2(devnull, STDERR_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        execv(net, (char *const *)argv);
+        _exit(127);
+    }
+
+    close(fds[1]);
+    *first_ms = -1;
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0) {
+        if (!got) {
+            *first_ms = now_ms() - t0;
+            got = 1;
+        }
+    }
+    close(fds[0]);
+    waitpid(pid, &status, 0);
+    *total_ms = now_ms() - t0;
+
+    return got && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char *argv[]) {
+    double limit = argc > 1 ? atof(argv[1]) : FIRST_RESULT_LIMIT_MS;
+    const char *net = argc > 2 ? argv[2] : "./net";
+    size_t n_cases = sizeof(latency_cases) / sizeof(latency_cases[0]);
+    int failures = 0;
+
+    if (limit <= 0) limit = FIRST_RESULT_LIMIT_MS;
+    if (access(net, X_OK) != 0) {
+        fprintf(stderr, "❌ Error: %s is not executable (run make first)\n", net);
+        return 1;
+    }
+
+    printf("⏱️  Startup-to-first-result, stdout on a pipe, median of %d runs (limit %.0f ms)\n",
+           FIRST_RESULT_RUNS, limit);
+    printf("%-12s %12s %12s  %s\n", "mode", "first (ms)", "total (ms)", "status");
+
+    for (size_t c = 0; c < n_cases; c++) {
+        double first[FIRST_RESULT_RUNS], total[FIRST_RESULT_RUNS];
+        int ok = 1;
+
+        for (int r = 0; r < FIRST_RESULT_RUNS; r++) {
+            if (!run_once(net, &latency_cases[c], &first[r], &total[r])) ok = 0;
+        }
+        qsort(first, FIRST_RESULT_RUNS, sizeof(double), cmp_double);
+        qsort(total, FIRST_RESULT_RUNS, sizeof(double), cmp_double);
+
+        double first_med = first[FIRST_RESULT_RUNS / 2];
+        double total_med = total[FIRST_RESULT_RUNS / 2];
+        const char *verdict = !ok ? "❌ failed" :
+                              first_med > limit ? "❌ too slow" : "✅";
+        if (!ok || first_med > limit) failures++;
+
+        printf("%-12s %12.2f %12.2f  %s\n", latency_cases[c].name,
+               first_med, total_med, verdict);
+    }
+
+    if (failures) {
+        printf("❌ %d mode(s) over the startup latency budget\n", failures);
+        return 1;
+    }
+    printf("✅ All modes produced their first result within %.0f ms\n", limit);
+    return 0;
+}
@@ -0,0 +1,470 @@
+/*
+ * ============================================================================
+ * PRIM BENCH - CONVERSION AND NETWORK-MATH PRIMITIVES
+ * ============================================================================
+ *
+ * Measures ns/op and ops/sec of the conversion helpers and the network
+ * math they feed, over randomized corpora shaped like real input:
+ *
+ * - addresses:  uniform 32-bit values, formatted as dotted quads
+ *               (1- to 3-digit octets, as in logs and host lists)
+ * - masks:      prefixes /8-/32, weighted towards /16-/30 like real
+ *               subnet plans, as dotted masks and 32-bit binary strings
+ *
+ * The educational helpers run in the quiet profile, so their trace lines
+ * cost one flag test and the timing is the arithmetic itself. The silent
+ * net_core primitives they wrap are measured alongside for reference.
+ *
+ * When perf_event_open() is allowed (perf_event_paranoid <= 2, or
+ * CAP_PERFMON) each primitive also reports user-space cycles,
+ * instructions and cache misses per op; otherwise those columns read "-".
+ *
+ * net_classify_ipv4_bulk() is then timed on a large buffer at 1, 2, 4 ...
+ * threads up to the CPU count, to show how it scales with cores.
+ *
+ * Results are printed as a table and written as a tab-separated file,
+ * one primitive per line in a fixed order, so two runs can be diffed.
+ *
+ * Usage: bench/prim_bench [ops_per_round] [results.tsv]
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#define _GNU_SOURCE
+#include "net.h"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+#define BENCH_CORPUS_SIZE      4096     // Power of two, fits in L1/L2 like a hot loop
+#define BENCH_DEFAULT_OPS      4000000
+#define BENCH_ROUNDS           5        // Best of N per primitive
+#define BENCH_DEFAULT_OUTPUT   "bench_results.tsv"
+#define BENCH_BULK_ADDRESSES   (1 << 26) // 256 MiB of addresses: far beyond the caches
+
+// Counters opened as one group, read together
+enum { COUNTER_CYCLES, COUNTER_INSTRUCTIONS, COUNTER_CACHE_MISSES, COUNTER_COUNT };
+
+typedef struct
+{
+    int fds[COUNTER_COUNT];
+    int available;
+} BenchCounters;
+
+typedef struct
+{
+    unsigned int ips[BENCH_CORPUS_SIZE];
+    unsigned int masks[BENCH_CORPUS_SIZE];
+    char ip_strs[BENCH_CORPUS_SIZE][NET_IPV4_STRLEN];
+    char mask_strs[BENCH_CORPUS_SIZE][NET_IPV4_STRLEN];
+    char bin_masks[BENCH_CORPUS_SIZE][33];
+    NetIpv6 ipv6s[BENCH_CORPUS_SIZE];
+    char ipv6_strs[BENCH_CORPUS_SIZE][NET_IPV6_STRLEN];
+} BenchCorpus;
+
+typedef struct
+{
+    const char *name;
+    unsigned long long (*run)(const BenchCorpus *corpus, size_t ops);
+} BenchPrimitive;
+
+typedef struct
+{
+    double ns_per_op;
+    double counters[COUNTER_COUNT];  // Per op, from the best round
+} BenchResult;
+
+/*
+ * ============================================================================
+ * CORPUS
+ * ============================================================================
+ */
+
+// xorshift64*: fixed seed, so every run measures the same inputs
+static unsigned long long bench_rand(unsigned long long *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static int bench_random_prefix(unsigned long long *state)
+{
+    // 3 in 4 masks are /16-/30, the rest anywhere in /8-/32
+    unsigned long long r = bench_rand(state);
+    if ((r & 3) != 0) return 16 + (int)((r >> 2) % 15);
+    return 8 + (int)((r >> 2) % 25);
+}
+
+static void bench_build_corpus(BenchCorpus *corpus)
+{
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+
+    for (size_t i = 0; i < BENCH_CORPUS_SIZE; i++)
+    {
+        const PrefixInfo *info = net_prefix_info(bench_random_prefix(&state));
+
+        corpus->ips[i] = (unsigned int)(bench_rand(&state) >> 32);
+        corpus->masks[i] = info->mask;
+        net_format_ipv4(corpus->ips[i], corpus->ip_strs[i]);
+        net_copy_string(info->dotted, corpus->mask_strs[i], NET_IPV4_STRLEN);
+        net_mask_to_binary(info->mask, corpus->bin_masks[i]);
+
+        // Global prefix over random groups, each zeroed with p = 1/4 so
+        // the text has :: runs of every length
+        uint64_t groups = bench_rand(&state), zeros = bench_rand(&state);
+        corpus->ipv6s[i].hi = 0x20010DB800000000ULL | (groups & 0xFFFFFFFFULL);
+        corpus->ipv6s[i].lo = bench_rand(&state);
+        for (int g = 0; g < 6; g++, zeros >>= 2) {
+            if ((zeros & 3) != 0) continue;
+            if (g < 2) corpus->ipv6s[i].hi &= ~(0xFFFFULL << (16 * g));
+            else corpus->ipv6s[i].lo &= ~(0xFFFFULL << (16 * (g - 2)));
+        }
+        net_format_ipv6(&corpus->ipv6s[i], corpus->ipv6_strs[i]);
+    }
+}
+
+/*
+ * ============================================================================
+ * PRIMITIVES
+ * ============================================================================
+ *
+ * Each loop folds its results into a checksum that main() consumes, so
+ * the compiler cannot drop the calls.
+ */
+
+#define BENCH_INDEX(i) ((i) & (BENCH_CORPUS_SIZE - 1))
+
+static unsigned long long bench_ip_to_int(const BenchCorpus *corpus, size_t ops)
+{
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < ops; i++) sum += ip_to_int(corpus->ip_strs[BENCH_INDEX(i)]);
+    return sum;
+}
+
+static unsigned long long bench_mask_to_int(const BenchCorpus *corpus, size_t ops)
+{
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < ops; i++) sum += mask_to_int(corpus->mask_strs[BENCH_INDEX(i)]);
+    return sum;
+}
+
+static unsigned long long bench_broadcast(const BenchCorpus *corpus, size_t ops)
+{
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < ops; i++) {
+        size_t k = BENCH_INDEX(i);
+        sum += calculate_broadcast_address(corpus->ips[k] & corpus->masks[k], corpus->masks[k]);
+    }
+    return sum;
+}
+
+static unsigned long long bench_available_ips(const BenchCorpus *corpus, size_t ops)
+{
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < ops; i++) sum += (unsigned int)calculate_available_ips(corpus->bin_masks[BENCH_INDEX(i)]);
+    return sum;
+}
+
+static unsigned long long bench_network_class(const BenchCorpus *corpus, size_t ops)
+{
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < ops; i++) sum += (uintptr_t)get_network_class(corpus->ips[BENCH_INDEX(i)]);
+    return sum;
+}
+
+static unsigned long long bench_net_classify_ipv4(const BenchCorpus *corpus, size_t ops)
+{
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < ops; i++) sum += net_classify_ipv4(corpus->ips[BENCH_INDEX(i)]);
+    return sum;
+}
+
+static unsigned long long bench_net_parse_ipv4(const BenchCorpus *corpus, size_t ops)
+{
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < ops; i++) {
+        unsigned int ip = 0;
+        net_parse_ipv4(corpus->ip_strs[BENCH_INDEX(i)], &ip);
+        sum += ip;
+    }
+    return sum;
+}
+
+static unsigned long long bench_net_parse_mask(const BenchCorpus *corpus, size_t ops)
+{
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < ops; i++) {
+        int octets[4];
+        unsigned int value = 0;
+        net_parse_mask(corpus->mask_strs[BENCH_INDEX(i)], octets, &value, NULL);
+        sum += value;
+    }
+    return sum;
+}
+
+static unsigned long long bench_net_format_ipv4(const BenchCorpus *corpus, size_t ops)
+{
+    unsigned long long sum = 0;
+    char buf[NET_IPV4_STRLEN];
+    for (size_t i = 0; i < ops; i++) sum += net_format_ipv4(corpus->ips[BENCH_INDEX(i)], buf) + (unsigned char)buf[0];
+    return sum;
+}
+
+static unsigned long long bench_net_parse_ipv6(const BenchCorpus *corpus, size_t ops)
+{
+    unsigned long long sum = 0;
+    NetIpv6 ip = {0, 0};
+    for (size_t i = 0; i < ops; i++) {
+        net_parse_ipv6(corpus->ipv6_strs[BENCH_INDEX(i)], &ip);
+        sum += ip.lo;
+    }
+    return sum;
+}
+
+static unsigned long long bench_net_format_ipv6(const BenchCorpus *corpus, size_t ops)
+{
+    unsigned long long sum = 0;
+    char buf[NET_IPV6_STRLEN];
+    for (size_t i = 0; i < ops; i++) sum += net_format_ipv6(&corpus->ipv6s[BENCH_INDEX(i)], buf) + (unsigned char)buf[0];
+    return sum;
+}
+
+// Fixed order: the TSV lines of two runs line up for diff
+static const BenchPrimitive bench_primitives[] = {
+    {"ip_to_int",                   bench_ip_to_int},
+    {"mask_to_int",                 bench_mask_to_int},
+    {"calculate_broadcast_address", bench_broadcast},
+    {"calculate_available_ips",     bench_available_ips},
+    {"get_network_class",           bench_network_class},
+    {"net_classify_ipv4",           bench_net_classify_ipv4},
+    {"net_parse_ipv4",              bench_net_parse_ipv4},
+    {"net_parse_mask",              bench_net_parse_mask},
+    {"net_format_ipv4",             bench_net_format_ipv4},
+    {"net_parse_ipv6",              bench_net_parse_ipv6},
+    {"net_format_ipv6",             bench_net_format_ipv6},
+};
+
+/*
+ * ============================================================================
+ * HARDWARE COUNTERS
+ * ============================================================================
+ */
+
+static int bench_perf_open(unsigned long long config, int group_fd)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd < 0;   // The leader starts the group
+    attr.exclude_kernel = 1;        // Allowed at perf_event_paranoid 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+static void bench_counters_open(BenchCounters *counters)
+{
+    static const unsigned long long configs[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES
+    };
+
+    counters->available = 0;
+    for (int c = 0; c < COUNTER_COUNT; c++) counters->fds[c] = -1;
+
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        counters->fds[c] = bench_perf_open(configs[c], c == 0 ? -1 : counters->fds[0]);
+        if (counters->fds[c] < 0) {
+            fprintf(stderr, "⚠️  perf_event_open unavailable (%s); counters not reported\n", strerror(errno));
+            for (int k = 0; k < c; k++) close(counters->fds[k]);
+            return;
+        }
+    }
+    counters->available = 1;
+}
+
+static void bench_counters_close(BenchCounters *counters)
+{
+    if (!counters->available) return;
+    for (int c = 0; c < COUNTER_COUNT; c++) close(counters->fds[c]);
+}
+
+static void bench_counters_start(const BenchCounters *counters)
+{
+    if (!counters->available) return;
+    ioctl(counters->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(counters->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+// Output: 1 if the values were read
+static int bench_counters_stop(const BenchCounters *counters, unsigned long long *values)
+{
+    unsigned long long group[1 + COUNTER_COUNT];
+
+    if (!counters->available) return 0;
+    ioctl(counters->fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    if (read(counters->fds[0], group, sizeof(group)) != (ssize_t)sizeof(group)) return 0;
+    if (group[0] != COUNTER_COUNT) return 0;
+    memcpy(values, group + 1, sizeof(unsigned long long) * COUNTER_COUNT);
+    return 1;
+}
+
+/*
+ * ============================================================================
+ * MEASUREMENT
+ * ============================================================================
+ */
+
+static volatile unsigned long long bench_sink;
+
+static void bench_measure(const BenchPrimitive *primitive, const BenchCorpus *corpus,
+                          size_t ops, const BenchCounters *counters, BenchResult *result)
+{
+    result->ns_per_op = 0;
+    for (int c = 0; c < COUNTER_COUNT; c++) result->counters[c] = -1;
+
+    bench_sink += primitive->run(corpus, ops / 10);  // Warm caches and predictors
+
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        unsigned long long values[COUNTER_COUNT];
+
+        bench_counters_start(counters);
+        unsigned long long start = net_now_ns();
+        bench_sink += primitive->run(corpus, ops);
+        unsigned long long elapsed = net_now_ns() - start;
+        int counted = bench_counters_stop(counters, values);
+
+        double ns = (double)elapsed / (double)ops;
+        if (round == 0 || ns < result->ns_per_op) {
+            result->ns_per_op = ns;
+            for (int c = 0; c < COUNTER_COUNT; c++) {
+                result->counters[c] = counted ? (double)values[c] / (double)ops : -1;
+            }
+        }
+    }
+}
+
+/*
+ * Bulk classification throughput at 1, 2, 4, ... threads up to the CPU count
+ * over BENCH_BULK_ADDRESSES random addresses (best of BENCH_ROUNDS each)
+ */
+static void bench_bulk_scaling(FILE *tsv)
+{
+    unsigned int *ips = malloc(BENCH_BULK_ADDRESSES * sizeof(unsigned int));
+    unsigned char *codes = malloc(BENCH_BULK_ADDRESSES);
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (!ips || !codes) {
+        free(ips);
+        free(codes);
+        return;
+    }
+    for (size_t i = 0; i < BENCH_BULK_ADDRESSES; i++) ips[i] = (unsigned int)(bench_rand(&state) >> 32);
+    if (cpus < 1) cpus = 1;
+
+    printf("\n⏱️  net_classify_ipv4_bulk (%s kernel): %d addresses, best of %d\n\n",
+           net_classify_backend(), BENCH_BULK_ADDRESSES, BENCH_ROUNDS);
+    printf("%-28s %10s %14s %10s\n", "threads", "ns/addr", "addr/s", "speedup");
+
+    double single = 0;
+    for (long threads = 1; ; threads = threads * 2 > cpus && threads < cpus ? cpus : threads * 2)
+    {
+        double best = 0;
+        for (int round = 0; round < BENCH_ROUNDS; round++) {
+            unsigned long long start = net_now_ns();
+            net_classify_ipv4_bulk(ips, BENCH_BULK_ADDRESSES, codes, (int)threads);
+            double ns = (double)(net_now_ns() - start) / BENCH_BULK_ADDRESSES;
+            if (round == 0 || ns < best) best = ns;
+            bench_sink += codes[round];
+        }
+        if (threads == 1) single = best;
+
+        char name[48];
+        snprintf(name, sizeof(name), "net_classify_ipv4_bulk/%ld", threads);
+        printf("%-28ld %10.3f %14.0f %9.2fx\n", threads, best, 1e9 / best, single / best);
+        fprintf(tsv, "%s\t%.3f\t%.0f\t-\t-\t-\n", name, best, 1e9 / best);
+        if (threads >= cpus) break;
+    }
+
+    free(ips);
+    free(codes);
+}
+
+// Formats a per-op counter, or "-" when it was not measured
+static const char *bench_counter_text(double value, char *buf, size_t size)
+{
+    if (value < 0) snprintf(buf, size, "-");
+    else snprintf(buf, size, "%.2f", value);
+    return buf;
+}
+
+/*
+ * ============================================================================
+ * MAIN
+ * ============================================================================
+ */
+
+int main(int argc, char **argv)
+{
+    size_t ops = argc > 1 ? strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_OPS;
+    const char *output = argc > 2 ? argv[2] : BENCH_DEFAULT_OUTPUT;
+    size_t count = sizeof(bench_primitives) / sizeof(bench_primitives[0]);
+    if (ops == 0) ops = BENCH_DEFAULT_OPS;
+
+    set_quiet_mode(1);  // Trace lines off: measure the arithmetic, not stdio
+
+    BenchCorpus *corpus = malloc(sizeof(BenchCorpus));
+    if (!corpus) return 1;
+    bench_build_corpus(corpus);
+
+    BenchCounters counters;
+    bench_counters_open(&counters);
+
+    FILE *tsv = fopen(output, "w");
+    if (!tsv) {
+        fprintf(stderr, "❌ Cannot write %s: %s\n", output, strerror(errno));
+        bench_counters_close(&counters);
+        free(corpus);
+        return 1;
+    }
+    fprintf(tsv, "primitive\tns_per_op\tops_per_sec\tcycles_per_op\tinstructions_per_op\tcache_misses_per_op\n");
+
+    printf("⏱️  Primitive benchmark: %zu ops per round over %d inputs, best of %d\n\n",
+           ops, BENCH_CORPUS_SIZE, BENCH_ROUNDS);
+    printf("%-28s %10s %14s %10s %10s %10s\n", "primitive", "ns/op", "ops/s", "cycles", "instr", "misses");
+
+    for (size_t i = 0; i < count; i++)
+    {
+        BenchResult result;
+        char cycles[32], instructions[32], misses[32];
+
+        bench_measure(&bench_primitives[i], corpus, ops, &counters, &result);
+        double ops_per_sec = result.ns_per_op > 0 ? 1e9 / result.ns_per_op : 0;
+        bench_counter_text(result.counters[COUNTER_CYCLES], cycles, sizeof(cycles));
+        bench_counter_text(result.counters[COUNTER_INSTRUCTIONS], instructions, sizeof(instructions));
+        bench_counter_text(result.counters[COUNTER_CACHE_MISSES], misses, sizeof(misses));
+
+        printf("%-28s %10.2f %14.0f %10s %10s %10s\n", bench_primitives[i].name,
+               result.ns_per_op, ops_per_sec, cycles, instructions, misses);
+        fprintf(tsv, "%s\t%.2f\t%.0f\t%s\t%s\t%s\n", bench_primitives[i].name,
+                result.ns_per_op, ops_per_sec, cycles, instructions, misses);
+    }
+
+    bench_bulk_scaling(tsv);
+
+    fclose(tsv);
+    printf("\n📄 Results written to %s\n", output);
+
+    bench_counters_close(&counters);
+    free(corpus);
+    return bench_sink == 42 ? 2 : 0;  // Consume the checksum
+}
@@ -0,0 +1,348 @@
+/*
+ * ============================================================================
+ * PROBE BENCH - CONNECT PROBES PER SECOND: SELECT vs EPOLL vs IO_URING
+ * ============================================================================
+ *
+ * Measures how many TCP connect probes per second each engine completes
+ * against local listeners, where the network costs almost nothing and the
+ * per-probe system call overhead dominates:
+ *
+ * - select:   socket/fcntl/connect/select/getsockopt/close per probe, the
+ *             pattern of check_tcp_connectivity(), kept concurrent up to
+ *             FD_SETSIZE so it is not penalized for being sequential
+ * - epoll:    the connect scanner's epoll backend
+ * - io_uring: the connect scanner's io_uring backend
+ *
+ * Targets: a set of listeners on 127.0.0.1 (accepted and closed by a
+ * helper thread) mixed with the same ports on 127.0.0.2-254, which are
+ * refused immediately — like a sweep, mostly closed with some open.
+ *
+ * Usage: bench/probe_bench [probes] [in_flight]
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#define _GNU_SOURCE
+#include "net.h"
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <pthread.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+#define BENCH_LISTENERS        8
+#define BENCH_OPEN_EVERY       20       // One target in 20 is a listener
+#define BENCH_DEFAULT_PROBES   200000
+#define BENCH_DEFAULT_INFLIGHT 512
+#define BENCH_ROUNDS           3        // Best of N per engine
+#define BENCH_TIMEOUT_MS       1000
+
+typedef struct
+{
+    unsigned int ip;
+    unsigned short port;
+} BenchTarget;
+
+typedef struct
+{
+    int fds[BENCH_LISTENERS];
+    volatile int stop;
+} BenchListeners;
+
+typedef struct
+{
+    const char *name;
+    size_t completed;
+    size_t open_count;
+    double seconds;
+    double cpu_us;               // Main thread CPU time (user + system)
+} BenchRun;
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static double bench_thread_cpu_us(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return (double)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e6 +
+           (double)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+/*
+ * ============================================================================
+ * LOCAL LISTENERS
+ * ============================================================================
+ */
+
+/*
+ * Accepts and immediately closes every connection until stopped
+ */
+static void *bench_accept_loop(void *arg)
+{
+    BenchListeners *listeners = arg;
+    struct pollfd pfds[BENCH_LISTENERS];
+
+    for (int i = 0; i < BENCH_LISTENERS; i++) {
+        pfds[i].fd = listeners->fds[i];
+        pfds[i].events = POLLIN;
+    }
+
+    while (!listeners->stop)
+    {
+        if (poll(pfds, BENCH_LISTENERS, 100) <= 0) continue;
+        for (int i = 0; i < BENCH_LISTENERS; i++) {
+            if (!(pfds[i].revents & POLLIN)) continue;
+            int fd;
+            while ((fd = accept4(pfds[i].fd, NULL, NULL, SOCK_NONBLOCK)) >= 0) close(fd);
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Opens the listeners on ephemeral ports of 127.0.0.1
+ */
+static int bench_open_listeners(BenchListeners *listeners, unsigned short *ports)
+{
+    for (int i = 0; i < BENCH_LISTENERS; i++)
+    {
+        struct sockaddr_in addr;
+        socklen_t addr_len = sizeof(addr);
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+            listen(fd, 4096) != 0 || getsockname(fd, (struct sockaddr *)&addr, &addr_len) != 0) {
+            fprintf(stderr, "❌ Cannot open listener: %s\n", strerror(errno));
+            if (fd >= 0) close(fd);
+            return 0;
+        }
+        listeners->fds[i] = fd;
+        ports[i] = ntohs(addr.sin_port);
+    }
+    return 1;
+}
+
+/*
+ * ============================================================================
+ * ENGINES
+ * ============================================================================
+ */
+
+/*
+ * select() engine: the per-probe system calls of check_tcp_connectivity()
+ */
+static void bench_run_select(const BenchTarget *targets, size_t count, size_t max_inflight, BenchRun *run)
+{
+    int fds[FD_SETSIZE];
+    size_t active = 0;
+    size_t next = 0;
+
+    if (max_inflight > FD_SETSIZE - 64) max_inflight = FD_SETSIZE - 64;
+
+    while (next < count || active > 0)
+    {
+        // Fill the window
+        while (next < count && active < max_inflight)
+        {
+            const BenchTarget *target = &targets[next++];
+            int fd = socket(AF_INET, SOCK_STREAM, 0);
+            if (fd < 0 || fd >= FD_SETSIZE) {
+                if (fd >= 0) close(fd);
+                run->completed++;
+                continue;
+            }
+            int flags = fcntl(fd, F_GETFL, 0);
+            fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+            struct sockaddr_in addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(target->port);
+            addr.sin_addr.s_addr = htonl(target->ip);
+
+            int result = connect(fd, (struct sockaddr *)&addr, sizeof(addr));
+            if (result == 0 || errno != EINPROGRESS) {
+                if (result == 0) run->open_count++;
+                close(fd);
+                run->completed++;
+                continue;
+            }
+            fds[active++] = fd;
+        }
+        if (active == 0) continue;
+
+        // select() rescans the whole set on every call
+        fd_set write_fds;
+        FD_ZERO(&write_fds);
+        int max_fd = 0;
+        for (size_t i = 0; i < active; i++) {
+            FD_SET(fds[i], &write_fds);
+            if (fds[i] > max_fd) max_fd = fds[i];
+        }
+        struct timeval timeout = {BENCH_TIMEOUT_MS / 1000, (BENCH_TIMEOUT_MS % 1000) * 1000};
+        int ready = select(max_fd + 1, NULL, &write_fds, NULL, &timeout);
+
+        for (size_t i = 0; i < active; )
+        {
+            if (ready > 0 && !FD_ISSET(fds[i], &write_fds)) {
+                i++;
+                continue;
+            }
+            int error = 0;
+            socklen_t error_len = sizeof(error);
+            getsockopt(fds[i], SOL_SOCKET, SO_ERROR, &error, &error_len);
+            if (ready > 0 && error == 0) {
+                struct linger reset = {1, 0};
+                setsockopt(fds[i], SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+                run->open_count++;
+            }
+            close(fds[i]);
+            run->completed++;
+            fds[i] = fds[--active];
+        }
+    }
+}
+
+/*
+ * Connect scanner engine on a given backend
+ *
+ * @return: 1 if the backend ran, 0 if it is unavailable
+ */
+static int bench_run_scanner(SweepBackend backend, const BenchTarget *targets, size_t count,
+                             size_t max_inflight, BenchRun *run)
+{
+    ConnectScanner scanner;
+    if (!connect_scanner_init_backend(&scanner, backend, max_inflight, BENCH_TIMEOUT_MS, NULL, NULL)) {
+        return 0;
+    }
+    if (scanner.backend != backend) {
+        connect_scanner_free(&scanner);
+        return 0;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        while (!connect_scanner_submit(&scanner, targets[i].ip, targets[i].port)) {
+            connect_scanner_run_once(&scanner, -1);
+        }
+    }
+    connect_scanner_drain(&scanner);
+
+    run->completed = scanner.completed;
+    run->open_count = scanner.open_count;
+    connect_scanner_free(&scanner);
+    return 1;
+}
+
+/*
+ * Runs one engine BENCH_ROUNDS times and keeps the fastest round
+ *
+ * @param engine: 0 = select, otherwise a SweepBackend
+ * @return: 1 if the engine is available
+ */
+static int bench_engine(const char *name, int engine, const BenchTarget *targets, size_t count,
+                        size_t max_inflight, BenchRun *best)
+{
+    memset(best, 0, sizeof(*best));
+    best->name = name;
+
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        BenchRun run;
+        memset(&run, 0, sizeof(run));
+        run.name = name;
+
+        double cpu_start = bench_thread_cpu_us();
+        double start = bench_now();
+        if (engine == 0) {
+            bench_run_select(targets, count, max_inflight, &run);
+        } else if (!bench_run_scanner((SweepBackend)engine, targets, count, max_inflight, &run)) {
+            return 0;
+        }
+        run.seconds = bench_now() - start;
+        run.cpu_us = bench_thread_cpu_us() - cpu_start;
+
+        if (best->seconds == 0 || run.seconds < best->seconds) *best = run;
+    }
+    return 1;
+}
+
+/*
+ * ============================================================================
+ * MAIN
+ * ============================================================================
+ */
+
+int main(int argc, char **argv)
+{
+    size_t count = argc > 1 ? strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_PROBES;
+    size_t max_inflight = argc > 2 ? strtoul(argv[2], NULL, 10) : BENCH_DEFAULT_INFLIGHT;
+    if (count == 0) count = BENCH_DEFAULT_PROBES;
+    if (max_inflight == 0) max_inflight = BENCH_DEFAULT_INFLIGHT;
+
+    BenchListeners listeners;
+    unsigned short ports[BENCH_LISTENERS];
+    memset(&listeners, 0, sizeof(listeners));
+    if (!bench_open_listeners(&listeners, ports)) return 1;
+
+    pthread_t acceptor;
+    if (pthread_create(&acceptor, NULL, bench_accept_loop, &listeners) != 0) {
+        fprintf(stderr, "❌ Cannot start accept thread\n");
+        return 1;
+    }
+
+    // 127.0.0.1 has the listeners; the same ports on 127.0.0.2-254 refuse
+    BenchTarget *targets = malloc(count * sizeof(BenchTarget));
+    if (!targets) return 1;
+    size_t expected_open = 0;
+    for (size_t i = 0; i < count; i++) {
+        targets[i].port = ports[i % BENCH_LISTENERS];
+        if (i % BENCH_OPEN_EVERY == 0) {
+            targets[i].ip = INADDR_LOOPBACK;
+            expected_open++;
+        } else {
+            targets[i].ip = INADDR_LOOPBACK + 1 + (unsigned int)(i % 253);
+        }
+    }
+
+    printf("⏱️  Connect probe benchmark: %zu probes (%zu open), %zu in flight, best of %d\n\n",
+           count, expected_open, max_inflight, BENCH_ROUNDS);
+    printf("%-10s %10s %8s %10s %12s %14s\n", "engine", "probes", "open", "seconds", "probes/s", "cpu us/probe");
+
+    static const struct { const char *name; int engine; } engines[] = {
+        {"select",   0},
+        {"epoll",    SWEEP_BACKEND_EPOLL},
+        {"io_uring", SWEEP_BACKEND_URING},
+    };
+
+    for (size_t i = 0; i < sizeof(engines) / sizeof(engines[0]); i++)
+    {
+        BenchRun run;
+        if (!bench_engine(engines[i].name, engines[i].engine, targets, count, max_inflight, &run)) {
+            printf("%-10s %10s\n", engines[i].name, "unavailable");
+            continue;
+        }
+        printf("%-10s %10zu %8zu %10.3f %12.0f %14.2f\n", run.name, run.completed, run.open_count,
+               run.seconds, (double)run.completed / run.seconds, run.cpu_us / (double)run.completed);
+    }
+
+    listeners.stop = 1;
+    pthread_join(acceptor, NULL);
+    for (int i = 0; i < BENCH_LISTENERS; i++) close(listeners.fds[i]);
+    free(targets);
+    return 0;
+}
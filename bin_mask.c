@@ -24,8 +24,6 @@
  */
 char *dec_to_binary(int nb)
 {
-    int index = 7;  // Start from rightmost bit (bit 7)
-    
     // Allocate memory for 8 bits + null terminator
     char *bin_nb = malloc(sizeof(char) * 9);
     if (!bin_nb) {
@@ -33,25 +31,10 @@ char *dec_to_binary(int nb)
         return NULL;
     }
     
-    // Initialize all bits to '0' and add null terminator
-    memset(bin_nb, '0', 8);
-    bin_nb[8] = '\0';
-    
-    // Handle special case: 0 → "00000000"
-    if (nb == 0) {
-        printf("🔢 Binary conversion: %d → %s\n", nb, bin_nb);
-        return bin_nb;
-    }
-    
-    // Convert to binary using repeated division by 2
-    while (nb > 0 && index >= 0)
-    {
-        bin_nb[index] = (nb % 2) + '0';  // Get remainder (0 or 1) and convert to char
-        nb /= 2;                         // Integer division by 2
-        index--;                         // Move to next bit position (leftward)
-    }
+    // Repeated division by 2 is done by the silent core primitive
+    net_octet_to_binary((unsigned int)nb & 255, bin_nb);
     
-    printf("🔢 Binary conversion: Original → %s\n", bin_nb);
+    trace_printf("🔢 Binary conversion: %d → %s\n", nb, bin_nb);
     return bin_nb;
 }
 
@@ -85,8 +68,8 @@ char *copy_input(const char *input)
         return NULL;
     }
     
-    strcpy(copy, input);
-    printf("📝 String copied: \"%s\" (length: %zu)\n", input, len);
+    net_copy_string(input, copy, len + 1);
+    trace_printf("📝 String copied: \"%s\" (length: %zu)\n", input, len);
     
     return copy;
 }
@@ -103,48 +86,45 @@ char *copy_input(const char *input)
  * Takes a dotted decimal string like "255.255.255.0" and splits it
  * into an array [255, 255, 255, 0] for mathematical processing.
  * 
- * Uses strtok() to split on '.' delimiter - this is why we need
- * a copy of the input string (strtok modifies the original).
+ * The parsing itself is done by net_parse_mask() in a single pass:
+ * the input is only read (no strtok), the result goes into storage
+ * owned by the caller (no static array), and the mask is checked for
+ * contiguity while the octets are read. This makes the function safe
+ * to call from several threads at once.
  * 
- * @param input: Subnet mask string (WILL BE MODIFIED by strtok)
- * @return: Static array of 4 integers, or NULL if invalid format
+ * @param input: Subnet mask string (not modified)
+ * @param mask_out: Caller array of 4 integers that receives the octets
+ * @param prefix_out: Receives the prefix length (may be NULL)
+ * @return: mask_out, or NULL if invalid format or non-contiguous mask
  */
-int *prepar_mask(char *input)
+int *prepar_mask(const char *input, int *mask_out, int *prefix_out)
 {
-    static int mask[4];  // Static array - persists after function returns
-    int i = 0;
+    int prefix;
     
-    printf("🔍 Parsing mask string: \"%s\"\n", input);
+    if (!input || !mask_out) {
+        printf("❌ Invalid mask: NULL input\n");
+        return NULL;
+    }
     
-    // Split string on '.' delimiter
-    char *token = strtok(input, ".");
+    trace_printf("🔍 Parsing mask string: \"%s\"\n", input);
     
-    while (token != NULL && i < 4)
-    {
-        mask[i] = atoi(token);  // Convert string to integer
-        
-        // Validate octet range (0-255)
-        if (mask[i] < 0 || mask[i] > 255) {
-            printf("❌ Invalid octet value: %d (must be 0-255)\n", mask[i]);
-            return NULL;
+    NetStatus status = net_parse_mask(input, mask_out, NULL, &prefix);
+    if (status != NET_OK) {
+        printf("❌ Invalid mask \"%s\": %s\n", input, net_status_string(status));
+        if (status == NET_ERR_MASK) {
+            printf("   The 1 bits of a subnet mask must be contiguous from the left\n");
         }
-        
-        printf("   Octet %d: %s → %d\n", i+1, token, mask[i]);
-        
-        i++;
-        token = strtok(NULL, ".");  // Get next token
-    }
-    
-    // Ensure we got exactly 4 octets
-    if (i != 4) {
-        printf("❌ Invalid mask format: expected 4 octets, got %d\n", i);
         return NULL;
     }
     
-    printf("✅ Mask parsed successfully: [%d, %d, %d, %d]\n", 
-           mask[0], mask[1], mask[2], mask[3]);
+    for (int i = 0; i < 4; i++) {
+        trace_printf("   Octet %d: %d\n", i + 1, mask_out[i]);
+    }
+    trace_printf("✅ Mask parsed successfully: [%d, %d, %d, %d] (/%d)\n", 
+           mask_out[0], mask_out[1], mask_out[2], mask_out[3], prefix);
     
-    return mask;
+    if (prefix_out) *prefix_out = prefix;
+    return mask_out;
 }
 
 /*
@@ -170,7 +150,7 @@ char *mask_bin_single(int *mask)
     
     int pos = 0;  // Position in result string
     
-    printf("🔄 Converting mask to binary...\n");
+    trace_printf("🔄 Converting mask to binary...\n");
     
     // Convert each octet to binary and concatenate
     for (int i = 0; i < 4; i++)
@@ -186,14 +166,14 @@ char *mask_bin_single(int *mask)
         memcpy(res + pos, bin_oct, 8);
         pos += 8;
         
-        printf("   Octet %d (%d) → %s\n", i+1, mask[i], bin_oct);
+        trace_printf("   Octet %d (%d) → %s\n", i+1, mask[i], bin_oct);
         
         free(bin_oct);  // Clean up individual octet binary string
     }
     
     res[32] = '\0';  // Null terminate the 32-bit string
     
-    printf("✅ Complete binary mask: %s\n", res);
+    trace_printf("✅ Complete binary mask: %s\n", res);
     
     return res;
 }
@@ -214,18 +194,11 @@ void print_binary_mask(const char *mask_str)
 {
     printf("🔍 Basic binary mask analysis for: %s\n", mask_str);
     
-    char *input_copy = copy_input(mask_str);
-    if (!input_copy)
-    {
-        printf("❌ Memory allocation failed.\n");
-        return;
-    }
-
-    int *mask = prepar_mask(input_copy);
+    int mask_octets[4];
+    int *mask = prepar_mask(mask_str, mask_octets, NULL);
     if (!mask)
     {
         printf("❌ Invalid subnet mask format.\n");
-        free(input_copy);
         return;
     }
 
@@ -233,14 +206,12 @@ void print_binary_mask(const char *mask_str)
     if (!bin_mask)
     {
         printf("❌ Memory allocation error.\n");
-        free(input_copy);
         return;
     }
 
     printf("📊 Binary mask (32 bits):\n%s\n", bin_mask);
 
     free(bin_mask);
-    free(input_copy);
 }
 
 /*
@@ -275,21 +246,21 @@ int calculate_available_ips(const char *bin_mask)
     
     int host_bits = 0;
     
-    printf("🔢 Counting host bits in mask: %s\n", bin_mask);
+    trace_printf("🔢 Counting host bits in mask: %s\n", bin_mask);
     
     // Count the number of 0 bits (host bits) from right to left
     for (int i = 31; i >= 0; i--)
     {
         if (bin_mask[i] == '0') {
             host_bits++;
-            printf("   Bit %d: 0 (host bit #%d)\n", i, host_bits);
+            trace_printf("   Bit %d: 0 (host bit #%d)\n", i, host_bits);
         } else {
-            printf("   Bit %d: 1 (network bit) - stopping count\n", i);
+            trace_printf("   Bit %d: 1 (network bit) - stopping count\n", i);
             break; // Stop when we hit the first 1 bit from the right
         }
     }
     
-    printf("📈 Total host bits: %d (CIDR: /%d)\n", host_bits, 32 - host_bits);
+    trace_printf("📈 Total host bits: %d (CIDR: /%d)\n", host_bits, 32 - host_bits);
     
     // Calculate total IPs using mathematical exponentiation: 2^host_bits
     int total_ips = 1;
@@ -298,23 +269,23 @@ int calculate_available_ips(const char *bin_mask)
         total_ips *= 2;
     }
     
-    printf("🧮 Total possible IPs: 2^%d = %d\n", host_bits, total_ips);
+    trace_printf("🧮 Total possible IPs: 2^%d = %d\n", host_bits, total_ips);
     
     // Handle special cases according to networking standards
     if (host_bits == 0) // /32 - single host
     {
-        printf("🏠 Special case: /32 single host network\n");
+        trace_printf("🏠 Special case: /32 single host network\n");
         return 1;
     }
     else if (host_bits == 1) // /31 - point-to-point link
     {
-        printf("🔗 Special case: /31 point-to-point link (RFC 3021)\n");
+        trace_printf("🔗 Special case: /31 point-to-point link (RFC 3021)\n");
         return 2;
     }
     else // Normal network - subtract network and broadcast
     {
         int available = total_ips - 2;
-        printf("💼 Normal network: %d total - 2 (network + broadcast) = %d usable\n", 
+        trace_printf("💼 Normal network: %d total - 2 (network + broadcast) = %d usable\n", 
                total_ips, available);
         return available;
     }
@@ -336,18 +307,11 @@ void print_mask_info(const char *mask_str)
     printf("🎯 Comprehensive subnet mask analysis\n");
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     
-    char *input_copy = copy_input(mask_str);
-    if (!input_copy)
-    {
-        printf("❌ Memory allocation failed.\n");
-        return;
-    }
-
-    int *mask = prepar_mask(input_copy);
+    int mask_octets[4];
+    int *mask = prepar_mask(mask_str, mask_octets, NULL);
     if (!mask)
     {
         printf("❌ Invalid subnet mask format.\n");
-        free(input_copy);
         return;
     }
 
@@ -355,7 +319,6 @@ void print_mask_info(const char *mask_str)
     if (!bin_mask)
     {
         printf("❌ Memory allocation error.\n");
-        free(input_copy);
         return;
     }
 
@@ -400,7 +363,6 @@ void print_mask_info(const char *mask_str)
 
     // Clean up allocated memory
     free(bin_mask);
-    free(input_copy);
     
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
 }
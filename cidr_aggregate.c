@@ -0,0 +1,473 @@
+/*
+ * ============================================================================
+ * CIDR AGGREGATION - RADIX SORT, MERGE AND EXTERNAL SORT
+ * ============================================================================
+ *
+ * This file implements the --aggregate mode: a CIDR list of any size, in
+ * any order, with overlaps, duplicates and adjacent blocks, is collapsed
+ * into the minimal list of prefixes that covers exactly the same
+ * addresses (supernetting).
+ *
+ *   ./net --aggregate routes.txt             file
+ *   zcat bgp.gz | ./net --aggregate - 64     stdin, 64 MB sort memory
+ *
+ * Sort: each prefix becomes a 64-bit key (network << 6 | prefix), so
+ * sorting keys orders by address and, for one address, the shorter
+ * (covering) prefix first. Keys are sorted by an LSD radix sort with
+ * three 13-bit digits; a digit that is the same in every key (common for
+ * a /8-heavy table) is skipped.
+ *
+ * Merge: sorted prefixes are swept once. Each one either extends the
+ * current run (it overlaps or touches it) or closes it. A closed run is
+ * written as its minimal CIDR cover (ip_range_write_cidrs), which also
+ * joins siblings: 10.0.0.0/25 + 10.0.0.128/25 is one run → 10.0.0.0/24.
+ *
+ * Bounded memory: keys are collected in chunks sized from the memory
+ * budget (16 bytes per prefix: keys + radix scratch). When the input
+ * fills more than one chunk, each chunk is sorted and merged into
+ * disjoint runs, and the runs are spilled to a temporary file as binary
+ * (first, last) pairs. Merging already shrinks most real tables a lot.
+ * The spilled runs are then read back together through a min-heap
+ * (k-way merge) and fed to the same sweep. At most AGG_MERGE_FANIN runs
+ * are merged at once; with more chunks than that, groups are first
+ * merged into new spilled runs, pass after pass. Memory stays within the
+ * budget plus AGG_MERGE_FANIN read buffers, and the merge needs no file
+ * descriptor beyond the spill file itself (in $TMPDIR, default /tmp).
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <errno.h>
+#include <unistd.h>
+
+#define AGG_RADIX_BITS          13
+#define AGG_RADIX_SIZE          (1U << AGG_RADIX_BITS)
+#define AGG_RADIX_PASSES        3                // 39 bits: 32 address + 6 prefix
+#define AGG_BYTES_PER_PREFIX    (2 * sizeof(uint64_t))
+#define AGG_SPILL_BUFFER        (64 * 1024)      // Read buffer per merged run
+#define AGG_MERGE_FANIN         64               // Runs merged at once (4 MiB of buffers)
+
+/*
+ * ============================================================================
+ * RADIX SORT
+ * ============================================================================
+ */
+
+/*
+ * Sorts keys in place (scratch has room for count keys)
+ */
+static void agg_radix_sort(uint64_t *keys, uint64_t *scratch, size_t count)
+{
+    static size_t counts[AGG_RADIX_PASSES][AGG_RADIX_SIZE];
+    uint64_t *src = keys, *dst = scratch;
+
+    // One scan builds the histograms of every digit
+    memset(counts, 0, sizeof(counts));
+    for (size_t i = 0; i < count; i++) {
+        for (int pass = 0; pass < AGG_RADIX_PASSES; pass++) {
+            counts[pass][(keys[i] >> (pass * AGG_RADIX_BITS)) & (AGG_RADIX_SIZE - 1)]++;
+        }
+    }
+
+    for (int pass = 0; pass < AGG_RADIX_PASSES; pass++)
+    {
+        size_t *bucket = counts[pass];
+        unsigned int shift = (unsigned int)(pass * AGG_RADIX_BITS);
+
+        // Every key has the same digit: the pass would not move anything
+        if (count == 0 || bucket[(src[0] >> shift) & (AGG_RADIX_SIZE - 1)] == count) continue;
+
+        size_t offset = 0;
+        for (unsigned int d = 0; d < AGG_RADIX_SIZE; d++) {
+            size_t n = bucket[d];
+            bucket[d] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < count; i++) {
+            dst[bucket[(src[i] >> shift) & (AGG_RADIX_SIZE - 1)]++] = src[i];
+        }
+
+        uint64_t *swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != keys) memcpy(keys, src, count * sizeof(*keys));
+}
+
+/*
+ * ============================================================================
+ * RUN SWEEP
+ * ============================================================================
+ */
+
+// Joins ascending intervals into runs; closed runs go to out, or to spill
+typedef struct
+{
+    OutputBuffer *out;           // Final output (minimal CIDR cover), or NULL
+    FILE *spill;                 // Spill file for (first, last) pairs, or NULL
+    int pending;
+    unsigned int first;
+    unsigned int last;
+    size_t prefixes;             // Prefixes written to out
+    unsigned long long addresses;
+    size_t runs;                 // Runs closed
+} AggSweep;
+
+static int agg_close_run(AggSweep *sweep)
+{
+    if (!sweep->pending) return 1;
+    sweep->pending = 0;
+    sweep->runs++;
+
+    if (sweep->spill) {
+        unsigned int pair[2] = { sweep->first, sweep->last };
+        return fwrite(pair, sizeof(pair), 1, sweep->spill) == 1;
+    }
+    sweep->prefixes += ip_range_write_cidrs(sweep->out, sweep->first, sweep->last);
+    sweep->addresses += (unsigned long long)(sweep->last - sweep->first) + 1;
+    return 1;
+}
+
+/*
+ * Adds an interval (intervals must arrive in ascending order of first)
+ *
+ * @return: 1 if successful, 0 on a spill write error
+ */
+static int agg_sweep_add(AggSweep *sweep, unsigned int first, unsigned int last)
+{
+    if (sweep->pending && (sweep->last == 0xFFFFFFFFU || first <= sweep->last + 1)) {
+        if (last > sweep->last) sweep->last = last;
+        return 1;
+    }
+    if (!agg_close_run(sweep)) return 0;
+    sweep->pending = 1;
+    sweep->first = first;
+    sweep->last = last;
+    return 1;
+}
+
+/*
+ * Sweeps sorted keys into runs
+ *
+ * @return: 1 if successful, 0 on a spill write error
+ */
+static int agg_sweep_keys(AggSweep *sweep, const uint64_t *keys, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        unsigned int first = (unsigned int)(keys[i] >> 6);
+        unsigned int last = first | NET_PREFIX_TABLE[keys[i] & 63].wildcard;
+        if (!agg_sweep_add(sweep, first, last)) return 0;
+    }
+    return agg_close_run(sweep);
+}
+
+/*
+ * ============================================================================
+ * EXTERNAL MERGE
+ * ============================================================================
+ */
+
+// One spilled run being read back through its own small buffer
+typedef struct
+{
+    off_t offset;                // File offset of the next unread pair
+    size_t remaining;            // Pairs not yet read from the file
+    unsigned int *pairs;         // Buffered pairs
+    size_t pos;                  // Next buffered pair
+    size_t len;                  // Buffered pairs
+    unsigned int first;          // Current pair
+    unsigned int last;
+} AggSpillRun;
+
+/*
+ * Advances a run to its next pair
+ *
+ * @return: 1 if a pair was read, 0 at the end of the run, -1 on a read error
+ */
+static int agg_spill_next(int fd, AggSpillRun *run)
+{
+    if (run->pos == run->len)
+    {
+        size_t want = AGG_SPILL_BUFFER / (2 * sizeof(unsigned int));
+        if (want > run->remaining) want = run->remaining;
+        if (want == 0) return 0;
+
+        size_t bytes = want * 2 * sizeof(unsigned int);
+        ssize_t n = pread(fd, run->pairs, bytes, run->offset);
+        if (n != (ssize_t)bytes) return -1;
+        run->offset += (off_t)bytes;
+        run->remaining -= want;
+        run->pos = 0;
+        run->len = want;
+    }
+    run->first = run->pairs[2 * run->pos];
+    run->last = run->pairs[2 * run->pos + 1];
+    run->pos++;
+    return 1;
+}
+
+// Min-heap of runs ordered by their current first address
+static void agg_heap_down(AggSpillRun **heap, size_t count, size_t i)
+{
+    for (;;) {
+        size_t smallest = i, left = 2 * i + 1, right = left + 1;
+        if (left < count && heap[left]->first < heap[smallest]->first) smallest = left;
+        if (right < count && heap[right]->first < heap[smallest]->first) smallest = right;
+        if (smallest == i) return;
+
+        AggSpillRun *swap = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = swap;
+        i = smallest;
+    }
+}
+
+/*
+ * k-way merge of up to AGG_MERGE_FANIN spilled runs into a sweep
+ *
+ * Run i starts at offsets[i] of the spill file and holds counts[i]
+ * pairs. Runs are read with pread() on the one spill descriptor, each
+ * through an AGG_SPILL_BUFFER buffer, so a merge needs no extra file
+ * descriptors and at most AGG_MERGE_FANIN buffers.
+ *
+ * @return: 1 if successful, 0 on failure
+ */
+static int agg_merge_spilled(AggSweep *sweep, int fd, const off_t *offsets,
+                             const size_t *counts, size_t chunks)
+{
+    AggSpillRun runs[AGG_MERGE_FANIN];
+    AggSpillRun *heap[AGG_MERGE_FANIN];
+    size_t heap_count = 0;
+    int ok = 0;
+
+    memset(runs, 0, sizeof(runs));
+    for (size_t i = 0; i < chunks; i++) {
+        runs[i].pairs = malloc(AGG_SPILL_BUFFER);
+        if (!runs[i].pairs) goto done;
+        runs[i].offset = offsets[i];
+        runs[i].remaining = counts[i];
+
+        int read = agg_spill_next(fd, &runs[i]);
+        if (read < 0) goto done;
+        if (read > 0) heap[heap_count++] = &runs[i];
+    }
+    for (size_t i = heap_count / 2; i-- > 0; ) agg_heap_down(heap, heap_count, i);
+
+    while (heap_count > 0) {
+        AggSpillRun *top = heap[0];
+        if (!agg_sweep_add(sweep, top->first, top->last)) goto done;
+
+        int read = agg_spill_next(fd, top);
+        if (read < 0) goto done;
+        if (read == 0) heap[0] = heap[--heap_count];
+        agg_heap_down(heap, heap_count, 0);
+    }
+    ok = agg_close_run(sweep);
+
+done:
+    for (size_t i = 0; i < chunks; i++) free(runs[i].pairs);
+    return ok;
+}
+
+/*
+ * Merges spilled runs in groups of AGG_MERGE_FANIN, appending each
+ * group's result to the spill file as a new run, until one final merge
+ * is left. Run i of the next pass replaces entry i of offsets/counts.
+ *
+ * @return: Runs left (<= AGG_MERGE_FANIN), or 0 on failure
+ */
+static size_t agg_reduce_runs(FILE *spill, off_t *offsets, size_t *counts, size_t chunks,
+                              size_t *passes)
+{
+    while (chunks > AGG_MERGE_FANIN)
+    {
+        size_t merged = 0;
+
+        for (size_t lo = 0; lo < chunks; lo += AGG_MERGE_FANIN)
+        {
+            size_t group = chunks - lo < AGG_MERGE_FANIN ? chunks - lo : AGG_MERGE_FANIN;
+            AggSweep pass_sweep;
+
+            memset(&pass_sweep, 0, sizeof(pass_sweep));
+            pass_sweep.spill = spill;
+            if (fflush(spill) != 0 || fseeko(spill, 0, SEEK_END) != 0) return 0;
+
+            off_t offset = ftello(spill);
+            if (!agg_merge_spilled(&pass_sweep, fileno(spill), offsets + lo, counts + lo, group)) {
+                return 0;
+            }
+            offsets[merged] = offset;
+            counts[merged] = pass_sweep.runs;
+            merged++;
+        }
+        chunks = merged;
+        (*passes)++;
+    }
+    return fflush(spill) == 0 ? chunks : 0;
+}
+
+/*
+ * ============================================================================
+ * AGGREGATE MODE
+ * ============================================================================
+ */
+
+/*
+ * Collapses a CIDR list into its minimal equivalent prefix list
+ *
+ * @param path: CIDR file ("-" or NULL = standard input)
+ * @param memory_mb: Sort memory budget in MiB (0 = AGGREGATE_MEMORY_MB)
+ * @return: Process exit status (0 on success)
+ */
+int run_aggregate_mode(const char *path, size_t memory_mb)
+{
+    LineReader reader;
+    OutputBuffer out;
+    AggSweep sweep;
+    const char *line;
+    size_t len, line_number = 0, invalid = 0, total = 0;
+    size_t chunk_capacity, used = 0, chunks = 0, chunk_alloc = 0;
+    uint64_t *keys = NULL, *scratch = NULL;
+    off_t *offsets = NULL;
+    size_t *pair_counts = NULL;
+    size_t spilled = 0, passes = 1;
+    FILE *spill = NULL;
+    char spill_path[4096];
+    const char *tmpdir = getenv("TMPDIR");
+    int status = 1;
+
+    if (memory_mb == 0) memory_mb = AGGREGATE_MEMORY_MB;
+    chunk_capacity = memory_mb * 1024 * 1024 / AGG_BYTES_PER_PREFIX;
+    if (chunk_capacity < 1024) chunk_capacity = 1024;
+
+    if (!line_reader_open(&reader, path)) return 1;
+    if (!output_buffer_init(&out, STDOUT_FILENO, OUTPUT_BUFFER_SIZE)) {
+        line_reader_close(&reader);
+        return 1;
+    }
+    memset(&sweep, 0, sizeof(sweep));
+    sweep.out = &out;
+
+    keys = malloc(chunk_capacity * sizeof(*keys));
+    scratch = malloc(chunk_capacity * sizeof(*scratch));
+    if (!keys || !scratch) {
+        fprintf(stderr, "❌ Memory allocation failed (%zu MB sort budget)\n", memory_mb);
+        goto done;
+    }
+
+    for (;;)
+    {
+        int more = line_reader_next(&reader, &line, &len);
+        if (!more && reader.error) goto done;  // Nothing written yet: no partial cover
+
+        if (more)
+        {
+            line_number++;
+            while (len > 0 && (*line == ' ' || *line == '\t')) { line++; len--; }
+            while (len > 0 && (line[len - 1] == ' ' || line[len - 1] == '\t')) len--;
+            if (len == 0 || *line == '#') continue;
+
+            const char *p;
+            unsigned int ip;
+            int prefix;
+            if (net_parse_cidr_span(line, line + len, &ip, &prefix, &p) != NET_OK || p != line + len) {
+                if (invalid++ < IPSET_MAX_REPORTED_ERRORS) {
+                    fprintf(stderr, "⚠️  %s:%zu: invalid prefix \"%.*s\"\n", path ? path : "-",
+                            line_number, (int)(len > 64 ? 64 : len), line);
+                }
+                continue;
+            }
+            keys[used++] = ((uint64_t)(ip & NET_PREFIX_TABLE[prefix].mask) << 6) | (uint64_t)prefix;
+            total++;
+            if (used < chunk_capacity) continue;
+        }
+
+        // Input fits in one chunk: sort and write the result directly
+        if (!more && chunks == 0) {
+            agg_radix_sort(keys, scratch, used);
+            agg_sweep_keys(&sweep, keys, used);
+            break;
+        }
+
+        // Otherwise spill this chunk as sorted, merged runs
+        if (!spill) {
+            if (!tmpdir || !*tmpdir) tmpdir = "/tmp";
+            if ((size_t)snprintf(spill_path, sizeof(spill_path), "%s/net-aggregate-XXXXXX",
+                                 tmpdir) >= sizeof(spill_path)) {
+                fprintf(stderr, "❌ TMPDIR path too long: %s\n", tmpdir);
+                goto done;
+            }
+            int fd = mkstemp(spill_path);
+            if (fd < 0 || !(spill = fdopen(fd, "w+b"))) {
+                fprintf(stderr, "❌ Cannot create spill file in %s: %s\n", tmpdir, strerror(errno));
+                if (fd >= 0) close(fd);
+                goto done;
+            }
+            unlink(spill_path);  // Removed on close, even if the run is interrupted
+        }
+        if (used > 0) {
+            if (chunks == chunk_alloc) {
+                chunk_alloc = chunk_alloc ? chunk_alloc * 2 : 16;
+                off_t *grown_offsets = realloc(offsets, chunk_alloc * sizeof(*offsets));
+                if (grown_offsets) offsets = grown_offsets;
+                size_t *grown_counts = realloc(pair_counts, chunk_alloc * sizeof(*pair_counts));
+                if (grown_counts) pair_counts = grown_counts;
+                if (!grown_offsets || !grown_counts) {
+                    fprintf(stderr, "❌ Memory allocation failed\n");
+                    goto done;
+                }
+            }
+
+            AggSweep chunk_sweep;
+            memset(&chunk_sweep, 0, sizeof(chunk_sweep));
+            chunk_sweep.spill = spill;
+            offsets[chunks] = ftello(spill);
+            agg_radix_sort(keys, scratch, used);
+            if (!agg_sweep_keys(&chunk_sweep, keys, used)) {
+                fprintf(stderr, "❌ Spill write failed: %s\n", strerror(errno));
+                goto done;
+            }
+            pair_counts[chunks++] = chunk_sweep.runs;
+            used = 0;
+        }
+        if (!more) break;
+    }
+
+    if (chunks > 0)
+    {
+        // The sort buffers are not needed for the merge
+        free(keys);
+        free(scratch);
+        keys = scratch = NULL;
+
+        spilled = chunks;
+        chunks = agg_reduce_runs(spill, offsets, pair_counts, chunks, &passes);
+        if (chunks == 0 || !agg_merge_spilled(&sweep, fileno(spill), offsets, pair_counts, chunks)) {
+            fprintf(stderr, "❌ External merge failed: %s\n", strerror(errno));
+            goto done;
+        }
+    }
+    status = 0;
+
+done:
+    output_buffer_free(&out);
+    line_reader_close(&reader);
+    if (spill) fclose(spill);
+    free(keys);
+    free(scratch);
+    free(offsets);
+    free(pair_counts);
+
+    if (invalid > 0) fprintf(stderr, "⚠️  %s: %zu invalid line(s) skipped\n", path ? path : "-", invalid);
+    if (status == 0) {
+        fprintf(stderr, "📊 %zu prefixes → %zu prefixes, %llu addresses", total,
+                sweep.prefixes, sweep.addresses);
+        if (spilled > 0) {
+            fprintf(stderr, " (external sort: %zu chunks spilled, %zu merge passes)", spilled, passes);
+        }
+        fprintf(stderr, "\n");
+    }
+    return status;
+}
@@ -44,7 +44,7 @@
  */
 int parse_cidr_notation(const char *cidr_str, char *ip_out, int *prefix_len)
 {
-    printf("🔍 Parsing CIDR notation: %s\n", cidr_str);
+    trace_printf("🔍 Parsing CIDR notation: %s\n", cidr_str);
     
     if (!cidr_str || !ip_out || !prefix_len) {
         printf("❌ Invalid input parameters\n");
@@ -77,10 +77,10 @@ int parse_cidr_notation(const char *cidr_str, char *ip_out, int *prefix_len)
         return 0;
     }
     
-    printf("✅ CIDR parsed successfully:\n");
-    printf("   📍 Network IP: %s\n", ip_out);
-    printf("   📏 Prefix Length: /%d\n", *prefix_len);
-    printf("   🧮 Network Bits: %d, Host Bits: %d\n", *prefix_len, 32 - *prefix_len);
+    trace_printf("✅ CIDR parsed successfully:\n");
+    trace_printf("   📍 Network IP: %s\n", ip_out);
+    trace_printf("   📏 Prefix Length: /%d\n", *prefix_len);
+    trace_printf("   🧮 Network Bits: %d, Host Bits: %d\n", *prefix_len, 32 - *prefix_len);
     
     return 1;
 }
@@ -96,57 +96,40 @@ int parse_cidr_notation(const char *cidr_str, char *ip_out, int *prefix_len)
  * - /24: 24 ones = 11111111 11111111 11111111 00000000 = 255.255.255.0
  * - /28: 28 ones = 11111111 11111111 11111111 11110000 = 255.255.255.240
  * 
+ * The values come from the precomputed NET_PREFIX_TABLE; this function
+ * only adds the explanation and a heap copy for existing callers.
+ * 
  * @param prefix_len: CIDR prefix length (0-32)
  * @return: Dynamically allocated subnet mask string (caller must free)
  */
 char *cidr_to_subnet_mask(int prefix_len)
 {
-    printf("🧮 Converting CIDR /%d to subnet mask...\n", prefix_len);
+    trace_printf("🧮 Converting CIDR /%d to subnet mask...\n", prefix_len);
     
-    if (prefix_len < 0 || prefix_len > 32) {
+    const PrefixInfo *info = net_prefix_info(prefix_len);
+    if (!info) {
         printf("❌ Invalid prefix length: %d\n", prefix_len);
         return NULL;
     }
     
-    // Calculate the 32-bit mask value
-    // For /24: we want 24 ones followed by 8 zeros
-    unsigned int mask_value;
-    
-    if (prefix_len == 0) {
-        mask_value = 0;  // 0.0.0.0
-    } else if (prefix_len == 32) {
-        mask_value = 0xFFFFFFFF;  // 255.255.255.255
-    } else {
-        // Mathematical calculation: create mask with prefix_len ones
-        // Shift 1 left by (32 - prefix_len) positions, then subtract 1
-        // This creates the host bits pattern, then we invert it
-        mask_value = 0xFFFFFFFF << (32 - prefix_len);
-    }
+    // For /24: 24 ones followed by 8 zeros (0xFFFFFFFF << 8)
+    unsigned int mask_value = info->mask;
+    trace_printf("🔢 Calculated mask value: %u (0x%08X)\n", mask_value, mask_value);
     
-    printf("🔢 Calculated mask value: %u (0x%08X)\n", mask_value, mask_value);
+    trace_printf("🔍 Mathematical breakdown:\n");
+    trace_printf("   Octet A: (mask >> 24) & 0xFF = %u\n", (mask_value >> 24) & 0xFF);
+    trace_printf("   Octet B: (mask >> 16) & 0xFF = %u\n", (mask_value >> 16) & 0xFF);
+    trace_printf("   Octet C: (mask >> 8) & 0xFF = %u\n", (mask_value >> 8) & 0xFF);
+    trace_printf("   Octet D: mask & 0xFF = %u\n", mask_value & 0xFF);
     
-    // Convert to dotted decimal using mathematical division
-    unsigned int octet_a = (mask_value >> 24) & 0xFF;  // Extract bits 31-24
-    unsigned int octet_b = (mask_value >> 16) & 0xFF;  // Extract bits 23-16
-    unsigned int octet_c = (mask_value >> 8) & 0xFF;   // Extract bits 15-8
-    unsigned int octet_d = mask_value & 0xFF;          // Extract bits 7-0
-    
-    printf("🔍 Mathematical breakdown:\n");
-    printf("   Octet A: (mask >> 24) & 0xFF = %u\n", octet_a);
-    printf("   Octet B: (mask >> 16) & 0xFF = %u\n", octet_b);
-    printf("   Octet C: (mask >> 8) & 0xFF = %u\n", octet_c);
-    printf("   Octet D: mask & 0xFF = %u\n", octet_d);
-    
-    // Allocate and format result string
-    char *result = malloc(16);  // "255.255.255.255" + null terminator
+    char *result = malloc(NET_IPV4_STRLEN);
     if (!result) {
         printf("❌ Memory allocation failed\n");
         return NULL;
     }
+    net_copy_string(info->dotted, result, NET_IPV4_STRLEN);
     
-    sprintf(result, "%u.%u.%u.%u", octet_a, octet_b, octet_c, octet_d);
-    
-    printf("✅ CIDR /%d → Subnet Mask: %s\n", prefix_len, result);
+    trace_printf("✅ CIDR /%d → Subnet Mask: %s\n", prefix_len, result);
     
     return result;
 }
@@ -160,10 +143,24 @@ char *cidr_to_subnet_mask(int prefix_len)
  * - Network range calculation
  * - Available IP count
  * 
- * @param cidr_str: CIDR string like "192.168.1.0/24"
+ * @param cidr_str: CIDR string like "192.168.1.0/24" (or an IPv6 prefix)
  */
 void analyze_cidr_network(const char *cidr_str)
 {
+    // Records (--format or quiet profile): the same analysis, no trace
+    if (use_result_records())
+    {
+        emit_network_result(cidr_str);
+        return;
+    }
+    
+    // IPv6 prefixes: 128-bit analysis
+    if (strchr(cidr_str, ':'))
+    {
+        analyze_ipv6_address(cidr_str);
+        return;
+    }
+    
     printf("🌐 Comprehensive CIDR Network Analysis\n");
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     
@@ -176,12 +173,8 @@ void analyze_cidr_network(const char *cidr_str)
         return;
     }
     
-    // Convert to subnet mask
-    char *mask_str = cidr_to_subnet_mask(prefix_len);
-    if (!mask_str) {
-        printf("❌ Failed to convert CIDR to subnet mask\n");
-        return;
-    }
+    // Subnet mask comes straight from the prefix table
+    const char *mask_str = NET_PREFIX_TABLE[prefix_len].dotted;
     
     char prefix_str[5];  // buffer for "/xx"
     snprintf(prefix_str, sizeof(prefix_str), "/%d", prefix_len);
@@ -196,9 +189,8 @@ void analyze_cidr_network(const char *cidr_str)
     
     // Perform complete network analysis
     printf("\n=== Detailed Network Analysis ===\n");
-    print_ip_range(ip_str, mask_str);
+    print_ip_range_cidr(ip_str, prefix_len);
     
-    free(mask_str);
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
 }
 
@@ -227,7 +219,7 @@ const char *get_network_class(unsigned int ip)
     // Extract first octet using mathematical division
     unsigned int first_octet = ip / 16777216;  // ip / 256^3
     
-    printf("🔍 Class determination: First octet = %u\n", first_octet);
+    trace_printf("🔍 Class determination: First octet = %u\n", first_octet);
     
     if (first_octet >= 1 && first_octet <= 126) {
         return "Class A";
@@ -367,10 +359,16 @@ int is_ip_in_network(const char *ip_str, const char *network_str, const char *ma
  * Validates IP within CIDR network range with detailed output
  * 
  * @param ip_str: IP address to validate
- * @param cidr_str: CIDR network string
+ * @param cidr_str: CIDR network string (IPv6 inputs go to validate_ipv6_in_range)
  */
 void validate_ip_in_range(const char *ip_str, const char *cidr_str)
 {
+    if (strchr(ip_str, ':') || strchr(cidr_str, ':'))
+    {
+        validate_ipv6_in_range(ip_str, cidr_str);
+        return;
+    }
+    
     printf("🎯 IP Range Validation\n");
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     
@@ -383,15 +381,28 @@ void validate_ip_in_range(const char *ip_str, const char *cidr_str)
         return;
     }
     
-    // Convert to subnet mask
-    char *mask_str = cidr_to_subnet_mask(prefix_len);
-    if (!mask_str) {
-        return;
-    }
+    // Mask as an integer straight from the prefix table (no string round trip)
+    const PrefixInfo *info = &NET_PREFIX_TABLE[prefix_len];
+    const char *mask_str = info->dotted;
     
     printf("\n🔍 Checking if %s is in network %s\n", ip_str, cidr_str);
     
-    int is_in_network = is_ip_in_network(ip_str, network_ip, mask_str);
+    unsigned int ip = ip_to_int(ip_str);
+    unsigned int network = ip_to_int(network_ip);
+    int is_in_network = 0;
+    
+    if (ip == 0) {
+        printf("❌ Invalid IP address or network parameters\n");
+    } else {
+        unsigned int ip_network = calculate_network_address(ip, info->mask);
+        unsigned int actual_network = calculate_network_address(network, info->mask);
+        is_in_network = (ip_network == actual_network);
+        
+        printf("🧮 Network validation calculation:\n");
+        printf("   IP (%s) network: %u\n", ip_str, ip_network);
+        printf("   Given network: %u\n", actual_network);
+        printf("   Match: %s\n", is_in_network ? "YES" : "NO");
+    }
     
     printf("\n📋 Validation Summary:\n");
     printf("┌─────────────────────────────────────────────────────────┐\n");
@@ -402,7 +413,6 @@ void validate_ip_in_range(const char *ip_str, const char *cidr_str)
     printf("│ Result:            %-36s │\n", is_in_network ? "✅ IP IS in network" : "❌ IP NOT in network");
     printf("└─────────────────────────────────────────────────────────┘\n");
     
-    free(mask_str);
     printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
 }
 
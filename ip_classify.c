@@ -0,0 +1,313 @@
+/*
+ * ============================================================================
+ * BULK ADDRESS CLASSIFICATION - BRANCH-FREE, SIMD AND MULTI-THREADED
+ * ============================================================================
+ *
+ * This file classifies 32-bit addresses into the categories reported by
+ * get_network_class() and check_loopback_ip(), without the trace and
+ * without a branch per range, so buffers of billions of addresses can be
+ * classified at memory speed on every core.
+ *
+ * Every range is a fixed prefix, so each test is one equality or ordering
+ * compare on a shifted address:
+ *
+ *   first octet o = IP ÷ 256³
+ *   class = (o ≥ 1) + (o ≥ 128) + (o ≥ 192) + (o ≥ 224) + (o ≥ 240)
+ *           + 5 × (o = 127)                          → 0 reserved .. 6 loopback
+ *   type  = 1 × (o = 127)                            loopback
+ *         + 2 × (o = 10 or IP ÷ 2²⁰ = 172.16/12 or IP ÷ 2¹⁶ = 192.168)
+ *         + 3 × (IP ÷ 2¹⁶ = 169.254)                 link-local
+ *         + 4 × (224 ≤ o < 240)                      multicast
+ *         + 5 × (o = 0 or o ≥ 240)                   reserved ("this network", class E)
+ *
+ * The type ranges never overlap, so at most one term is non-zero.
+ *
+ * Kernels:
+ * - scalar: the formula above on one address (compares become SETcc)
+ * - avx2:   the same compares on 8 addresses per iteration, packed to
+ *           8 category bytes with one shuffle
+ *
+ * net_classify_ipv4_bulk() splits the buffer into one contiguous chunk
+ * per thread, rounded to 64 addresses so no two threads write the same
+ * cache line of the output. There is no shared state, so throughput
+ * grows with the number of cores until memory bandwidth is reached.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <unistd.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define NET_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+#define CLASSIFY_CHUNK_ALIGN    64           // Addresses: one output cache line
+
+// Prefixes tested beyond the first octet
+#define PREFIX_172_16           0xAC1U       // 172.16.0.0/12, IP ÷ 2²⁰
+#define PREFIX_192_168          0xC0A8U      // 192.168.0.0/16, IP ÷ 2¹⁶
+#define PREFIX_169_254          0xA9FEU      // 169.254.0.0/16, IP ÷ 2¹⁶
+
+/*
+ * ============================================================================
+ * BACKEND SELECTION
+ * ============================================================================
+ */
+
+enum
+{
+    CLASSIFY_BACKEND_SCALAR = 0,
+    CLASSIFY_BACKEND_AVX2
+};
+
+static int classify_backend = CLASSIFY_BACKEND_SCALAR;
+
+/*
+ * Selects the kernel once before main(), like the parser backend
+ */
+__attribute__((constructor))
+static void init_classify_backend(void)
+{
+#ifdef NET_HAVE_X86_SIMD
+    const char *env = getenv("NET_SIMD");
+    if (env && strcmp(env, "0") == 0) return;
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) classify_backend = CLASSIFY_BACKEND_AVX2;
+#endif
+}
+
+const char *net_classify_backend(void)
+{
+    return classify_backend == CLASSIFY_BACKEND_AVX2 ? "avx2" : "scalar";
+}
+
+/*
+ * ============================================================================
+ * SCALAR KERNEL
+ * ============================================================================
+ */
+
+/*
+ * Returns the category code of one address
+ *
+ * @param ip: Address as a 32-bit integer
+ * @return: NET_CLASS_* | NET_TYPE_* << 4
+ */
+unsigned char net_classify_ipv4(unsigned int ip)
+{
+    unsigned int o = ip >> 24;
+    unsigned int loopback = (o == 127);
+    unsigned int reserved = (o >= 240);
+    unsigned int multicast = (o >= 224) & !reserved;
+    unsigned int private_range = (o == 10) | ((ip >> 20) == PREFIX_172_16) | ((ip >> 16) == PREFIX_192_168);
+    unsigned int link_local = ((ip >> 16) == PREFIX_169_254);
+    unsigned int reserved_type = reserved | (o == 0);
+
+    unsigned int net_class = (o >= 1) + (o >= 128) + (o >= 192) + (o >= 224) + reserved + 5 * loopback;
+    unsigned int type = NET_TYPE_LOOPBACK * loopback + NET_TYPE_PRIVATE * private_range +
+                        NET_TYPE_LINK_LOCAL * link_local + NET_TYPE_MULTICAST * multicast +
+                        NET_TYPE_RESERVED * reserved_type;
+
+    return (unsigned char)(net_class | type << 4);
+}
+
+static void classify_range_scalar(const unsigned int *ips, size_t count, unsigned char *codes)
+{
+    for (size_t i = 0; i < count; i++) codes[i] = net_classify_ipv4(ips[i]);
+}
+
+/*
+ * ============================================================================
+ * AVX2 KERNEL
+ * ============================================================================
+ */
+
+#ifdef NET_HAVE_X86_SIMD
+
+/*
+ * Classifies 8 addresses per iteration
+ *
+ * The shifted values (octet, IP ÷ 2²⁰, IP ÷ 2¹⁶) are below 2³¹, so the
+ * signed 32-bit compares give the unsigned answer. A compare yields -1 per
+ * true lane: AND with a constant turns it into that term of the sum.
+ */
+__attribute__((target("avx2")))
+static void classify_range_avx2(const unsigned int *ips, size_t count, unsigned char *codes)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i pick_low_bytes = _mm256_setr_epi8(
+        0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i ip = _mm256_loadu_si256((const __m256i *)(ips + i));
+        __m256i o = _mm256_srli_epi32(ip, 24);
+        __m256i hi12 = _mm256_srli_epi32(ip, 20);
+        __m256i hi16 = _mm256_srli_epi32(ip, 16);
+
+        __m256i ge1 = _mm256_cmpgt_epi32(o, _mm256_setzero_si256());
+        __m256i ge128 = _mm256_cmpgt_epi32(o, _mm256_set1_epi32(127));
+        __m256i ge192 = _mm256_cmpgt_epi32(o, _mm256_set1_epi32(191));
+        __m256i ge224 = _mm256_cmpgt_epi32(o, _mm256_set1_epi32(223));
+        __m256i ge240 = _mm256_cmpgt_epi32(o, _mm256_set1_epi32(239));
+        __m256i loopback = _mm256_cmpeq_epi32(o, _mm256_set1_epi32(127));
+        __m256i private_range = _mm256_or_si256(
+            _mm256_cmpeq_epi32(o, _mm256_set1_epi32(10)),
+            _mm256_or_si256(_mm256_cmpeq_epi32(hi12, _mm256_set1_epi32(PREFIX_172_16)),
+                            _mm256_cmpeq_epi32(hi16, _mm256_set1_epi32(PREFIX_192_168))));
+        __m256i link_local = _mm256_cmpeq_epi32(hi16, _mm256_set1_epi32(PREFIX_169_254));
+        __m256i multicast = _mm256_andnot_si256(ge240, ge224);
+        __m256i reserved_type = _mm256_or_si256(ge240, _mm256_cmpeq_epi32(o, _mm256_setzero_si256()));
+
+        // class: count of thresholds passed, plus 5 for 127
+        __m256i net_class = _mm256_add_epi32(
+            _mm256_add_epi32(_mm256_and_si256(ge1, one), _mm256_and_si256(ge128, one)),
+            _mm256_add_epi32(_mm256_and_si256(ge192, one), _mm256_and_si256(ge224, one)));
+        net_class = _mm256_add_epi32(net_class, _mm256_and_si256(ge240, one));
+        net_class = _mm256_add_epi32(net_class, _mm256_and_si256(loopback, _mm256_set1_epi32(5)));
+
+        // type: disjoint ranges, already shifted into the high nibble
+        __m256i type = _mm256_or_si256(
+            _mm256_or_si256(_mm256_and_si256(loopback, _mm256_set1_epi32(NET_TYPE_LOOPBACK << 4)),
+                            _mm256_and_si256(private_range, _mm256_set1_epi32(NET_TYPE_PRIVATE << 4))),
+            _mm256_or_si256(_mm256_and_si256(link_local, _mm256_set1_epi32(NET_TYPE_LINK_LOCAL << 4)),
+                            _mm256_and_si256(multicast, _mm256_set1_epi32(NET_TYPE_MULTICAST << 4))));
+        type = _mm256_or_si256(type, _mm256_and_si256(reserved_type, _mm256_set1_epi32(NET_TYPE_RESERVED << 4)));
+
+        // Low byte of each lane → 4 bytes per 128-bit half
+        __m256i packed = _mm256_shuffle_epi8(_mm256_or_si256(net_class, type), pick_low_bytes);
+        uint32_t low = (uint32_t)_mm256_extract_epi32(packed, 0);
+        uint32_t high = (uint32_t)_mm256_extract_epi32(packed, 4);
+        memcpy(codes + i, &low, 4);
+        memcpy(codes + i + 4, &high, 4);
+    }
+
+    classify_range_scalar(ips + i, count - i, codes + i);
+}
+
+#endif // NET_HAVE_X86_SIMD
+
+static void classify_range(const unsigned int *ips, size_t count, unsigned char *codes)
+{
+#ifdef NET_HAVE_X86_SIMD
+    if (classify_backend == CLASSIFY_BACKEND_AVX2) {
+        classify_range_avx2(ips, count, codes);
+        return;
+    }
+#endif
+    classify_range_scalar(ips, count, codes);
+}
+
+/*
+ * ============================================================================
+ * THREADED BULK CLASSIFICATION
+ * ============================================================================
+ */
+
+typedef struct
+{
+    const unsigned int *ips;
+    unsigned char *codes;
+    size_t count;
+    pthread_t thread;
+    int started;                 // 1 if a worker thread owns the chunk
+} ClassifyChunk;
+
+static void *classify_chunk_worker(void *arg)
+{
+    ClassifyChunk *chunk = arg;
+    classify_range(chunk->ips, chunk->count, chunk->codes);
+    return NULL;
+}
+
+/*
+ * Classifies a buffer of addresses on several threads
+ *
+ * Chunks are contiguous and at least CLASSIFY_MIN_CHUNK addresses, so
+ * small buffers run on the calling thread only. The caller classifies
+ * the first chunk itself; a thread that cannot be started leaves its
+ * chunk to the caller as well.
+ *
+ * @param ips: Addresses as 32-bit integers
+ * @param count: Number of addresses
+ * @param codes: Receives one category code per address
+ * @param threads: Maximum number of threads, 0 = one per online CPU
+ */
+void net_classify_ipv4_bulk(const unsigned int *ips, size_t count,
+                            unsigned char *codes, int threads)
+{
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+
+    size_t max_threads = count / CLASSIFY_MIN_CHUNK;
+    if (max_threads < 1) max_threads = 1;
+    if ((size_t)threads > max_threads) threads = (int)max_threads;
+
+    if (threads == 1) {
+        classify_range(ips, count, codes);
+        return;
+    }
+
+    ClassifyChunk *chunks = malloc((size_t)threads * sizeof(ClassifyChunk));
+    if (!chunks) {
+        classify_range(ips, count, codes);
+        return;
+    }
+
+    // Equal shares, rounded up to whole output cache lines
+    size_t share = (count + (size_t)threads - 1) / (size_t)threads;
+    share = (share + CLASSIFY_CHUNK_ALIGN - 1) / CLASSIFY_CHUNK_ALIGN * CLASSIFY_CHUNK_ALIGN;
+
+    size_t offset = 0;
+    for (int t = 0; t < threads; t++)
+    {
+        size_t length = offset < count ? count - offset : 0;
+        if (length > share) length = share;
+
+        chunks[t].ips = ips + offset;
+        chunks[t].codes = codes + offset;
+        chunks[t].count = length;
+        chunks[t].started = t > 0 && length > 0 &&
+                     pthread_create(&chunks[t].thread, NULL, classify_chunk_worker, &chunks[t]) == 0;
+        offset += length;
+    }
+
+    for (int t = 0; t < threads; t++) {
+        if (!chunks[t].started) classify_range(chunks[t].ips, chunks[t].count, chunks[t].codes);
+    }
+    for (int t = 1; t < threads; t++) {
+        if (chunks[t].started) pthread_join(chunks[t].thread, NULL);
+    }
+
+    free(chunks);
+}
+
+/*
+ * ============================================================================
+ * LABELS
+ * ============================================================================
+ */
+
+const char *net_class_label(unsigned char code)
+{
+    static const char *const labels[] = { "reserved", "A", "B", "C", "D", "E", "loopback" };
+    unsigned int net_class = NET_CATEGORY_CLASS(code);
+    return net_class <= NET_CLASS_LOOPBACK ? labels[net_class] : "reserved";
+}
+
+const char *net_type_label(unsigned char code)
+{
+    static const char *const labels[] = {
+        "public", "loopback", "private", "link-local", "multicast", "reserved"
+    };
+    unsigned int type = NET_CATEGORY_TYPE(code);
+    return type <= NET_TYPE_RESERVED ? labels[type] : "reserved";
+}
@@ -40,6 +40,9 @@
  * = 3,221,225,472 + 11,010,048 + 256 + 1
  * = 3,232,235,777
  * 
+ * The conversion itself is done by net_parse_ipv4(); this function adds
+ * the educational trace on top.
+ * 
  * @param ip_str: IP address string like "192.168.1.1"
  * @return: 32-bit integer representation, 0 if invalid
  */
@@ -47,52 +50,21 @@ unsigned int ip_to_int(const char *ip_str)
 {
     unsigned int result = 0;
     
-    // Create a working copy of the input string (strtok modifies the original)
-    char *ip_copy = copy_input(ip_str);
-    if (!ip_copy) {
-        printf("❌ Memory allocation failed for IP string copy\n");
+    // Parse with the silent core primitive (no copy, no strtok, no allocation)
+    NetStatus status = net_parse_ipv4(ip_str, &result);
+    if (status != NET_OK) {
+        printf("❌ Invalid IP format: %s (%s)\n", ip_str ? ip_str : "NULL",
+               net_status_string(status));
         return 0;
     }
     
-    // Parse the IP address into 4 octets using dot as delimiter
-    char *token = strtok(ip_copy, ".");
-    int octets[4];  // Array to store the 4 octets (A, B, C, D)
-    int i = 0;
-    
-    // Extract each octet and validate it's in range 0-255
-    while (token != NULL && i < 4)
-    {
-        unsigned int octet = (unsigned int)atoi(token);
-        
-        // Validate octet range (0-255)
-        if (octet > 255) {
-            printf("❌ Invalid octet value %u (must be 0-255)\n", octet);
-            free(ip_copy);
-            return 0;
-        }
-        
-        octets[i] = octet;
-        token = strtok(NULL, ".");
-        i++;
-    }
-    
-    // Ensure we got exactly 4 octets
-    if (i == 4) {
-        // Apply mathematical formula: IP = A×256³ + B×256² + C×256¹ + D×256⁰
-        result = octets[0] * 16777216 +  // A × 256³ (first octet × 16,777,216)
-                 octets[1] * 65536 +     // B × 256² (second octet × 65,536)
-                 octets[2] * 256 +       // C × 256¹ (third octet × 256)
-                 octets[3];              // D × 256⁰ (fourth octet × 1)
-        
-        printf("🔢 IP Conversion: %s → %u\n", ip_str, result);
-        printf("   Math: %d×16777216 + %d×65536 + %d×256 + %d = %u\n", 
-               octets[0], octets[1], octets[2], octets[3], result);
-    } else {
-        printf("❌ Invalid IP format: expected 4 octets, got %d\n", i);
-    }
+    // Educational trace: show the formula IP = A×256³ + B×256² + C×256¹ + D×256⁰
+    trace_printf("🔢 IP Conversion: %s → %u\n", ip_str, result);
+    trace_printf("   Math: %u×16777216 + %u×65536 + %u×256 + %u = %u\n", 
+           result / 16777216, (result % 16777216) / 65536,
+           (result % 65536) / 256, result % 256, result);
     
-    free(ip_copy);
-    return (i == 4) ? result : 0;
+    return result;
 }
 
 /*
@@ -123,23 +95,18 @@ unsigned int ip_to_int(const char *ip_str)
 char *int_to_ip(unsigned int ip)
 {
     // Allocate memory for IP string (max "255.255.255.255" = 15 chars + null terminator)
-    char *ip_str = malloc(16);
+    char *ip_str = malloc(NET_IPV4_STRLEN);
     if (!ip_str) {
         printf("❌ Memory allocation failed for IP string\n");
         return NULL;
     }
     
-    // Mathematical extraction of octets using division and modulo
-    unsigned int octet_a = ip / 16777216;           // 256³ = 16,777,216
-    unsigned int octet_b = (ip % 16777216) / 65536; // 256² = 65,536
-    unsigned int octet_c = (ip % 65536) / 256;      // 256¹ = 256
-    unsigned int octet_d = ip % 256;                // 256⁰ = 1
+    // Format with the silent core primitive
+    net_format_ipv4(ip, ip_str);
     
-    // Format the result as dotted decimal notation
-    sprintf(ip_str, "%u.%u.%u.%u", octet_a, octet_b, octet_c, octet_d);
-    
-    printf("🔢 Integer Conversion: %u → %s\n", ip, ip_str);
-    printf("   Math: A=%u, B=%u, C=%u, D=%u\n", octet_a, octet_b, octet_c, octet_d);
+    trace_printf("🔢 Integer Conversion: %u → %s\n", ip, ip_str);
+    trace_printf("   Math: A=%u, B=%u, C=%u, D=%u\n", ip / 16777216,
+           (ip % 16777216) / 65536, (ip % 65536) / 256, ip % 256);
     
     return ip_str;
 }
@@ -159,32 +126,22 @@ char *int_to_ip(unsigned int ip)
  */
 unsigned int mask_to_int(const char *mask_str)
 {
-    // Create working copy for parsing
-    char *input_copy = copy_input(mask_str);
-    if (!input_copy) {
-        printf("❌ Memory allocation failed for mask string copy\n");
-        return 0;
-    }
+    unsigned int result = 0;
     
-    // Parse mask into integer array
-    int *mask = prepar_mask(input_copy);
-    if (!mask) {
-        printf("❌ Invalid subnet mask format: %s\n", mask_str);
-        free(input_copy);
+    // Parse with the silent, reentrant core primitive (checks contiguity)
+    NetStatus status = net_parse_mask(mask_str, NULL, &result, NULL);
+    if (status != NET_OK) {
+        printf("❌ Invalid subnet mask format: %s (%s)\n", mask_str ? mask_str : "NULL",
+               net_status_string(status));
         return 0;
     }
     
-    // Apply mathematical formula: Mask = A×256³ + B×256² + C×256¹ + D×256⁰
-    unsigned int result = mask[0] * 16777216 +  // 256³ = 16,777,216
-                          mask[1] * 65536 +     // 256² = 65,536
-                          mask[2] * 256 +       // 256¹ = 256
-                          mask[3];              // 256⁰ = 1
-    
-    printf("🔢 Mask Conversion: %s → %u\n", mask_str, result);
-    printf("   Math: %d×16777216 + %d×65536 + %d×256 + %d = %u\n", 
-           mask[0], mask[1], mask[2], mask[3], result);
+    // Educational trace: Mask = A×256³ + B×256² + C×256¹ + D×256⁰
+    trace_printf("🔢 Mask Conversion: %s → %u\n", mask_str, result);
+    trace_printf("   Math: %u×16777216 + %u×65536 + %u×256 + %u = %u\n", 
+           result / 16777216, (result % 16777216) / 65536,
+           (result % 65536) / 256, result % 256, result);
     
-    free(input_copy);
     return result;
 }
 
@@ -208,9 +165,9 @@ unsigned int mask_to_int(const char *mask_str)
  */
 unsigned int calculate_network_address(unsigned int ip, unsigned int mask)
 {
-    unsigned int network = ip & mask;
+    unsigned int network = net_network_address(ip, mask);
     
-    printf("🌐 Network Calculation: IP (%u) AND Mask (%u) = %u\n", ip, mask, network);
+    trace_printf("🌐 Network Calculation: IP (%u) AND Mask (%u) = %u\n", ip, mask, network);
     
     return network;
 }
@@ -231,9 +188,9 @@ unsigned int calculate_broadcast_address(unsigned int network, unsigned int mask
     unsigned int inverse_mask = 4294967295U - mask;
     
     // Broadcast = Network OR Inverse_mask
-    unsigned int broadcast = network | inverse_mask;
+    unsigned int broadcast = net_broadcast_address(network, mask);
     
-    printf("📡 Broadcast Calculation: Network (%u) OR InverseMask (%u) = %u\n", 
+    trace_printf("📡 Broadcast Calculation: Network (%u) OR InverseMask (%u) = %u\n", 
            network, inverse_mask, broadcast);
     
     return broadcast;
@@ -0,0 +1,349 @@
+/*
+ * ============================================================================
+ * SIMD DOTTED-QUAD PARSER (SSE4.1 / AVX2)
+ * ============================================================================
+ *
+ * This file contains a vectorized implementation of the IPv4 parser used by
+ * ip_to_int() and the bulk modes. The whole address (at most 15 characters)
+ * fits in one 16-byte SSE register, so it can be validated and converted
+ * with a handful of instructions instead of a character loop.
+ *
+ * Algorithm (one 16-byte block):
+ * 1. Classify every byte: digit ('0'-'9'), dot, or terminator
+ * 2. Length = position of the first terminator; exactly 3 dots required
+ * 3. Octet lengths (1-3 digits each) select one of 81 shuffle patterns
+ * 4. PSHUFB places each octet right-aligned in its own 32-bit lane:
+ *        [0, hundreds, tens, ones]
+ * 5. PMADDUBSW × [0, 100, 10, 1] then PMADDWD × [1, 1] gives
+ *        octet = hundreds×100 + tens×10 + ones        (base-10 math)
+ * 6. Values > 255 are rejected, then PACKUSDW/PACKUSWB pack the four
+ *    octets into one 32-bit word: IP = A×256³ + B×256² + C×256 + D
+ *
+ * The AVX2 variant runs the same steps on two addresses at once (one per
+ * 128-bit lane) for the batch entry point.
+ *
+ * Anything unusual (too many dots, long octets, values > 255, unreadable
+ * bytes near a page boundary) is handed to the scalar reference parser in
+ * net_core.c, so every path returns exactly the same result and status.
+ *
+ * The backend is chosen once at startup from CPUID; NET_SIMD=0 in the
+ * environment forces the scalar parser.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <stdint.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define NET_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+/*
+ * ============================================================================
+ * BACKEND SELECTION
+ * ============================================================================
+ */
+
+enum
+{
+    PARSE_BACKEND_SCALAR = 0,
+    PARSE_BACKEND_SSE41,
+    PARSE_BACKEND_AVX2
+};
+
+static int parse_backend = PARSE_BACKEND_SCALAR;
+
+#ifdef NET_HAVE_X86_SIMD
+
+// Shuffle patterns indexed by (len0-1)×27 + (len1-1)×9 + (len2-1)×3 + (len3-1)
+static unsigned char shuffle_table[81][16];
+
+/*
+ * Builds the 81 PSHUFB patterns and selects the best backend
+ *
+ * Runs once before main() (single-threaded), so the table and the backend
+ * choice never change while parsers are running.
+ */
+__attribute__((constructor))
+static void init_parse_backend(void)
+{
+    for (int index = 0; index < 81; index++)
+    {
+        int lengths[4] = { index / 27 + 1, index / 9 % 3 + 1, index / 3 % 3 + 1, index % 3 + 1 };
+        int start = 0;
+
+        for (int octet = 0; octet < 4; octet++)
+        {
+            unsigned char *lane = shuffle_table[index] + 4 * octet;
+            int last = start + lengths[octet] - 1;  // position of the ones digit
+
+            // Lane layout [0, hundreds, tens, ones]; 0x80 makes PSHUFB write zero
+            lane[0] = 0x80;
+            lane[1] = (lengths[octet] >= 3) ? (unsigned char)(last - 2) : 0x80;
+            lane[2] = (lengths[octet] >= 2) ? (unsigned char)(last - 1) : 0x80;
+            lane[3] = (unsigned char)last;
+
+            start = last + 2;  // skip the dot
+        }
+    }
+
+    const char *env = getenv("NET_SIMD");
+    if (env && strcmp(env, "0") == 0) return;
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) parse_backend = PARSE_BACKEND_AVX2;
+    else if (__builtin_cpu_supports("sse4.1")) parse_backend = PARSE_BACKEND_SSE41;
+}
+
+/*
+ * Checks that 16 bytes can be loaded from p without crossing into the next
+ * page (a load that stays inside one mapped page can never fault)
+ */
+static inline int can_load16(const char *p)
+{
+    return ((uintptr_t)p & 4095) <= 4096 - 16;
+}
+
+/*
+ * Locates the three dots and returns the shuffle table index
+ *
+ * @param digit_mask: Bit i set if byte i is a digit
+ * @param dot_mask: Bit i set if byte i is a dot
+ * @param avail: Number of bytes that belong to the input (may exceed 16)
+ * @param len_out: Receives the address length
+ * @return: Table index 0-80, or -1 if the block needs the scalar parser
+ */
+static inline int classify_block(unsigned int digit_mask, unsigned int dot_mask,
+                                 size_t avail, int *len_out)
+{
+    unsigned int stop_mask = ~(digit_mask | dot_mask) & 0xFFFF;
+    if (avail < 16) stop_mask |= 0xFFFFU << avail;
+    if (stop_mask == 0) return -1;  // 16+ address characters: not a plain quad
+
+    int len = __builtin_ctz(stop_mask);
+    unsigned int dots = dot_mask & ((1U << len) - 1);
+    if (dots == 0) return -1;
+
+    int d0 = __builtin_ctz(dots);
+    dots &= dots - 1;
+    if (dots == 0) return -1;
+    int d1 = __builtin_ctz(dots);
+    dots &= dots - 1;
+    if (dots == 0) return -1;
+    int d2 = __builtin_ctz(dots);
+    dots &= dots - 1;
+    if (dots != 0) return -1;  // more than three dots
+
+    int l0 = d0, l1 = d1 - d0 - 1, l2 = d2 - d1 - 1, l3 = len - d2 - 1;
+    if (l0 < 1 || l0 > 3 || l1 < 1 || l1 > 3 || l2 < 1 || l2 > 3 || l3 < 1 || l3 > 3)
+        return -1;
+
+    *len_out = len;
+    return (l0 - 1) * 27 + (l1 - 1) * 9 + (l2 - 1) * 3 + (l3 - 1);
+}
+
+/*
+ * Parses one address from a 16-byte block with SSE4.1
+ *
+ * @param p: Address text (16 bytes must be readable)
+ * @param avail: Bytes that belong to the input
+ * @param out: Receives the 32-bit address
+ * @return: Address length, or 0 if the scalar parser must decide
+ */
+__attribute__((target("sse4.1")))
+static int parse_block_sse41(const char *p, size_t avail, unsigned int *out)
+{
+    __m128i input = _mm_loadu_si128((const __m128i *)p);
+    __m128i values = _mm_sub_epi8(input, _mm_set1_epi8('0'));
+    __m128i digits = _mm_cmpeq_epi8(_mm_min_epu8(values, _mm_set1_epi8(9)), values);
+    __m128i dots = _mm_cmpeq_epi8(input, _mm_set1_epi8('.'));
+
+    int len;
+    int index = classify_block((unsigned int)_mm_movemask_epi8(digits),
+                               (unsigned int)_mm_movemask_epi8(dots), avail, &len);
+    if (index < 0) return 0;
+
+    __m128i pattern = _mm_loadu_si128((const __m128i *)shuffle_table[index]);
+    __m128i lanes = _mm_shuffle_epi8(values, pattern);
+    __m128i pairs = _mm_maddubs_epi16(lanes, _mm_set1_epi32(0x010A6400));  // [0,100,10,1]
+    __m128i octets = _mm_madd_epi16(pairs, _mm_set1_epi16(1));
+
+    if (_mm_movemask_epi8(_mm_cmpgt_epi32(octets, _mm_set1_epi32(255)))) return 0;
+
+    __m128i packed = _mm_packus_epi16(_mm_packus_epi32(octets, octets), octets);
+    *out = __builtin_bswap32((uint32_t)_mm_cvtsi128_si32(packed));
+    return len;
+}
+
+/*
+ * Parses two addresses at once with AVX2 (one per 128-bit lane)
+ *
+ * @param a, b: Address texts (16 bytes each must be readable)
+ * @param out_a, out_b: Receive the 32-bit addresses
+ * @param len_a, len_b: Receive the lengths (0 = scalar parser must decide)
+ */
+__attribute__((target("avx2")))
+static void parse_pair_avx2(const char *a, const char *b,
+                            unsigned int *out_a, unsigned int *out_b,
+                            int *len_a, int *len_b)
+{
+    __m256i input = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)a)),
+        _mm_loadu_si128((const __m128i *)b), 1);
+    __m256i values = _mm256_sub_epi8(input, _mm256_set1_epi8('0'));
+    __m256i digits = _mm256_cmpeq_epi8(_mm256_min_epu8(values, _mm256_set1_epi8(9)), values);
+    __m256i dots = _mm256_cmpeq_epi8(input, _mm256_set1_epi8('.'));
+
+    unsigned int digit_mask = (unsigned int)_mm256_movemask_epi8(digits);
+    unsigned int dot_mask = (unsigned int)_mm256_movemask_epi8(dots);
+
+    int index_a = classify_block(digit_mask & 0xFFFF, dot_mask & 0xFFFF, 16, len_a);
+    int index_b = classify_block(digit_mask >> 16, dot_mask >> 16, 16, len_b);
+    if (index_a < 0) *len_a = 0;
+    if (index_b < 0) *len_b = 0;
+    if (index_a < 0 && index_b < 0) return;
+
+    __m256i pattern = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)shuffle_table[index_a < 0 ? 0 : index_a])),
+        _mm_loadu_si128((const __m128i *)shuffle_table[index_b < 0 ? 0 : index_b]), 1);
+    __m256i lanes = _mm256_shuffle_epi8(values, pattern);
+    __m256i pairs = _mm256_maddubs_epi16(lanes, _mm256_set1_epi32(0x010A6400));
+    __m256i octets = _mm256_madd_epi16(pairs, _mm256_set1_epi16(1));
+
+    unsigned int too_big = (unsigned int)_mm256_movemask_epi8(
+        _mm256_cmpgt_epi32(octets, _mm256_set1_epi32(255)));
+    if (too_big & 0xFFFF) *len_a = 0;
+    if (too_big >> 16) *len_b = 0;
+
+    __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(octets, octets), octets);
+    *out_a = __builtin_bswap32((uint32_t)_mm256_extract_epi32(packed, 0));
+    *out_b = __builtin_bswap32((uint32_t)_mm256_extract_epi32(packed, 4));
+}
+
+#endif // NET_HAVE_X86_SIMD
+
+/*
+ * Returns the name of the parser backend in use
+ *
+ * @return: "avx2", "sse4.1" or "scalar"
+ */
+const char *net_parse_ipv4_backend(void)
+{
+    switch (parse_backend)
+    {
+        case PARSE_BACKEND_AVX2:  return "avx2";
+        case PARSE_BACKEND_SSE41: return "sse4.1";
+    }
+    return "scalar";
+}
+
+/*
+ * ============================================================================
+ * PUBLIC PARSING ENTRY POINTS
+ * ============================================================================
+ */
+
+/*
+ * Parses a dotted quad at the start of [str, end), vector path first
+ *
+ * @param str: First character of the address
+ * @param end: One past the last readable character
+ * @param out: Receives the 32-bit address
+ * @param stop: Receives a pointer just past the address (may be NULL)
+ * @return: Same status as net_parse_ipv4_span_scalar()
+ */
+NetStatus net_parse_ipv4_span(const char *str, const char *end,
+                              unsigned int *out, const char **stop)
+{
+#ifdef NET_HAVE_X86_SIMD
+    if (parse_backend != PARSE_BACKEND_SCALAR && can_load16(str))
+    {
+        int len = parse_block_sse41(str, (size_t)(end - str), out);
+        if (len > 0) {
+            if (stop) *stop = str + len;
+            return NET_OK;
+        }
+    }
+#endif
+    return net_parse_ipv4_span_scalar(str, end, out, stop);
+}
+
+/*
+ * Parses a complete NUL-terminated dotted quad, vector path first
+ *
+ * @param str: Address string like "192.168.1.1"
+ * @param out: Receives the 32-bit address
+ * @return: Same status as net_parse_ipv4_scalar()
+ */
+NetStatus net_parse_ipv4(const char *str, unsigned int *out)
+{
+#ifdef NET_HAVE_X86_SIMD
+    if (parse_backend != PARSE_BACKEND_SCALAR && str && out && can_load16(str))
+    {
+        // The NUL terminator stops the block; it must follow the address directly
+        int len = parse_block_sse41(str, 16, out);
+        if (len > 0 && str[len] == '\0') return NET_OK;
+    }
+#endif
+    return net_parse_ipv4_scalar(str, out);
+}
+
+/*
+ * Converts an array of address strings to 32-bit integers
+ *
+ * With AVX2 the strings are processed in pairs; otherwise each string goes
+ * through net_parse_ipv4(). Strings stored in 16-byte aligned slots always
+ * take the vector path.
+ *
+ * @param strs: Array of NUL-terminated address strings
+ * @param count: Number of strings
+ * @param out: Receives the addresses (0 for invalid entries)
+ * @param status: Receives per-entry status codes (may be NULL)
+ * @return: Number of valid addresses
+ */
+size_t net_parse_ipv4_batch(const char *const *strs, size_t count,
+                            unsigned int *out, NetStatus *status)
+{
+    size_t valid = 0;
+    size_t i = 0;
+
+#ifdef NET_HAVE_X86_SIMD
+    if (parse_backend == PARSE_BACKEND_AVX2)
+    {
+        for (; i + 1 < count; i += 2)
+        {
+            const char *a = strs[i];
+            const char *b = strs[i + 1];
+            if (!a || !b || !can_load16(a) || !can_load16(b)) break;
+
+            int len_a, len_b;
+            parse_pair_avx2(a, b, &out[i], &out[i + 1], &len_a, &len_b);
+
+            for (int k = 0; k < 2; k++)
+            {
+                const char *s = k ? b : a;
+                int len = k ? len_b : len_a;
+                NetStatus result = NET_OK;
+
+                if (len == 0 || s[len] != '\0') result = net_parse_ipv4_scalar(s, &out[i + k]);
+                if (result != NET_OK) out[i + k] = 0;
+                else valid++;
+                if (status) status[i + k] = result;
+            }
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        NetStatus result = net_parse_ipv4(strs[i], &out[i]);
+        if (result != NET_OK) out[i] = 0;
+        else valid++;
+        if (status) status[i] = result;
+    }
+
+    return valid;
+}
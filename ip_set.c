@@ -0,0 +1,533 @@
+/*
+ * ============================================================================
+ * IP SETS - INTERVAL LISTS WITH BITMAP BLOCKS, AND CIDR SET ALGEBRA
+ * ============================================================================
+ *
+ * This file implements a set of IPv4 addresses built from CIDR lists and
+ * the --set-union, --set-intersect and --set-diff modes on top of it.
+ * It answers questions such as "which of these 500k prefixes overlap our
+ * allowed set" in one linear pass, instead of one is_ip_in_network() test
+ * per address and prefix pair.
+ *
+ * Structure: a sorted list of non-overlapping segments.
+ * - run:    every address from first to last (inclusive). A /8 or even
+ *           0.0.0.0/0 is one 16-byte run, so memory follows the number
+ *           of intervals, never the number of addresses.
+ * - bitmap: one /16 block as 65536 bits (8 KiB), roaring-style. A block
+ *           is stored this way only when more than IPSET_DENSE_RUNS runs
+ *           fall inside it (scattered hosts), where the bitmap is smaller
+ *           than the runs it replaces.
+ *
+ * Every segment reads back as a sorted stream of runs (ip_set_iter_next),
+ * so union, intersection and difference are classic two-pointer merges
+ * over two run streams, in O(n + m). Results are rebuilt as runs, then
+ * dense blocks are packed into bitmaps again.
+ *
+ * Output: each run is printed as its minimal CIDR cover. From the start
+ * of a run, the largest aligned block that still fits is taken:
+ *   size = lowest set bit of start (alignment), halved until ≤ remaining
+ *   prefix = 32 - log2(size)
+ * e.g. 10.0.0.1-10.0.0.6 → 10.0.0.1/32, 10.0.0.2/31, 10.0.0.4/31, 10.0.0.6/32
+ *
+ * Input files: one CIDR or bare address (/32) per line, blank lines and
+ * '#' comments skipped, in any order, overlaps allowed.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <unistd.h>
+
+#define IPSET_BLOCK_MASK        0xFFFF0000U
+#define IPSET_BLOCK_BITS        65536U
+
+/*
+ * ============================================================================
+ * SET LIFECYCLE
+ * ============================================================================
+ */
+
+void ip_set_init(IpSet *set)
+{
+    memset(set, 0, sizeof(*set));
+}
+
+void ip_set_free(IpSet *set)
+{
+    for (size_t i = 0; i < set->count; i++) free(set->segments[i].bits);
+    free(set->segments);
+    memset(set, 0, sizeof(*set));
+}
+
+static int ip_set_reserve(IpSet *set, size_t count)
+{
+    if (count <= set->capacity) return 1;
+
+    size_t capacity = set->capacity ? set->capacity * 2 : 64;
+    while (capacity < count) capacity *= 2;
+
+    IpSetSegment *segments = realloc(set->segments, capacity * sizeof(IpSetSegment));
+    if (!segments) return 0;
+    set->segments = segments;
+    set->capacity = capacity;
+    return 1;
+}
+
+/*
+ * Appends a run; runs must arrive in ascending order of first address
+ *
+ * A run that overlaps or touches the previous one is merged into it, so
+ * the set stays a list of disjoint, non-adjacent runs.
+ *
+ * @return: 1 if successful, 0 on allocation failure
+ */
+int ip_set_append(IpSet *set, unsigned int first, unsigned int last)
+{
+    if (set->count > 0)
+    {
+        IpSetSegment *tail = &set->segments[set->count - 1];
+        if (!tail->bits && (tail->last == 0xFFFFFFFFU || first <= tail->last + 1)) {
+            if (last > tail->last) tail->last = last;
+            return 1;
+        }
+    }
+
+    if (!ip_set_reserve(set, set->count + 1)) return 0;
+    set->segments[set->count].first = first;
+    set->segments[set->count].last = last;
+    set->segments[set->count].bits = NULL;
+    set->count++;
+    return 1;
+}
+
+/*
+ * Packs /16 blocks holding more than IPSET_DENSE_RUNS runs into bitmaps
+ *
+ * Only runs that lie entirely inside one block are packed. A run that
+ * crosses into the block stays a run, and since it ends before the block's
+ * first packed address, the segment list stays sorted and disjoint.
+ * Without memory for a bitmap, the remaining blocks simply stay runs.
+ */
+void ip_set_compact(IpSet *set)
+{
+    size_t read = 0, write = 0;
+
+    while (read < set->count)
+    {
+        IpSetSegment *segment = &set->segments[read];
+        unsigned int block = segment->first & IPSET_BLOCK_MASK;
+        size_t end = read;
+
+        while (end < set->count && !set->segments[end].bits &&
+               (set->segments[end].first & IPSET_BLOCK_MASK) == block &&
+               (set->segments[end].last & IPSET_BLOCK_MASK) == block) {
+            end++;
+        }
+
+        if (end - read <= IPSET_DENSE_RUNS) {
+            // Sparse (or a run crossing blocks): keep as is
+            size_t keep = end > read ? end : read + 1;
+            while (read < keep) set->segments[write++] = set->segments[read++];
+            continue;
+        }
+
+        uint64_t *bits = calloc(IPSET_BITMAP_WORDS, sizeof(uint64_t));
+        if (!bits) {
+            while (read < set->count) set->segments[write++] = set->segments[read++];
+            break;
+        }
+
+        unsigned int first = set->segments[read].first;
+        unsigned int last = set->segments[end - 1].last;
+        for (size_t i = read; i < end; i++) {
+            for (unsigned int ip = set->segments[i].first; ; ip++) {
+                unsigned int offset = ip - block;
+                bits[offset >> 6] |= 1ULL << (offset & 63);
+                if (ip == set->segments[i].last) break;
+            }
+        }
+
+        set->segments[write].first = first;
+        set->segments[write].last = last;
+        set->segments[write].bits = bits;
+        write++;
+        read = end;
+    }
+
+    set->count = write;
+}
+
+/*
+ * ============================================================================
+ * RUN ITERATION
+ * ============================================================================
+ */
+
+void ip_set_iter_init(IpSetIter *iter, const IpSet *set)
+{
+    iter->set = set;
+    iter->segment = 0;
+    iter->offset = 0;
+}
+
+// Position of the first bit equal to 'value' at or after offset, or IPSET_BLOCK_BITS
+static unsigned int bitmap_scan(const uint64_t *bits, unsigned int offset, int value)
+{
+    while (offset < IPSET_BLOCK_BITS)
+    {
+        uint64_t word = bits[offset >> 6];
+        if (!value) word = ~word;
+        word &= ~0ULL << (offset & 63);
+        if (word) return (offset & ~63U) + (unsigned int)__builtin_ctzll(word);
+        offset = (offset & ~63U) + 64;
+    }
+    return IPSET_BLOCK_BITS;
+}
+
+/*
+ * Returns the next run of the set in ascending order
+ *
+ * Runs of a bitmap block are found 64 bits at a time with count-trailing-
+ * zeros. Consecutive runs may touch (a run ending where a block starts);
+ * ip_set_append() merges them when results are built.
+ *
+ * @return: 1 with *first / *last set, 0 when the set is exhausted
+ */
+int ip_set_iter_next(IpSetIter *iter, unsigned int *first, unsigned int *last)
+{
+    const IpSet *set = iter->set;
+
+    while (iter->segment < set->count)
+    {
+        const IpSetSegment *segment = &set->segments[iter->segment];
+
+        if (!segment->bits) {
+            *first = segment->first;
+            *last = segment->last;
+            iter->segment++;
+            return 1;
+        }
+
+        unsigned int block = segment->first & IPSET_BLOCK_MASK;
+        unsigned int start = bitmap_scan(segment->bits, iter->offset, 1);
+        if (start < IPSET_BLOCK_BITS) {
+            unsigned int stop = bitmap_scan(segment->bits, start, 0);
+            *first = block + start;
+            *last = block + (stop - 1);
+            iter->offset = stop;
+            return 1;
+        }
+
+        iter->segment++;
+        iter->offset = 0;
+    }
+    return 0;
+}
+
+/*
+ * Tests whether an address belongs to the set (binary search on segments)
+ */
+int ip_set_contains(const IpSet *set, unsigned int ip)
+{
+    size_t low = 0, high = set->count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (set->segments[mid].last < ip) low = mid + 1;
+        else high = mid;
+    }
+    if (low == set->count || set->segments[low].first > ip) return 0;
+
+    const IpSetSegment *segment = &set->segments[low];
+    if (!segment->bits) return 1;
+    unsigned int offset = ip - (segment->first & IPSET_BLOCK_MASK);
+    return (int)((segment->bits[offset >> 6] >> (offset & 63)) & 1);
+}
+
+/*
+ * Number of addresses in the set (up to 2^32)
+ */
+unsigned long long ip_set_size(const IpSet *set)
+{
+    unsigned long long total = 0;
+
+    for (size_t i = 0; i < set->count; i++) {
+        const IpSetSegment *segment = &set->segments[i];
+        if (!segment->bits) {
+            total += (unsigned long long)(segment->last - segment->first) + 1;
+            continue;
+        }
+        for (unsigned int w = 0; w < IPSET_BITMAP_WORDS; w++) {
+            total += (unsigned long long)__builtin_popcountll(segment->bits[w]);
+        }
+    }
+    return total;
+}
+
+/*
+ * ============================================================================
+ * SET ALGEBRA
+ * ============================================================================
+ */
+
+/*
+ * Computes a ∪ b, a ∩ b or a \ b into out (initialized, empty)
+ *
+ * @return: 1 if successful, 0 on allocation failure
+ */
+int ip_set_combine(const IpSet *a, const IpSet *b, IpSetOp op, IpSet *out)
+{
+    IpSetIter ia, ib;
+    unsigned int a_first = 0, a_last = 0, b_first = 0, b_last = 0;
+    int have_a, have_b;
+
+    ip_set_iter_init(&ia, a);
+    ip_set_iter_init(&ib, b);
+    have_a = ip_set_iter_next(&ia, &a_first, &a_last);
+    have_b = ip_set_iter_next(&ib, &b_first, &b_last);
+
+    switch (op)
+    {
+        case IPSET_UNION:
+            // Take the lower run each time; append merges overlaps
+            while (have_a || have_b) {
+                if (have_a && (!have_b || a_first <= b_first)) {
+                    if (!ip_set_append(out, a_first, a_last)) return 0;
+                    have_a = ip_set_iter_next(&ia, &a_first, &a_last);
+                } else {
+                    if (!ip_set_append(out, b_first, b_last)) return 0;
+                    have_b = ip_set_iter_next(&ib, &b_first, &b_last);
+                }
+            }
+            break;
+
+        case IPSET_INTERSECT:
+            // Overlap of the two current runs, then drop the one that ends first
+            while (have_a && have_b) {
+                unsigned int first = a_first > b_first ? a_first : b_first;
+                unsigned int last = a_last < b_last ? a_last : b_last;
+                if (first <= last && !ip_set_append(out, first, last)) return 0;
+
+                if (a_last <= b_last) have_a = ip_set_iter_next(&ia, &a_first, &a_last);
+                else have_b = ip_set_iter_next(&ib, &b_first, &b_last);
+            }
+            break;
+
+        case IPSET_DIFF:
+            // Cut every b run out of the current a run, left to right
+            while (have_a) {
+                while (have_b && b_last < a_first) have_b = ip_set_iter_next(&ib, &b_first, &b_last);
+
+                if (!have_b || b_first > a_last) {
+                    if (!ip_set_append(out, a_first, a_last)) return 0;
+                    have_a = ip_set_iter_next(&ia, &a_first, &a_last);
+                    continue;
+                }
+                if (b_first > a_first && !ip_set_append(out, a_first, b_first - 1)) return 0;
+                if (b_last >= a_last) {
+                    have_a = ip_set_iter_next(&ia, &a_first, &a_last);
+                } else {
+                    a_first = b_last + 1;
+                    have_b = ip_set_iter_next(&ib, &b_first, &b_last);
+                }
+            }
+            break;
+    }
+
+    ip_set_compact(out);
+    return 1;
+}
+
+/*
+ * ============================================================================
+ * LOADING AND CIDR OUTPUT
+ * ============================================================================
+ */
+
+static int range_compare(const void *left, const void *right)
+{
+    const IpSetSegment *a = left, *b = right;
+    if (a->first != b->first) return a->first < b->first ? -1 : 1;
+    return (a->last > b->last) - (a->last < b->last);
+}
+
+/*
+ * Loads a file of CIDRs / addresses into an initialized, empty set
+ *
+ * Prefixes are collected as runs, sorted, merged and packed, so the file
+ * may list them in any order and with overlaps.
+ *
+ * @param set: Initialized, empty set
+ * @param path: File, or "-" for standard input
+ * @param prefixes: Receives the number of valid prefixes read (may be NULL)
+ * @return: 1 if successful, 0 if the file cannot be read
+ */
+int ip_set_load(IpSet *set, const char *path, size_t *prefixes)
+{
+    LineReader reader;
+    IpSet staged;
+    const char *line;
+    size_t len, line_number = 0, invalid = 0;
+
+    if (!line_reader_open(&reader, path)) return 0;
+    ip_set_init(&staged);
+
+    while (line_reader_next(&reader, &line, &len))
+    {
+        line_number++;
+
+        while (len > 0 && (*line == ' ' || *line == '\t')) { line++; len--; }
+        while (len > 0 && (line[len - 1] == ' ' || line[len - 1] == '\t')) len--;
+        if (len == 0 || *line == '#') continue;
+
+        const char *p;
+        unsigned int ip;
+        int prefix;
+        if (net_parse_cidr_span(line, line + len, &ip, &prefix, &p) != NET_OK || p != line + len) {
+            if (invalid++ < IPSET_MAX_REPORTED_ERRORS) {
+                fprintf(stderr, "⚠️  %s:%zu: invalid prefix \"%.*s\"\n",
+                        path, line_number, (int)(len > 64 ? 64 : len), line);
+            }
+            continue;
+        }
+
+        if (!ip_set_reserve(&staged, staged.count + 1)) {
+            fprintf(stderr, "❌ Memory allocation failed while loading %s\n", path);
+            line_reader_close(&reader);
+            ip_set_free(&staged);
+            return 0;
+        }
+        const PrefixInfo *info = &NET_PREFIX_TABLE[prefix];
+        staged.segments[staged.count].first = ip & info->mask;
+        staged.segments[staged.count].last = (ip & info->mask) | info->wildcard;
+        staged.segments[staged.count].bits = NULL;
+        staged.count++;
+    }
+    int read_failed = reader.error;
+    line_reader_close(&reader);
+    if (read_failed) {
+        ip_set_free(&staged);
+        return 0;
+    }
+
+    if (invalid > 0) fprintf(stderr, "⚠️  %s: %zu invalid line(s) skipped\n", path, invalid);
+    if (prefixes) *prefixes = staged.count;
+
+    qsort(staged.segments, staged.count, sizeof(IpSetSegment), range_compare);
+    for (size_t i = 0; i < staged.count; i++) {
+        if (!ip_set_append(set, staged.segments[i].first, staged.segments[i].last)) {
+            ip_set_free(&staged);
+            return 0;
+        }
+    }
+    ip_set_free(&staged);
+    ip_set_compact(set);
+    return 1;
+}
+
+/*
+ * Writes the minimal CIDR cover of first..last as "A.B.C.D/N\n" lines
+ *
+ * @return: Number of prefixes written
+ */
+size_t ip_range_write_cidrs(OutputBuffer *out, unsigned int first, unsigned int last)
+{
+    unsigned long long start = first;
+    unsigned long long end = (unsigned long long)last + 1;
+    size_t written = 0;
+
+    while (start < end)
+    {
+        // Largest block aligned at start that does not pass the end
+        unsigned long long size = start ? (start & (~start + 1)) : (1ULL << 32);
+        while (size > end - start) size >>= 1;
+
+        int prefix = 32 - __builtin_ctzll(size);
+        char *w = output_buffer_reserve(out, NET_IPV4_STRLEN + 4);
+        size_t n = net_format_ipv4((unsigned int)start, w);
+        n += (size_t)snprintf(w + n, 5, "/%d\n", prefix);
+        out->len += n;
+        written++;
+        start += size;
+    }
+    return written;
+}
+
+/*
+ * Prints the minimal CIDR cover of every run in the set
+ *
+ * @return: Number of prefixes written
+ */
+size_t ip_set_write_cidrs(const IpSet *set, OutputBuffer *out)
+{
+    IpSetIter iter;
+    unsigned int first, last;
+    size_t written = 0;
+    int pending = 0;
+    unsigned int pending_first = 0, pending_last = 0;
+
+    // Touching runs (bitmap block edges) are joined before the cover is taken
+    ip_set_iter_init(&iter, set);
+    while (ip_set_iter_next(&iter, &first, &last))
+    {
+        if (pending && pending_last != 0xFFFFFFFFU && first == pending_last + 1) {
+            pending_last = last;
+            continue;
+        }
+        if (pending) written += ip_range_write_cidrs(out, pending_first, pending_last);
+        pending = 1;
+        pending_first = first;
+        pending_last = last;
+    }
+    if (pending) written += ip_range_write_cidrs(out, pending_first, pending_last);
+    return written;
+}
+
+/*
+ * ============================================================================
+ * SET MODES
+ * ============================================================================
+ */
+
+/*
+ * Loads two CIDR files, combines them and prints the result as CIDRs
+ *
+ * @param op: IPSET_UNION, IPSET_INTERSECT or IPSET_DIFF
+ * @param path_a, path_b: CIDR files ("-" = standard input, for one of them)
+ * @return: Process exit status (0 on success)
+ */
+int run_set_mode(IpSetOp op, const char *path_a, const char *path_b)
+{
+    static const char *const op_names[] = { "∪", "∩", "∖" };
+    IpSet a, b, result;
+    OutputBuffer out;
+    size_t prefixes_a = 0, prefixes_b = 0;
+    int status = 1;
+
+    ip_set_init(&a);
+    ip_set_init(&b);
+    ip_set_init(&result);
+
+    if (!ip_set_load(&a, path_a, &prefixes_a) || !ip_set_load(&b, path_b, &prefixes_b)) goto done;
+    fprintf(stderr, "✅ %s: %zu prefixes → %zu segments; %s: %zu prefixes → %zu segments\n",
+            path_a, prefixes_a, a.count, path_b, prefixes_b, b.count);
+
+    if (!ip_set_combine(&a, &b, op, &result)) {
+        fprintf(stderr, "❌ Memory allocation failed\n");
+        goto done;
+    }
+    if (!output_buffer_init(&out, STDOUT_FILENO, OUTPUT_BUFFER_SIZE)) goto done;
+    size_t written = ip_set_write_cidrs(&result, &out);
+    output_buffer_free(&out);
+
+    fprintf(stderr, "📊 A %s B: %zu prefixes, %llu addresses\n",
+            op_names[op], written, ip_set_size(&result));
+    status = 0;
+
+done:
+    ip_set_free(&a);
+    ip_set_free(&b);
+    ip_set_free(&result);
+    return status;
+}
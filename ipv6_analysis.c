@@ -0,0 +1,391 @@
+/*
+ * ============================================================================
+ * IPv6 CIDR MODES - ANALYSIS, VALIDATION, SCANNING AND SPLITTING
+ * ============================================================================
+ *
+ * The IPv6 side of --cidr, --check, --scan and --split. The IPv4 modes
+ * hand any input containing ':' to the functions here, which work on the
+ * 128-bit NetIpv6 values from ipv6_core.c instead of 16-byte strings and
+ * unsigned int.
+ *
+ * Differences from IPv4 that show up in the output:
+ * - There is no broadcast address; every address of a prefix is usable,
+ *   and the range ends at the "last" address.
+ * - Prefixes can hold up to 2^128 addresses, so counts beyond 2^63 are
+ *   printed as powers of two.
+ * - Splitting is lazy: a /48 split into /64s is 65,536 subnets, so they
+ *   are produced one by one from a NetIpv6SubnetIter (records mode streams
+ *   all of them, the educational view lists the first and last ones).
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <unistd.h>  // For STDOUT_FILENO
+
+#define IPV6_SCAN_LIST_ALL      64           // Prefixes up to this size are listed in full
+#define IPV6_SCAN_SHOWN         5            // Addresses shown at each end otherwise
+#define IPV6_SPLIT_LIST_ALL     16           // Splits up to this many subnets are listed in full
+#define IPV6_SPLIT_SHOWN        8            // Subnets shown at the start otherwise
+
+/*
+ * ============================================================================
+ * RECORDS
+ * ============================================================================
+ */
+
+/*
+ * Analyzes one IPv6 address or prefix into a result struct
+ *
+ * - address or prefix: every field but error (ipv4 only when embedded)
+ * - bad prefix length: input and error "invalid-prefix"
+ * - anything else: input and error "invalid"
+ *
+ * @param line: Input (trimmed, not NUL-terminated)
+ * @param len: Input length
+ * @param result: Filled in; input is truncated to RESULT_INPUT_MAX - 1 bytes
+ * @return: Omit mask for result_sink_emit()
+ */
+unsigned int network6_result_parse(const char *line, size_t len, Network6Result *result)
+{
+    const char *end = line + len;
+    const char *p;
+    NetIpv6 ip;
+    int prefix;
+    size_t echo = len < RESULT_INPUT_MAX ? len : RESULT_INPUT_MAX - 1;
+
+    memset(result, 0, sizeof(*result));
+    memcpy(result->input, line, echo);
+    result->input[echo] = '\0';
+
+    NetStatus status = net_parse_ipv6_cidr_span(line, end, &ip, &prefix, &p);
+    if (status != NET_OK || p != end) {
+        // The address parsed up to the '/': the prefix length is at fault
+        const char *slash = memchr(line, '/', len);
+        int address_ok = slash && net_parse_ipv6_span_scalar(line, slash, &ip, &p) == NET_OK &&
+                         p == slash;
+        result->error = address_ok ? "invalid-prefix" : "invalid";
+        return NETWORK6_RESULT_VALUES;
+    }
+
+    NetIpv6 network = net_ipv6_network(&ip, prefix);
+    NetIpv6 last = net_ipv6_last(&ip, prefix);
+    unsigned int omit = NETWORK6_RESULT_ERROR;
+
+    net_format_ipv6(&ip, result->ip);
+    result->type = net_ipv6_type(&ip);
+    net_format_ipv6(&network, result->network);
+    result->prefix = (unsigned int)prefix;
+    net_format_ipv6(&last, result->last);
+    result->host_bits = (unsigned int)(128 - prefix);
+    if (!net_ipv6_embedded_ipv4(&ip, &result->ipv4)) omit |= NETWORK6_RESULT_IPV4;
+    return omit;
+}
+
+/*
+ * ============================================================================
+ * RANGE VALIDATION
+ * ============================================================================
+ */
+
+/*
+ * Validates an IPv6 address against an IPv6 prefix with detailed output
+ *
+ * Membership is (ip AND mask) == (network AND mask) over all 128 bits,
+ * the same test as for IPv4.
+ *
+ * @param ip_str: IPv6 address to validate
+ * @param cidr_str: IPv6 prefix like "2001:db8::/32"
+ */
+void validate_ipv6_in_range(const char *ip_str, const char *cidr_str)
+{
+    printf("🎯 IPv6 Range Validation\n");
+    printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+
+    NetIpv6 ip, network;
+    int prefix;
+
+    if (net_parse_ipv6(ip_str, &ip) != NET_OK) {
+        printf("❌ Invalid IPv6 address: %s\n", ip_str);
+        return;
+    }
+    if (net_parse_ipv6_cidr(cidr_str, &network, &prefix) != NET_OK) {
+        printf("❌ Invalid CIDR format: %s\n", cidr_str);
+        return;
+    }
+
+    NetIpv6 mask = net_ipv6_mask(prefix);
+    NetIpv6 ip_network = net_ipv6_network(&ip, prefix);
+    NetIpv6 actual_network = net_ipv6_network(&network, prefix);
+    int is_in_network = net_ipv6_in_prefix(&ip, &network, prefix);
+    char ip_net_str[NET_IPV6_STRLEN], net_str[NET_IPV6_STRLEN], mask_str[NET_IPV6_STRLEN];
+
+    net_format_ipv6(&ip_network, ip_net_str);
+    net_format_ipv6(&actual_network, net_str);
+    net_format_ipv6(&mask, mask_str);
+
+    printf("\n🔍 Checking if %s is in network %s\n", ip_str, cidr_str);
+    printf("🧮 Network validation calculation:\n");
+    printf("   IP (%s) network: %s\n", ip_str, ip_net_str);
+    printf("   Given network: %s\n", net_str);
+    printf("   Match: %s\n", is_in_network ? "YES" : "NO");
+
+    printf("\n📋 Validation Summary:\n");
+    printf("   ├─ Target IP:     %s\n", ip_str);
+    printf("   ├─ Network:       %s\n", cidr_str);
+    printf("   ├─ Network IP:    %s/%d\n", net_str, prefix);
+    printf("   ├─ Prefix Mask:   %s\n", mask_str);
+    printf("   └─ Result:        %s\n", is_in_network ? "✅ IP IS in network" : "❌ IP NOT in network");
+
+    printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+}
+
+/*
+ * ============================================================================
+ * RANGE SCANNING
+ * ============================================================================
+ */
+
+/*
+ * IPv6 range scanner - shows the boundaries and addresses of a prefix
+ *
+ * Small prefixes (up to IPV6_SCAN_LIST_ALL addresses) are listed in full;
+ * larger ones show the first and last few addresses, computed directly
+ * from the network and last address rather than by walking the range.
+ *
+ * @param cidr_str: IPv6 prefix like "2001:db8::/120"
+ */
+void scan_ipv6_range(const char *cidr_str)
+{
+    printf("🔍 IPv6 Network Range Scanner\n");
+    printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+
+    NetIpv6 ip;
+    int prefix;
+
+    if (net_parse_ipv6_cidr(cidr_str, &ip, &prefix) != NET_OK) {
+        printf("❌ Invalid CIDR format: %s\n", cidr_str);
+        return;
+    }
+
+    int host_bits = 128 - prefix;
+    NetIpv6 network = net_ipv6_network(&ip, prefix);
+    NetIpv6 last = net_ipv6_last(&ip, prefix);
+    NetIpv6 mask = net_ipv6_mask(prefix);
+    char net_str[NET_IPV6_STRLEN], last_str[NET_IPV6_STRLEN];
+    char mask_str[NET_IPV6_STRLEN], ip_str[NET_IPV6_STRLEN];
+    char count[32];
+
+    net_format_ipv6(&network, net_str);
+    net_format_ipv6(&last, last_str);
+    net_format_ipv6(&mask, mask_str);
+    format_ipv6_count(prefix, count, sizeof(count));
+
+    printf("📊 Network Scan Summary:\n");
+    printf("   ├─ Target Network:  %s\n", cidr_str);
+    printf("   ├─ Network Address: %s\n", net_str);
+    printf("   ├─ Last Address:    %s\n", last_str);
+    printf("   ├─ Prefix Mask:     %s\n", mask_str);
+    printf("   ├─ Host Bits:       %d\n", host_bits);
+    printf("   └─ Total IPs:       %s\n", count);
+
+    printf("\n🎯 IP Address Enumeration:\n");
+
+    if (host_bits == 0) // /128 - single host
+    {
+        printf("📍 Single Host Network (/128):\n");
+        printf("   └─ %s (single host)\n", net_str);
+    }
+    else if (host_bits < 7 && (1 << host_bits) <= IPV6_SCAN_LIST_ALL) // Small prefixes - show all
+    {
+        printf("📋 Complete IP Listing:\n");
+
+        for (uint64_t i = 0; i < (1ULL << host_bits); i++) {
+            NetIpv6 addr = net_ipv6_add(&network, i);
+            net_format_ipv6(&addr, ip_str);
+            printf("   %s %s%s\n", i + 1 < (1ULL << host_bits) ? "├─" : "└─", ip_str,
+                   i == 0 ? " (subnet-router anycast)" : "");
+        }
+    }
+    else // Large prefixes - show summary
+    {
+        printf("📈 Large Network Summary (showing first/last %d IPs):\n", IPV6_SCAN_SHOWN);
+
+        printf("   ├─ First %d IPs:\n", IPV6_SCAN_SHOWN);
+        for (int i = 0; i < IPV6_SCAN_SHOWN; i++) {
+            NetIpv6 addr = net_ipv6_add(&network, (uint64_t)i);
+            net_format_ipv6(&addr, ip_str);
+            printf("   │  ├─ %s%s\n", ip_str, i == 0 ? " (subnet-router anycast)" : "");
+        }
+
+        if (host_bits < 64) {
+            printf("   │  └─ ... (%llu more IPs) ...\n",
+                   (1ULL << host_bits) - 2 * IPV6_SCAN_SHOWN);
+        } else {
+            printf("   │  └─ ... (2^%d - %d more IPs) ...\n", host_bits, 2 * IPV6_SCAN_SHOWN);
+        }
+
+        printf("   └─ Last %d IPs:\n", IPV6_SCAN_SHOWN);
+        for (int i = IPV6_SCAN_SHOWN - 1; i >= 0; i--) {
+            NetIpv6 addr = net_ipv6_sub(&last, (uint64_t)i);
+            net_format_ipv6(&addr, ip_str);
+            printf("      %s %s\n", i > 0 ? "├─" : "└─", ip_str);
+        }
+    }
+
+    printf("\n💡 Network Scanning Notes:\n");
+    printf("   • IPv6 has no broadcast address: the whole range is usable\n");
+    printf("   • The all-zero host address is the subnet-router anycast (RFC 4291)\n");
+    printf("   • A /64 holds 2^64 addresses, far too many to sweep exhaustively\n");
+    printf("   • Real network scanning requires proper authorization\n");
+
+    printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+}
+
+/*
+ * ============================================================================
+ * SUBNET SPLITTING
+ * ============================================================================
+ */
+
+/*
+ * Reads the --split argument for an IPv6 prefix
+ *
+ * @param split_str: Target prefix ("/64") or a power-of-two subnet count
+ * @param prefix: Prefix length of the network being split
+ * @return: New prefix length, or -1 (error printed) if invalid
+ */
+static int ipv6_split_prefix(const char *split_str, int prefix)
+{
+    if (split_str[0] == '/') {
+        char *end;
+        long value = strtol(split_str + 1, &end, 10);
+        if (end == split_str + 1 || *end != '\0' || value < prefix || value > 128) {
+            printf("❌ Subnet prefix must be between /%d and /128: %s\n", prefix, split_str);
+            return -1;
+        }
+        return (int)value;
+    }
+
+    char *end;
+    unsigned long long count = strtoull(split_str, &end, 10);
+    if (end == split_str || *end != '\0' || count < 2 || (count & (count - 1)) != 0) {
+        printf("❌ Number of subnets must be a power of 2 (2, 4, 8, 16, etc.) or a prefix like /64\n");
+        return -1;
+    }
+
+    int bits = __builtin_ctzll(count);
+    if (prefix + bits > 128) {
+        printf("❌ Cannot split: would result in /%d (maximum is /128)\n", prefix + bits);
+        return -1;
+    }
+    return prefix + bits;
+}
+
+/*
+ * Splits an IPv6 prefix into equal subnets
+ *
+ * Subnets come from a NetIpv6SubnetIter, so nothing proportional to the
+ * subnet count is ever allocated. Records mode streams one network6
+ * record per subnet; the educational view lists small splits in full and
+ * the first IPV6_SPLIT_SHOWN subnets plus the last one otherwise.
+ *
+ * @param cidr_str: IPv6 prefix like "2001:db8::/48"
+ * @param split_str: Target prefix ("/64") or a power-of-two subnet count
+ */
+void split_ipv6_network(const char *cidr_str, const char *split_str)
+{
+    NetIpv6 ip;
+    int prefix;
+
+    if (net_parse_ipv6_cidr(cidr_str, &ip, &prefix) != NET_OK) {
+        printf("❌ Invalid CIDR format: %s\n", cidr_str);
+        return;
+    }
+
+    int new_prefix = ipv6_split_prefix(split_str, prefix);
+    if (new_prefix < 0) return;
+
+    int subnet_bits = new_prefix - prefix;
+    NetIpv6SubnetIter it;
+    NetIpv6 subnet;
+    char subnet_str[NET_IPV6_STRLEN];
+    char last_str[NET_IPV6_STRLEN];
+
+    net_ipv6_subnets_begin(&it, &ip, prefix, new_prefix);
+
+    // Records: one network6 record per subnet, streamed
+    if (use_result_records())
+    {
+        ResultSink sink;
+        Network6Result result;
+        char text[RESULT_INPUT_MAX];
+
+        if (!result_sink_open(&sink, get_result_format(), STDOUT_FILENO)) return;
+        while (net_ipv6_subnets_next(&it, &subnet)) {
+            size_t len = net_format_ipv6(&subnet, text);
+            len += (size_t)snprintf(text + len, sizeof(text) - len, "/%d", new_prefix);
+            unsigned int omit = network6_result_parse(text, len, &result);
+            result_sink_emit(&sink, &RESULT_SCHEMA_NETWORK6, &result, omit);
+        }
+        result_sink_close(&sink);
+        return;
+    }
+
+    char subnet_count[32], subnet_size[32];
+    format_ipv6_count(128 - subnet_bits, subnet_count, sizeof(subnet_count));
+    format_ipv6_count(new_prefix, subnet_size, sizeof(subnet_size));
+
+    printf("🔀 IPv6 Subnet Splitting Calculator\n");
+    printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+
+    printf("📊 Splitting Analysis:\n");
+    printf("   ├─ Original Network:  %s\n", cidr_str);
+    printf("   ├─ Subnet Prefix:     /%d\n", new_prefix);
+    printf("   ├─ Subnet Bits:       %d\n", subnet_bits);
+    printf("   ├─ Subnets:           %s\n", subnet_count);
+    printf("   └─ IPs per Subnet:    %s\n", subnet_size);
+
+    printf("\n🎯 Generated Subnets:\n");
+
+    int list_all = subnet_bits < 5 && (1 << subnet_bits) <= IPV6_SPLIT_LIST_ALL;
+    int shown = list_all ? (1 << subnet_bits) : IPV6_SPLIT_SHOWN;
+
+    for (int i = 0; i < shown && net_ipv6_subnets_next(&it, &subnet); i++) {
+        NetIpv6 last = net_ipv6_last(&subnet, new_prefix);
+        net_format_ipv6(&subnet, subnet_str);
+        net_format_ipv6(&last, last_str);
+
+        printf("   ├─ Subnet %d: %s/%d\n", i + 1, subnet_str, new_prefix);
+        printf("   │  ├─ First: %s\n", subnet_str);
+        printf("   │  └─ Last:  %s\n", last_str);
+        if (i < shown - 1 || !list_all) printf("   │\n");
+    }
+
+    if (!list_all) {
+        // The final subnet is computed directly; the ones between are skipped
+        NetIpv6 parent_last = net_ipv6_last(&ip, prefix);
+        NetIpv6 final = net_ipv6_network(&parent_last, new_prefix);
+        net_format_ipv6(&final, subnet_str);
+        net_format_ipv6(&parent_last, last_str);
+
+        if (subnet_bits < 64) {
+            printf("   ├─ ... (%llu more subnets) ...\n", (1ULL << subnet_bits) - IPV6_SPLIT_SHOWN - 1);
+        } else {
+            printf("   ├─ ... (2^%d - %d more subnets) ...\n", subnet_bits, IPV6_SPLIT_SHOWN + 1);
+        }
+        printf("   │\n");
+        printf("   └─ Last subnet: %s/%d\n", subnet_str, new_prefix);
+        printf("      ├─ First: %s\n", subnet_str);
+        printf("      └─ Last:  %s\n", last_str);
+    }
+
+    printf("\n💡 IPv6 Subnetting Notes:\n");
+    printf("   • /64 is the standard LAN size (SLAAC needs a 64-bit interface ID)\n");
+    printf("   • A /48 site holds 65,536 /64 subnets\n");
+    printf("   • There is no broadcast: every address in a subnet is usable\n");
+    printf("   • Use --format jsonl (or the quiet profile) to list every subnet\n");
+
+    printf("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+}
@@ -0,0 +1,674 @@
+/*
+ * ============================================================================
+ * IPv6 CORE - 128-BIT PARSING, FORMATTING AND PREFIX ARITHMETIC
+ * ============================================================================
+ *
+ * This file is the IPv6 counterpart of net_core.c: silent, allocation-free
+ * primitives on a 128-bit value type (NetIpv6, two 64-bit halves), used by
+ * analyze_ipv6_address() and convert_ipv6_formats() and usable in bulk.
+ *
+ * Text forms (RFC 4291 §2.2):
+ * - eight groups of 1-4 hex digits:     2001:0db8:0000:0000:0000:0000:0000:0001
+ * - one "::" for one or more zero groups: 2001:db8::1
+ * - a dotted IPv4 tail for the last 32 bits: ::ffff:192.0.2.1, 64:ff9b::10.0.0.1
+ *
+ * Canonical output (RFC 5952): lowercase, no leading zeros, the longest
+ * run of two or more zero groups (the first one on a tie) becomes "::",
+ * and IPv4-mapped addresses keep their dotted tail.
+ *
+ * Parsing paths:
+ * - scalar: the reference parser, one character at a time
+ * - SSE2:   the whole address (at most 39 characters) is loaded into three
+ *           16-byte registers (straight from the input unless that would
+ *           cross a page boundary). Each byte is classified as hex digit or
+ *           colon and converted to its nibble value with a few compares:
+ *               digit   '0'-'9'        → c - '0'
+ *               letter  'a'-'f'/'A'-'F' → (c | 0x20) - 'a' + 10
+ *           The groups are then read off the colon bitmask. Anything else
+ *           (dotted tail, errors, zone IDs) is handed to the scalar parser,
+ *           so both paths return exactly the same result and status.
+ * SSE2 is part of every x86-64 CPU, so no runtime dispatch is needed.
+ *
+ * Arithmetic: a prefix length selects a 128-bit mask built from the two
+ * halves, so network = ip AND mask and last = ip OR NOT mask, exactly as
+ * for IPv4. There is no broadcast in IPv6; "last" is the top of the range.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#define NET_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#define IPV6_MAX_TEXT           39           // 8 × 4 hex digits + 7 colons
+
+/*
+ * ============================================================================
+ * GROUP ACCESS
+ * ============================================================================
+ */
+
+// Group i (0-7) of an address, most significant first
+static inline unsigned int ipv6_group(const NetIpv6 *ip, int i)
+{
+    uint64_t half = i < 4 ? ip->hi : ip->lo;
+    return (unsigned int)(half >> (48 - 16 * (i & 3))) & 0xFFFF;
+}
+
+static void ipv6_from_groups(const unsigned int groups[8], NetIpv6 *out)
+{
+    out->hi = (uint64_t)groups[0] << 48 | (uint64_t)groups[1] << 32 |
+              (uint64_t)groups[2] << 16 | (uint64_t)groups[3];
+    out->lo = (uint64_t)groups[4] << 48 | (uint64_t)groups[5] << 32 |
+              (uint64_t)groups[6] << 16 | (uint64_t)groups[7];
+}
+
+/*
+ * Places the groups before and after "::" (gap = index of the "::", or -1)
+ */
+static NetStatus ipv6_assemble(const unsigned int *groups, int count, int gap, NetIpv6 *out)
+{
+    unsigned int full[8] = {0};
+
+    if (gap < 0) {
+        if (count != 8) return NET_ERR_FORMAT;
+        memcpy(full, groups, sizeof(full));
+    } else {
+        if (count > 7) return NET_ERR_FORMAT;  // "::" stands for at least one group
+        int tail = count - gap;
+        memcpy(full, groups, (size_t)gap * sizeof(unsigned int));
+        memcpy(full + 8 - tail, groups + gap, (size_t)tail * sizeof(unsigned int));
+    }
+    ipv6_from_groups(full, out);
+    return NET_OK;
+}
+
+/*
+ * ============================================================================
+ * SCALAR PARSER
+ * ============================================================================
+ */
+
+static inline int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    c = (char)(c | 0x20);
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/*
+ * Parses an IPv6 address at the start of a character range
+ *
+ * Parsing stops at the first character that cannot continue the address
+ * ('/', '%', space, end of range); the caller decides what may follow.
+ *
+ * @param str: Start of the text
+ * @param end: End of the text (exclusive)
+ * @param out: Receives the address
+ * @param stop: Receives the position after the address (may be NULL)
+ * @return: NET_OK, NET_ERR_FORMAT or NET_ERR_RANGE (a group over 4 digits)
+ */
+NetStatus net_parse_ipv6_span_scalar(const char *str, const char *end,
+                                     NetIpv6 *out, const char **stop)
+{
+    unsigned int groups[8];
+    int count = 0;
+    int gap = -1;
+    const char *p = str;
+
+    if (p < end && *p == ':') {
+        if (p + 1 >= end || p[1] != ':') return NET_ERR_FORMAT;
+        gap = 0;
+        p += 2;
+        if (p >= end || hex_value(*p) < 0) goto done;  // "::" alone
+    }
+
+    for (;;)
+    {
+        const char *token = p;
+        unsigned int value = 0;
+        int digits = 0;
+        int nibble;
+
+        while (p < end && (nibble = hex_value(*p)) >= 0) {
+            if (++digits > 4) break;
+            value = value << 4 | (unsigned int)nibble;
+            p++;
+        }
+        if (digits == 0) return NET_ERR_FORMAT;
+        if (digits > 4) return NET_ERR_RANGE;
+
+        // Dotted IPv4 tail: the token was the first octet, not a group
+        if (p < end && *p == '.') {
+            unsigned int ipv4;
+            if (count > 6) return NET_ERR_FORMAT;
+            NetStatus status = net_parse_ipv4_span_scalar(token, end, &ipv4, &p);
+            if (status != NET_OK) return status;
+            groups[count++] = ipv4 >> 16;
+            groups[count++] = ipv4 & 0xFFFF;
+            break;
+        }
+        if (count == 8) return NET_ERR_FORMAT;
+        groups[count++] = value;
+
+        if (p >= end || *p != ':') break;
+        if (p + 1 < end && p[1] == ':') {
+            if (gap >= 0) return NET_ERR_FORMAT;  // Only one "::"
+            gap = count;
+            p += 2;
+            if (p >= end || hex_value(*p) < 0) break;  // Trailing "::"
+        } else {
+            p++;
+        }
+    }
+
+done:
+    {
+        NetStatus status = ipv6_assemble(groups, count, gap, out);
+        if (status != NET_OK) return status;
+    }
+    if (stop) *stop = p;
+    return NET_OK;
+}
+
+/*
+ * Parses a complete NUL-terminated IPv6 address (scalar reference)
+ */
+NetStatus net_parse_ipv6_scalar(const char *str, NetIpv6 *out)
+{
+    if (!str || !out) return NET_ERR_NULL;
+
+    const char *stop;
+    NetStatus status = net_parse_ipv6_span_scalar(str, str + strlen(str), out, &stop);
+    if (status != NET_OK) return status;
+
+    return (*stop == '\0') ? NET_OK : NET_ERR_FORMAT;
+}
+
+/*
+ * ============================================================================
+ * SSE2 PARSER
+ * ============================================================================
+ */
+
+#ifdef NET_HAVE_SSE2
+
+/*
+ * Checks that 48 bytes can be loaded from p without crossing into the next
+ * page (a load that stays inside one mapped page can never fault)
+ */
+static inline int can_load48(const char *p)
+{
+    return ((uintptr_t)p & 4095) <= 4096 - 48;
+}
+
+/*
+ * Classifies one 16-byte block: nibble values into nibbles[], and bit i of
+ * the masks set when byte i is a hex digit / a colon / the NUL terminator
+ */
+static inline void classify_hex16(const char *block, unsigned char *nibbles, unsigned int *hex_mask,
+                                  unsigned int *colon_mask, unsigned int *nul_mask)
+{
+    __m128i input = _mm_loadu_si128((const __m128i *)block);
+    __m128i digit = _mm_sub_epi8(input, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(input, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+
+    // Unsigned x ≤ k  ⇔  min(x, k) == x
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    __m128i values = _mm_or_si128(_mm_and_si128(is_digit, digit),
+                                  _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+
+    _mm_storeu_si128((__m128i *)nibbles, values);
+    *hex_mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter));
+    *colon_mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(input, _mm_set1_epi8(':')));
+    *nul_mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(input, _mm_setzero_si128()));
+}
+
+/*
+ * Parses a plain hex-and-colon address (at most 39 characters)
+ *
+ * The text is read straight from str when 48 bytes fit in its page, and
+ * copied into a zero-padded buffer otherwise.
+ *
+ * @return: 1 if parsed, 0 if the scalar parser must decide
+ */
+static int parse_ipv6_sse2(const char *str, NetIpv6 *out)
+{
+    char block[48];
+    unsigned char nibbles[4 + 48] = {0};  // 4 bytes of zero padding in front
+    uint64_t hex = 0, colons = 0, nul = 0;
+    const char *src = str;
+
+    if (!can_load48(str)) {
+        size_t n = strnlen(str, IPV6_MAX_TEXT + 1);
+        if (n > IPV6_MAX_TEXT) return 0;
+        memset(block, 0, sizeof(block));
+        memcpy(block, str, n);
+        src = block;
+    }
+    for (int k = 0; k < 3; k++) {
+        unsigned int hex_mask, colon_mask, nul_mask;
+        classify_hex16(src + 16 * k, nibbles + 4 + 16 * k, &hex_mask, &colon_mask, &nul_mask);
+        hex |= (uint64_t)hex_mask << (16 * k);
+        colons |= (uint64_t)colon_mask << (16 * k);
+        nul |= (uint64_t)nul_mask << (16 * k);
+    }
+
+    if (nul == 0) return 0;
+    size_t len = (size_t)__builtin_ctzll(nul);
+    if (len == 0 || len > IPV6_MAX_TEXT) return 0;
+
+    uint64_t all = (1ULL << len) - 1;
+    if (((hex | colons) & all) != all) return 0;  // Dots, zone IDs, garbage
+    colons &= all;
+
+    unsigned int groups[8];
+    int count = 0;
+    int gap = -1;
+    size_t pos = 0;
+
+    if (colons & 1) {
+        if (!(colons & 2)) return 0;
+        gap = 0;
+        pos = 2;
+    }
+
+    while (pos < len)
+    {
+        uint64_t ahead = colons >> pos;
+        size_t next = ahead ? pos + (size_t)__builtin_ctzll(ahead) : len;
+        size_t digits = next - pos;
+        if (digits == 0 || digits > 4 || count == 8) return 0;
+
+        // The 4 nibbles ending at the colon, little-endian (last digit in
+        // the top byte); bytes before the group are masked off, so 1-4
+        // digits take the same branch-free path
+        uint32_t quad;
+        memcpy(&quad, nibbles + next, 4);
+        quad &= ~0U << (8 * (4 - digits));
+        groups[count++] = (quad >> 24) | (quad >> 12 & 0xF0) |
+                          (quad & 0xF00) | (quad << 12 & 0xF000);
+
+        if (next == len) break;
+        if (next + 1 == len) return 0;  // Trailing single colon
+        if (colons >> (next + 1) & 1) {
+            if (gap >= 0) return 0;
+            gap = count;
+            pos = next + 2;
+        } else {
+            pos = next + 1;
+        }
+    }
+
+    return ipv6_assemble(groups, count, gap, out) == NET_OK;
+}
+
+#endif // NET_HAVE_SSE2
+
+/*
+ * Parses a complete NUL-terminated IPv6 address
+ *
+ * @param str: Address like "2001:db8::1" or "::ffff:192.0.2.1"
+ * @param out: Receives the 128-bit address
+ * @return: NET_OK, or an error code if the string is not exactly one address
+ */
+NetStatus net_parse_ipv6(const char *str, NetIpv6 *out)
+{
+    if (!str || !out) return NET_ERR_NULL;
+
+#ifdef NET_HAVE_SSE2
+    if (parse_ipv6_sse2(str, out)) return NET_OK;
+#endif
+    return net_parse_ipv6_scalar(str, out);
+}
+
+/*
+ * Parses "addr/len" or a bare address inside a bounded buffer
+ *
+ * The IPv6 counterpart of net_parse_cidr_span(): lines need not be
+ * NUL-terminated and may carry more fields. A bare address means /128.
+ *
+ * @param str: First character to parse
+ * @param end: One past the last character available
+ * @param out: Receives the address (host bits are kept as given)
+ * @param prefix_out: Receives the prefix length 0-128
+ * @param end_out: Receives the position after the prefix (may be NULL)
+ * @return: NET_OK, NET_ERR_FORMAT or NET_ERR_RANGE
+ */
+NetStatus net_parse_ipv6_cidr_span(const char *str, const char *end, NetIpv6 *out,
+                                   int *prefix_out, const char **end_out)
+{
+    if (!str || !end || !out || !prefix_out) return NET_ERR_NULL;
+
+    const char *p;
+    NetStatus status = net_parse_ipv6_span_scalar(str, end, out, &p);
+    if (status != NET_OK) return status;
+
+    int prefix = 128;
+    if (p < end && *p == '/') {
+        int digits = 0;
+        prefix = 0;
+        p++;
+        while (p < end && *p >= '0' && *p <= '9' && digits < 3) {
+            prefix = prefix * 10 + (*p - '0');
+            p++;
+            digits++;
+        }
+        if (digits == 0) return NET_ERR_FORMAT;
+        if (prefix > 128 || (p < end && *p >= '0' && *p <= '9')) return NET_ERR_RANGE;
+    }
+
+    *prefix_out = prefix;
+    if (end_out) *end_out = p;
+    return NET_OK;
+}
+
+/*
+ * Parses a complete NUL-terminated "addr/len" (a bare address is a /128)
+ *
+ * @param str: NUL-terminated text
+ * @param out: Receives the address (host bits are kept)
+ * @param prefix_out: Receives the prefix length 0-128
+ * @return: NET_OK, or an error code describing the problem
+ */
+NetStatus net_parse_ipv6_cidr(const char *str, NetIpv6 *out, int *prefix_out)
+{
+    if (!str || !out || !prefix_out) return NET_ERR_NULL;
+
+    const char *end = str + strlen(str);
+    const char *p;
+    NetStatus status = net_parse_ipv6_cidr_span(str, end, out, prefix_out, &p);
+    if (status != NET_OK) return status;
+
+    return (p == end) ? NET_OK : NET_ERR_FORMAT;
+}
+
+/*
+ * ============================================================================
+ * FORMATTING
+ * ============================================================================
+ */
+
+/*
+ * Writes a group without leading zeros
+ *
+ * The four hex digits are built in one 32-bit word (first digit in the low
+ * byte) and stored at once; w advances by the significant digits only, so
+ * up to 3 bytes past the text are scratch and get overwritten.
+ */
+static char *put_hex_group(char *w, unsigned int group)
+{
+    uint32_t nibbles = (group >> 12) | (group >> 8 & 0xF) << 8 |
+                       (group >> 4 & 0xF) << 16 | (group & 0xF) << 24;
+    uint32_t letters = ((nibbles + 0x06060606U) >> 4) & 0x01010101U;  // Bytes ≥ 10
+    uint32_t text = nibbles + 0x30303030U + letters * ('a' - '0' - 10);
+    int digits = (31 - __builtin_clz(group | 1)) / 4 + 1;
+
+    text >>= 8 * (4 - digits);
+    memcpy(w, &text, 4);
+    return w + digits;
+}
+
+/*
+ * Formats an address in RFC 5952 canonical form
+ *
+ * @param ip: Address
+ * @param buf: At least NET_IPV6_STRLEN bytes
+ * @return: Length of the text written, excluding the NUL terminator
+ */
+size_t net_format_ipv6(const NetIpv6 *ip, char *buf)
+{
+    unsigned int zeros = 0;  // Bit i set when group i is zero
+    for (int i = 0; i < 8; i++) zeros |= (unsigned int)(ipv6_group(ip, i) == 0) << i;
+
+    // Bit i of run survives k rounds when groups i..i+k are all zero;
+    // the lowest bit left at the longest length is the first such run
+    int best_start = -1, best_len = 0;
+    for (unsigned int run = zeros & zeros >> 1, k = 2; run; run &= run >> 1, k++) {
+        best_start = __builtin_ctz(run);
+        best_len = (int)k;
+    }
+
+    // ::ffff:a.b.c.d keeps its dotted IPv4 tail
+    int mapped = ip->hi == 0 && (ip->lo >> 32) == 0xFFFF;
+    int groups = mapped ? 6 : 8;
+    char *w = buf;
+
+    for (int i = 0; i < groups; i++)
+    {
+        if (i == best_start) {
+            *w++ = ':';
+            if (i == 0) *w++ = ':';
+            i += best_len - 1;
+            continue;
+        }
+        w = put_hex_group(w, ipv6_group(ip, i));
+        if (i < 7) *w++ = ':';
+    }
+    if (mapped) w += net_format_ipv4((unsigned int)ip->lo, w);
+
+    *w = '\0';
+    return (size_t)(w - buf);
+}
+
+/*
+ * Formats all eight groups with four digits each (39 characters)
+ */
+size_t net_format_ipv6_full(const NetIpv6 *ip, char *buf)
+{
+    static const char digits[] = "0123456789abcdef";
+    char *w = buf;
+
+    for (int i = 0; i < 8; i++) {
+        unsigned int group = ipv6_group(ip, i);
+        for (int shift = 12; shift >= 0; shift -= 4) *w++ = digits[(group >> shift) & 0xF];
+        if (i < 7) *w++ = ':';
+    }
+    *w = '\0';
+    return (size_t)(w - buf);
+}
+
+/*
+ * ============================================================================
+ * PREFIX ARITHMETIC
+ * ============================================================================
+ */
+
+/*
+ * Returns the mask of a prefix length: the first 'prefix' bits set
+ */
+NetIpv6 net_ipv6_mask(int prefix)
+{
+    NetIpv6 mask = {0, 0};
+
+    if (prefix <= 0) return mask;
+    if (prefix >= 128) {
+        mask.hi = mask.lo = ~0ULL;
+        return mask;
+    }
+    if (prefix >= 64) {
+        mask.hi = ~0ULL;
+        mask.lo = prefix == 64 ? 0 : ~0ULL << (128 - prefix);
+    } else {
+        mask.hi = ~0ULL << (64 - prefix);
+    }
+    return mask;
+}
+
+NetIpv6 net_ipv6_network(const NetIpv6 *ip, int prefix)
+{
+    NetIpv6 mask = net_ipv6_mask(prefix);
+    NetIpv6 network = { ip->hi & mask.hi, ip->lo & mask.lo };
+    return network;
+}
+
+NetIpv6 net_ipv6_last(const NetIpv6 *ip, int prefix)
+{
+    NetIpv6 mask = net_ipv6_mask(prefix);
+    NetIpv6 last = { ip->hi | ~mask.hi, ip->lo | ~mask.lo };
+    return last;
+}
+
+/*
+ * Adds a 64-bit offset with carry into the high half (wraps at 2^128)
+ */
+NetIpv6 net_ipv6_add(const NetIpv6 *ip, uint64_t offset)
+{
+    NetIpv6 sum = { ip->hi, ip->lo + offset };
+    if (sum.lo < ip->lo) sum.hi++;
+    return sum;
+}
+
+/*
+ * Subtracts a 64-bit offset with borrow from the high half (wraps at 0)
+ */
+NetIpv6 net_ipv6_sub(const NetIpv6 *ip, uint64_t offset)
+{
+    NetIpv6 diff = { ip->hi, ip->lo - offset };
+    if (diff.lo > ip->lo) diff.hi--;
+    return diff;
+}
+
+int net_ipv6_compare(const NetIpv6 *a, const NetIpv6 *b)
+{
+    if (a->hi != b->hi) return a->hi < b->hi ? -1 : 1;
+    if (a->lo != b->lo) return a->lo < b->lo ? -1 : 1;
+    return 0;
+}
+
+int net_ipv6_in_prefix(const NetIpv6 *ip, const NetIpv6 *network, int prefix)
+{
+    NetIpv6 mask = net_ipv6_mask(prefix);
+    return ((ip->hi ^ network->hi) & mask.hi) == 0 && ((ip->lo ^ network->lo) & mask.lo) == 0;
+}
+
+/*
+ * ============================================================================
+ * SUBNET ENUMERATION
+ * ============================================================================
+ *
+ * Splitting a prefix can give far more subnets than fit in memory (a /48
+ * holds 65,536 /64s, a /32 four billion), so subnets are produced one at a
+ * time by an iterator, or computed directly from their number.
+ */
+
+// Adds 2^bit (bit 0-127) to an address
+static NetIpv6 ipv6_add_bit(const NetIpv6 *ip, int bit)
+{
+    if (bit >= 64) {
+        NetIpv6 sum = { ip->hi + (1ULL << (bit - 64)), ip->lo };
+        return sum;
+    }
+    return net_ipv6_add(ip, 1ULL << bit);
+}
+
+/*
+ * Returns subnet number 'index' (from 0) of length new_prefix inside a prefix
+ *
+ * Only the low (new_prefix - prefix) bits of index are used.
+ *
+ * @param network: Any address inside the prefix
+ * @param prefix: Prefix length of the network
+ * @param new_prefix: Subnet prefix length (prefix-128)
+ * @param index: Subnet number
+ * @return: Network address of the subnet
+ */
+NetIpv6 net_ipv6_subnet(const NetIpv6 *network, int prefix, int new_prefix, uint64_t index)
+{
+    NetIpv6 subnet = net_ipv6_network(network, prefix);
+    int bits = new_prefix - prefix;
+    int shift = 128 - new_prefix;
+
+    if (bits <= 0) return subnet;
+    if (bits < 64) index &= (1ULL << bits) - 1;
+
+    if (shift >= 64) subnet.hi |= index << (shift - 64);
+    else {
+        subnet.lo |= index << shift;
+        if (shift > 0) subnet.hi |= index >> (64 - shift);
+    }
+    return subnet;
+}
+
+/*
+ * Starts enumerating the /new_prefix subnets of network/prefix
+ *
+ * @param it: Iterator to initialize
+ * @param network: Any address inside the prefix
+ * @param prefix: Prefix length of the network
+ * @param new_prefix: Subnet prefix length; nothing is produced if shorter than prefix
+ */
+void net_ipv6_subnets_begin(NetIpv6SubnetIter *it, const NetIpv6 *network, int prefix, int new_prefix)
+{
+    NetIpv6 last = net_ipv6_last(network, prefix);
+
+    it->next = net_ipv6_network(network, prefix);
+    it->last = net_ipv6_network(&last, new_prefix);
+    it->prefix = new_prefix;
+    it->done = new_prefix < prefix || new_prefix > 128;
+}
+
+/*
+ * Produces the next subnet in ascending order
+ *
+ * @param it: Iterator from net_ipv6_subnets_begin()
+ * @param subnet: Receives the subnet network address
+ * @return: 1 if a subnet was produced, 0 when all have been
+ */
+int net_ipv6_subnets_next(NetIpv6SubnetIter *it, NetIpv6 *subnet)
+{
+    if (it->done) return 0;
+
+    *subnet = it->next;
+    if (net_ipv6_compare(&it->next, &it->last) == 0) it->done = 1;
+    else it->next = ipv6_add_bit(&it->next, 128 - it->prefix);
+    return 1;
+}
+
+/*
+ * ============================================================================
+ * CLASSIFICATION AND EMBEDDED IPv4
+ * ============================================================================
+ */
+
+/*
+ * Extracts the IPv4 address carried in the low 32 bits of
+ * - ::ffff:0:0/96   IPv4-mapped (RFC 4291)
+ * - 64:ff9b::/96    IPv4/IPv6 translation (RFC 6052)
+ *
+ * @return: 1 with *ipv4 set if the address embeds one, 0 otherwise
+ */
+int net_ipv6_embedded_ipv4(const NetIpv6 *ip, unsigned int *ipv4)
+{
+    int mapped = ip->hi == 0 && (ip->lo >> 32) == 0xFFFF;
+    int nat64 = ip->hi == 0x0064FF9B00000000ULL && (ip->lo >> 32) == 0;
+
+    if (!mapped && !nat64) return 0;
+    *ipv4 = (unsigned int)ip->lo;
+    return 1;
+}
+
+/*
+ * Returns the address type label (most specific block first)
+ */
+const char *net_ipv6_type(const NetIpv6 *ip)
+{
+    unsigned int top = (unsigned int)(ip->hi >> 48);
+
+    if (ip->hi == 0 && ip->lo == 0) return "unspecified";
+    if (ip->hi == 0 && ip->lo == 1) return "loopback";
+    if (ip->hi == 0 && (ip->lo >> 32) == 0xFFFF) return "ipv4-mapped";
+    if (ip->hi == 0x0064FF9B00000000ULL && (ip->lo >> 32) == 0) return "nat64";
+    if ((ip->hi >> 32) == 0x20010DB8) return "documentation";
+    if ((top & 0xFFC0) == 0xFE80) return "link-local";
+    if ((top & 0xFE00) == 0xFC00) return "unique-local";
+    if ((top & 0xFF00) == 0xFF00) return "multicast";
+    if ((top & 0xE000) == 0x2000) return "global-unicast";
+    return "reserved";
+}
@@ -0,0 +1,389 @@
+/*
+ * ============================================================================
+ * LONGEST-PREFIX-MATCH TABLE FOR IPv6 (RANGE TABLE)
+ * ============================================================================
+ *
+ * The IPv6 counterpart of the DIR-24-8 table in lpm_table.c, sized for
+ * full Internet tables (200k+ prefixes) and used by --lpm and the daemon
+ * for table lines and queries that contain ':'.
+ *
+ * DIR-24-8 does not carry over: with 128-bit addresses a direct-indexed
+ * table needs a chain of up to 13 tbl8 levels, and a full IPv6 table
+ * would allocate hundreds of megabytes of 256-entry groups. Instead:
+ *
+ * - The prefixes are flattened into sorted, disjoint address ranges.
+ *   Each range records the route that is the longest match for every
+ *   address in it (0 = none). Nested prefixes split their parent's range,
+ *   so n prefixes give at most 2n + 1 ranges.
+ * - index[] has one entry per value of the top 16 bits, pointing at the
+ *   range that holds the first address of that /16. A lookup reads its
+ *   entry and the next one, then binary-searches only the ranges between.
+ *
+ * Memory is linear in the number of prefixes (16 + 4 bytes per range plus
+ * a 256 KB index), so a 200k-prefix table needs about 10 MB.
+ *
+ * Building: prefixes are sorted by (network, length, load order) and swept
+ * left to right with a stack of the prefixes that contain the current
+ * address; a range starts wherever the innermost open prefix changes.
+ * Among duplicates of the same network and length, the last one loaded
+ * wins, as in lpm_table.c.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+
+#define LPM6_BATCH_GROUP 16     // Searches advanced in lockstep by lpm6_lookup_batch
+
+// One prefix while building: sort key plus route number
+typedef struct
+{
+    NetIpv6 network;
+    unsigned int prefix;
+    unsigned int route;         // 1-based route number
+} Lpm6BuildEntry;
+
+// A prefix that contains the current sweep position
+typedef struct
+{
+    NetIpv6 network;
+    NetIpv6 last;
+    unsigned int prefix;
+    unsigned int route;
+} Lpm6OpenPrefix;
+
+/*
+ * ============================================================================
+ * TABLE CONSTRUCTION
+ * ============================================================================
+ */
+
+/*
+ * Initializes an empty table (routes can be added, lookups need a build)
+ *
+ * @param table: Table to initialize
+ */
+void lpm6_table_init(Lpm6Table *table)
+{
+    memset(table, 0, sizeof(*table));
+}
+
+/*
+ * Appends a route to the staging list
+ *
+ * Host bits below the prefix are cleared, and the label is copied into
+ * the table's label arena.
+ *
+ * @param table: Table being built
+ * @param ip: Any address inside the network
+ * @param prefix: Prefix length 0-128
+ * @param label: Optional label bytes (may be NULL)
+ * @param label_len: Label length in bytes
+ * @return: NET_OK, NET_ERR_RANGE for a bad prefix, NET_ERR_BUFFER if out of memory
+ */
+NetStatus lpm6_table_add(Lpm6Table *table, const NetIpv6 *ip, int prefix,
+                         const char *label, size_t label_len)
+{
+    if (prefix < 0 || prefix > 128) return NET_ERR_RANGE;
+    if (!label) label_len = 0;
+
+    if (table->route_count == table->route_capacity) {
+        size_t capacity = table->route_capacity ? table->route_capacity * 2 : 1024;
+        Lpm6Route *routes = realloc(table->routes, capacity * sizeof(Lpm6Route));
+        if (!routes) return NET_ERR_BUFFER;
+        table->routes = routes;
+        table->route_capacity = capacity;
+    }
+
+    if (table->labels_len + label_len > table->labels_capacity) {
+        size_t capacity = table->labels_capacity ? table->labels_capacity : 4096;
+        while (capacity < table->labels_len + label_len) capacity *= 2;
+        char *labels = realloc(table->labels, capacity);
+        if (!labels) return NET_ERR_BUFFER;
+        table->labels = labels;
+        table->labels_capacity = capacity;
+    }
+
+    Lpm6Route *route = &table->routes[table->route_count++];
+    route->network = net_ipv6_network(ip, prefix);
+    route->prefix = (unsigned int)prefix;
+    route->label_offset = (unsigned int)table->labels_len;
+    route->label_len = (unsigned int)label_len;
+
+    if (label_len > 0) memcpy(table->labels + table->labels_len, label, label_len);
+    table->labels_len += label_len;
+    return NET_OK;
+}
+
+static int lpm6_entry_compare(const void *a, const void *b)
+{
+    const Lpm6BuildEntry *x = a;
+    const Lpm6BuildEntry *y = b;
+    int order = net_ipv6_compare(&x->network, &y->network);
+
+    if (order != 0) return order;
+    if (x->prefix != y->prefix) return x->prefix < y->prefix ? -1 : 1;
+    return x->route < y->route ? -1 : (x->route > y->route);
+}
+
+/*
+ * Starts a range at 'start' (a later decision for the same start wins,
+ * and a range with the same route as the one before it is merged into it)
+ */
+static void lpm6_emit(Lpm6Table *table, const NetIpv6 *start, unsigned int route)
+{
+    size_t n = table->range_count;
+
+    if (n > 0 && net_ipv6_compare(&table->starts[n - 1], start) == 0) n--;
+    if (n > 0 && table->routes_of_ranges[n - 1] == route) {
+        table->range_count = n;
+        return;
+    }
+    table->starts[n] = *start;
+    table->routes_of_ranges[n] = route;
+    table->range_count = n + 1;
+}
+
+/*
+ * Fills the range and index arrays from the staged routes
+ *
+ * @param table: Table with staged routes
+ * @return: 1 if successful, 0 on allocation failure
+ */
+int lpm6_table_build(Lpm6Table *table)
+{
+    size_t count = table->route_count;
+    Lpm6BuildEntry *entries = malloc((count ? count : 1) * sizeof(Lpm6BuildEntry));
+    Lpm6OpenPrefix stack[129];  // Open prefixes strictly nest: at most one per length
+    int depth = 0;
+
+    free(table->starts);
+    free(table->routes_of_ranges);
+    free(table->index);
+    table->starts = malloc((2 * count + 1) * sizeof(NetIpv6));
+    table->routes_of_ranges = malloc((2 * count + 1) * sizeof(unsigned int));
+    table->index = malloc((LPM6_INDEX_ENTRIES + 1) * sizeof(unsigned int));
+    table->range_count = 0;
+    if (!entries || !table->starts || !table->routes_of_ranges || !table->index) goto fail;
+
+    for (size_t i = 0; i < count; i++) {
+        entries[i].network = table->routes[i].network;
+        entries[i].prefix = table->routes[i].prefix;
+        entries[i].route = (unsigned int)i + 1;
+    }
+    qsort(entries, count, sizeof(Lpm6BuildEntry), lpm6_entry_compare);
+
+    NetIpv6 zero = { 0, 0 };
+    lpm6_emit(table, &zero, 0);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const Lpm6BuildEntry *entry = &entries[i];
+
+        // Close the prefixes that end before this one starts
+        while (depth > 0 && net_ipv6_compare(&stack[depth - 1].last, &entry->network) < 0) {
+            NetIpv6 next = net_ipv6_add(&stack[--depth].last, 1);
+            lpm6_emit(table, &next, depth > 0 ? stack[depth - 1].route : 0);
+        }
+
+        Lpm6OpenPrefix *top = depth > 0 ? &stack[depth - 1] : NULL;
+        if (top && top->prefix == entry->prefix &&
+            net_ipv6_compare(&top->network, &entry->network) == 0) {
+            top->route = entry->route;  // Duplicate: the later route wins
+        } else {
+            top = &stack[depth++];
+            top->network = entry->network;
+            top->last = net_ipv6_last(&entry->network, (int)entry->prefix);
+            top->prefix = entry->prefix;
+            top->route = entry->route;
+        }
+        lpm6_emit(table, &entry->network, entry->route);
+    }
+
+    // Close the rest; a prefix reaching the top of the space ends there
+    while (depth > 0) {
+        const Lpm6OpenPrefix *closed = &stack[--depth];
+        if (closed->last.hi == ~0ULL && closed->last.lo == ~0ULL) continue;
+        NetIpv6 next = net_ipv6_add(&closed->last, 1);
+        lpm6_emit(table, &next, depth > 0 ? stack[depth - 1].route : 0);
+    }
+
+    // index[b] = range holding the first address of /16 block b
+    size_t range = 0;
+    for (unsigned int block = 0; block < LPM6_INDEX_ENTRIES; block++) {
+        uint64_t block_start = (uint64_t)block << 48;
+        while (range + 1 < table->range_count &&
+               (table->starts[range + 1].hi < block_start ||
+                (table->starts[range + 1].hi == block_start && table->starts[range + 1].lo == 0))) {
+            range++;
+        }
+        table->index[block] = (unsigned int)range;
+    }
+    table->index[LPM6_INDEX_ENTRIES] = (unsigned int)(table->range_count - 1);
+
+    free(entries);
+    return 1;
+
+fail:
+    fprintf(stderr, "❌ Memory allocation failed while building IPv6 prefix table\n");
+    free(entries);
+    free(table->starts);
+    free(table->routes_of_ranges);
+    free(table->index);
+    table->starts = NULL;
+    table->routes_of_ranges = NULL;
+    table->index = NULL;
+    table->range_count = 0;
+    return 0;
+}
+
+/*
+ * ============================================================================
+ * LOOKUP
+ * ============================================================================
+ */
+
+/*
+ * Returns the route number for an address (1-based, 0 if no match)
+ *
+ * The search keeps "starts[base] <= ip" and halves the candidate count
+ * each step; the comparison feeds a conditional move, not a branch.
+ */
+static inline unsigned int lpm6_lookup_index(const Lpm6Table *table, const NetIpv6 *ip)
+{
+    unsigned int block = (unsigned int)(ip->hi >> 48);
+    size_t base = table->index[block];
+    size_t n = table->index[block + 1] - base + 1;
+
+    while (n > 1) {
+        size_t half = n / 2;
+        const NetIpv6 *start = &table->starts[base + half];
+        int below = start->hi < ip->hi || (start->hi == ip->hi && start->lo <= ip->lo);
+        base = below ? base + half : base;
+        n -= half;
+    }
+    return table->routes_of_ranges[base];
+}
+
+/*
+ * Finds the longest prefix containing an address
+ *
+ * @param table: Built table (an empty, unbuilt table matches nothing)
+ * @param ip: Address to look up
+ * @return: Matching route, or NULL if no prefix contains the address
+ */
+const Lpm6Route *lpm6_lookup(const Lpm6Table *table, const NetIpv6 *ip)
+{
+    if (!table->index) return NULL;
+
+    unsigned int route = lpm6_lookup_index(table, ip);
+    return route ? &table->routes[route - 1] : NULL;
+}
+
+/*
+ * Looks up many addresses at once
+ *
+ * The binary searches of a group of addresses advance one step at a time
+ * in lockstep, and each step prefetches the range the next step of that
+ * search will compare against. The cache misses of the independent
+ * searches then overlap instead of running one after the other.
+ *
+ * @param table: Built table
+ * @param ips: Addresses to look up
+ * @param count: Number of addresses
+ * @param routes_out: Receives a route pointer (or NULL) per address
+ */
+void lpm6_lookup_batch(const Lpm6Table *table, const NetIpv6 *ips, size_t count,
+                       const Lpm6Route **routes_out)
+{
+    size_t base[LPM6_BATCH_GROUP];
+    size_t n[LPM6_BATCH_GROUP];
+
+    if (!table->index) {
+        for (size_t i = 0; i < count; i++) routes_out[i] = NULL;
+        return;
+    }
+
+    for (size_t group = 0; group < count; group += LPM6_BATCH_GROUP)
+    {
+        size_t size = count - group < LPM6_BATCH_GROUP ? count - group : LPM6_BATCH_GROUP;
+        const NetIpv6 *ip = ips + group;
+        int active = 0;
+
+        for (size_t i = 0; i < size; i++) {
+            unsigned int block = (unsigned int)(ip[i].hi >> 48);
+            base[i] = table->index[block];
+            n[i] = table->index[block + 1] - base[i] + 1;
+            __builtin_prefetch(&table->starts[base[i] + n[i] / 2]);
+            active |= n[i] > 1;
+        }
+
+        while (active) {
+            active = 0;
+            for (size_t i = 0; i < size; i++) {
+                if (n[i] <= 1) continue;
+                size_t half = n[i] / 2;
+                const NetIpv6 *start = &table->starts[base[i] + half];
+                int below = start->hi < ip[i].hi || (start->hi == ip[i].hi && start->lo <= ip[i].lo);
+                base[i] = below ? base[i] + half : base[i];
+                n[i] -= half;
+                __builtin_prefetch(&table->starts[base[i] + n[i] / 2]);
+                active |= n[i] > 1;
+            }
+        }
+
+        for (size_t i = 0; i < size; i++) {
+            unsigned int route = table->routes_of_ranges[base[i]];
+            routes_out[group + i] = route ? &table->routes[route - 1] : NULL;
+        }
+    }
+}
+
+/*
+ * Formats the result fields of one lookup (no newline)
+ *
+ * Output: " match=<network>/<prefix> label=<label>" or " match=none",
+ * the same layout as lpm_format_result().
+ *
+ * @param table: Table the route belongs to
+ * @param route: Lookup result (NULL = no match)
+ * @param w: Destination with room for LPM_MAX_RESULT_LENGTH + label length
+ * @return: Number of bytes written
+ */
+size_t lpm6_format_result(const Lpm6Table *table, const Lpm6Route *route, char *w)
+{
+    char *start = w;
+
+    if (!route) {
+        memcpy(w, " match=none", 11);
+        return 11;
+    }
+
+    memcpy(w, " match=", 7);
+    w += 7;
+    w += net_format_ipv6(&route->network, w);
+    w += sprintf(w, "/%u", route->prefix);
+    if (route->label_len > 0) {
+        memcpy(w, " label=", 7);
+        w += 7;
+        memcpy(w, table->labels + route->label_offset, route->label_len);
+        w += route->label_len;
+    }
+    return (size_t)(w - start);
+}
+
+/*
+ * Releases all table memory
+ *
+ * @param table: Table to free
+ */
+void lpm6_table_free(Lpm6Table *table)
+{
+    free(table->starts);
+    free(table->routes_of_ranges);
+    free(table->index);
+    free(table->routes);
+    free(table->labels);
+    memset(table, 0, sizeof(*table));
+}
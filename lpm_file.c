@@ -0,0 +1,395 @@
+/*
+ * ============================================================================
+ * PREBUILT LPM TABLE FILES - COMPILE ONCE, MMAP EVERYWHERE
+ * ============================================================================
+ *
+ * Parsing a multi-million-line CIDR list and building the DIR-24-8 arrays
+ * costs a noticeable fraction of a second on every start. This file adds
+ * a binary table format that holds the built arrays exactly as they are
+ * laid out in memory, so a lookup process only has to mmap() the file:
+ *
+ *   ./net --compile-table routes.txt routes.lpm   (once)
+ *   ./net --lpm routes.lpm addresses.txt          (any number of times)
+ *
+ * Because the mapping is read-only and shared, every concurrent net
+ * process uses the same page-cache pages; nothing is copied per process.
+ *
+ * File layout (native byte order, each section 4096-byte aligned):
+ *   LpmFileHeader | routes | tbl24 | tbl8 groups | labels
+ *
+ * Before writing, the prefix set is sorted by (network, prefix) and
+ * duplicates are removed (the last occurrence in the input wins, exactly
+ * as for text tables). The file is written under a temporary name and
+ * renamed into place, so readers never see a half-written table.
+ *
+ * Compiled files hold IPv4 routes only; IPv6 prefixes of the input are
+ * reported and skipped (load IPv6 tables as text, see lpm6_table.c).
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define LPM_FILE_ALIGN 4096
+
+/*
+ * ============================================================================
+ * SORT AND DEDUPLICATE
+ * ============================================================================
+ */
+
+// Sort key: the route plus its position in the input (for stability)
+typedef struct
+{
+    unsigned int network;
+    unsigned int prefix;
+    unsigned int index;
+} LpmSortKey;
+
+/*
+ * Orders routes by network, then prefix, then load order
+ */
+static int lpm_route_compare(const void *a, const void *b)
+{
+    const LpmSortKey *ka = a;
+    const LpmSortKey *kb = b;
+
+    if (ka->network != kb->network) return ka->network < kb->network ? -1 : 1;
+    if (ka->prefix != kb->prefix) return ka->prefix < kb->prefix ? -1 : 1;
+    return ka->index < kb->index ? -1 : (ka->index > kb->index);
+}
+
+/*
+ * Sorts the staged routes and keeps one route per (network, prefix)
+ *
+ * The label arena is rebuilt so labels of dropped duplicates do not end
+ * up in the file. Must be called before lpm_table_build().
+ *
+ * @param table: Table with staged routes (not mapped)
+ * @return: Number of duplicates removed, or -1 on allocation failure
+ */
+long lpm_table_dedup(LpmTable *table)
+{
+    size_t count = table->route_count;
+    if (count == 0) return 0;
+
+    LpmSortKey *order = malloc(count * sizeof(LpmSortKey));
+    LpmRoute *routes = malloc(count * sizeof(LpmRoute));
+    char *labels = malloc(table->labels_len ? table->labels_len : 1);
+    if (!order || !routes || !labels) {
+        free(order);
+        free(routes);
+        free(labels);
+        return -1;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        order[i].network = table->routes[i].network;
+        order[i].prefix = table->routes[i].prefix;
+        order[i].index = (unsigned int)i;
+    }
+    qsort(order, count, sizeof(LpmSortKey), lpm_route_compare);
+
+    size_t kept = 0;
+    size_t labels_len = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        // Equal neighbours are in load order: only the last one survives
+        if (i + 1 < count && order[i + 1].network == order[i].network &&
+            order[i + 1].prefix == order[i].prefix) continue;
+
+        const LpmRoute *route = &table->routes[order[i].index];
+        routes[kept] = *route;
+        routes[kept].label_offset = (unsigned int)labels_len;
+        memcpy(labels + labels_len, table->labels + route->label_offset, route->label_len);
+        labels_len += route->label_len;
+        kept++;
+    }
+
+    free(order);
+    free(table->routes);
+    free(table->labels);
+    table->routes = routes;
+    table->route_count = kept;
+    table->route_capacity = count;
+    table->labels = labels;
+    table->labels_len = labels_len;
+    table->labels_capacity = table->labels_len ? table->labels_len : 1;
+
+    return (long)(count - kept);
+}
+
+/*
+ * ============================================================================
+ * WRITING
+ * ============================================================================
+ */
+
+static size_t lpm_align(size_t offset)
+{
+    return (offset + LPM_FILE_ALIGN - 1) & ~(size_t)(LPM_FILE_ALIGN - 1);
+}
+
+/*
+ * Writes len bytes at offset, retrying short writes
+ */
+static int lpm_write_at(int fd, const void *data, size_t len, size_t offset)
+{
+    const char *p = data;
+
+    while (len > 0)
+    {
+        ssize_t n = pwrite(fd, p, len, (off_t)offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+        p += n;
+        len -= (size_t)n;
+        offset += (size_t)n;
+    }
+    return 1;
+}
+
+/*
+ * Serializes a built table to a binary table file
+ *
+ * @param table: Built table (lpm_table_build() done)
+ * @param path: Destination file (replaced atomically)
+ * @return: 1 if successful, 0 on I/O failure
+ */
+int lpm_table_save(const LpmTable *table, const char *path)
+{
+    LpmFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LPM_FILE_MAGIC, sizeof(header.magic));
+    header.version = LPM_FILE_VERSION;
+    header.byte_order = LPM_FILE_BYTE_ORDER;
+    header.route_count = table->route_count;
+    header.tbl8_groups = table->tbl8_groups;
+    header.labels_len = table->labels_len;
+
+    size_t routes_size = table->route_count * sizeof(LpmRoute);
+    size_t tbl24_size = (size_t)LPM_TBL24_ENTRIES * sizeof(unsigned int);
+    size_t tbl8_size = table->tbl8_groups * LPM_TBL8_GROUP_SIZE * sizeof(unsigned int);
+
+    header.routes_offset = lpm_align(sizeof(header));
+    header.tbl24_offset = lpm_align(header.routes_offset + routes_size);
+    header.tbl8_offset = lpm_align(header.tbl24_offset + tbl24_size);
+    header.labels_offset = lpm_align(header.tbl8_offset + tbl8_size);
+    header.file_size = header.labels_offset + table->labels_len;
+
+    char temp_path[4096];
+    if (snprintf(temp_path, sizeof(temp_path), "%s.tmp.%d", path, (int)getpid()) >= (int)sizeof(temp_path)) {
+        fprintf(stderr, "❌ Output path too long: %s\n", path);
+        return 0;
+    }
+
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "❌ Cannot create %s: %s\n", temp_path, strerror(errno));
+        return 0;
+    }
+
+    int ok = ftruncate(fd, (off_t)header.file_size) == 0 &&
+             lpm_write_at(fd, &header, sizeof(header), 0) &&
+             lpm_write_at(fd, table->routes, routes_size, header.routes_offset) &&
+             lpm_write_at(fd, table->tbl24, tbl24_size, header.tbl24_offset) &&
+             lpm_write_at(fd, table->tbl8, tbl8_size, header.tbl8_offset) &&
+             lpm_write_at(fd, table->labels, table->labels_len, header.labels_offset);
+
+    if (close(fd) != 0) ok = 0;
+    if (ok && rename(temp_path, path) != 0) ok = 0;
+
+    if (!ok) {
+        fprintf(stderr, "❌ Cannot write %s: %s\n", path, strerror(errno));
+        unlink(temp_path);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * ============================================================================
+ * MAPPING
+ * ============================================================================
+ */
+
+/*
+ * Checks that a section lies inside the file and is aligned like
+ * lpm_table_save() writes it (no overflow for any header values)
+ */
+static int lpm_file_section_ok(unsigned long long offset, unsigned long long length, size_t size)
+{
+    return offset % LPM_FILE_ALIGN == 0 && offset <= size && length <= size - offset;
+}
+
+/*
+ * Maps a binary table file read-only and points the table at it
+ *
+ * Only the header and the section bounds are checked, so opening costs
+ * the same for any table size and no entry page is touched. The entries
+ * are not trusted: lookups check group and route numbers against the
+ * header counts (see lpm_lookup_index), so a corrupt file gives wrong
+ * matches at worst, never a read outside the mapping. The pages are
+ * faulted in on first use and shared with other processes through the
+ * page cache.
+ *
+ * @param table: Table to set up (lpm_table_free() unmaps it)
+ * @param path: File written by lpm_table_save()
+ * @return: 1 if successful, 0 if the file is missing or not a valid table
+ */
+int lpm_table_map(LpmTable *table, const char *path)
+{
+    lpm_table_init(table);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "❌ Cannot open %s: %s\n", path, strerror(errno));
+        return 0;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(LpmFileHeader)) {
+        fprintf(stderr, "❌ %s: not a compiled table\n", path);
+        close(fd);
+        return 0;
+    }
+
+    void *mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "❌ Cannot map %s: %s\n", path, strerror(errno));
+        return 0;
+    }
+
+    const LpmFileHeader *header = mapping;
+    size_t size = (size_t)st.st_size;
+    const char *error = NULL;
+
+    if (memcmp(header->magic, LPM_FILE_MAGIC, sizeof(header->magic)) != 0) {
+        error = "not a compiled table";
+    } else if (header->version != LPM_FILE_VERSION) {
+        error = "unsupported table version (recompile with --compile-table)";
+    } else if (header->byte_order != LPM_FILE_BYTE_ORDER) {
+        error = "table was compiled on a machine with a different byte order";
+    } else if (header->file_size != size ||
+               header->route_count > size / sizeof(LpmRoute) ||
+               header->tbl8_groups > LPM_TBL8_MAX_GROUPS ||
+               !lpm_file_section_ok(header->routes_offset, header->route_count * sizeof(LpmRoute), size) ||
+               !lpm_file_section_ok(header->tbl24_offset, (unsigned long long)LPM_TBL24_ENTRIES * sizeof(unsigned int), size) ||
+               !lpm_file_section_ok(header->tbl8_offset, header->tbl8_groups * LPM_TBL8_GROUP_SIZE * sizeof(unsigned int), size) ||
+               !lpm_file_section_ok(header->labels_offset, header->labels_len, size)) {
+        error = "table file is truncated or corrupt";
+    }
+
+    if (error) {
+        fprintf(stderr, "❌ %s: %s\n", path, error);
+        munmap(mapping, size);
+        return 0;
+    }
+
+    const char *base = mapping;
+    table->routes = (LpmRoute *)(base + header->routes_offset);
+    table->route_count = header->route_count;
+    table->tbl24 = (unsigned int *)(base + header->tbl24_offset);
+    table->tbl8 = (unsigned int *)(base + header->tbl8_offset);
+    table->tbl8_groups = header->tbl8_groups;
+    table->labels = (char *)(base + header->labels_offset);
+    table->labels_len = header->labels_len;
+    table->mapping = mapping;
+    table->mapping_size = size;
+    return 1;
+}
+
+/*
+ * Opens a table in either format
+ *
+ * Compiled tables (recognized by their magic bytes) are mapped, anything
+ * else is parsed as a text table.
+ *
+ * @param table: Table to set up
+ * @param path: Compiled or text table file
+ * @return: 1 if successful, 0 on failure
+ */
+int lpm_table_open(LpmTable *table, const char *path)
+{
+    char magic[sizeof(((LpmFileHeader *)0)->magic)];
+    ssize_t n = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        n = read(fd, magic, sizeof(magic));
+        close(fd);
+    }
+
+    if (n == (ssize_t)sizeof(magic) && memcmp(magic, LPM_FILE_MAGIC, sizeof(magic)) == 0) {
+        return lpm_table_map(table, path);
+    }
+
+    lpm_table_init(table);
+    return lpm_table_load(table, path);
+}
+
+/*
+ * ============================================================================
+ * COMPILE-TABLE MODE ENTRY POINT
+ * ============================================================================
+ */
+
+/*
+ * Converts a text table into a compiled table file
+ *
+ * @param input_path: Text table ("CIDR [label]" lines)
+ * @param output_path: Compiled table to write
+ * @return: Process exit status (0 on success)
+ */
+int run_compile_table_mode(const char *input_path, const char *output_path)
+{
+    LpmTable table;
+    lpm_table_init(&table);
+
+    printf("🔨 Compiling prefix table %s → %s\n", input_path, output_path);
+
+    // Parse without building: dedup first, then build once
+    if (!lpm_table_read(&table, input_path)) {
+        lpm_table_free(&table);
+        return 1;
+    }
+
+    if (table.v6.route_count > 0) {
+        fprintf(stderr, "⚠️  %zu IPv6 prefixes skipped: compiled tables hold IPv4 routes only\n",
+                table.v6.route_count);
+        lpm6_table_free(&table.v6);
+    }
+
+    size_t loaded = table.route_count;
+    long duplicates = lpm_table_dedup(&table);
+    if (duplicates < 0 || !lpm_table_build(&table)) {
+        fprintf(stderr, "❌ Memory allocation failed while compiling %s\n", input_path);
+        lpm_table_free(&table);
+        return 1;
+    }
+
+    if (!lpm_table_save(&table, output_path)) {
+        lpm_table_free(&table);
+        return 1;
+    }
+
+    struct stat st;
+    double megabytes = stat(output_path, &st) == 0 ? (double)st.st_size / (1024.0 * 1024.0) : 0.0;
+
+    printf("✅ %zu prefixes read, %ld duplicates removed, %zu written\n",
+           loaded, duplicates, table.route_count);
+    printf("   tbl8 groups: %zu, file size: %.1f MB\n", table.tbl8_groups, megabytes);
+    printf("💡 Use it with: ./net --lpm %s [file]\n", output_path);
+
+    lpm_table_free(&table);
+    return 0;
+}
@@ -0,0 +1,540 @@
+/*
+ * ============================================================================
+ * LONGEST-PREFIX-MATCH ROUTING TABLE (DIR-24-8)
+ * ============================================================================
+ *
+ * This file implements a loadable prefix table that answers "which is the
+ * most specific network containing this address?" for large route and ACL
+ * sets (millions of CIDRs), plus the --lpm mode built on top of it.
+ *
+ * Structure (DIR-24-8, as used by software routers):
+ * - tbl24: one 32-bit entry for every possible /24 (2^24 entries). The
+ *   entry holds the route number of the longest prefix of length <= 24
+ *   covering that /24, or 0 if no route covers it.
+ * - tbl8: groups of 256 entries, one group per /24 that also contains
+ *   longer prefixes (/25-/32). The tbl24 entry then stores the group
+ *   number with LPM_TBL8_FLAG set, and the group holds one entry per
+ *   address of that /24.
+ *
+ * A lookup is therefore at most two memory reads:
+ *   entry = tbl24[ip >> 8]
+ *   if (entry & LPM_TBL8_FLAG) entry = tbl8[group * 256 + (ip & 255)]
+ *
+ * Building: routes are inserted in ascending prefix-length order, so a
+ * longer prefix always overwrites the shorter ones it lies inside. Among
+ * duplicates of the same network and length, the last one loaded wins.
+ *
+ * Tables are loaded from text (below) or mapped from a compiled file
+ * produced by --compile-table (see lpm_file.c). IPv6 prefixes in a text
+ * table go to the embedded range table of lpm6_table.c instead.
+ *
+ * Table file format (blank lines and '#' comments are skipped):
+ *   10.0.0.0/8          core
+ *   10.1.0.0/16         branch-office
+ *   192.0.2.1           host route (bare address = /32)
+ *   2001:db8::/32       documentation (IPv6)
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <unistd.h>
+#include <sys/mman.h>
+
+/*
+ * ============================================================================
+ * TABLE CONSTRUCTION
+ * ============================================================================
+ */
+
+/*
+ * Initializes an empty table (routes can be added, lookups need a build)
+ *
+ * @param table: Table to initialize
+ */
+void lpm_table_init(LpmTable *table)
+{
+    memset(table, 0, sizeof(*table));
+}
+
+/*
+ * Appends a route to the staging list
+ *
+ * Host bits below the prefix are cleared, so "10.1.2.3/16" is stored
+ * as 10.1.0.0/16. The label is copied into the table's label arena.
+ *
+ * @param table: Table being built
+ * @param ip: Any address inside the network
+ * @param prefix: Prefix length 0-32
+ * @param label: Optional label bytes (may be NULL)
+ * @param label_len: Label length in bytes
+ * @return: NET_OK, NET_ERR_RANGE for a bad prefix, NET_ERR_BUFFER if out of memory
+ */
+NetStatus lpm_table_add(LpmTable *table, unsigned int ip, int prefix,
+                        const char *label, size_t label_len)
+{
+    if (prefix < 0 || prefix > 32) return NET_ERR_RANGE;
+    if (!label) label_len = 0;
+
+    if (table->route_count == table->route_capacity) {
+        size_t capacity = table->route_capacity ? table->route_capacity * 2 : 1024;
+        LpmRoute *routes = realloc(table->routes, capacity * sizeof(LpmRoute));
+        if (!routes) return NET_ERR_BUFFER;
+        table->routes = routes;
+        table->route_capacity = capacity;
+    }
+
+    if (table->labels_len + label_len > table->labels_capacity) {
+        size_t capacity = table->labels_capacity ? table->labels_capacity : 4096;
+        while (capacity < table->labels_len + label_len) capacity *= 2;
+        char *labels = realloc(table->labels, capacity);
+        if (!labels) return NET_ERR_BUFFER;
+        table->labels = labels;
+        table->labels_capacity = capacity;
+    }
+
+    LpmRoute *route = &table->routes[table->route_count++];
+    route->network = ip & NET_PREFIX_TABLE[prefix].mask;
+    route->prefix = (unsigned int)prefix;
+    route->label_offset = (unsigned int)table->labels_len;
+    route->label_len = (unsigned int)label_len;
+
+    if (label_len > 0) memcpy(table->labels + table->labels_len, label, label_len);
+    table->labels_len += label_len;
+    return NET_OK;
+}
+
+/*
+ * Returns a new tbl8 group filled with 'value', or -1 if out of memory
+ */
+static long lpm_tbl8_alloc(LpmTable *table, unsigned int value)
+{
+    if (table->tbl8_groups == table->tbl8_capacity) {
+        size_t capacity = table->tbl8_capacity ? table->tbl8_capacity * 2 : 256;
+        if (capacity > LPM_TBL8_MAX_GROUPS) capacity = LPM_TBL8_MAX_GROUPS;
+        if (capacity == table->tbl8_groups) return -1;
+
+        unsigned int *tbl8 = realloc(table->tbl8, capacity * LPM_TBL8_GROUP_SIZE * sizeof(unsigned int));
+        if (!tbl8) return -1;
+        table->tbl8 = tbl8;
+        table->tbl8_capacity = capacity;
+    }
+
+    size_t group = table->tbl8_groups++;
+    unsigned int *entries = table->tbl8 + group * LPM_TBL8_GROUP_SIZE;
+    for (int i = 0; i < LPM_TBL8_GROUP_SIZE; i++) entries[i] = value;
+    return (long)group;
+}
+
+/*
+ * Fills the lookup arrays from the staged routes
+ *
+ * Routes are ordered by prefix length with a counting sort (33 buckets,
+ * stable, O(n)) and written shortest first.
+ *
+ * @param table: Table with staged routes
+ * @return: 1 if successful, 0 on allocation failure
+ */
+int lpm_table_build(LpmTable *table)
+{
+    size_t bucket_start[NET_PREFIX_COUNT + 1] = {0};
+    unsigned int *order = NULL;
+
+    free(table->tbl24);
+    table->tbl24 = calloc(LPM_TBL24_ENTRIES, sizeof(unsigned int));
+    table->tbl8_groups = 0;
+    if (!table->tbl24) goto fail;
+
+    order = malloc((table->route_count ? table->route_count : 1) * sizeof(unsigned int));
+    if (!order) goto fail;
+
+    for (size_t i = 0; i < table->route_count; i++) bucket_start[table->routes[i].prefix + 1]++;
+    for (int p = 0; p < NET_PREFIX_COUNT; p++) bucket_start[p + 1] += bucket_start[p];
+    for (size_t i = 0; i < table->route_count; i++) {
+        order[bucket_start[table->routes[i].prefix]++] = (unsigned int)i;
+    }
+
+    for (size_t n = 0; n < table->route_count; n++)
+    {
+        unsigned int index = order[n];
+        const LpmRoute *route = &table->routes[index];
+        unsigned int value = index + 1;  // 0 means "no route"
+
+        if (route->prefix <= 24) {
+            // Covers 2^(24 - prefix) whole /24 blocks
+            unsigned int first = route->network >> 8;
+            unsigned int count = 1U << (24 - route->prefix);
+            for (unsigned int i = first; i < first + count; i++) table->tbl24[i] = value;
+        } else {
+            // Covers 2^(32 - prefix) addresses inside one /24 block
+            unsigned int block = route->network >> 8;
+            unsigned int entry = table->tbl24[block];
+            if (!(entry & LPM_TBL8_FLAG)) {
+                long group = lpm_tbl8_alloc(table, entry);
+                if (group < 0) goto fail;
+                entry = (unsigned int)group | LPM_TBL8_FLAG;
+                table->tbl24[block] = entry;
+            }
+
+            unsigned int *entries = table->tbl8 + (size_t)(entry & ~LPM_TBL8_FLAG) * LPM_TBL8_GROUP_SIZE;
+            unsigned int first = route->network & 0xFF;
+            unsigned int count = 1U << (32 - route->prefix);
+            for (unsigned int i = first; i < first + count; i++) entries[i] = value;
+        }
+    }
+
+    free(order);
+    return table->v6.route_count == 0 || lpm6_table_build(&table->v6);
+
+fail:
+    fprintf(stderr, "❌ Memory allocation failed while building prefix table\n");
+    free(order);
+    free(table->tbl24);
+    table->tbl24 = NULL;
+    return 0;
+}
+
+/*
+ * Stages the routes of a text table file (without building)
+ *
+ * Each line holds a CIDR (or bare address) optionally followed by
+ * whitespace and a label; a ':' in the first field makes it an IPv6
+ * route. Invalid lines are reported on stderr and skipped.
+ *
+ * @param table: Initialized table
+ * @param path: Table file, or "-" for standard input
+ * @return: 1 if successful, 0 if the file cannot be read
+ */
+int lpm_table_read(LpmTable *table, const char *path)
+{
+    LineReader reader;
+    const char *line;
+    size_t len;
+    size_t line_number = 0;
+    size_t invalid = 0;
+
+    if (!line_reader_open(&reader, path)) return 0;
+
+    while (line_reader_next(&reader, &line, &len))
+    {
+        line_number++;
+
+        while (len > 0 && (*line == ' ' || *line == '\t')) { line++; len--; }
+        while (len > 0 && (line[len - 1] == ' ' || line[len - 1] == '\t')) len--;
+        if (len == 0 || *line == '#') continue;
+
+        const char *end = line + len;
+        const char *p = line;
+        unsigned int ip;
+        NetIpv6 ip6;
+        int prefix;
+        NetStatus status;
+
+        while (p < end && *p != ' ' && *p != '\t' && *p != ':') p++;
+        int is_ipv6 = p < end && *p == ':';
+        if (is_ipv6) {
+            status = net_parse_ipv6_cidr_span(line, end, &ip6, &prefix, &p);
+        } else {
+            status = net_parse_cidr_span(line, end, &ip, &prefix, &p);
+        }
+
+        if (status != NET_OK || (p < end && *p != ' ' && *p != '\t')) {
+            if (invalid++ < LPM_MAX_REPORTED_ERRORS) {
+                fprintf(stderr, "⚠️  %s:%zu: invalid prefix \"%.*s\"\n",
+                        path, line_number, (int)(len > 64 ? 64 : len), line);
+            }
+            continue;
+        }
+
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        status = is_ipv6 ? lpm6_table_add(&table->v6, &ip6, prefix, p, (size_t)(end - p))
+                         : lpm_table_add(table, ip, prefix, p, (size_t)(end - p));
+        if (status != NET_OK) {
+            fprintf(stderr, "❌ Memory allocation failed while loading %s\n", path);
+            line_reader_close(&reader);
+            return 0;
+        }
+    }
+    int read_failed = reader.error;
+    line_reader_close(&reader);
+    if (read_failed) return 0;
+
+    if (invalid > 0) fprintf(stderr, "⚠️  %s: %zu invalid line(s) skipped\n", path, invalid);
+    return 1;
+}
+
+/*
+ * Loads and builds a table from a text table file
+ *
+ * @param table: Initialized table
+ * @param path: Table file, or "-" for standard input
+ * @return: 1 if successful, 0 if the file cannot be read or built
+ */
+int lpm_table_load(LpmTable *table, const char *path)
+{
+    return lpm_table_read(table, path) && lpm_table_build(table);
+}
+
+/*
+ * ============================================================================
+ * LOOKUP
+ * ============================================================================
+ */
+
+/*
+ * Returns the route number for an address (1-based, 0 if no match)
+ *
+ * Group numbers are checked against the table's group count, so a
+ * corrupt compiled file cannot make a lookup read outside the mapping.
+ */
+static inline unsigned int lpm_lookup_index(const LpmTable *table, unsigned int ip)
+{
+    unsigned int entry = table->tbl24[ip >> 8];
+    if (entry & LPM_TBL8_FLAG) {
+        size_t group = entry & ~LPM_TBL8_FLAG;
+        if (group >= table->tbl8_groups) return 0;
+        entry = table->tbl8[group * LPM_TBL8_GROUP_SIZE + (ip & 0xFF)];
+    }
+    return entry;
+}
+
+/*
+ * Returns the route for a route number, or NULL for 0
+ *
+ * Numbers past the route list and routes whose prefix or label lie
+ * outside the table (possible only in a corrupt compiled file) count as
+ * no match. Built tables always pass; the checks are a few compares on
+ * the route that is read anyway.
+ */
+static inline const LpmRoute *lpm_route_at(const LpmTable *table, unsigned int index)
+{
+    if (index == 0 || index > table->route_count) return NULL;
+
+    const LpmRoute *route = &table->routes[index - 1];
+    if (route->prefix > 32 || route->label_offset > table->labels_len ||
+        route->label_len > table->labels_len - route->label_offset) {
+        return NULL;
+    }
+    return route;
+}
+
+/*
+ * Finds the longest prefix containing an address
+ *
+ * @param table: Built table
+ * @param ip: Address to look up
+ * @return: Matching route, or NULL if no prefix contains the address
+ */
+const LpmRoute *lpm_lookup(const LpmTable *table, unsigned int ip)
+{
+    return lpm_route_at(table, lpm_lookup_index(table, ip));
+}
+
+/*
+ * Looks up many addresses at once
+ *
+ * All first-level reads are issued before any result is used, so the
+ * cache misses of independent lookups overlap instead of running one
+ * after the other.
+ *
+ * @param table: Built table
+ * @param ips: Addresses to look up
+ * @param count: Number of addresses
+ * @param routes_out: Receives a route pointer (or NULL) per address
+ */
+void lpm_lookup_batch(const LpmTable *table, const unsigned int *ips, size_t count,
+                      const LpmRoute **routes_out)
+{
+    for (size_t i = 0; i < count; i++) __builtin_prefetch(&table->tbl24[ips[i] >> 8]);
+
+    for (size_t i = 0; i < count; i++) {
+        routes_out[i] = lpm_route_at(table, lpm_lookup_index(table, ips[i]));
+    }
+}
+
+/*
+ * Releases all table memory
+ *
+ * @param table: Table to free
+ */
+void lpm_table_free(LpmTable *table)
+{
+    if (table->mapping) {
+        // Compiled table: all arrays point into the file mapping
+        munmap(table->mapping, table->mapping_size);
+    } else {
+        free(table->tbl24);
+        free(table->tbl8);
+        free(table->routes);
+        free(table->labels);
+        lpm6_table_free(&table->v6);
+    }
+    memset(table, 0, sizeof(*table));
+}
+
+/*
+ * ============================================================================
+ * LPM MODE ENTRY POINT
+ * ============================================================================
+ */
+
+// Input lines are collected in blocks so their lookups can overlap
+#define LPM_BLOCK_SIZE 32
+
+typedef struct
+{
+    unsigned int ip;
+    NetIpv6 ip6;
+    int is_ipv6;
+    int valid;
+    size_t len;
+    char text[LPM_ECHO_MAX];
+} LpmInputSlot;
+
+/*
+ * Formats the result fields of one lookup (no newline)
+ *
+ * Output: " match=<network>/<prefix> label=<label>", " match=none" when
+ * no prefix contains the address, or " error=invalid".
+ *
+ * @param table: Table the route belongs to
+ * @param route: Lookup result (NULL = no match)
+ * @param valid: 0 if the input was not an address
+ * @param w: Destination with room for LPM_MAX_RESULT_LENGTH + label length
+ * @return: Number of bytes written
+ */
+size_t lpm_format_result(const LpmTable *table, const LpmRoute *route, int valid, char *w)
+{
+    char *start = w;
+
+    if (!valid) {
+        memcpy(w, " error=invalid", 14);
+        w += 14;
+    } else if (!route) {
+        memcpy(w, " match=none", 11);
+        w += 11;
+    } else {
+        memcpy(w, " match=", 7);
+        w += 7;
+        w += net_format_ipv4(route->network, w);
+        *w++ = '/';
+        if (route->prefix >= 10) *w++ = (char)('0' + route->prefix / 10);
+        *w++ = (char)('0' + route->prefix % 10);
+        if (route->label_len > 0) {
+            memcpy(w, " label=", 7);
+            w += 7;
+            memcpy(w, table->labels + route->label_offset, route->label_len);
+            w += route->label_len;
+        }
+    }
+    return (size_t)(w - start);
+}
+
+/*
+ * Looks up a block of parsed lines and writes one result line for each
+ */
+static void lpm_flush_block(const LpmTable *table, OutputBuffer *out,
+                            const LpmInputSlot *slots, size_t count)
+{
+    unsigned int ips[LPM_BLOCK_SIZE] = {0};
+    const LpmRoute *routes[LPM_BLOCK_SIZE];
+    NetIpv6 ips6[LPM_BLOCK_SIZE];
+    const Lpm6Route *routes6[LPM_BLOCK_SIZE];
+    size_t count6 = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        ips[i] = slots[i].valid && !slots[i].is_ipv6 ? slots[i].ip : 0;
+        if (slots[i].valid && slots[i].is_ipv6) ips6[count6++] = slots[i].ip6;
+    }
+    lpm_lookup_batch(table, ips, count, routes);
+    if (count6 > 0) lpm6_lookup_batch(&table->v6, ips6, count6, routes6);
+
+    for (size_t i = 0, i6 = 0; i < count; i++)
+    {
+        int ipv6_match = slots[i].valid && slots[i].is_ipv6;
+        const Lpm6Route *route6 = ipv6_match ? routes6[i6++] : NULL;
+        const LpmRoute *route = ipv6_match ? NULL : routes[i];
+        size_t label_len = route ? route->label_len : route6 ? route6->label_len : 0;
+
+        output_buffer_write(out, slots[i].text, slots[i].len);
+        char *w = output_buffer_reserve(out, LPM_MAX_RESULT_LENGTH + label_len);
+        size_t n = ipv6_match ? lpm6_format_result(&table->v6, route6, w)
+                              : lpm_format_result(table, route, slots[i].valid, w);
+        w[n] = '\n';
+        out->len += n + 1;
+    }
+}
+
+/*
+ * Runs longest-prefix-match lookups for every address in the input
+ *
+ * @param table_path: Text or compiled (--compile-table) route table
+ * @param input_path: Address list, or NULL / "-" for standard input
+ * @return: Process exit status (0 on success, 1 on load/read failure)
+ */
+int run_lpm_mode(const char *table_path, const char *input_path)
+{
+    LpmTable table;
+    LineReader reader;
+    OutputBuffer out;
+    LpmInputSlot slots[LPM_BLOCK_SIZE];
+    size_t count = 0;
+
+    if (!lpm_table_open(&table, table_path)) {
+        lpm_table_free(&table);
+        return 1;
+    }
+    fprintf(stderr, "✅ %s %zu prefixes from %s (%zu tbl8 groups)\n",
+            table.mapping ? "Mapped" : "Loaded", table.route_count, table_path, table.tbl8_groups);
+    if (table.v6.route_count > 0) {
+        fprintf(stderr, "✅ Loaded %zu IPv6 prefixes (%zu ranges)\n",
+                table.v6.route_count, table.v6.range_count);
+    }
+
+    if (!line_reader_open(&reader, input_path)) {
+        lpm_table_free(&table);
+        return 1;
+    }
+    if (!output_buffer_init(&out, STDOUT_FILENO, OUTPUT_BUFFER_SIZE)) {
+        line_reader_close(&reader);
+        lpm_table_free(&table);
+        return 1;
+    }
+
+    const char *line;
+    size_t len;
+    while (line_reader_next(&reader, &line, &len))
+    {
+        while (len > 0 && (*line == ' ' || *line == '\t')) { line++; len--; }
+        while (len > 0 && (line[len - 1] == ' ' || line[len - 1] == '\t')) len--;
+        if (len == 0 || *line == '#') continue;
+
+        // The line pointer is only valid until the next read, so keep a copy
+        LpmInputSlot *slot = &slots[count++];
+        slot->len = len < LPM_ECHO_MAX ? len : LPM_ECHO_MAX;
+        memcpy(slot->text, line, slot->len);
+
+        const char *p;
+        slot->is_ipv6 = memchr(line, ':', len) != NULL;
+        if (slot->is_ipv6) {
+            slot->valid = net_parse_ipv6_span_scalar(line, line + len, &slot->ip6, &p) == NET_OK &&
+                          p == line + len;
+        } else {
+            slot->valid = net_parse_ipv4_span(line, line + len, &slot->ip, &p) == NET_OK &&
+                          p == line + len;
+        }
+
+        if (count == LPM_BLOCK_SIZE) {
+            lpm_flush_block(&table, &out, slots, count);
+            count = 0;
+        }
+    }
+    if (count > 0) lpm_flush_block(&table, &out, slots, count);
+
+    int status = reader.error ? 1 : 0;
+    output_buffer_free(&out);
+    line_reader_close(&reader);
+    lpm_table_free(&table);
+    return status;
+}
@@ -32,6 +32,7 @@
  */
 
 #include "net.h"
+#include <unistd.h>  // For isatty()
 
 /*
  * Main program entry point
@@ -39,18 +40,68 @@
  */
 int main(int argc, char *argv[])
 {
+    unsigned long long start_ns = net_now_ns();
+    
     // Check for color preference
     if (getenv("NO_COLOR") != NULL) {
         set_theme(-1); // Disable colors
     }
     
-    // Check for theme selection
-    if (argc >= 3 && strcmp(argv[1], "--theme") == 0) {
-        int theme = atoi(argv[2]);
-        set_theme(theme);
-        argc -= 2;  // Remove theme arguments
+    // Global options come before the mode and are removed from argv:
+    // --theme <n>, --format <fmt>, --quiet/--fast, --verbose, --timing
+    int quiet = -1;  // -1 = decide from the terminal
+    while (argc >= 2)
+    {
+        int used = 0;
+        if (argc >= 3 && strcmp(argv[1], "--theme") == 0) {
+            set_theme(atoi(argv[2]));
+            used = 2;
+        }
+        else if (argc >= 3 && strcmp(argv[1], "--format") == 0) {
+            ResultFormat format;
+            if (!result_format_parse(argv[2], &format)) {
+                fprintf(stderr, "❌ Unknown format: %s (text, jsonl, csv or binary)\n", argv[2]);
+                return 1;
+            }
+            set_result_format(format);
+            used = 2;
+        }
+        else if (strcmp(argv[1], "--quiet") == 0 || strcmp(argv[1], "--fast") == 0) {
+            quiet = 1;
+            used = 1;
+        }
+        else if (strcmp(argv[1], "--verbose") == 0) {
+            quiet = 0;
+            used = 1;
+        }
+        else if (strcmp(argv[1], "--timing") == 0) {
+            result_timing_start(start_ns);
+            used = 1;
+        }
+        if (!used) break;
+        
+        argc -= used;  // Remove option arguments
         for (int i = 1; i < argc; i++) {
-            argv[i] = argv[i + 2];
+            argv[i] = argv[i + used];
+        }
+    }
+    
+    // Pipes and files get results only: no animations, boxes or traces
+    set_quiet_mode(quiet >= 0 ? quiet : !isatty(STDOUT_FILENO));
+    
+    // Modes without a result record keep their text output
+    if (get_result_format() != RESULT_FORMAT_TEXT && argc >= 2)
+    {
+        static const char *const text_modes[] = {
+            "--help", "--ipv6-convert", "--lpm", "--compile-table", "--daemon", "--monitor",
+            "--set-union", "--set-intersect", "--set-diff", "--enumerate",
+            "--vlsm", "--aggregate"
+        };
+        for (size_t i = 0; i < sizeof(text_modes) / sizeof(text_modes[0]); i++) {
+            if (strcmp(argv[1], text_modes[i]) == 0) {
+                fprintf(stderr, "⚠️  %s has no --format records; printing text\n", argv[1]);
+                set_result_format(RESULT_FORMAT_TEXT);
+            }
         }
     }
     
@@ -60,6 +111,8 @@ int main(int argc, char *argv[])
     
     if (argc == 1 || (argc == 2 && strcmp(argv[1], "--help") == 0))
     {
+        set_quiet_mode(0);  // The guide is always shown in full
+        
         // Beautiful help display
         draw_header_box("🌟 NETWORK CALCULATOR v3.0 🌟", "Educational Network Analysis Tool");
         
@@ -85,10 +138,28 @@ int main(int argc, char *argv[])
             "  ./net --discover <ip> [timeout]     → Service discovery scan",
             "  ./net --diagnose <ip>               → Comprehensive diagnostics",
             "",
+            "⚡ BULK MODES:",
+            "  ./net --batch [file]                → Analyze IP/CIDR lines (stdin)",
+            "  ./net --lpm <table> [file]          → Longest prefix match per IP",
+            "  ./net --compile-table <in> <out>    → Prebuild an mmap-able LPM table",
+            "  ./net --set-union <a> <b>           → CIDRs in either file (also",
+            "        --set-intersect, --set-diff)    in both / in a but not b)",
+            "  ./net --enumerate <cidr|a-b> [step] [skip] [seed] [--random] → Stream addresses",
+            "  ./net --vlsm <cidr> <file|n,n,...>  → Pack host requirements into subnets",
+            "  ./net --aggregate [file] [mem-MB]   → Minimal prefix list (supernetting)",
+            "  ./net --sweep <cidr> [ports] [n] [ms] → Parallel TCP sweep (--all)",
+            "  ./net --ping-sweep <cidr> [n] [ms] [pps] → Ping every host (--all)",
+            "  ./net --daemon <socket> [table] [n] [ms] → Serve requests on a Unix socket",
+            "  ./net --monitor <targets> [every] [ms] → Report up/down/latency changes",
+            "  ./net --format <jsonl|csv|binary> <mode> → Machine-readable records",
+            "  ./net --quiet <mode>                → Results only (default when piped)",
+            "  ./net --timing <mode>               → Report time to first result",
+            "",
             "💡 EXAMPLES:",
             "  ./net 255.255.255.0                 → Shows 0.0.0.0/24 range",
             "  ./net 192.168.1.100 255.255.255.0   → Shows 192.168.1.0/24",
             "  ./net --scan 192.168.1.0/24         → Scan network IPs",
+            "  ./net --split 2001:db8::/48 /64    → IPv6 /64 subnets of a /48",
             "  ./net --ping 8.8.8.8 4              → Ping Google DNS",
             "  ./net --tcp 192.168.1.1 22          → Check SSH port",
             "  ./net --discover 192.168.1.1        → Find open services",
@@ -115,8 +186,9 @@ int main(int argc, char *argv[])
         return 0;
     }
     
-    // Check for valid number of arguments (2-4 allowed, excluding help)
-    if (argc < 2 || argc > 4)
+    // Check for valid number of arguments (2-7 allowed, excluding help;
+    // --sweep takes the most optional arguments)
+    if (argc < 2 || argc > 7)
     {
         printf("❌ Invalid number of arguments!\n\n");
         printf("Usage: %s [--help | <subnet_mask> | <ip> <subnet_mask> | -l <ip> | --cidr <cidr> | --class <ip> | --check <ip> <cidr> | --convert <ip>]\n", argv[0]);
@@ -131,6 +203,8 @@ int main(int argc, char *argv[])
     // Check if user wants loopback analysis (format: ./net -l <ip>)
     if (argc == 3 && strcmp(argv[1], "-l") == 0)
     {
+        if (use_result_records()) return emit_network_result(argv[2]) ? 0 : 1;
+        
         printf("🔍 Starting Loopback Analysis...\n");
         printf("Target IP: %s\n\n", argv[2]);
         check_loopback_ip(argv[2]);
@@ -144,6 +218,8 @@ int main(int argc, char *argv[])
     // Check if user wants CIDR analysis (format: ./net --cidr <cidr>)
     if (argc == 3 && strcmp(argv[1], "--cidr") == 0)
     {
+        if (use_result_records()) return emit_network_result(argv[2]) ? 0 : 1;
+        
         printf("📡 Starting CIDR Network Analysis...\n");
         printf("Target CIDR: %s\n\n", argv[2]);
         analyze_cidr_network(argv[2]);
@@ -157,6 +233,8 @@ int main(int argc, char *argv[])
     // Check if user wants class analysis (format: ./net --class <ip>)
     if (argc == 3 && strcmp(argv[1], "--class") == 0)
     {
+        if (use_result_records()) return emit_network_result(argv[2]) ? 0 : 1;
+        
         printf("🏷️  Starting Network Class Analysis...\n");
         printf("Target IP: %s\n\n", argv[2]);
         classify_ip_address(argv[2]);
@@ -170,6 +248,8 @@ int main(int argc, char *argv[])
     // Check if user wants range validation (format: ./net --check <ip> <cidr>)
     if (argc == 4 && strcmp(argv[1], "--check") == 0)
     {
+        if (use_result_records()) return emit_check_result(argv[2], argv[3]) ? 0 : 1;
+        
         printf("🎯 Starting IP Range Validation...\n");
         printf("Target IP: %s, Network: %s\n\n", argv[2], argv[3]);
         validate_ip_in_range(argv[2], argv[3]);
@@ -183,6 +263,8 @@ int main(int argc, char *argv[])
     // Check if user wants format conversion (format: ./net --convert <ip>)
     if (argc == 3 && strcmp(argv[1], "--convert") == 0)
     {
+        if (use_result_records()) return emit_conversion_result(argv[2]) ? 0 : 1;
+        
         printf("🔄 Starting Multi-Format Conversion...\n");
         printf("Target IP: %s\n\n", argv[2]);
         convert_ip_formats(argv[2]);
@@ -196,6 +278,8 @@ int main(int argc, char *argv[])
     // Check if user wants network scanning (format: ./net --scan <cidr>)
     if (argc == 3 && strcmp(argv[1], "--scan") == 0)
     {
+        if (use_result_records()) return emit_network_result(argv[2]) ? 0 : 1;
+        
         show_loading_animation("🔍 Preparing Network Scanner", 600);
         draw_header_box("🌐 Network Range Scanner", argv[2]);
         scan_network_range(argv[2]);
@@ -206,11 +290,16 @@ int main(int argc, char *argv[])
     // MODE 7: SUBNET SPLITTER (--split flag)
     // ========================================================================
     
-    // Check if user wants subnet splitting (format: ./net --split <cidr> <num>)
+    // Check if user wants subnet splitting (format: ./net --split <cidr> <num|/len>)
     if (argc == 4 && strcmp(argv[1], "--split") == 0)
     {
         show_loading_animation("🔀 Initializing Subnet Splitter", 700);
         draw_header_box("🔀 VLSM Subnet Calculator", argv[2]);
+        // IPv6 prefixes also accept a target length ("/64") in place of a count
+        if (strchr(argv[2], ':')) {
+            split_ipv6_network(argv[2], argv[3]);
+            return 0;
+        }
         int num_subnets = atoi(argv[3]);
         split_network(argv[2], num_subnets);
         return 0;
@@ -223,8 +312,10 @@ int main(int argc, char *argv[])
     // Check if user wants IPv6 analysis (format: ./net --ipv6 <ipv6_address>)
     if (argc == 3 && strcmp(argv[1], "--ipv6") == 0)
     {
-        printf("🌐 Starting IPv6 Analyzer...\n");
-        printf("Target IPv6: %s\n\n", argv[2]);
+        if (use_result_records()) return emit_network6_result(argv[2]) ? 0 : 1;
+        
+        trace_printf("🌐 Starting IPv6 Analyzer...\n");
+        trace_printf("Target IPv6: %s\n\n", argv[2]);
         analyze_ipv6_address(argv[2]);
         return 0;
     }
@@ -236,8 +327,8 @@ int main(int argc, char *argv[])
     // Check if user wants IPv6 format conversion (format: ./net --ipv6-convert <ipv6>)
     if (argc == 3 && strcmp(argv[1], "--ipv6-convert") == 0)
     {
-        printf("🔄 Starting IPv6 Format Converter...\n");
-        printf("Target IPv6: %s\n\n", argv[2]);
+        trace_printf("🔄 Starting IPv6 Format Converter...\n");
+        trace_printf("Target IPv6: %s\n\n", argv[2]);
         convert_ipv6_formats(argv[2]);
         return 0;
     }
@@ -264,6 +355,7 @@ int main(int argc, char *argv[])
     {
         int count = (argc >= 4) ? atoi(argv[3]) : 4;     // Default 4 packets
         int timeout = (argc >= 5) ? atoi(argv[4]) : 5;   // Default 5 second timeout
+        if (use_result_records()) return emit_ping_result(argv[2], count, timeout) ? 0 : 1;
         perform_icmp_ping(argv[2], count, timeout);
         return 0;
     }
@@ -291,12 +383,225 @@ int main(int argc, char *argv[])
         return 0;
     }
 
+    // ========================================================================
+    // MODE 14: BULK BATCH ANALYSIS (--batch flag)
+    // ========================================================================
+    
+    // Check if user wants bulk analysis (format: ./net --batch [file])
+    if ((argc == 2 || argc == 3) && strcmp(argv[1], "--batch") == 0)
+    {
+        return run_batch_mode(argc == 3 ? argv[2] : NULL);
+    }
+
+    // ========================================================================
+    // MODE 15: LONGEST-PREFIX-MATCH LOOKUP (--lpm flag)
+    // ========================================================================
+    
+    // Check if user wants table lookups (format: ./net --lpm <table> [file])
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "--lpm") == 0)
+    {
+        return run_lpm_mode(argv[2], argc == 4 ? argv[3] : NULL);
+    }
+
+    // ========================================================================
+    // MODE 16: COMPILE PREFIX TABLE (--compile-table flag)
+    // ========================================================================
+    
+    // Check if user wants a compiled table (format: ./net --compile-table <in> <out>)
+    if (argc == 4 && strcmp(argv[1], "--compile-table") == 0)
+    {
+        return run_compile_table_mode(argv[2], argv[3]);
+    }
+
+    // ========================================================================
+    // MODE 17: PARALLEL HOST SWEEP (--sweep flag)
+    // ========================================================================
+    
+    // Check if user wants a network sweep
+    // (format: ./net --sweep <cidr> [ports|-] [in_flight] [timeout_ms] [--all])
+    if (argc >= 3 && strcmp(argv[1], "--sweep") == 0)
+    {
+        const char *positional[3] = {NULL, NULL, NULL};
+        int positional_count = 0;
+        int show_all = 0;
+        
+        for (int i = 3; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--all") == 0) show_all = 1;
+            else if (positional_count < 3) positional[positional_count++] = argv[i];
+        }
+        
+        // "-" keeps the default for that position
+        for (int i = 0; i < positional_count; i++)
+        {
+            if (strcmp(positional[i], "-") == 0) positional[i] = NULL;
+        }
+        
+        const char *ports = positional[0];
+        size_t in_flight = positional[1] ? (size_t)atol(positional[1]) : SWEEP_DEFAULT_INFLIGHT;
+        int timeout_ms = positional[2] ? atoi(positional[2]) : SWEEP_DEFAULT_TIMEOUT_MS;
+        return run_sweep_mode(argv[2], ports, in_flight, timeout_ms, show_all);
+    }
+
+    // ========================================================================
+    // MODE 18: CONCURRENT PING SWEEP (--ping-sweep flag)
+    // ========================================================================
+    
+    // Check if user wants to ping a whole network
+    // (format: ./net --ping-sweep <cidr> [count] [timeout_ms] [rate] [--all])
+    if (argc >= 3 && strcmp(argv[1], "--ping-sweep") == 0)
+    {
+        const char *positional[3] = {NULL, NULL, NULL};
+        int positional_count = 0;
+        int show_all = 0;
+        
+        for (int i = 3; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--all") == 0) show_all = 1;
+            else if (positional_count < 3) positional[positional_count++] = argv[i];
+        }
+        
+        // "-" keeps the default for that position
+        for (int i = 0; i < positional_count; i++)
+        {
+            if (strcmp(positional[i], "-") == 0) positional[i] = NULL;
+        }
+        
+        int count = positional[0] ? atoi(positional[0]) : PING_SWEEP_DEFAULT_COUNT;
+        int timeout_ms = positional[1] ? atoi(positional[1]) : PING_SWEEP_DEFAULT_TIMEOUT_MS;
+        unsigned int rate = positional[2] ? (unsigned int)atol(positional[2]) : PING_SWEEP_DEFAULT_RATE;
+        return run_ping_sweep_mode(argv[2], count, timeout_ms, rate, show_all);
+    }
+
+    // ========================================================================
+    // MODE 19: DIAGNOSTICS DAEMON (--daemon flag)
+    // ========================================================================
+    
+    // Check if user wants a long-running daemon on a local socket
+    // (format: ./net --daemon <socket_path> [table|-] [in_flight] [timeout_ms])
+    if (argc >= 3 && strcmp(argv[1], "--daemon") == 0)
+    {
+        const char *positional[3] = {NULL, NULL, NULL};
+        
+        // "-" keeps the default for that position
+        for (int i = 3; i < argc && i < 6; i++)
+        {
+            positional[i - 3] = strcmp(argv[i], "-") == 0 ? NULL : argv[i];
+        }
+        
+        size_t in_flight = positional[1] ? (size_t)atol(positional[1]) : SWEEP_DEFAULT_INFLIGHT;
+        int timeout_ms = positional[2] ? atoi(positional[2]) : SWEEP_DEFAULT_TIMEOUT_MS;
+        return run_daemon_mode(argv[2], positional[0], in_flight, timeout_ms);
+    }
+
+    // ========================================================================
+    // MODE 20: CONTINUOUS MONITORING (--monitor flag)
+    // ========================================================================
+    
+    // Check if user wants to watch a list of endpoints
+    // (format: ./net --monitor <targets_file> [interval|-] [timeout_ms])
+    if (argc >= 3 && strcmp(argv[1], "--monitor") == 0)
+    {
+        unsigned int interval_ms = MONITOR_DEFAULT_INTERVAL_MS;
+        int timeout_ms = MONITOR_DEFAULT_TIMEOUT_MS;
+        
+        // "-" keeps the default for that position (intervals as in the file: 500ms, 5s, 1m)
+        if (argc > 3 && strcmp(argv[3], "-") != 0)
+        {
+            interval_ms = monitor_parse_interval(argv[3], strlen(argv[3]));
+            if (interval_ms == 0)
+            {
+                fprintf(stderr, "❌ Invalid interval: %s\n", argv[3]);
+                return 1;
+            }
+        }
+        if (argc > 4 && strcmp(argv[4], "-") != 0) timeout_ms = atoi(argv[4]);
+        return run_monitor_mode(argv[2], interval_ms, timeout_ms);
+    }
+
+    // ========================================================================
+    // MODE 21: CIDR SET ALGEBRA (--set-union, --set-intersect, --set-diff)
+    // ========================================================================
+    
+    // Check if user wants to combine two CIDR lists (format: ./net --set-<op> <a> <b>)
+    if (argc == 4 && strncmp(argv[1], "--set-", 6) == 0)
+    {
+        static const struct { const char *name; IpSetOp op; } set_modes[] = {
+            {"--set-union",     IPSET_UNION},
+            {"--set-intersect", IPSET_INTERSECT},
+            {"--set-diff",      IPSET_DIFF},
+        };
+        for (size_t i = 0; i < sizeof(set_modes) / sizeof(set_modes[0]); i++) {
+            if (strcmp(argv[1], set_modes[i].name) == 0) {
+                return run_set_mode(set_modes[i].op, argv[2], argv[3]);
+            }
+        }
+    }
+
+    // ========================================================================
+    // MODE 22: ADDRESS ENUMERATION (--enumerate flag)
+    // ========================================================================
+    
+    // Check if user wants every address of a range
+    // (format: ./net --enumerate <cidr|first-last> [stride|-] [exclude|-] [seed|-] [--random])
+    if (argc >= 3 && strcmp(argv[1], "--enumerate") == 0)
+    {
+        const char *positional[3] = {NULL, NULL, NULL};
+        int positional_count = 0;
+        EnumOrder order = ENUM_ORDER_SEQUENTIAL;
+        
+        for (int i = 3; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--random") == 0) order = ENUM_ORDER_RANDOM;
+            else if (positional_count < 3) positional[positional_count++] = argv[i];
+        }
+        
+        // "-" keeps the default for that position
+        for (int i = 0; i < positional_count; i++)
+        {
+            if (strcmp(positional[i], "-") == 0) positional[i] = NULL;
+        }
+        
+        unsigned int stride = positional[0] ? (unsigned int)strtoul(positional[0], NULL, 10) : 1;
+        uint64_t seed = positional[2] ? strtoull(positional[2], NULL, 10) : net_now_ns();
+        return run_enumerate_mode(argv[2], stride, positional[1], order, seed);
+    }
+
+    // ========================================================================
+    // MODE 23: VLSM PLANNER (--vlsm flag)
+    // ========================================================================
+    
+    // Check if user wants host requirements packed into a block
+    // (format: ./net --vlsm <cidr> <requirements-file|-|n,n,...>)
+    if (argc == 4 && strcmp(argv[1], "--vlsm") == 0)
+    {
+        return run_vlsm_mode(argv[2], argv[3]);
+    }
+
+    // ========================================================================
+    // MODE 24: CIDR AGGREGATION (--aggregate flag)
+    // ========================================================================
+    
+    // Check if user wants a prefix list collapsed
+    // (format: ./net --aggregate [file|-] [memory-MB])
+    if (argc >= 2 && argc <= 4 && strcmp(argv[1], "--aggregate") == 0)
+    {
+        size_t memory_mb = argc == 4 ? (size_t)strtoul(argv[3], NULL, 10) : 0;
+        return run_aggregate_mode(argc >= 3 ? argv[2] : "-", memory_mb);
+    }
+
     // ========================================================================
     // MODE 6: BASIC SUBNET ANALYSIS (subnet mask only)
     // ========================================================================
     
     if (argc == 2)
     {
+        if (use_result_records()) {
+            // The 0.0.0.0 network of the mask, as one record
+            char input[RESULT_INPUT_MAX];
+            snprintf(input, sizeof(input), "0.0.0.0 %s", argv[1]);
+            return emit_network_result(input) ? 0 : 1;
+        }
         printf("📊 Starting Basic Subnet Analysis...\n");
         printf("Input: Subnet Mask = %s\n", argv[1]);
         printf("Network Base: 0.0.0.0 (for demonstration)\n\n");
@@ -316,6 +621,10 @@ int main(int argc, char *argv[])
     
     else if (argc == 3)
     {
+        if (use_result_records()) {
+            print_ip_range(argv[1], argv[2]);  // One record, no trace
+            return 0;
+        }
         printf("🌐 Starting Complete Network Analysis...\n");
         printf("Input: IP = %s, Subnet Mask = %s\n\n", argv[1], argv[2]);
         
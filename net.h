@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <stdint.h>
 
 /*
  * ============================================================================
@@ -34,9 +36,11 @@
 char *dec_to_binary(int nb);
 
 // Parses subnet mask string (e.g., "255.255.255.0") into integer array
-// Input: String like "255.255.255.0"
-// Output: Array of 4 integers [255, 255, 255, 0] or NULL if invalid
-int *prepar_mask(char *input);
+// Reentrant: results go to caller storage, the input is not modified
+// Input: Mask string, array of 4 ints, optional prefix length output
+// Output: mask_out filled with [255, 255, 255, 0], or NULL if invalid
+//         (invalid includes masks whose ones are not contiguous)
+int *prepar_mask(const char *input, int *mask_out, int *prefix_out);
 
 // Converts integer mask array to a single 32-bit binary string
 // Input: Array of 4 integers representing octets
@@ -85,6 +89,192 @@ unsigned int calculate_network_address(unsigned int ip, unsigned int mask);
 // Output: Broadcast address as 32-bit integer
 unsigned int calculate_broadcast_address(unsigned int network, unsigned int mask);
 
+// ============================================================================
+// CORE CONVERSION API - SILENT AND ALLOCATION-FREE (net_core.c)
+// ============================================================================
+// These primitives never print and never allocate. Results are written to
+// caller-provided storage and errors are reported as NetStatus codes.
+// The educational functions above are thin wrappers around them.
+
+// Longest dotted-quad text "255.255.255.255" plus NUL terminator
+#define NET_IPV4_STRLEN 16
+
+// Status codes returned by the core API
+typedef enum
+{
+    NET_OK = 0,          // Success
+    NET_ERR_NULL,        // Missing (NULL) argument
+    NET_ERR_FORMAT,      // Malformed text (wrong separators, missing digits)
+    NET_ERR_RANGE,       // Value out of range (octet > 255, prefix > 32)
+    NET_ERR_MASK,        // Subnet mask ones are not contiguous
+    NET_ERR_BUFFER       // Destination buffer too small
+} NetStatus;
+
+// Returns a short description of a status code
+const char *net_status_string(NetStatus status);
+
+// Parses a NUL-terminated dotted quad like "192.168.1.1"
+// Uses the SSE4.1/AVX2 parser when available (ip_parse_simd.c)
+// Output: NET_OK and the 32-bit address in *out, or an error code
+NetStatus net_parse_ipv4(const char *str, unsigned int *out);
+
+// Parses a dotted quad at the start of [str, end) without requiring a NUL
+// *stop receives the position just after the address (for "ip/len", "ip mask")
+NetStatus net_parse_ipv4_span(const char *str, const char *end,
+                              unsigned int *out, const char **stop);
+
+// Scalar reference implementations of the two parsers above
+NetStatus net_parse_ipv4_scalar(const char *str, unsigned int *out);
+NetStatus net_parse_ipv4_span_scalar(const char *str, const char *end,
+                                     unsigned int *out, const char **stop);
+
+// Converts an array of NUL-terminated strings to 32-bit addresses
+// Invalid entries produce 0 in out[] and an error in status[] (may be NULL)
+// Output: Number of valid addresses
+size_t net_parse_ipv4_batch(const char *const *strs, size_t count,
+                            unsigned int *out, NetStatus *status);
+
+// Name of the parser selected at startup: "avx2", "sse4.1" or "scalar"
+// Set NET_SIMD=0 in the environment to force the scalar parser
+const char *net_parse_ipv4_backend(void);
+
+// Parses a dotted subnet mask in one pass, rejecting holes in the ones
+// Reentrant: writes only to caller storage (any output may be NULL)
+// Output: NET_OK with octets, 32-bit mask and prefix length, or an error
+NetStatus net_parse_mask(const char *str, int *octets_out,
+                         unsigned int *mask_out, int *prefix_out);
+
+// Parses CIDR notation "A.B.C.D/N" into address and prefix length
+NetStatus net_parse_cidr(const char *str, unsigned int *ip_out, int *prefix_out);
+
+// Parses "A.B.C.D/N" (or a bare address as /32) inside [str, end)
+// Output: NET_OK, with end_out set to the first character after the prefix
+NetStatus net_parse_cidr_span(const char *str, const char *end, unsigned int *ip_out,
+                              int *prefix_out, const char **end_out);
+
+// Formats a 32-bit address into buf (at least NET_IPV4_STRLEN bytes)
+// Output: Length of the text written, excluding the NUL terminator
+size_t net_format_ipv4(unsigned int ip, char *buf);
+
+// Renders up to 'count' consecutive addresses starting at 'first' as
+// "A.B.C.D\n" lines into buf, stopping early when buf is full
+// Output: Bytes written; *rendered receives the number of addresses written
+size_t net_format_ipv4_range(unsigned int first, unsigned long long count,
+                             char *buf, size_t size, unsigned long long *rendered);
+
+// Writes the 8-bit binary form of an octet into buf (at least 9 bytes)
+void net_octet_to_binary(unsigned int octet, char *buf);
+
+// Writes the 32-bit binary form of a value into buf (at least 33 bytes)
+void net_mask_to_binary(unsigned int value, char *buf);
+
+// Copies src into dst of the given size
+// Output: NET_OK, or NET_ERR_BUFFER if it does not fit (nothing copied)
+NetStatus net_copy_string(const char *src, char *dst, size_t size);
+
+// Converts a subnet mask to prefix length (-1 if ones are not contiguous)
+int net_mask_to_prefix(unsigned int mask);
+
+// Network = IP AND Mask, Broadcast = Network OR ~Mask
+unsigned int net_network_address(unsigned int ip, unsigned int mask);
+unsigned int net_broadcast_address(unsigned int network, unsigned int mask);
+
+// ============================================================================
+// PREFIX LENGTH TABLE (prefix_table.c)
+// ============================================================================
+// Everything derived from a prefix length, precomputed for /0 through /32.
+
+#define NET_PREFIX_COUNT 33
+
+typedef struct
+{
+    unsigned int mask;            // 32-bit subnet mask
+    unsigned int wildcard;        // ~mask (host bits)
+    char dotted[NET_IPV4_STRLEN]; // "255.255.255.0"
+    char binary[33];              // 32 '0'/'1' characters
+    unsigned long long total;     // Addresses in the block (2^host_bits)
+    unsigned long long usable;    // Host addresses (RFC 3021 for /31)
+} PrefixInfo;
+
+// Read-only table indexed by prefix length 0-32
+extern const PrefixInfo NET_PREFIX_TABLE[NET_PREFIX_COUNT];
+
+// Returns the table entry for a prefix length, or NULL if not 0-32
+const PrefixInfo *net_prefix_info(int prefix);
+
+// Converts a prefix length to its 32-bit mask without any string step
+NetStatus net_prefix_to_mask(int prefix, unsigned int *mask_out);
+
+// ============================================================================
+// IPv6 CORE - 128-BIT PARSING, FORMATTING AND ARITHMETIC (ipv6_core.c)
+// ============================================================================
+
+// Longest text form: "ffff:ffff:ffff:ffff:ffff:ffff:255.255.255.255" + NUL
+#define NET_IPV6_STRLEN 46
+
+// 128-bit address as two host-order halves (hi = groups 0-3)
+typedef struct
+{
+    uint64_t hi;
+    uint64_t lo;
+} NetIpv6;
+
+// Parses a NUL-terminated address ("2001:db8::1", "::ffff:192.0.2.1")
+// Uses the SSE2 hex path when available, the scalar parser otherwise
+// Output: NET_OK and the address in *out, or an error code
+NetStatus net_parse_ipv6(const char *str, NetIpv6 *out);
+
+// Scalar reference parsers; the span form stops at the first character
+// that cannot continue the address ('/', '%', space) and reports it in *stop
+NetStatus net_parse_ipv6_scalar(const char *str, NetIpv6 *out);
+NetStatus net_parse_ipv6_span_scalar(const char *str, const char *end,
+                                     NetIpv6 *out, const char **stop);
+
+// Parses "addr/len"; a bare address is a /128. The span form works on
+// unterminated lines and reports the position after the prefix
+NetStatus net_parse_ipv6_cidr(const char *str, NetIpv6 *out, int *prefix_out);
+NetStatus net_parse_ipv6_cidr_span(const char *str, const char *end, NetIpv6 *out,
+                                   int *prefix_out, const char **end_out);
+
+// RFC 5952 canonical text (buf: NET_IPV6_STRLEN bytes) and the fully
+// expanded 39-character form
+// Output: Length written, excluding the NUL terminator
+size_t net_format_ipv6(const NetIpv6 *ip, char *buf);
+size_t net_format_ipv6_full(const NetIpv6 *ip, char *buf);
+
+// Prefix arithmetic: mask, first and last address of the /prefix
+NetIpv6 net_ipv6_mask(int prefix);
+NetIpv6 net_ipv6_network(const NetIpv6 *ip, int prefix);
+NetIpv6 net_ipv6_last(const NetIpv6 *ip, int prefix);
+NetIpv6 net_ipv6_add(const NetIpv6 *ip, uint64_t offset);
+NetIpv6 net_ipv6_sub(const NetIpv6 *ip, uint64_t offset);
+int net_ipv6_compare(const NetIpv6 *a, const NetIpv6 *b);
+int net_ipv6_in_prefix(const NetIpv6 *ip, const NetIpv6 *network, int prefix);
+
+// Lazy subnet enumeration: the /new_prefix subnets of network/prefix in
+// ascending order, one per call, without materializing the list
+typedef struct
+{
+    NetIpv6 next;               // Network of the next subnet
+    NetIpv6 last;               // Network of the final subnet
+    int prefix;                 // Subnet prefix length
+    int done;
+} NetIpv6SubnetIter;
+
+void net_ipv6_subnets_begin(NetIpv6SubnetIter *it, const NetIpv6 *network, int prefix, int new_prefix);
+int net_ipv6_subnets_next(NetIpv6SubnetIter *it, NetIpv6 *subnet);
+
+// Subnet number index (from 0) of length new_prefix, computed directly
+NetIpv6 net_ipv6_subnet(const NetIpv6 *network, int prefix, int new_prefix, uint64_t index);
+
+// IPv4 carried by ::ffff:0:0/96 or 64:ff9b::/96
+// Output: 1 with *ipv4 set, 0 if the address embeds none
+int net_ipv6_embedded_ipv4(const NetIpv6 *ip, unsigned int *ipv4);
+
+// "unspecified", "loopback", "ipv4-mapped", "nat64", "documentation",
+// "link-local", "unique-local", "multicast", "global-unicast" or "reserved"
+const char *net_ipv6_type(const NetIpv6 *ip);
+
 // ============================================================================
 // ANALYSIS AND DISPLAY FUNCTIONS
 // ============================================================================
@@ -110,6 +300,10 @@ void print_mask_info(const char *mask_str);
 // Input: Network IP string and subnet mask string
 void print_ip_range(const char *network_ip, const char *mask_str);
 
+// Same analysis as print_ip_range for CIDR input, mask from NET_PREFIX_TABLE
+// Input: IP string and prefix length (1-32)
+void print_ip_range_cidr(const char *network_ip, int prefix_len);
+
 // Prints IP range information using 0.0.0.0 as base network
 // Useful for understanding subnet sizing without specific network
 // Input: Subnet mask string
@@ -135,9 +329,10 @@ void check_loopback_ip(const char *ip_str);
 // Output: 1 if valid, 0 if invalid
 int parse_cidr_notation(const char *cidr_str, char *ip_out, int *prefix_len);
 
-// Converts CIDR prefix length to subnet mask string
+// Converts CIDR prefix length to subnet mask string (educational trace)
 // Input: Prefix length (0-32)
 // Output: Dynamically allocated subnet mask string (must be freed)
+// Note: CIDR code paths use NET_PREFIX_TABLE instead of this string
 char *cidr_to_subnet_mask(int prefix_len);
 
 // Complete CIDR network analysis
@@ -189,12 +384,32 @@ void analyze_ipv6_address(const char *ipv6_str);
 // Input: IPv6 address string
 void convert_ipv6_formats(const char *ipv6_str);
 
+// Formats the size of a prefix: 2^(128 - prefix) in full up to 2^63,
+// "2^N" beyond
+void format_ipv6_count(int prefix, char *buf, size_t size);
+
+// IPv6 side of --check, --scan and --split (ipv6_analysis.c); the IPv4
+// modes hand over any input containing ':'
+void validate_ipv6_in_range(const char *ip_str, const char *cidr_str);
+void scan_ipv6_range(const char *cidr_str);
+
+// Splits into /N subnets, given as "/N" or a power-of-two count
+void split_ipv6_network(const char *cidr_str, const char *split_str);
+
 // Enhanced output formatting functions (output_formatter.c)
 // Terminal color and theme support
 int terminal_supports_colors(void);
 void print_colored(const char *color, const char *format, ...);
 void set_theme(int theme);
 
+// Quiet profile (--quiet/--fast, automatic when stdout is not a terminal):
+// animations, decorative boxes and trace lines are skipped
+void set_quiet_mode(int quiet);
+int is_quiet_mode(void);
+
+// printf() for educational trace lines, silent in the quiet profile
+#define trace_printf(...) do { if (!is_quiet_mode()) printf(__VA_ARGS__); } while (0)
+
 // Beautiful box drawing and headers
 void draw_header_box(const char *title, const char *subtitle);
 void draw_info_box(const char *title, const char **lines, int line_count);
@@ -227,8 +442,25 @@ int check_tcp_connectivity(const char *ip, int port, int timeout_sec);
 // Output: 1 if at least one reply received, 0 if all failed
 int perform_icmp_ping(const char *ip, int packet_count, int timeout_sec);
 
+// One's complement checksum of an ICMP message (RFC 1071)
+unsigned short calculate_icmp_checksum(void *data, int len);
+
+// Well-known service port with its display name
+typedef struct
+{
+    const char *name;
+    int port;
+} CommonPort;
+
+// Returns the table of well-known service ports scanned by default
+// Output: Pointer to the table, count receives the number of entries
+const CommonPort *get_common_ports(size_t *count);
+
+// Returns the service name of a well-known port, or NULL
+const char *common_port_name(unsigned int port);
+
 // Service discovery scanner - tests common ports for open services
-// Uses non-blocking sockets to rapidly scan well-known service ports
+// Probes all ports in parallel through the epoll connect scanner
 // Educational trace shows TCP handshake states and port status classification
 // Input: IP address string, timeout in seconds for each connection
 void scan_services_in_range(const char *ip, int timeout_sec);
@@ -239,4 +471,936 @@ void scan_services_in_range(const char *ip, int timeout_sec);
 // Input: Target IP address string
 void generate_diagnostics_report(const char *ip);
 
+// ============================================================================
+// STREAMING I/O - BUFFERED READER AND WRITER (stream_io.c)
+// ============================================================================
+
+// Buffer sizes used by the bulk modes (large chunks = few system calls)
+#define LINE_READER_BUFFER_SIZE (1 << 20)
+#define OUTPUT_BUFFER_SIZE      (1 << 20)
+
+// Buffered line reader over a file descriptor
+// Lines are returned in place (no copy, no per-line allocation)
+typedef struct
+{
+    int fd;          // Source file descriptor
+    char *buf;       // Read buffer
+    size_t cap;      // Buffer capacity
+    size_t start;    // Offset of the next unread byte
+    size_t end;      // Offset one past the last valid byte
+    int eof;         // 1 once read() reported end of input
+    int error;       // 1 if read() failed (eof is set too)
+    int skip_line;   // 1 while discarding the rest of an overlong line
+} LineReader;
+
+// Buffered writer that flushes to a file descriptor in large chunks
+typedef struct
+{
+    int fd;          // Destination file descriptor
+    char *buf;       // Pending output
+    size_t len;      // Bytes pending
+    size_t cap;      // Buffer capacity
+} OutputBuffer;
+
+// Opens a reader on a file path, or on stdin when path is NULL or "-"
+// Output: 1 if successful, 0 on failure
+int line_reader_open(LineReader *reader, const char *path);
+
+// Returns the next line (without '\n') through line/len
+// Output: 1 if a line was returned, 0 at end of input or on a read error
+// (reader->error tells them apart)
+int line_reader_next(LineReader *reader, const char **line, size_t *len);
+
+// Releases the reader buffer and closes the file (stdin stays open)
+void line_reader_close(LineReader *reader);
+
+// Output buffer lifecycle and writes
+int output_buffer_init(OutputBuffer *out, int fd, size_t cap);
+void output_buffer_write(OutputBuffer *out, const char *data, size_t len);
+char *output_buffer_reserve(OutputBuffer *out, size_t n);
+void output_buffer_flush(OutputBuffer *out);
+void output_buffer_free(OutputBuffer *out);
+
+// ============================================================================
+// RESULT SINK - MACHINE-READABLE OUTPUT (result_sink.c)
+// ============================================================================
+
+#define RESULT_INPUT_MAX        64           // Echoed input bytes, including the NUL
+#define RESULT_MAX_FIELDS       32           // Fields per schema (omit mask width)
+#define RESULT_MAX_RECORD       1024         // Longest serialized record
+#define RESULT_BINARY_MAGIC     "NETR"
+#define RESULT_BINARY_VERSION   1
+
+// Output format selected with --format (text = each mode's own output)
+typedef enum
+{
+    RESULT_FORMAT_TEXT,
+    RESULT_FORMAT_JSONL,
+    RESULT_FORMAT_CSV,
+    RESULT_FORMAT_BINARY
+} ResultFormat;
+
+typedef enum
+{
+    RESULT_FIELD_U32,            // unsigned int
+    RESULT_FIELD_U64,            // unsigned long long
+    RESULT_FIELD_F64,            // double
+    RESULT_FIELD_IPV4,           // unsigned int, host byte order
+    RESULT_FIELD_STR,            // const char * (NULL = absent)
+    RESULT_FIELD_CHARS           // char[width], NUL-terminated
+} ResultFieldType;
+
+// One member of a result struct
+typedef struct
+{
+    const char *name;
+    ResultFieldType type;
+    size_t offset;               // offsetof() in the result struct
+    unsigned int width;          // Bytes in a binary record
+} ResultField;
+
+// Describes how to serialize one result struct
+typedef struct
+{
+    const char *name;            // Record type ("network", "service", ...)
+    unsigned short id;           // Binary record type
+    const ResultField *fields;
+    size_t field_count;
+    size_t binary_size;          // Sum of the field widths
+} ResultSchema;
+
+// Buffered serializer; the writer is chosen by the format at open time
+typedef struct ResultSink
+{
+    ResultFormat format;
+    OutputBuffer out;
+    const ResultSchema *header_schema;   // Schema of the last CSV header
+    void (*write)(struct ResultSink *sink, const ResultSchema *schema,
+                  const void *record, unsigned int omit);
+} ResultSink;
+
+// Address or network analysis (--cidr, "ip mask", --batch)
+typedef struct
+{
+    char input[RESULT_INPUT_MAX];
+    unsigned int ip;
+    const char *net_class;
+    const char *type;
+    unsigned int network;
+    unsigned int prefix;
+    unsigned int mask;
+    unsigned int broadcast;
+    unsigned int first;
+    unsigned int last;
+    unsigned long long usable;
+    const char *error;
+} NetworkResult;
+
+// Omit mask bits of NetworkResult (bit n = field n left out)
+#define NETWORK_RESULT_RANGE    0x7F0u       // network through usable
+#define NETWORK_RESULT_ERROR    0x800u
+#define NETWORK_RESULT_ADDRESS  0x00Eu       // ip, class, type
+
+// One TCP connection attempt (--tcp, --discover, --sweep)
+typedef struct
+{
+    unsigned int ip;
+    unsigned int port;
+    const char *state;
+    const char *service;         // NULL when the port is not a known service
+    unsigned long long rtt_ns;
+} ServiceResult;
+
+// Echo statistics of one host (--ping-sweep)
+typedef struct
+{
+    unsigned int ip;
+    unsigned int sent;
+    unsigned int received;
+    double loss_pct;
+    unsigned long long rtt_min_ns;
+    unsigned long long rtt_avg_ns;
+    unsigned long long rtt_max_ns;
+    unsigned long long jitter_ns;
+} PingResult;
+
+#define PING_RESULT_RTT         0xF0u        // Omitted when nothing answered
+
+// Address membership test (--check)
+typedef struct
+{
+    unsigned int ip;
+    unsigned int network;
+    unsigned int prefix;
+    unsigned int in_range;       // 1 if the address belongs to the network
+} CheckResult;
+
+// Address notations (--convert)
+typedef struct
+{
+    unsigned int ip;
+    unsigned int value;          // 32-bit integer form
+    char hex[11];                // "0xC0A80101"
+    char binary[36];             // "11000000.10101000.00000001.00000001"
+} ConversionResult;
+
+// IPv6 address or prefix analysis (--cidr, --scan, --split, --ipv6)
+typedef struct
+{
+    char input[RESULT_INPUT_MAX];
+    char ip[NET_IPV6_STRLEN];    // RFC 5952 form
+    const char *type;            // net_ipv6_type() label
+    char network[NET_IPV6_STRLEN];
+    unsigned int prefix;
+    char last[NET_IPV6_STRLEN];
+    unsigned int host_bits;      // The prefix holds 2^host_bits addresses
+    unsigned int ipv4;           // Embedded IPv4 (mapped or NAT64)
+    const char *error;
+} Network6Result;
+
+// Omit mask bits of Network6Result (bit n = field n left out)
+#define NETWORK6_RESULT_IPV4    0x080u
+#define NETWORK6_RESULT_ERROR   0x100u
+#define NETWORK6_RESULT_VALUES  0x0FEu       // ip through ipv4
+
+// IPv6 address membership test (--check)
+typedef struct
+{
+    char ip[NET_IPV6_STRLEN];
+    char network[NET_IPV6_STRLEN];
+    unsigned int prefix;
+    unsigned int in_range;
+} Check6Result;
+
+extern const ResultSchema RESULT_SCHEMA_NETWORK;
+extern const ResultSchema RESULT_SCHEMA_SERVICE;
+extern const ResultSchema RESULT_SCHEMA_PING;
+extern const ResultSchema RESULT_SCHEMA_CHECK;
+extern const ResultSchema RESULT_SCHEMA_CONVERSION;
+extern const ResultSchema RESULT_SCHEMA_NETWORK6;
+extern const ResultSchema RESULT_SCHEMA_CHECK6;
+
+// Global output format (set from --format in main)
+void set_result_format(ResultFormat format);
+ResultFormat get_result_format(void);
+
+// 1 when modes should write result records instead of their trace
+// (a machine format was selected, or the quiet profile is active)
+int use_result_records(void);
+
+// Reports the delay from start_ns to the first record on stderr (--timing)
+void result_timing_start(unsigned long long start_ns);
+
+// Parses "text", "jsonl", "csv" or "binary"
+// Output: 1 if recognized, 0 otherwise
+int result_format_parse(const char *name, ResultFormat *format);
+
+// Sink lifecycle: open on a descriptor, emit records, close (flushes)
+// omit: bit n set = field n of the schema is absent from this record
+int result_sink_open(ResultSink *sink, ResultFormat format, int fd);
+void result_sink_emit(ResultSink *sink, const ResultSchema *schema,
+                      const void *record, unsigned int omit);
+void result_sink_flush(ResultSink *sink);
+void result_sink_close(ResultSink *sink);
+
+// Analyzes one IP, CIDR or "ip mask" input and writes it as a single record
+// (IPv6 addresses and prefixes give a network6 record)
+// Output: 1 if the input was valid, 0 otherwise (an error record is still written)
+int emit_network_result(const char *input);
+
+// Single-record forms of --check and --convert (--check also takes IPv6)
+// Output: 1 if successful, 0 if the input is invalid (error on stderr)
+int emit_check_result(const char *ip_str, const char *cidr_str);
+int emit_conversion_result(const char *ip_str);
+
+// Writes an IPv6 address or prefix as a single network6 record
+// Output: 1 if the input was valid, 0 otherwise (an error record is still written)
+int emit_network6_result(const char *input);
+
+// Fills a Network6Result for one IPv6 address or prefix (ipv6_analysis.c)
+// Output: Omit mask for result_sink_emit() (error field set when invalid)
+unsigned int network6_result_parse(const char *line, size_t len, Network6Result *result);
+
+// ============================================================================
+// BATCH MODE - BULK IP / CIDR ANALYSIS (batch_mode.c)
+// ============================================================================
+
+// Longest result suffix appended after an echoed input line
+#define BATCH_MAX_RESULT_LENGTH 256
+
+// Formats the result fields for one IP, CIDR or "ip mask" input (no newline)
+// Output: Bytes written (at most BATCH_MAX_RESULT_LENGTH)
+size_t batch_format_result(const char *line, size_t len, char *w);
+
+// Fills a NetworkResult for one IP, CIDR or "ip mask" input
+// Output: Omit mask for result_sink_emit() (error field set when invalid)
+unsigned int network_result_parse(const char *line, size_t len, NetworkResult *result);
+
+// Analyzes newline-delimited IPs, CIDRs or "ip mask" pairs in one process
+// Emits one compact key=value result line per input line
+// Input: File path, or NULL / "-" for standard input
+// Output: Process exit status (0 on success)
+int run_batch_mode(const char *path);
+
+// ============================================================================
+// BULK ADDRESS CLASSIFICATION (ip_classify.c)
+// ============================================================================
+
+// Category code of an address: class in the low nibble, type in the high
+// nibble. The same answers as get_network_class() and check_loopback_ip().
+#define NET_CLASS_RESERVED      0            // 0.0.0.0/8
+#define NET_CLASS_A             1
+#define NET_CLASS_B             2
+#define NET_CLASS_C             3
+#define NET_CLASS_D             4            // Multicast
+#define NET_CLASS_E             5            // Reserved (240.0.0.0/4)
+#define NET_CLASS_LOOPBACK      6            // 127.0.0.0/8
+
+#define NET_TYPE_PUBLIC         0
+#define NET_TYPE_LOOPBACK       1            // 127.0.0.0/8
+#define NET_TYPE_PRIVATE        2            // RFC 1918
+#define NET_TYPE_LINK_LOCAL     3            // 169.254.0.0/16
+#define NET_TYPE_MULTICAST      4            // 224.0.0.0/4
+#define NET_TYPE_RESERVED       5            // 240.0.0.0/4
+
+#define NET_CATEGORY_CLASS(code) ((code) & 0x0F)
+#define NET_CATEGORY_TYPE(code)  ((code) >> 4)
+
+#define CLASSIFY_MIN_CHUNK      (1U << 16)   // Fewer addresses per thread is not worth a thread
+
+// Category code of one address (branch-free)
+unsigned char net_classify_ipv4(unsigned int ip);
+
+// Writes the category code of count addresses to codes[], split over
+// up to 'threads' threads (0 = one per online CPU)
+void net_classify_ipv4_bulk(const unsigned int *ips, size_t count,
+                            unsigned char *codes, int threads);
+
+// Compact labels of a category code, as printed by --batch:
+// class "A"-"E", "loopback" or "reserved"; type "public", "private", ...
+const char *net_class_label(unsigned char code);
+const char *net_type_label(unsigned char code);
+
+// Kernel selected at startup: "avx2" or "scalar" (NET_SIMD=0 forces scalar)
+const char *net_classify_backend(void);
+
+// ============================================================================
+// IP SETS - INTERVAL LISTS WITH BITMAP BLOCKS (ip_set.c)
+// ============================================================================
+
+#define IPSET_BITMAP_WORDS        1024         // 65536 bits: one /16 block
+#define IPSET_DENSE_RUNS          512          // More runs in a /16 than this → bitmap
+#define IPSET_MAX_REPORTED_ERRORS 10           // Invalid input lines printed
+
+typedef enum
+{
+    IPSET_UNION,
+    IPSET_INTERSECT,
+    IPSET_DIFF
+} IpSetOp;
+
+// One segment: a run of addresses (bits == NULL), or a /16 block bitmap
+// covering first..last (bits has IPSET_BITMAP_WORDS words)
+typedef struct
+{
+    unsigned int first;
+    unsigned int last;           // Inclusive
+    uint64_t *bits;
+} IpSetSegment;
+
+// Sorted, disjoint segments
+typedef struct
+{
+    IpSetSegment *segments;
+    size_t count;
+    size_t capacity;
+} IpSet;
+
+// Reads a set back as ascending runs
+typedef struct
+{
+    const IpSet *set;
+    size_t segment;              // Current segment
+    unsigned int offset;         // Next bit of a bitmap segment
+} IpSetIter;
+
+// Set lifecycle: runs are appended in ascending order, then packed
+void ip_set_init(IpSet *set);
+void ip_set_free(IpSet *set);
+int ip_set_append(IpSet *set, unsigned int first, unsigned int last);
+void ip_set_compact(IpSet *set);
+
+// Loads CIDRs / addresses from a file (any order, overlaps allowed)
+// Output: 1 if successful, 0 on failure; *prefixes = valid lines read
+int ip_set_load(IpSet *set, const char *path, size_t *prefixes);
+
+void ip_set_iter_init(IpSetIter *iter, const IpSet *set);
+int ip_set_iter_next(IpSetIter *iter, unsigned int *first, unsigned int *last);
+
+int ip_set_contains(const IpSet *set, unsigned int ip);
+unsigned long long ip_set_size(const IpSet *set);
+
+// a ∪ b, a ∩ b or a \ b into an initialized, empty set, in O(n + m)
+// Output: 1 if successful, 0 on allocation failure
+int ip_set_combine(const IpSet *a, const IpSet *b, IpSetOp op, IpSet *out);
+
+// Prints first..last as its minimal CIDR cover, one prefix per line
+// Output: Number of prefixes written
+size_t ip_range_write_cidrs(OutputBuffer *out, unsigned int first, unsigned int last);
+
+// Prints the set as its minimal CIDR cover, one prefix per line
+// Output: Number of prefixes written
+size_t ip_set_write_cidrs(const IpSet *set, OutputBuffer *out);
+
+// --set-union / --set-intersect / --set-diff over two CIDR files
+// Output: Process exit status (0 on success)
+int run_set_mode(IpSetOp op, const char *path_a, const char *path_b);
+
+// ============================================================================
+// STREAMING ADDRESS ENUMERATION (ip_enumerate.c)
+// ============================================================================
+
+#define ENUM_BATCH_SIZE      4096    // Addresses generated per batch
+#define ENUM_FEISTEL_ROUNDS  4       // Rounds of the random-order permutation
+
+typedef enum
+{
+    ENUM_ORDER_SEQUENTIAL,
+    ENUM_ORDER_RANDOM
+} EnumOrder;
+
+// Constant-memory walk over first, first + stride, ... up to last
+typedef struct
+{
+    unsigned int first;          // First address of the range
+    unsigned int stride;         // Distance between visited addresses (>= 1)
+    uint64_t count;              // Positions in the range (up to 2^32)
+    uint64_t next;               // Next position, or next Feistel index (random)
+    EnumOrder order;
+    unsigned int half_bits;      // Feistel half width: domain is 2^(2 * half_bits)
+    uint32_t keys[ENUM_FEISTEL_ROUNDS];
+    const IpSet *exclude;        // Addresses skipped, or NULL
+    IpSetIter exclude_iter;      // Excluded runs still ahead (sequential order)
+    unsigned int exclude_first;  // Current excluded run
+    unsigned int exclude_last;
+    int exclude_pending;         // 1 while exclude_first..exclude_last is valid
+} NetEnumerator;
+
+void net_enum_init(NetEnumerator *it, unsigned int first, unsigned int last,
+                   unsigned int stride, EnumOrder order, uint64_t seed, const IpSet *exclude);
+
+// Output: Addresses written to out (0 once the walk is complete)
+size_t net_enum_next_batch(NetEnumerator *it, unsigned int *out, size_t max);
+
+// Next run of consecutive addresses (whole runs for sequential stride 1)
+// Output: 1 if a run was returned, 0 once the walk is complete
+int net_enum_next_run(NetEnumerator *it, unsigned int *first, uint64_t *count);
+
+// --enumerate: prints every address of a CIDR or "first-last" range
+// Output: Process exit status (0 on success)
+int run_enumerate_mode(const char *range, unsigned int stride, const char *exclude_path,
+                       EnumOrder order, uint64_t seed);
+
+// ============================================================================
+// CIDR AGGREGATION (cidr_aggregate.c)
+// ============================================================================
+
+#define AGGREGATE_MEMORY_MB     256          // Default sort memory before spilling to disk
+
+// --aggregate: collapses a CIDR list into its minimal equivalent prefix list
+// Output: Process exit status (0 on success)
+int run_aggregate_mode(const char *path, size_t memory_mb);
+
+// ============================================================================
+// VLSM PLANNER (vlsm_plan.c)
+// ============================================================================
+
+// --vlsm: one subnet per host requirement, packed by a best-fit buddy allocator
+// Output: Process exit status (0 if every requirement was placed)
+int run_vlsm_mode(const char *parent, const char *requirements);
+
+// ============================================================================
+// LONGEST-PREFIX-MATCH TABLE - IPv6 RANGES (lpm6_table.c)
+// ============================================================================
+
+#define LPM6_INDEX_BITS     16                       // Index on the top 16 bits
+#define LPM6_INDEX_ENTRIES  (1U << LPM6_INDEX_BITS)
+
+// One IPv6 prefix of the table
+typedef struct
+{
+    NetIpv6 network;            // Network address (host bits cleared)
+    unsigned int prefix;        // Prefix length 0-128
+    unsigned int label_offset;  // Label position in the label arena
+    unsigned int label_len;     // Label length (0 = no label)
+} Lpm6Route;
+
+// Route list plus the sorted ranges and /16 index built from it
+typedef struct
+{
+    NetIpv6 *starts;            // First address of each range, ascending
+    unsigned int *routes_of_ranges; // Route number per range (0 = none)
+    size_t range_count;
+    unsigned int *index;        // Range holding the first address of each /16
+    Lpm6Route *routes;          // All routes, in load order
+    size_t route_count;
+    size_t route_capacity;
+    char *labels;               // Label bytes of all routes
+    size_t labels_len;
+    size_t labels_capacity;
+} Lpm6Table;
+
+// Table lifecycle: init, add routes, build, then look up
+void lpm6_table_init(Lpm6Table *table);
+NetStatus lpm6_table_add(Lpm6Table *table, const NetIpv6 *ip, int prefix,
+                         const char *label, size_t label_len);
+int lpm6_table_build(Lpm6Table *table);
+void lpm6_table_free(Lpm6Table *table);
+
+// Returns the longest prefix containing ip, or NULL if none does
+const Lpm6Route *lpm6_lookup(const Lpm6Table *table, const NetIpv6 *ip);
+void lpm6_lookup_batch(const Lpm6Table *table, const NetIpv6 *ips, size_t count,
+                       const Lpm6Route **routes_out);
+
+// Formats " match=<net>/<len> label=<label>" or " match=none"
+size_t lpm6_format_result(const Lpm6Table *table, const Lpm6Route *route, char *w);
+
+// ============================================================================
+// LONGEST-PREFIX-MATCH TABLE - DIR-24-8 (lpm_table.c)
+// ============================================================================
+
+#define LPM_TBL24_ENTRIES       (1U << 24)   // One entry per /24
+#define LPM_TBL8_GROUP_SIZE     256          // One entry per address of a /24
+#define LPM_TBL8_MAX_GROUPS     (1U << 24)   // At most one group per /24
+#define LPM_TBL8_FLAG           0x80000000U  // tbl24 entry points to a tbl8 group
+#define LPM_MAX_REPORTED_ERRORS 10           // Invalid table lines printed
+#define LPM_ECHO_MAX            64           // Input bytes echoed per result
+#define LPM_MAX_RESULT_LENGTH   64           // Result suffix, excluding label
+
+// One prefix of the table
+typedef struct
+{
+    unsigned int network;       // Network address (host bits cleared)
+    unsigned int prefix;        // Prefix length 0-32
+    unsigned int label_offset;  // Label position in the label arena
+    unsigned int label_len;     // Label length (0 = no label)
+} LpmRoute;
+
+// Route list plus the two-level lookup arrays built from it
+typedef struct
+{
+    unsigned int *tbl24;        // Route number or tbl8 group per /24
+    unsigned int *tbl8;         // 256-entry groups for prefixes /25-/32
+    size_t tbl8_groups;         // Groups in use
+    size_t tbl8_capacity;       // Groups allocated
+    LpmRoute *routes;           // All routes, in load order
+    size_t route_count;
+    size_t route_capacity;
+    char *labels;               // Label bytes of all routes
+    size_t labels_len;
+    size_t labels_capacity;
+    void *mapping;              // Compiled table file mapping (read-only), or NULL
+    size_t mapping_size;
+    Lpm6Table v6;               // IPv6 routes (text tables only)
+} LpmTable;
+
+// Table lifecycle: init, add routes, build, then look up
+void lpm_table_init(LpmTable *table);
+NetStatus lpm_table_add(LpmTable *table, unsigned int ip, int prefix,
+                        const char *label, size_t label_len);
+int lpm_table_build(LpmTable *table);
+void lpm_table_free(LpmTable *table);
+
+// Stages "CIDR [label]" lines from a text file (read) and builds (load)
+// Output: 1 if successful, 0 on failure
+int lpm_table_read(LpmTable *table, const char *path);
+int lpm_table_load(LpmTable *table, const char *path);
+
+// Returns the longest prefix containing ip, or NULL if none does
+const LpmRoute *lpm_lookup(const LpmTable *table, unsigned int ip);
+
+// Looks up count addresses with overlapping memory accesses
+void lpm_lookup_batch(const LpmTable *table, const unsigned int *ips, size_t count,
+                      const LpmRoute **routes_out);
+
+// Formats " match=<net>/<len> label=<label>", " match=none" or " error=invalid"
+// Output: Bytes written (at most LPM_MAX_RESULT_LENGTH + label length)
+size_t lpm_format_result(const LpmTable *table, const LpmRoute *route, int valid, char *w);
+
+// Reports the longest matching prefix for every address in the input
+// Input: Table file, address file or NULL / "-" for standard input
+// Output: Process exit status (0 on success)
+int run_lpm_mode(const char *table_path, const char *input_path);
+
+// ============================================================================
+// COMPILED LPM TABLE FILES (lpm_file.c)
+// ============================================================================
+
+#define LPM_FILE_MAGIC      "NETLPM\0\0"  // 8 bytes at offset 0
+#define LPM_FILE_VERSION    1
+#define LPM_FILE_BYTE_ORDER 0x01020304U   // Written natively, checked on map
+
+// Fixed header at the start of a compiled table; offsets are in bytes
+typedef struct
+{
+    char magic[8];
+    unsigned int version;
+    unsigned int byte_order;
+    unsigned long long route_count;
+    unsigned long long tbl8_groups;
+    unsigned long long labels_len;
+    unsigned long long routes_offset;
+    unsigned long long tbl24_offset;
+    unsigned long long tbl8_offset;
+    unsigned long long labels_offset;
+    unsigned long long file_size;
+} LpmFileHeader;
+
+// Sorts staged routes and drops duplicate prefixes (last one wins)
+// Output: Number of duplicates removed, or -1 on allocation failure
+long lpm_table_dedup(LpmTable *table);
+
+// Writes a built table to a compiled file (atomic rename)
+int lpm_table_save(const LpmTable *table, const char *path);
+
+// Maps a compiled file read-only; the table cannot be modified afterwards
+int lpm_table_map(LpmTable *table, const char *path);
+
+// Maps a compiled file or loads a text table, based on its first bytes
+int lpm_table_open(LpmTable *table, const char *path);
+
+// Compiles a text table into a binary table file
+// Output: Process exit status (0 on success)
+int run_compile_table_mode(const char *input_path, const char *output_path);
+
+// ============================================================================
+// TIMER WHEEL - O(1) DEADLINES AND SCHEDULES (timer_wheel.c)
+// ============================================================================
+
+#define TIMER_WHEEL_DEFAULT_SLOTS 256
+#define TIMER_WHEEL_LEVELS        4      // Level n slots span slot_count^n ticks
+
+// Intrusive timer: embed in the structure that owns the deadline
+typedef struct TimerNode
+{
+    struct TimerNode *next;      // NULL when not scheduled
+    struct TimerNode *prev;
+    unsigned long long expires;  // Deadline tick
+} TimerNode;
+
+// Hierarchical wheel: TIMER_WHEEL_LEVELS rings of slot_count lists
+typedef struct
+{
+    TimerNode *slots;            // List sentinels, level by level
+    size_t slot_count;           // Per level, a power of two
+    unsigned int slot_bits;      // log2(slot_count)
+    unsigned int tick_ms;
+    unsigned long long current_tick;
+    size_t active;               // Scheduled timers
+} TimerWheel;
+
+typedef void (*TimerCallback)(TimerNode *node, void *context);
+
+int timer_wheel_init(TimerWheel *wheel, size_t slot_count, unsigned int tick_ms,
+                     unsigned long long now_ms);
+void timer_wheel_add(TimerWheel *wheel, TimerNode *node, unsigned long long deadline_ms);
+void timer_wheel_remove(TimerWheel *wheel, TimerNode *node);
+size_t timer_wheel_advance(TimerWheel *wheel, unsigned long long now_ms,
+                           TimerCallback expire, void *context);
+void timer_wheel_free(TimerWheel *wheel);
+
+// ============================================================================
+// NETWORK SWEEP - EPOLL / IO_URING CONNECT SCANNER (network_sweep.c, sweep_uring.c)
+// ============================================================================
+
+#define SWEEP_DEFAULT_INFLIGHT   1024
+#define SWEEP_DEFAULT_TIMEOUT_MS 1000
+#define SWEEP_TICK_MS            10     // Deadline resolution
+#define SWEEP_WHEEL_SLOTS        256    // Level 0 = 2.56 s
+#define SWEEP_EVENT_BATCH        256    // epoll events per wakeup
+#define SWEEP_RESERVED_FDS       32     // Descriptors kept free for the process
+#define SWEEP_MAX_RESULT_LENGTH  96
+#define SWEEP_URING_MAX_ENTRIES  32768  // Kernel limit on submission queue size
+
+// Connect scanner engine
+typedef enum
+{
+    SWEEP_BACKEND_AUTO,  // io_uring when supported, else epoll
+    SWEEP_BACKEND_EPOLL,
+    SWEEP_BACKEND_URING
+} SweepBackend;
+
+// Outcome of one connection attempt
+typedef enum
+{
+    SWEEP_OPEN,          // Handshake completed
+    SWEEP_CLOSED,        // Refused (RST)
+    SWEEP_TIMEOUT,       // No answer before the deadline (filtered)
+    SWEEP_UNREACHABLE,   // Host or network unreachable (ICMP)
+    SWEEP_ERROR          // Local failure (descriptors, ports, ...)
+} SweepState;
+
+typedef struct
+{
+    unsigned int ip;             // Host byte order
+    unsigned short port;
+    SweepState state;
+    int error;                   // errno-style code (0 when open)
+    void *tag;                   // Caller's value from connect_scanner_submit_tagged()
+    unsigned long long rtt_ns;   // Time from submission to the outcome
+} SweepResult;
+
+// Called for every finished attempt; must not submit new targets
+typedef void (*SweepCallback)(const SweepResult *result, void *context);
+
+// One in-flight attempt (timer must stay the first member)
+typedef struct
+{
+    TimerNode timer;
+    int fd;
+    unsigned int ip;
+    unsigned short port;
+    unsigned long long start_ns;
+    void *tag;
+} SweepConnection;
+
+typedef struct
+{
+    SweepBackend backend;        // Resolved backend (never AUTO after init)
+    int epfd;                    // epoll instance (can be nested in an outer loop), -1 on io_uring
+    void *uring;                 // io_uring state (sweep_uring.c), NULL on epoll
+    SweepConnection *connections;
+    unsigned int *free_slots;    // Stack of unused connection slots
+    size_t free_count;
+    size_t max_inflight;
+    size_t inflight;
+    int timeout_ms;
+    TimerWheel wheel;
+    SweepCallback callback;
+    void *context;
+    size_t submitted;
+    size_t completed;
+    size_t open_count;
+} ConnectScanner;
+
+// Scanner lifecycle: init, submit targets, run_once until drained, free
+int connect_scanner_init(ConnectScanner *scanner, size_t max_inflight, int timeout_ms,
+                         SweepCallback callback, void *context);
+int connect_scanner_init_backend(ConnectScanner *scanner, SweepBackend backend, size_t max_inflight,
+                                 int timeout_ms, SweepCallback callback, void *context);
+int connect_scanner_submit(ConnectScanner *scanner, unsigned int ip, unsigned short port);
+int connect_scanner_submit_tagged(ConnectScanner *scanner, unsigned int ip, unsigned short port, void *tag);
+
+// Descriptor that becomes readable when the scanner has work (for an outer epoll loop)
+int connect_scanner_fd(const ConnectScanner *scanner);
+size_t connect_scanner_run_once(ConnectScanner *scanner, int max_wait_ms);
+void connect_scanner_drain(ConnectScanner *scanner);
+void connect_scanner_free(ConnectScanner *scanner);
+
+// Text label of a state ("open", "closed", "timeout", ...)
+const char *sweep_state_string(SweepState state);
+const char *sweep_backend_string(SweepBackend backend);
+
+// Shared by the scanner backends
+SweepState sweep_state_from_errno(int error);
+void sweep_report(ConnectScanner *scanner, SweepConnection *conn, SweepState state, int error);
+void sweep_release(ConnectScanner *scanner, SweepConnection *conn);
+void sweep_close(SweepConnection *conn, SweepState state);
+
+// io_uring backend (sweep_uring.c); init returns 0 if the kernel lacks support
+int sweep_uring_init(ConnectScanner *scanner);
+int sweep_uring_submit(ConnectScanner *scanner, SweepConnection *conn);
+size_t sweep_uring_run_once(ConnectScanner *scanner, int max_wait_ms);
+int sweep_uring_fd(const ConnectScanner *scanner);
+void sweep_uring_free(ConnectScanner *scanner);
+
+// Parses "22,80,8000-8100" into a malloc'd port array (NULL = common ports)
+// Output: Number of ports, 0 if the list is invalid
+size_t parse_port_list(const char *spec, unsigned short **ports_out);
+
+// Sweeps every usable host of a CIDR × a port list, streaming results
+// Output: Process exit status (0 on success)
+int run_sweep_mode(const char *cidr_str, const char *port_spec, size_t max_inflight,
+                   int timeout_ms, int show_all);
+
+// ============================================================================
+// RTT HISTOGRAM - NANOSECOND TIMING AND LATENCY PERCENTILES (rtt_histogram.c)
+// ============================================================================
+
+#define RTT_HISTOGRAM_SUB_BITS  7      // 64 sub-buckets per power of two: < 1.6% error
+#define RTT_HISTOGRAM_BUCKETS   ((1 << RTT_HISTOGRAM_SUB_BITS) + \
+                                 (64 - RTT_HISTOGRAM_SUB_BITS) * (1 << (RTT_HISTOGRAM_SUB_BITS - 1)))
+#define NET_DURATION_STRLEN     24     // "18446744073.710 s" + NUL, with room
+
+// Log-linear histogram of round-trip times in nanoseconds
+typedef struct
+{
+    unsigned long long counts[RTT_HISTOGRAM_BUCKETS];
+    unsigned long long total;
+    unsigned long long sum_ns;
+    unsigned long long min_ns;
+    unsigned long long max_ns;
+    unsigned long long last_ns;  // Previous sample, for jitter
+    double jitter_ns;            // RFC 3550 smoothed |RTT(i) - RTT(i-1)|
+} RttHistogram;
+
+struct msghdr;
+
+// Monotonic clock in nanoseconds
+unsigned long long net_now_ns(void);
+
+// Kernel receive time (SO_TIMESTAMPNS) of a message on the monotonic clock, else now_ns
+unsigned long long net_rx_timestamp_ns(const struct msghdr *msg, unsigned long long now_ns);
+
+// "850 ns", "41.3 us", "12.48 ms", "1.503 s"
+char *net_format_duration(unsigned long long ns, char *out);
+
+void rtt_histogram_init(RttHistogram *hist);
+void rtt_histogram_record(RttHistogram *hist, unsigned long long ns);
+void rtt_histogram_merge(RttHistogram *dst, const RttHistogram *src);
+unsigned long long rtt_histogram_percentile(const RttHistogram *hist, double percentile);
+unsigned long long rtt_histogram_mean(const RttHistogram *hist);
+
+// "n=.. min=.. p50=.. p90=.. p99=.. p99.9=.. max=.. jitter=.."
+int rtt_histogram_summary(const RttHistogram *hist, char *out, size_t size);
+
+// Multi-line report for the diagnostics modes
+void rtt_histogram_print(const RttHistogram *hist);
+
+// ============================================================================
+// PING SWEEP - CONCURRENT MULTI-TARGET ICMP ECHO (ping_sweep.c)
+// ============================================================================
+
+#define PING_SWEEP_DEFAULT_COUNT      3
+#define PING_SWEEP_MAX_COUNT          64     // One bit per attempt in received_mask
+#define PING_SWEEP_DEFAULT_TIMEOUT_MS 1000
+#define PING_SWEEP_DEFAULT_RATE       10000  // Packets per second
+#define PING_SWEEP_INTERVAL_MS        1000   // Minimum gap between rounds to one host
+#define PING_SWEEP_BATCH              64     // Requests per pacing step, replies per recvmmsg()
+#define PING_SWEEP_MAX_RESULT_LENGTH  160
+#define PING_SWEEP_WINDOW             (1 << 18)  // Hosts held in memory per pass (~18 MB of targets)
+#define PING_MAGIC                    0x4E455450u  // "NETP"
+#define PING_ECHO_REQUEST             8
+#define PING_ECHO_REPLY               0
+
+// Echo request as sent; for replies the same bytes follow the IP header (raw)
+typedef struct
+{
+    uint8_t type;
+    uint8_t code;
+    uint16_t checksum;
+    uint16_t id;
+    uint16_t seq;
+    uint32_t magic;
+    uint32_t run_id;             // Rejects replies addressed to other pingers
+    uint32_t index;              // Target index
+    uint32_t attempt;
+    uint64_t sent_ns;            // net_now_ns() at send time
+} __attribute__((packed)) PingPacket;
+
+// Per-target statistics (sent by the sending thread, the rest by the receive thread)
+typedef struct
+{
+    unsigned int ip;                     // Host byte order
+    unsigned int sent;
+    unsigned int received;
+    unsigned int duplicates;
+    unsigned long long received_mask;    // Bit n = reply to attempt n seen
+    unsigned long long rtt_sum_ns;
+    unsigned long long rtt_min_ns;
+    unsigned long long rtt_max_ns;
+    unsigned long long last_rtt_ns;
+    double jitter_ns;                    // RFC 3550 estimator
+} PingTarget;
+
+typedef struct
+{
+    int fd;                      // Shared ICMP socket
+    int raw;                     // 1 = SOCK_RAW, 0 = unprivileged ping socket
+    unsigned short ident;        // Echo identifier (raw sockets only)
+    unsigned int run_id;         // Rejects replies addressed to other pingers
+    PingTarget *targets;
+    size_t target_count;
+    size_t target_capacity;      // Room allocated by multi_pinger_init()
+    int count;                   // Echo requests per target
+    int timeout_ms;
+    unsigned int rate;           // Packets per second
+    int stop;                    // Set to end the receive thread
+    pthread_t receiver;
+    size_t replies;
+    size_t late;                 // Replies after the timeout
+    size_t foreign;              // Replies that matched no request
+    size_t send_errors;
+    RttHistogram rtt;            // Every reply of the run (receive thread)
+} MultiPinger;
+
+// Opens a ping socket, or a raw ICMP socket if ping sockets are not allowed
+// Output: Descriptor (*raw_out = 1 for raw), or -1 with an error printed
+int ping_open_socket(int *raw_out);
+
+// Parses a received datagram as one of our echo replies (PING_MAGIC)
+// Output: 1 with *reply filled in, 0 for anything else
+int ping_parse_reply(const unsigned char *data, size_t len, int raw, PingPacket *reply);
+
+// Pinger lifecycle: init with targets, run one pass, read targets, free
+// (ips = NULL only reserves room; multi_pinger_set_range() then fills it per pass)
+int multi_pinger_init(MultiPinger *pinger, const unsigned int *ips, size_t target_count,
+                      int count, int timeout_ms, unsigned int rate);
+void multi_pinger_set_range(MultiPinger *pinger, unsigned int first, size_t target_count);
+int multi_pinger_run(MultiPinger *pinger);
+void multi_pinger_free(MultiPinger *pinger);
+
+// Pings every usable host of a CIDR, printing loss and RTT per host
+// Output: Process exit status (0 on success)
+int run_ping_sweep_mode(const char *cidr_str, int count, int timeout_ms, unsigned int rate, int show_all);
+
+// Pings one host and writes a single PingResult record
+// Output: 1 if the host answered, 0 otherwise
+int emit_ping_result(const char *ip_str, int count, int timeout_sec);
+
+// ============================================================================
+// DIAGNOSTICS DAEMON - LINE PROTOCOL ON A UNIX SOCKET (net_daemon.c)
+// ============================================================================
+
+#define DAEMON_MAX_CLIENTS    256
+#define DAEMON_TAG_MAX        32           // Request tag, including the NUL
+#define DAEMON_LINE_MAX       4096         // Longest accepted request line
+#define DAEMON_REPLY_MAX      512          // Formatted reply text
+#define DAEMON_READ_SIZE      16384
+#define DAEMON_MAX_PENDING    (64u << 20)  // Unread output before a client is dropped
+#define DAEMON_EVENT_BATCH    64
+#define DAEMON_FEED_QUANTUM   256          // Targets one job submits per turn
+
+// Serves PING/ANALYZE/LPM/LOAD/TCP/SWEEP/STATS requests until SHUTDOWN or a signal
+// Output: Process exit status (0 on clean shutdown)
+int run_daemon_mode(const char *socket_path, const char *table_path, size_t max_inflight, int timeout_ms);
+
+// ============================================================================
+// MONITOR - SCHEDULED PROBES WITH STATE-CHANGE OUTPUT (net_monitor.c)
+// ============================================================================
+
+#define MONITOR_DEFAULT_INTERVAL_MS  5000
+#define MONITOR_DEFAULT_TIMEOUT_MS   1000
+#define MONITOR_MIN_INTERVAL_MS      100
+#define MONITOR_TICK_MS              10     // Schedule resolution
+#define MONITOR_WHEEL_SLOTS          256    // Level 0 = 2.56 s, level 1 = 11 min, ...
+#define MONITOR_JITTER_PERCENT       10     // Every interval varies by ±10%
+#define MONITOR_WINDOW               20     // Rolling window of probes per target
+#define MONITOR_DOWN_AFTER           3      // Consecutive failures → down
+#define MONITOR_UP_AFTER             2      // Consecutive successes → up again
+#define MONITOR_DEGRADED_LOSS_PCT    20     // Window loss → degraded
+#define MONITOR_LATENCY_FACTOR       2      // Median RTT ×2 or ÷2 → latency event
+#define MONITOR_LATENCY_MIN_DELTA_US 1000   // ... if it moved by at least 1 ms
+#define MONITOR_LATENCY_MIN_SAMPLES  5      // Successful probes before comparing
+#define MONITOR_NAME_MAX             64
+
+// Parses "250ms", "5s", "2m", "1h" or a bare number of seconds
+// Output: Milliseconds, or 0 if invalid
+unsigned int monitor_parse_interval(const char *text, size_t len);
+
+// Probes every target of a file at its own interval until SIGINT/SIGTERM,
+// printing one line per state change (up/down/degraded/latency)
+// Output: Process exit status (0 on success)
+int run_monitor_mode(const char *path, unsigned int default_interval_ms, int timeout_ms);
+
 #endif // NET_H
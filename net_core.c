@@ -0,0 +1,499 @@
+/*
+ * ============================================================================
+ * CORE CONVERSION API - SILENT, ALLOCATION-FREE PRIMITIVES
+ * ============================================================================
+ *
+ * This file contains the quiet building blocks behind the educational
+ * conversion functions. They use the same mathematics as ip_to_int(),
+ * int_to_ip() and friends, but:
+ * - never print anything
+ * - never allocate memory (results go into caller-provided buffers)
+ * - report errors through NetStatus codes instead of messages
+ *
+ * The educational functions in ip_conversion.c and bin_mask.c are thin
+ * wrappers that call these primitives and then print their trace, so both
+ * paths always produce identical results.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+
+/*
+ * ============================================================================
+ * STATUS REPORTING
+ * ============================================================================
+ */
+
+/*
+ * Returns a short human-readable description of a status code
+ *
+ * @param status: Status returned by a core function
+ * @return: Constant description string
+ */
+const char *net_status_string(NetStatus status)
+{
+    switch (status)
+    {
+        case NET_OK:         return "success";
+        case NET_ERR_NULL:   return "missing input";
+        case NET_ERR_FORMAT: return "malformed input";
+        case NET_ERR_RANGE:  return "value out of range";
+        case NET_ERR_MASK:   return "non-contiguous subnet mask";
+        case NET_ERR_BUFFER: return "output buffer too small";
+    }
+    return "unknown error";
+}
+
+/*
+ * ============================================================================
+ * IPv4 PARSING
+ * ============================================================================
+ */
+
+/*
+ * Parses a dotted-quad address at the start of a character range
+ *
+ * Formula: IP = A×256³ + B×256² + C×256¹ + D×256⁰
+ * Each octet is 1-3 decimal digits with a value of 0-255. Parsing stops
+ * after the fourth octet; the caller decides what may follow.
+ *
+ * This is the reference (scalar) implementation. net_parse_ipv4_span()
+ * in ip_parse_simd.c uses a vector path when the CPU allows it and falls
+ * back here for anything unusual, so both always agree.
+ *
+ * @param str: First character of the address
+ * @param end: One past the last readable character
+ * @param out: Receives the 32-bit address
+ * @param stop: Receives a pointer just past the address (may be NULL)
+ * @return: NET_OK, NET_ERR_FORMAT or NET_ERR_RANGE
+ */
+NetStatus net_parse_ipv4_span_scalar(const char *str, const char *end,
+                                     unsigned int *out, const char **stop)
+{
+    unsigned int result = 0;
+    const char *p = str;
+
+    for (int octet_index = 0; octet_index < 4; octet_index++)
+    {
+        if (octet_index > 0) {
+            if (p >= end || *p != '.') return NET_ERR_FORMAT;
+            p++;
+        }
+
+        unsigned int octet = 0;
+        int digits = 0;
+        while (p < end && *p >= '0' && *p <= '9' && digits < 3) {
+            octet = octet * 10 + (unsigned int)(*p - '0');
+            p++;
+            digits++;
+        }
+        if (digits == 0) return NET_ERR_FORMAT;
+        if (p < end && *p >= '0' && *p <= '9') return NET_ERR_RANGE;  // 4+ digits
+        if (octet > 255) return NET_ERR_RANGE;
+
+        result = result * 256 + octet;
+    }
+
+    *out = result;
+    if (stop) *stop = p;
+    return NET_OK;
+}
+
+/*
+ * Parses a complete NUL-terminated dotted-quad address (scalar reference)
+ *
+ * @param str: Address string like "192.168.1.1"
+ * @param out: Receives the 32-bit address
+ * @return: NET_OK, or an error code if the string is not exactly one address
+ */
+NetStatus net_parse_ipv4_scalar(const char *str, unsigned int *out)
+{
+    if (!str || !out) return NET_ERR_NULL;
+
+    const char *stop;
+    NetStatus status = net_parse_ipv4_span_scalar(str, str + strlen(str), out, &stop);
+    if (status != NET_OK) return status;
+
+    return (*stop == '\0') ? NET_OK : NET_ERR_FORMAT;
+}
+
+/*
+ * Parses CIDR notation "A.B.C.D/N" into an address and prefix length
+ *
+ * @param str: NUL-terminated CIDR string
+ * @param ip_out: Receives the 32-bit address (host bits are kept)
+ * @param prefix_out: Receives the prefix length 0-32
+ * @return: NET_OK, or an error code describing the problem
+ */
+NetStatus net_parse_cidr(const char *str, unsigned int *ip_out, int *prefix_out)
+{
+    if (!str || !ip_out || !prefix_out) return NET_ERR_NULL;
+
+    const char *end = str + strlen(str);
+    const char *p;
+    NetStatus status = net_parse_ipv4_span(str, end, ip_out, &p);
+    if (status != NET_OK) return status;
+    if (*p != '/') return NET_ERR_FORMAT;
+    p++;
+
+    int prefix = 0;
+    int digits = 0;
+    while (*p >= '0' && *p <= '9' && digits < 3) {
+        prefix = prefix * 10 + (*p - '0');
+        p++;
+        digits++;
+    }
+    if (digits == 0 || *p != '\0') return NET_ERR_FORMAT;
+    if (prefix > 32) return NET_ERR_RANGE;
+
+    *prefix_out = prefix;
+    return NET_OK;
+}
+
+/*
+ * Parses "A.B.C.D/N" or a bare "A.B.C.D" inside a bounded buffer
+ *
+ * Used by the bulk loaders, whose lines are not NUL-terminated and may
+ * carry more fields after the prefix. A bare address means /32.
+ *
+ * @param str: First character to parse
+ * @param end: One past the last character available
+ * @param ip_out: Receives the address (host bits are kept as given)
+ * @param prefix_out: Receives the prefix length 0-32
+ * @param end_out: Receives the position after the prefix (may be NULL)
+ * @return: NET_OK, NET_ERR_FORMAT or NET_ERR_RANGE
+ */
+NetStatus net_parse_cidr_span(const char *str, const char *end, unsigned int *ip_out,
+                              int *prefix_out, const char **end_out)
+{
+    if (!str || !end || !ip_out || !prefix_out) return NET_ERR_NULL;
+
+    const char *p;
+    NetStatus status = net_parse_ipv4_span(str, end, ip_out, &p);
+    if (status != NET_OK) return status;
+
+    int prefix = 32;
+    if (p < end && *p == '/') {
+        int digits = 0;
+        prefix = 0;
+        p++;
+        while (p < end && *p >= '0' && *p <= '9' && digits < 3) {
+            prefix = prefix * 10 + (*p - '0');
+            p++;
+            digits++;
+        }
+        if (digits == 0) return NET_ERR_FORMAT;
+        if (prefix > 32 || (p < end && *p >= '0' && *p <= '9')) return NET_ERR_RANGE;
+    }
+
+    *prefix_out = prefix;
+    if (end_out) *end_out = p;
+    return NET_OK;
+}
+
+/*
+ * Parses and validates a dotted subnet mask in a single pass
+ *
+ * Reentrant replacement for the old strtok()-based parsing: nothing is
+ * static and the input is never modified, so any number of threads can
+ * parse masks at the same time.
+ *
+ * While reading the octets left to right the parser is in one of two
+ * states: "still in the ones" (every octet so far was 255) or "in the
+ * zeros". The first octet that is not 255 must be a contiguous run of
+ * ones (0, 128, 192, 224, 240, 248, 252, 254) and every octet after it
+ * must be 0. The prefix length is the sum of the one bits seen.
+ *
+ * @param str: Mask string like "255.255.255.192"
+ * @param octets_out: Receives the 4 octets (may be NULL)
+ * @param mask_out: Receives the 32-bit mask (may be NULL)
+ * @param prefix_out: Receives the prefix length 0-32 (may be NULL)
+ * @return: NET_OK, NET_ERR_FORMAT, NET_ERR_RANGE or NET_ERR_MASK
+ */
+NetStatus net_parse_mask(const char *str, int *octets_out,
+                         unsigned int *mask_out, int *prefix_out)
+{
+    if (!str) return NET_ERR_NULL;
+
+    const char *p = str;
+    unsigned int mask = 0;
+    int octets[4];
+    int prefix = 0;
+    int in_ones = 1;
+
+    for (int octet_index = 0; octet_index < 4; octet_index++)
+    {
+        if (octet_index > 0) {
+            if (*p != '.') return NET_ERR_FORMAT;
+            p++;
+        }
+
+        unsigned int octet = 0;
+        int digits = 0;
+        while (*p >= '0' && *p <= '9' && digits < 3) {
+            octet = octet * 10 + (unsigned int)(*p - '0');
+            p++;
+            digits++;
+        }
+        if (digits == 0) return NET_ERR_FORMAT;
+        if ((*p >= '0' && *p <= '9') || octet > 255) return NET_ERR_RANGE;
+
+        if (in_ones) {
+            // Inverse of a contiguous octet is 2^n - 1: adding 1 clears all its bits
+            unsigned int inverse = 255 - octet;
+            if (inverse & (inverse + 1)) return NET_ERR_MASK;
+            prefix += 8 - __builtin_popcount(inverse);
+            if (octet != 255) in_ones = 0;
+        } else if (octet != 0) {
+            return NET_ERR_MASK;  // a one after the zeros started
+        }
+
+        octets[octet_index] = (int)octet;
+        mask = mask * 256 + octet;
+    }
+    if (*p != '\0') return NET_ERR_FORMAT;
+
+    if (octets_out) memcpy(octets_out, octets, sizeof(octets));
+    if (mask_out) *mask_out = mask;
+    if (prefix_out) *prefix_out = prefix;
+    return NET_OK;
+}
+
+/*
+ * ============================================================================
+ * IPv4 FORMATTING
+ * ============================================================================
+ */
+
+/*
+ * Precomputed text for every octet value, each followed by a dot
+ *
+ * Every entry is exactly 4 bytes, so an octet is emitted with one fixed-size
+ * copy and no division: the digits land in place, the dot lands right after
+ * them, and the write position advances by len + 1. For the last octet the
+ * dot is simply overwritten by the terminator.
+ */
+typedef struct
+{
+    char text[4];        // Digits followed by '.', zero-padded to 4 bytes
+    unsigned char len;   // Number of digits (1-3)
+} OctetText;
+
+static const OctetText OCTET_TEXT[256] = {
+    { "0.", 1 }, { "1.", 1 }, { "2.", 1 }, { "3.", 1 }, { "4.", 1 }, { "5.", 1 }, { "6.", 1 }, { "7.", 1 },
+    { "8.", 1 }, { "9.", 1 }, { "10.", 2 }, { "11.", 2 }, { "12.", 2 }, { "13.", 2 }, { "14.", 2 }, { "15.", 2 },
+    { "16.", 2 }, { "17.", 2 }, { "18.", 2 }, { "19.", 2 }, { "20.", 2 }, { "21.", 2 }, { "22.", 2 }, { "23.", 2 },
+    { "24.", 2 }, { "25.", 2 }, { "26.", 2 }, { "27.", 2 }, { "28.", 2 }, { "29.", 2 }, { "30.", 2 }, { "31.", 2 },
+    { "32.", 2 }, { "33.", 2 }, { "34.", 2 }, { "35.", 2 }, { "36.", 2 }, { "37.", 2 }, { "38.", 2 }, { "39.", 2 },
+    { "40.", 2 }, { "41.", 2 }, { "42.", 2 }, { "43.", 2 }, { "44.", 2 }, { "45.", 2 }, { "46.", 2 }, { "47.", 2 },
+    { "48.", 2 }, { "49.", 2 }, { "50.", 2 }, { "51.", 2 }, { "52.", 2 }, { "53.", 2 }, { "54.", 2 }, { "55.", 2 },
+    { "56.", 2 }, { "57.", 2 }, { "58.", 2 }, { "59.", 2 }, { "60.", 2 }, { "61.", 2 }, { "62.", 2 }, { "63.", 2 },
+    { "64.", 2 }, { "65.", 2 }, { "66.", 2 }, { "67.", 2 }, { "68.", 2 }, { "69.", 2 }, { "70.", 2 }, { "71.", 2 },
+    { "72.", 2 }, { "73.", 2 }, { "74.", 2 }, { "75.", 2 }, { "76.", 2 }, { "77.", 2 }, { "78.", 2 }, { "79.", 2 },
+    { "80.", 2 }, { "81.", 2 }, { "82.", 2 }, { "83.", 2 }, { "84.", 2 }, { "85.", 2 }, { "86.", 2 }, { "87.", 2 },
+    { "88.", 2 }, { "89.", 2 }, { "90.", 2 }, { "91.", 2 }, { "92.", 2 }, { "93.", 2 }, { "94.", 2 }, { "95.", 2 },
+    { "96.", 2 }, { "97.", 2 }, { "98.", 2 }, { "99.", 2 }, { "100.", 3 }, { "101.", 3 }, { "102.", 3 }, { "103.", 3 },
+    { "104.", 3 }, { "105.", 3 }, { "106.", 3 }, { "107.", 3 }, { "108.", 3 }, { "109.", 3 }, { "110.", 3 }, { "111.", 3 },
+    { "112.", 3 }, { "113.", 3 }, { "114.", 3 }, { "115.", 3 }, { "116.", 3 }, { "117.", 3 }, { "118.", 3 }, { "119.", 3 },
+    { "120.", 3 }, { "121.", 3 }, { "122.", 3 }, { "123.", 3 }, { "124.", 3 }, { "125.", 3 }, { "126.", 3 }, { "127.", 3 },
+    { "128.", 3 }, { "129.", 3 }, { "130.", 3 }, { "131.", 3 }, { "132.", 3 }, { "133.", 3 }, { "134.", 3 }, { "135.", 3 },
+    { "136.", 3 }, { "137.", 3 }, { "138.", 3 }, { "139.", 3 }, { "140.", 3 }, { "141.", 3 }, { "142.", 3 }, { "143.", 3 },
+    { "144.", 3 }, { "145.", 3 }, { "146.", 3 }, { "147.", 3 }, { "148.", 3 }, { "149.", 3 }, { "150.", 3 }, { "151.", 3 },
+    { "152.", 3 }, { "153.", 3 }, { "154.", 3 }, { "155.", 3 }, { "156.", 3 }, { "157.", 3 }, { "158.", 3 }, { "159.", 3 },
+    { "160.", 3 }, { "161.", 3 }, { "162.", 3 }, { "163.", 3 }, { "164.", 3 }, { "165.", 3 }, { "166.", 3 }, { "167.", 3 },
+    { "168.", 3 }, { "169.", 3 }, { "170.", 3 }, { "171.", 3 }, { "172.", 3 }, { "173.", 3 }, { "174.", 3 }, { "175.", 3 },
+    { "176.", 3 }, { "177.", 3 }, { "178.", 3 }, { "179.", 3 }, { "180.", 3 }, { "181.", 3 }, { "182.", 3 }, { "183.", 3 },
+    { "184.", 3 }, { "185.", 3 }, { "186.", 3 }, { "187.", 3 }, { "188.", 3 }, { "189.", 3 }, { "190.", 3 }, { "191.", 3 },
+    { "192.", 3 }, { "193.", 3 }, { "194.", 3 }, { "195.", 3 }, { "196.", 3 }, { "197.", 3 }, { "198.", 3 }, { "199.", 3 },
+    { "200.", 3 }, { "201.", 3 }, { "202.", 3 }, { "203.", 3 }, { "204.", 3 }, { "205.", 3 }, { "206.", 3 }, { "207.", 3 },
+    { "208.", 3 }, { "209.", 3 }, { "210.", 3 }, { "211.", 3 }, { "212.", 3 }, { "213.", 3 }, { "214.", 3 }, { "215.", 3 },
+    { "216.", 3 }, { "217.", 3 }, { "218.", 3 }, { "219.", 3 }, { "220.", 3 }, { "221.", 3 }, { "222.", 3 }, { "223.", 3 },
+    { "224.", 3 }, { "225.", 3 }, { "226.", 3 }, { "227.", 3 }, { "228.", 3 }, { "229.", 3 }, { "230.", 3 }, { "231.", 3 },
+    { "232.", 3 }, { "233.", 3 }, { "234.", 3 }, { "235.", 3 }, { "236.", 3 }, { "237.", 3 }, { "238.", 3 }, { "239.", 3 },
+    { "240.", 3 }, { "241.", 3 }, { "242.", 3 }, { "243.", 3 }, { "244.", 3 }, { "245.", 3 }, { "246.", 3 }, { "247.", 3 },
+    { "248.", 3 }, { "249.", 3 }, { "250.", 3 }, { "251.", 3 }, { "252.", 3 }, { "253.", 3 }, { "254.", 3 }, { "255.", 3 },
+};
+
+/*
+ * Formats a 32-bit address as dotted-quad text
+ *
+ * Formula: A = IP/256³, B = (IP%256³)/256², C = (IP%256²)/256, D = IP%256
+ * Each octet is looked up in OCTET_TEXT instead of being divided by 10.
+ *
+ * @param ip: 32-bit address
+ * @param buf: Destination, at least NET_IPV4_STRLEN bytes
+ * @return: Length of the text written (excluding the NUL terminator)
+ */
+size_t net_format_ipv4(unsigned int ip, char *buf)
+{
+    char *p = buf;
+    const OctetText *octet;
+
+    octet = &OCTET_TEXT[ip >> 24];
+    memcpy(p, octet->text, 4);
+    p += octet->len + 1;
+    octet = &OCTET_TEXT[(ip >> 16) & 255];
+    memcpy(p, octet->text, 4);
+    p += octet->len + 1;
+    octet = &OCTET_TEXT[(ip >> 8) & 255];
+    memcpy(p, octet->text, 4);
+    p += octet->len + 1;
+    octet = &OCTET_TEXT[ip & 255];
+    memcpy(p, octet->text, 4);
+    p += octet->len;
+    *p = '\0';
+
+    return (size_t)(p - buf);
+}
+
+/*
+ * Renders consecutive addresses as newline-terminated lines
+ *
+ * Addresses inside the same /24 share their first three octets, so the
+ * "A.B.C." prefix is built once per block of 256 and only the last octet
+ * is looked up per address. The output is ready for a single write().
+ *
+ * @param first: First address to render
+ * @param count: Number of addresses wanted (may exceed what fits)
+ * @param buf: Destination buffer
+ * @param size: Destination size in bytes
+ * @param rendered: Receives how many addresses were written
+ * @return: Number of bytes written
+ */
+size_t net_format_ipv4_range(unsigned int first, unsigned long long count,
+                             char *buf, size_t size, unsigned long long *rendered)
+{
+    char prefix[16];
+    size_t prefix_len = 0;
+    unsigned int current_block = 0;
+    unsigned long long done = 0;
+    size_t used = 0;
+
+    while (done < count && size - used >= 32)
+    {
+        unsigned int ip = first + (unsigned int)done;
+
+        // Rebuild the "A.B.C." prefix when entering a new /24 (or at the start)
+        if (done == 0 || (ip >> 8) != current_block) {
+            current_block = ip >> 8;
+            prefix_len = net_format_ipv4(ip & 0xFFFFFF00U, prefix) - 1;  // drop the trailing "0"
+        }
+
+        // Emit as many addresses of this /24 as fit and are wanted
+        unsigned int last_octet = ip & 255;
+        while (done < count && last_octet <= 255 && size - used >= 32)
+        {
+            char *p = buf + used;
+            const OctetText *octet = &OCTET_TEXT[last_octet];
+
+            memcpy(p, prefix, 16);            // fixed-size copies compile to moves
+            memcpy(p + prefix_len, octet->text, 4);
+            p[prefix_len + octet->len] = '\n';
+            used += prefix_len + octet->len + 1;
+
+            done++;
+            last_octet++;
+        }
+    }
+
+    if (rendered) *rendered = done;
+    return used;
+}
+
+/*
+ * ============================================================================
+ * BINARY REPRESENTATION
+ * ============================================================================
+ */
+
+/*
+ * Writes the 8-bit binary form of an octet, most significant bit first
+ *
+ * @param octet: Value 0-255
+ * @param buf: Destination, at least 9 bytes ("11000000" + NUL)
+ */
+void net_octet_to_binary(unsigned int octet, char *buf)
+{
+    for (int bit = 7; bit >= 0; bit--) {
+        buf[bit] = (char)('0' + octet % 2);
+        octet /= 2;
+    }
+    buf[8] = '\0';
+}
+
+/*
+ * Writes the 32-bit binary form of an address or mask
+ *
+ * @param value: 32-bit value
+ * @param buf: Destination, at least 33 bytes
+ */
+void net_mask_to_binary(unsigned int value, char *buf)
+{
+    for (int i = 0; i < 4; i++) {
+        net_octet_to_binary((value >> (24 - 8 * i)) & 255, buf + 8 * i);
+    }
+    buf[32] = '\0';
+}
+
+/*
+ * ============================================================================
+ * STRING AND NETWORK HELPERS
+ * ============================================================================
+ */
+
+/*
+ * Copies a string into a caller-provided buffer
+ *
+ * @param src: Source string
+ * @param dst: Destination buffer
+ * @param size: Destination size in bytes (including the NUL terminator)
+ * @return: NET_OK, NET_ERR_NULL or NET_ERR_BUFFER (nothing copied)
+ */
+NetStatus net_copy_string(const char *src, char *dst, size_t size)
+{
+    if (!src || !dst) return NET_ERR_NULL;
+
+    size_t len = strlen(src);
+    if (len >= size) return NET_ERR_BUFFER;
+
+    memcpy(dst, src, len + 1);
+    return NET_OK;
+}
+
+/*
+ * Converts a subnet mask to its prefix length
+ *
+ * A valid mask is N ones followed by zeros, so its inverse is 2^(32-N) - 1
+ * and (inverse + 1) has at most one bit set.
+ *
+ * @param mask: 32-bit subnet mask
+ * @return: Prefix length 0-32, or -1 if the ones are not contiguous
+ */
+int net_mask_to_prefix(unsigned int mask)
+{
+    unsigned int inverse = ~mask;
+
+    if (inverse & (inverse + 1)) return -1;
+
+    int prefix = 0;
+    while (prefix < 32 && (mask & (0x80000000U >> prefix))) prefix++;
+    return prefix;
+}
+
+/*
+ * Network address = IP AND Mask
+ */
+unsigned int net_network_address(unsigned int ip, unsigned int mask)
+{
+    return ip & mask;
+}
+
+/*
+ * Broadcast address = Network OR (2³² - 1 - Mask)
+ */
+unsigned int net_broadcast_address(unsigned int network, unsigned int mask)
+{
+    return network | (4294967295U - mask);
+}
@@ -0,0 +1,991 @@
+/*
+ * ============================================================================
+ * NET DAEMON - PERSISTENT DIAGNOSTICS SERVICE ON A UNIX DOMAIN SOCKET
+ * ============================================================================
+ *
+ * Running one process per check pays process start-up, table loading and
+ * socket setup every time. `net --daemon <socket>` pays them once and
+ * keeps everything warm:
+ *
+ * - one connect scanner (epoll or io_uring) shared by every client
+ * - an optional LPM table, loaded or memory-mapped once (LOAD swaps it)
+ * - client connections on a local SOCK_STREAM socket
+ *
+ * Everything runs on one thread around one epoll instance. The scanner's
+ * own descriptor is nested in that instance, so probe completions and
+ * client requests wake the same loop and no request ever blocks it.
+ * The one slow request, LOAD of a text table, is parsed and built on a
+ * worker thread; its eventfd wakes the loop, which swaps the new table in.
+ * Lookups keep using the old table until then.
+ *
+ * Protocol: one request per line, "<tag> <COMMAND> [args]". Every reply
+ * line starts with the request's tag, so clients may pipeline requests
+ * and match replies that complete out of order.
+ *
+ *   <tag> PING                       → <tag> pong
+ *   <tag> ANALYZE <ip|cidr|ip mask>  → <tag> <same fields as --batch>
+ *   <tag> LPM <ip>                   → <tag> match=<net>/<len> [label=..] | match=none
+ *   <tag> LOAD <table>               → <tag> ok routes=<n> (once the table is built)
+ *   <tag> TCP <ip> <port>            → <tag> <ip> port=.. state=.. rtt_us=..
+ *   <tag> SWEEP <cidr> [ports|-] [all] → <tag> <ip> port=.. state=open .. (per result)
+ *                                      <tag> end probes=<n> open=<n> seconds=<s>
+ *   <tag> STATS                      → <tag> clients=.. requests=.. dispatch_avg_ns=.. ...
+ *   <tag> QUIT                       → <tag> bye (connection closes)
+ *   <tag> SHUTDOWN                   → <tag> bye (daemon exits)
+ * Errors: "<tag> error=<reason>".
+ *
+ * TCP and SWEEP are jobs: their targets are fed to the scanner round-robin
+ * (DAEMON_FEED_QUANTUM at a time), so a large sweep does not hold back a
+ * single TCP check queued after it.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#define _GNU_SOURCE
+#include "net.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/stat.h>
+#include <sys/eventfd.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <strings.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+
+// epoll data values that are not client slots
+#define DAEMON_EVENT_LISTEN   0xFFFFFFFFu
+#define DAEMON_EVENT_SCANNER  0xFFFFFFFEu
+#define DAEMON_EVENT_LOAD     0xFFFFFFFDu
+
+typedef struct
+{
+    int fd;                      // -1 when the slot is free
+    unsigned int generation;     // Bumped on close so late job results are dropped
+    char *in;
+    size_t in_len;
+    size_t in_cap;
+    char *out;
+    size_t out_len;
+    size_t out_sent;
+    size_t out_cap;
+    int want_write;              // EPOLLOUT is registered
+    int closing;                 // Close once the output is flushed
+    int discarding;              // 1 while dropping the rest of an overlong line
+} DaemonClient;
+
+typedef struct DaemonJob
+{
+    struct DaemonJob *next;      // Feed queue
+    struct DaemonJob *all_prev;  // Every live job (for shutdown)
+    struct DaemonJob *all_next;
+    unsigned int client;
+    unsigned int generation;
+    char tag[DAEMON_TAG_MAX];
+    size_t tag_len;
+    int single;                  // TCP: one result line, no end line
+    int show_all;
+    int queued;                  // Still has targets to feed
+    unsigned long long next_host;
+    unsigned long long last_host;
+    unsigned short *ports;
+    size_t port_count;
+    size_t port_index;
+    size_t pending;              // Submitted, not yet completed
+    size_t probes;
+    size_t open_count;
+    unsigned long long start_ns;
+} DaemonJob;
+
+// A LOAD being built on its worker thread (one at a time)
+typedef struct
+{
+    pthread_t thread;
+    int active;                  // Worker started, not yet joined
+    int event_fd;                // Written by the worker when the table is ready
+    char path[DAEMON_REPLY_MAX];
+    LpmTable table;
+    int ok;                      // lpm_table_open() result
+    unsigned int client;
+    unsigned int generation;
+    char tag[DAEMON_TAG_MAX];
+    size_t tag_len;
+} DaemonLoad;
+
+typedef struct
+{
+    int epfd;
+    int listen_fd;
+    const char *path;
+    int running;
+    DaemonClient *clients;
+    size_t client_limit;         // Highest used slot + 1
+    size_t client_count;
+    ConnectScanner scanner;
+    LpmTable table;
+    int has_table;
+    DaemonLoad load;
+    DaemonJob *queue_head;
+    DaemonJob *queue_tail;
+    DaemonJob *all_jobs;
+    unsigned long long requests;     // Immediate requests answered
+    unsigned long long dispatch_ns;  // Their total handling time
+    unsigned long long jobs;
+} NetDaemon;
+
+static volatile sig_atomic_t daemon_stop_signal = 0;
+
+static void daemon_on_signal(int signo)
+{
+    (void)signo;
+    daemon_stop_signal = 1;
+}
+
+/*
+ * ============================================================================
+ * CLIENT OUTPUT
+ * ============================================================================
+ */
+
+/*
+ * Makes room for n more output bytes
+ *
+ * @return: Pointer to the free space, or NULL on allocation failure
+ */
+static char *client_reserve(DaemonClient *client, size_t n)
+{
+    if (client->out_cap - client->out_len < n) {
+        size_t cap = client->out_cap ? client->out_cap : 4096;
+        while (cap - client->out_len < n) cap *= 2;
+        char *grown = realloc(client->out, cap);
+        if (!grown) return NULL;
+        client->out = grown;
+        client->out_cap = cap;
+    }
+    return client->out + client->out_len;
+}
+
+/*
+ * Queues "<tag><text>\n" (text starts with a space)
+ */
+static void client_reply(DaemonClient *client, const char *tag, size_t tag_len,
+                         const char *text, size_t len)
+{
+    char *w = client_reserve(client, tag_len + len + 1);
+    if (!w) return;
+    memcpy(w, tag, tag_len);
+    memcpy(w + tag_len, text, len);
+    w[tag_len + len] = '\n';
+    client->out_len += tag_len + len + 1;
+}
+
+static void client_replyf(DaemonClient *client, const char *tag, size_t tag_len, const char *format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+/*
+ * Queues a formatted reply line
+ */
+static void client_replyf(DaemonClient *client, const char *tag, size_t tag_len, const char *format, ...)
+{
+    char text[DAEMON_REPLY_MAX];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (n < 0) return;
+    if ((size_t)n >= sizeof(text)) n = (int)sizeof(text) - 1;
+    client_reply(client, tag, tag_len, text, (size_t)n);
+}
+
+/*
+ * Closes a client and frees its slot
+ */
+static void daemon_close_client(NetDaemon *daemon, DaemonClient *client)
+{
+    if (client->fd < 0) return;
+    close(client->fd);  // also removes it from the epoll set
+    client->fd = -1;
+    client->generation++;
+    free(client->in);
+    free(client->out);
+    client->in = client->out = NULL;
+    client->in_len = client->in_cap = 0;
+    client->out_len = client->out_sent = client->out_cap = 0;
+    client->want_write = 0;
+    client->closing = 0;
+    client->discarding = 0;
+    daemon->client_count--;
+}
+
+/*
+ * Writes as much pending output as the socket accepts
+ */
+static void daemon_flush_client(NetDaemon *daemon, DaemonClient *client)
+{
+    while (client->out_sent < client->out_len)
+    {
+        ssize_t n = send(client->fd, client->out + client->out_sent, client->out_len - client->out_sent,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n > 0) {
+            client->out_sent += (size_t)n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        daemon_close_client(daemon, client);
+        return;
+    }
+
+    int pending = client->out_sent < client->out_len;
+    if (!pending) {
+        client->out_len = client->out_sent = 0;
+        if (client->closing) {
+            daemon_close_client(daemon, client);
+            return;
+        }
+    } else if (client->out_len - client->out_sent > DAEMON_MAX_PENDING) {
+        // A client that stops reading must not make the daemon grow without bound
+        fprintf(stderr, "⚠️  Dropping client that is not reading its results\n");
+        daemon_close_client(daemon, client);
+        return;
+    }
+
+    if (pending != client->want_write) {
+        struct epoll_event event;
+        event.events = EPOLLIN | (pending ? EPOLLOUT : 0);
+        event.data.u32 = (unsigned int)(client - daemon->clients);
+        epoll_ctl(daemon->epfd, EPOLL_CTL_MOD, client->fd, &event);
+        client->want_write = pending;
+    }
+}
+
+/*
+ * ============================================================================
+ * PROBE JOBS
+ * ============================================================================
+ */
+
+/*
+ * Returns the job's client if it is still connected
+ */
+static DaemonClient *daemon_job_client(NetDaemon *daemon, const DaemonJob *job)
+{
+    DaemonClient *client = &daemon->clients[job->client];
+    if (client->fd < 0 || client->generation != job->generation) return NULL;
+    return client;
+}
+
+/*
+ * Frees a job once every target has been submitted and completed
+ */
+static void daemon_job_maybe_finish(NetDaemon *daemon, DaemonJob *job)
+{
+    if (job->queued || job->pending > 0) return;
+
+    DaemonClient *client = daemon_job_client(daemon, job);
+    if (client && !job->single) {
+        client_replyf(client, job->tag, job->tag_len, " end probes=%zu open=%zu seconds=%.3f",
+                      job->probes, job->open_count, (double)(net_now_ns() - job->start_ns) / 1e9);
+    }
+
+    if (job->all_prev) job->all_prev->all_next = job->all_next;
+    else daemon->all_jobs = job->all_next;
+    if (job->all_next) job->all_next->all_prev = job->all_prev;
+    free(job->ports);
+    free(job);
+}
+
+/*
+ * Scanner callback: routes a result to the job (and client) that asked for it
+ */
+static void daemon_scan_result(const SweepResult *result, void *context)
+{
+    NetDaemon *daemon = context;
+    DaemonJob *job = result->tag;
+
+    job->pending--;
+    job->probes++;
+    if (result->state == SWEEP_OPEN) job->open_count++;
+
+    DaemonClient *client = daemon_job_client(daemon, job);
+    if (client && (job->single || job->show_all || result->state == SWEEP_OPEN)) {
+        char ip_text[NET_IPV4_STRLEN];
+        net_format_ipv4(result->ip, ip_text);
+        client_replyf(client, job->tag, job->tag_len, " %s port=%u state=%s rtt_us=%.1f", ip_text,
+                      result->port, sweep_state_string(result->state), (double)result->rtt_ns / 1e3);
+    }
+    daemon_job_maybe_finish(daemon, job);
+}
+
+/*
+ * Feeds queued job targets to the scanner until it is full
+ *
+ * Jobs take turns, DAEMON_FEED_QUANTUM targets at a time.
+ */
+static void daemon_feed(NetDaemon *daemon)
+{
+    while (daemon->queue_head)
+    {
+        DaemonJob *job = daemon->queue_head;
+
+        // Nobody is waiting for an abandoned job: stop submitting its targets
+        if (!daemon_job_client(daemon, job)) job->next_host = job->last_host + 1;
+
+        for (size_t n = 0; n < DAEMON_FEED_QUANTUM && job->next_host <= job->last_host; n++)
+        {
+            // Counted first: epoll may report an immediate result inside submit
+            job->pending++;
+            if (!connect_scanner_submit_tagged(&daemon->scanner, (unsigned int)job->next_host,
+                                               job->ports[job->port_index], job)) {
+                job->pending--;
+                return;
+            }
+            if (++job->port_index == job->port_count) {
+                job->port_index = 0;
+                job->next_host++;
+            }
+        }
+
+        daemon->queue_head = job->next;
+        if (!daemon->queue_head) daemon->queue_tail = NULL;
+        job->next = NULL;
+
+        if (job->next_host <= job->last_host) {
+            // Quantum used up: back of the line
+            if (daemon->queue_tail) daemon->queue_tail->next = job;
+            else daemon->queue_head = job;
+            daemon->queue_tail = job;
+        } else {
+            job->queued = 0;
+            daemon_job_maybe_finish(daemon, job);
+        }
+    }
+}
+
+/*
+ * Creates a job over [first, last] × ports and queues it
+ *
+ * @return: 1 if queued, 0 on allocation failure (ports is freed either way)
+ */
+static int daemon_start_job(NetDaemon *daemon, DaemonClient *client, const char *tag, size_t tag_len,
+                            unsigned int first, unsigned int last, unsigned short *ports, size_t port_count,
+                            int single, int show_all)
+{
+    DaemonJob *job = calloc(1, sizeof(DaemonJob));
+    if (!job) {
+        free(ports);
+        return 0;
+    }
+
+    job->client = (unsigned int)(client - daemon->clients);
+    job->generation = client->generation;
+    memcpy(job->tag, tag, tag_len);
+    job->tag_len = tag_len;
+    job->single = single;
+    job->show_all = show_all;
+    job->queued = 1;
+    job->next_host = first;
+    job->last_host = last;
+    job->ports = ports;
+    job->port_count = port_count;
+    job->start_ns = net_now_ns();
+
+    job->all_next = daemon->all_jobs;
+    if (daemon->all_jobs) daemon->all_jobs->all_prev = job;
+    daemon->all_jobs = job;
+
+    if (daemon->queue_tail) daemon->queue_tail->next = job;
+    else daemon->queue_head = job;
+    daemon->queue_tail = job;
+    daemon->jobs++;
+    return 1;
+}
+
+/*
+ * ============================================================================
+ * TABLE LOADING
+ * ============================================================================
+ */
+
+/*
+ * Worker thread: opens the requested table, then wakes the event loop
+ */
+static void *daemon_load_worker(void *arg)
+{
+    DaemonLoad *load = arg;
+    uint64_t one = 1;
+
+    load->ok = lpm_table_open(&load->table, load->path);
+    while (write(load->event_fd, &one, sizeof(one)) < 0 && errno == EINTR) {}
+    return NULL;
+}
+
+/*
+ * Joins the LOAD worker, swaps its table in and answers the client
+ *
+ * Called when the worker's eventfd fires, or at shutdown (where the
+ * join waits for the table to finish building).
+ */
+static void daemon_finish_load(NetDaemon *daemon)
+{
+    DaemonLoad *load = &daemon->load;
+
+    pthread_join(load->thread, NULL);
+    load->active = 0;
+
+    // The client may have disconnected while the table was being built
+    DaemonClient *client = &daemon->clients[load->client];
+    if (client->fd < 0 || client->generation != load->generation) client = NULL;
+
+    if (!load->ok) {
+        lpm_table_free(&load->table);
+        if (client) client_reply(client, load->tag, load->tag_len, " error=load-failed", 18);
+        return;
+    }
+    if (daemon->has_table) lpm_table_free(&daemon->table);
+    daemon->table = load->table;
+    daemon->has_table = 1;
+    if (client) {
+        client_replyf(client, load->tag, load->tag_len, " ok routes=%zu",
+                      daemon->table.route_count + daemon->table.v6.route_count);
+    }
+}
+
+/*
+ * ============================================================================
+ * REQUESTS
+ * ============================================================================
+ */
+
+/*
+ * Splits the next whitespace-separated token off [*p, end)
+ *
+ * @return: Token length (0 at end of line)
+ */
+static size_t daemon_token(const char **p, const char *end, const char **token)
+{
+    const char *s = *p;
+    while (s < end && (*s == ' ' || *s == '\t')) s++;
+    const char *e = s;
+    while (e < end && *e != ' ' && *e != '\t') e++;
+    *token = s;
+    *p = e;
+    return (size_t)(e - s);
+}
+
+/*
+ * Compares a token to a command name, ignoring case
+ */
+static int daemon_is(const char *token, size_t len, const char *name)
+{
+    return strlen(name) == len && strncasecmp(token, name, len) == 0;
+}
+
+/*
+ * Copies a token into a NUL-terminated buffer
+ *
+ * @return: 1 if it fit, 0 otherwise
+ */
+static int daemon_copy_token(char *dst, size_t size, const char *token, size_t len)
+{
+    if (len == 0 || len >= size) return 0;
+    memcpy(dst, token, len);
+    dst[len] = '\0';
+    return 1;
+}
+
+/*
+ * Handles one request line
+ */
+static void daemon_handle_line(NetDaemon *daemon, DaemonClient *client, const char *line, size_t len)
+{
+    unsigned long long start_ns = net_now_ns();
+    const char *p = line;
+    const char *end = line + len;
+    const char *tag;
+    const char *verb;
+    char scratch[DAEMON_REPLY_MAX];
+
+    size_t tag_len = daemon_token(&p, end, &tag);
+    if (tag_len == 0) return;  // Blank line
+    if (tag_len >= DAEMON_TAG_MAX) {
+        client_replyf(client, "-", 1, " error=tag-too-long");
+        return;
+    }
+    size_t verb_len = daemon_token(&p, end, &verb);
+
+    // Remaining arguments, trimmed
+    const char *args = p;
+    while (args < end && (*args == ' ' || *args == '\t')) args++;
+    size_t args_len = (size_t)(end - args);
+    while (args_len > 0 && (args[args_len - 1] == ' ' || args[args_len - 1] == '\t')) args_len--;
+
+    if (daemon_is(verb, verb_len, "PING")) {
+        client_reply(client, tag, tag_len, " pong", 5);
+    }
+    else if (daemon_is(verb, verb_len, "ANALYZE")) {
+        size_t n = args_len > 0 ? batch_format_result(args, args_len, scratch) : 0;
+        if (n == 0) client_reply(client, tag, tag_len, " error=invalid", 14);
+        else client_reply(client, tag, tag_len, scratch, n);
+    }
+    else if (daemon_is(verb, verb_len, "LPM")) {
+        unsigned int ip;
+        NetIpv6 ip6;
+        const char *ip_end;
+        int is_ipv6 = memchr(args, ':', args_len) != NULL;
+        int valid = is_ipv6
+            ? net_parse_ipv6_span_scalar(args, args + args_len, &ip6, &ip_end) == NET_OK
+            : net_parse_ipv4_span(args, args + args_len, &ip, &ip_end) == NET_OK;
+        valid = valid && ip_end == args + args_len;
+        if (!daemon->has_table) {
+            client_reply(client, tag, tag_len, " error=no-table", 15);
+        } else if (is_ipv6 && valid) {
+            const Lpm6Route *route = lpm6_lookup(&daemon->table.v6, &ip6);
+            size_t label_len = route ? route->label_len : 0;
+            char *w = client_reserve(client, tag_len + LPM_MAX_RESULT_LENGTH + label_len + 1);
+            if (w) {
+                memcpy(w, tag, tag_len);
+                size_t n = lpm6_format_result(&daemon->table.v6, route, w + tag_len);
+                w[tag_len + n] = '\n';
+                client->out_len += tag_len + n + 1;
+            }
+        } else {
+            const LpmRoute *route = valid ? lpm_lookup(&daemon->table, ip) : NULL;
+            size_t label_len = route ? route->label_len : 0;
+            char *w = client_reserve(client, tag_len + LPM_MAX_RESULT_LENGTH + label_len + 1);
+            if (w) {
+                memcpy(w, tag, tag_len);
+                size_t n = lpm_format_result(&daemon->table, route, valid, w + tag_len);
+                w[tag_len + n] = '\n';
+                client->out_len += tag_len + n + 1;
+            }
+        }
+    }
+    else if (daemon_is(verb, verb_len, "LOAD")) {
+        DaemonLoad *load = &daemon->load;
+        if (load->active) {
+            client_reply(client, tag, tag_len, " error=load-busy", 16);
+        } else if (!daemon_copy_token(load->path, sizeof(load->path), args, args_len)) {
+            client_reply(client, tag, tag_len, " error=invalid", 14);
+        } else {
+            load->client = (unsigned int)(client - daemon->clients);
+            load->generation = client->generation;
+            memcpy(load->tag, tag, tag_len);
+            load->tag_len = tag_len;
+            if (pthread_create(&load->thread, NULL, daemon_load_worker, load) != 0) {
+                client_reply(client, tag, tag_len, " error=load-failed", 18);
+            } else {
+                load->active = 1;  // Answered by daemon_finish_load()
+            }
+        }
+    }
+    else if (daemon_is(verb, verb_len, "TCP")) {
+        const char *ip_token;
+        const char *port_token;
+        char port_text[8];
+        char *port_end = port_text;
+        unsigned int ip;
+        const char *ip_end;
+        size_t ip_len = daemon_token(&p, end, &ip_token);
+        size_t port_len = daemon_token(&p, end, &port_token);
+        long port = daemon_copy_token(port_text, sizeof(port_text), port_token, port_len) &&
+                    port_text[0] >= '0' && port_text[0] <= '9'
+                    ? strtol(port_text, &port_end, 10) : 0;
+        if (*port_end != '\0') port = 0;  // Trailing garbage ("80abc")
+        unsigned short *ports = malloc(sizeof(unsigned short));
+
+        if (!ports || net_parse_ipv4_span(ip_token, ip_token + ip_len, &ip, &ip_end) != NET_OK ||
+            ip_end != ip_token + ip_len || port < 1 || port > 65535) {
+            free(ports);
+            client_reply(client, tag, tag_len, " error=invalid", 14);
+        } else {
+            ports[0] = (unsigned short)port;
+            if (!daemon_start_job(daemon, client, tag, tag_len, ip, ip, ports, 1, 1, 1)) {
+                client_reply(client, tag, tag_len, " error=no-memory", 16);
+            }
+        }
+        return;  // Jobs are not counted as immediate requests
+    }
+    else if (daemon_is(verb, verb_len, "SWEEP")) {
+        const char *cidr_token;
+        const char *ports_token;
+        const char *all_token;
+        char ports_text[DAEMON_REPLY_MAX];
+        unsigned int ip;
+        int prefix;
+        size_t cidr_len = daemon_token(&p, end, &cidr_token);
+        size_t ports_len = daemon_token(&p, end, &ports_token);
+        size_t all_len = daemon_token(&p, end, &all_token);
+        int show_all = daemon_is(all_token, all_len, "all");
+
+        if (net_parse_cidr_span(cidr_token, cidr_token + cidr_len, &ip, &prefix, NULL) != NET_OK) {
+            client_reply(client, tag, tag_len, " error=invalid-cidr", 19);
+            return;
+        }
+        // "-" or nothing keeps the common service ports
+        const char *spec = NULL;
+        if (ports_len > 0 && !(ports_len == 1 && *ports_token == '-')) {
+            if (!daemon_copy_token(ports_text, sizeof(ports_text), ports_token, ports_len)) {
+                client_reply(client, tag, tag_len, " error=invalid-ports", 20);
+                return;
+            }
+            spec = ports_text;
+        }
+        unsigned short *ports;
+        size_t port_count = parse_port_list(spec, &ports);
+        if (port_count == 0) {
+            client_reply(client, tag, tag_len, " error=invalid-ports", 20);
+            return;
+        }
+
+        const PrefixInfo *info = &NET_PREFIX_TABLE[prefix];
+        unsigned int network = ip & info->mask;
+        unsigned int broadcast = network | info->wildcard;
+        unsigned int first = prefix >= 31 ? network : network + 1;
+        unsigned int last = prefix >= 31 ? broadcast : broadcast - 1;
+        if (!daemon_start_job(daemon, client, tag, tag_len, first, last, ports, port_count, 0, show_all)) {
+            client_reply(client, tag, tag_len, " error=no-memory", 16);
+        }
+        return;
+    }
+    else if (daemon_is(verb, verb_len, "STATS")) {
+        client_replyf(client, tag, tag_len,
+                      " clients=%zu requests=%llu dispatch_avg_ns=%llu jobs=%llu inflight=%zu probes=%zu"
+                      " open=%zu backend=%s routes=%zu",
+                      daemon->client_count, daemon->requests,
+                      daemon->requests ? daemon->dispatch_ns / daemon->requests : 0ULL,
+                      daemon->jobs, daemon->scanner.inflight, daemon->scanner.completed,
+                      daemon->scanner.open_count, sweep_backend_string(daemon->scanner.backend),
+                      daemon->has_table ? daemon->table.route_count + daemon->table.v6.route_count
+                                        : (size_t)0);
+    }
+    else if (daemon_is(verb, verb_len, "QUIT")) {
+        client_reply(client, tag, tag_len, " bye", 4);
+        client->closing = 1;
+    }
+    else if (daemon_is(verb, verb_len, "SHUTDOWN")) {
+        client_reply(client, tag, tag_len, " bye", 4);
+        daemon->running = 0;
+    }
+    else {
+        client_reply(client, tag, tag_len, " error=unknown-command", 22);
+    }
+
+    daemon->requests++;
+    daemon->dispatch_ns += net_now_ns() - start_ns;
+}
+
+/*
+ * Reads available request bytes and handles every complete line
+ */
+static void daemon_read_client(NetDaemon *daemon, DaemonClient *client)
+{
+    for (;;)
+    {
+        if (client->in_cap - client->in_len < DAEMON_READ_SIZE) {
+            char *grown = realloc(client->in, client->in_len + DAEMON_READ_SIZE);
+            if (!grown) {
+                daemon_close_client(daemon, client);
+                return;
+            }
+            client->in = grown;
+            client->in_cap = client->in_len + DAEMON_READ_SIZE;
+        }
+
+        ssize_t n = recv(client->fd, client->in + client->in_len, client->in_cap - client->in_len, MSG_DONTWAIT);
+        if (n == 0) {
+            // Peer closed: finish writing what is already queued, then close
+            client->closing = 1;
+            break;
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            daemon_close_client(daemon, client);
+            return;
+        }
+        client->in_len += (size_t)n;
+        if (client->closing) {
+            // After QUIT: drain and drop whatever else the client sends
+            client->in_len = 0;
+            if ((size_t)n < DAEMON_READ_SIZE) break;
+            continue;
+        }
+
+        // Handle complete lines; an overlong line gets one error reply
+        size_t start = 0;
+        for (size_t i = client->in_len - (size_t)n; i < client->in_len; i++)
+        {
+            if (client->in[i] != '\n') continue;
+            size_t line_len = i - start;
+            if (line_len > 0 && client->in[start + line_len - 1] == '\r') line_len--;
+            if (client->discarding) {
+                client->discarding = 0;  // Tail of a line already answered
+            } else if (line_len > DAEMON_LINE_MAX) {
+                client_reply(client, "-", 1, " error=line-too-long", 20);
+            } else {
+                daemon_handle_line(daemon, client, client->in + start, line_len);
+            }
+            start = i + 1;
+            if (client->closing) break;  // QUIT: later lines are not run
+        }
+        if (start > 0) {
+            memmove(client->in, client->in + start, client->in_len - start);
+            client->in_len -= start;
+        }
+
+        // Partial line: past the limit, answer now and drop bytes up to the next '\n'
+        if (!client->discarding && client->in_len > DAEMON_LINE_MAX) {
+            client_reply(client, "-", 1, " error=line-too-long", 20);
+            client->discarding = 1;
+        }
+        if (client->discarding || client->closing) client->in_len = 0;
+        if ((size_t)n < DAEMON_READ_SIZE) break;
+    }
+}
+
+/*
+ * Accepts every pending connection
+ */
+static void daemon_accept(NetDaemon *daemon)
+{
+    for (;;)
+    {
+        int fd = accept4(daemon->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                fprintf(stderr, "⚠️  accept failed: %s\n", strerror(errno));
+            }
+            return;
+        }
+
+        size_t slot = 0;
+        while (slot < DAEMON_MAX_CLIENTS && daemon->clients[slot].fd >= 0) slot++;
+        if (slot == DAEMON_MAX_CLIENTS) {
+            close(fd);
+            continue;
+        }
+
+        DaemonClient *client = &daemon->clients[slot];
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u32 = (unsigned int)slot;
+        if (epoll_ctl(daemon->epfd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            continue;
+        }
+        client->fd = fd;
+        daemon->client_count++;
+        if (slot + 1 > daemon->client_limit) daemon->client_limit = slot + 1;
+    }
+}
+
+/*
+ * ============================================================================
+ * SETUP AND MAIN LOOP
+ * ============================================================================
+ */
+
+/*
+ * Binds the control socket, replacing a stale socket file
+ *
+ * @return: Listening descriptor, or -1 on failure
+ */
+static int daemon_listen(const char *path)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "❌ Socket path too long: %s\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        fprintf(stderr, "❌ socket failed: %s\n", strerror(errno));
+        return -1;
+    }
+
+    // A socket file nobody answers on is left over from a previous run
+    struct stat st;
+    if (stat(path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int alive = probe >= 0 && connect(probe, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+        if (probe >= 0) close(probe);
+        if (alive) {
+            fprintf(stderr, "❌ Another daemon is already listening on %s\n", path);
+            close(fd);
+            return -1;
+        }
+        unlink(path);
+    }
+
+    // Owner-only: the socket can start network probes
+    mode_t old_mask = umask(0077);
+    int bound = bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+    umask(old_mask);
+    if (bound != 0 || listen(fd, SOMAXCONN) != 0) {
+        fprintf(stderr, "❌ Cannot listen on %s: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*
+ * Releases everything the daemon holds
+ */
+static void daemon_cleanup(NetDaemon *daemon)
+{
+    if (daemon->load.active) daemon_finish_load(daemon);
+    if (daemon->load.event_fd >= 0) close(daemon->load.event_fd);
+    if (daemon->clients) {
+        for (size_t i = 0; i < DAEMON_MAX_CLIENTS; i++) {
+            if (daemon->clients[i].fd >= 0) {
+                daemon_flush_client(daemon, &daemon->clients[i]);
+                daemon_close_client(daemon, &daemon->clients[i]);
+            }
+        }
+        free(daemon->clients);
+    }
+    connect_scanner_free(&daemon->scanner);  // no callbacks: jobs are freed below
+    while (daemon->all_jobs) {
+        DaemonJob *job = daemon->all_jobs;
+        daemon->all_jobs = job->all_next;
+        free(job->ports);
+        free(job);
+    }
+    if (daemon->has_table) lpm_table_free(&daemon->table);
+    if (daemon->listen_fd >= 0) {
+        close(daemon->listen_fd);
+        unlink(daemon->path);
+    }
+    if (daemon->epfd >= 0) close(daemon->epfd);
+}
+
+/*
+ * Runs the diagnostics daemon until SHUTDOWN, SIGINT or SIGTERM
+ *
+ * @param socket_path: Unix domain socket to listen on
+ * @param table_path: LPM table to preload (text or compiled), or NULL
+ * @param max_inflight: Scanner concurrency shared by all clients
+ * @param timeout_ms: Connect deadline for TCP and SWEEP jobs
+ * @return: Process exit status (0 on clean shutdown)
+ */
+int run_daemon_mode(const char *socket_path, const char *table_path, size_t max_inflight, int timeout_ms)
+{
+    NetDaemon daemon;
+    memset(&daemon, 0, sizeof(daemon));
+    daemon.epfd = -1;
+    daemon.listen_fd = -1;
+    daemon.load.event_fd = -1;
+    daemon.path = socket_path;
+
+    daemon.clients = calloc(DAEMON_MAX_CLIENTS, sizeof(DaemonClient));
+    if (!daemon.clients) {
+        fprintf(stderr, "❌ Memory allocation failed for daemon clients\n");
+        return 1;
+    }
+    for (size_t i = 0; i < DAEMON_MAX_CLIENTS; i++) daemon.clients[i].fd = -1;
+
+    if (table_path) {
+        if (!lpm_table_open(&daemon.table, table_path)) {
+            lpm_table_free(&daemon.table);
+            daemon_cleanup(&daemon);
+            return 1;
+        }
+        daemon.has_table = 1;
+    }
+
+    if (!connect_scanner_init(&daemon.scanner, max_inflight, timeout_ms, daemon_scan_result, &daemon)) {
+        daemon_cleanup(&daemon);
+        return 1;
+    }
+
+    daemon.epfd = epoll_create1(EPOLL_CLOEXEC);
+    daemon.load.event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    daemon.listen_fd = daemon_listen(socket_path);
+    if (daemon.epfd < 0 || daemon.load.event_fd < 0 || daemon.listen_fd < 0) {
+        daemon_cleanup(&daemon);
+        return 1;
+    }
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u32 = DAEMON_EVENT_LISTEN;
+    epoll_ctl(daemon.epfd, EPOLL_CTL_ADD, daemon.listen_fd, &event);
+    event.data.u32 = DAEMON_EVENT_SCANNER;
+    epoll_ctl(daemon.epfd, EPOLL_CTL_ADD, connect_scanner_fd(&daemon.scanner), &event);
+    event.data.u32 = DAEMON_EVENT_LOAD;
+    epoll_ctl(daemon.epfd, EPOLL_CTL_ADD, daemon.load.event_fd, &event);
+
+    // No SA_RESTART: the signal must interrupt epoll_wait()
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = daemon_on_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    fprintf(stderr, "🛰️  Daemon listening on %s (%s scanner, %zu in flight, %d ms timeout%s)\n",
+            socket_path, sweep_backend_string(daemon.scanner.backend), daemon.scanner.max_inflight,
+            daemon.scanner.timeout_ms, daemon.has_table ? ", table loaded" : "");
+
+    struct epoll_event events[DAEMON_EVENT_BATCH];
+    daemon.running = 1;
+    while (daemon.running && !daemon_stop_signal)
+    {
+        // Queued targets and free scanner slots: do not sleep. Probes out:
+        // deadlines need a wakeup every tick. Otherwise sleep until a request.
+        int wait_ms = -1;
+        if (daemon.queue_head && daemon.scanner.inflight < daemon.scanner.max_inflight) wait_ms = 0;
+        else if (daemon.scanner.inflight > 0) wait_ms = SWEEP_TICK_MS;
+        int count = epoll_wait(daemon.epfd, events, DAEMON_EVENT_BATCH, wait_ms);
+        if (count < 0 && errno != EINTR) {
+            fprintf(stderr, "❌ epoll_wait failed: %s\n", strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            unsigned int id = events[i].data.u32;
+            if (id == DAEMON_EVENT_LISTEN) {
+                daemon_accept(&daemon);
+                continue;
+            }
+            if (id == DAEMON_EVENT_SCANNER) continue;  // Collected below
+            if (id == DAEMON_EVENT_LOAD) {
+                uint64_t done;
+                if (read(daemon.load.event_fd, &done, sizeof(done)) > 0 && daemon.load.active) {
+                    daemon_finish_load(&daemon);
+                }
+                continue;
+            }
+
+            DaemonClient *client = &daemon.clients[id];
+            if (client->fd < 0) continue;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) daemon_read_client(&daemon, client);
+        }
+
+        // Submit new targets and collect results; freed slots refill next turn
+        daemon_feed(&daemon);
+        if (daemon.scanner.inflight > 0) connect_scanner_run_once(&daemon.scanner, 0);
+
+        for (size_t i = 0; i < daemon.client_limit; i++) {
+            DaemonClient *client = &daemon.clients[i];
+            if (client->fd >= 0 && (client->out_len > client->out_sent || client->closing)) {
+                daemon_flush_client(&daemon, client);
+            }
+        }
+    }
+
+    fprintf(stderr, "👋 Daemon stopped (%llu requests, %llu jobs)\n", daemon.requests, daemon.jobs);
+    daemon_cleanup(&daemon);
+    return 0;
+}
@@ -0,0 +1,663 @@
+/*
+ * ============================================================================
+ * NET MONITOR - CONTINUOUS PROBING WITH STATE-CHANGE OUTPUT
+ * ============================================================================
+ *
+ * `net --monitor <targets-file>` probes every target forever at its own
+ * interval and prints one line only when a target changes state, so
+ * thousands of endpoints produce a handful of lines per hour.
+ *
+ * Targets file, one per line ('#' starts a comment):
+ *
+ *   <ip>[:<port>] [interval|-] [name]
+ *
+ *   10.0.0.1            → ICMP echo at the default interval
+ *   10.0.0.1:443 30s    → TCP connect every 30 s
+ *   10.0.0.2 500ms gw2  → ICMP echo every 500 ms, reported as "gw2"
+ *
+ * Intervals take ms, s, m or h (a bare number is seconds).
+ *
+ * Engine (one thread, one epoll loop):
+ * - Schedule: every target owns a node in a hierarchical timer wheel, so
+ *   starting, rescheduling and cancelling probes is O(1) whatever the
+ *   number of targets and however long their intervals
+ * - Jitter: first probes are spread uniformly over one interval and every
+ *   later interval varies by ±MONITOR_JITTER_PERCENT, so targets that
+ *   share an interval never fire in one burst
+ * - TCP: the connect scanner (epoll or io_uring), shared by all targets
+ * - ICMP: one nonblocking echo socket; replies carry the target index and
+ *   attempt, and the wheel node doubles as the reply deadline
+ *
+ * State per target: a rolling window of the last MONITOR_WINDOW probes
+ * (success + RTT). Events:
+ *   up        first success, or MONITOR_UP_AFTER in a row after "down"
+ *   down      MONITOR_DOWN_AFTER failures in a row
+ *   degraded  window loss ≥ MONITOR_DEGRADED_LOSS_PCT while up (once the
+ *             window is at least half full)
+ *   latency   window median RTT moved by ×MONITOR_LATENCY_FACTOR (and by
+ *             at least MONITOR_LATENCY_MIN_DELTA_US) since the last report
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+
+typedef enum
+{
+    MONITOR_UNKNOWN = 0,
+    MONITOR_UP,
+    MONITOR_DEGRADED,
+    MONITOR_DOWN
+} MonitorState;
+
+typedef struct
+{
+    TimerNode timer;             // First member: next probe, or the echo deadline
+    unsigned int ip;             // Host byte order
+    unsigned short port;         // 0 = ICMP echo
+    unsigned int interval_ms;
+    unsigned long long due_ms;   // Start of the current (or next) probe
+    char name[MONITOR_NAME_MAX];
+    int in_flight;
+    unsigned int attempt;        // ICMP attempts sent (matches replies)
+    unsigned long long sent_ns;
+    MonitorState state;
+    unsigned long long rtt_ns[MONITOR_WINDOW];  // Ring of the last probes
+    unsigned char ok[MONITOR_WINDOW];
+    unsigned int window_pos;
+    unsigned int window_count;
+    unsigned int consecutive_ok;
+    unsigned int consecutive_fail;
+    unsigned long long baseline_ns;  // Median RTT at the last latency report
+} MonitorTarget;
+
+typedef struct
+{
+    MonitorTarget *targets;
+    size_t target_count;
+    size_t tcp_count;
+    size_t icmp_count;
+    int timeout_ms;
+    TimerWheel wheel;
+    ConnectScanner scanner;
+    int has_scanner;
+    int icmp_fd;
+    int icmp_raw;
+    unsigned short ident;
+    unsigned int run_id;
+    unsigned long long rng;      // xorshift64 state for the jitter
+    unsigned long long probes;
+    unsigned long long failures;
+    unsigned long long events;
+    RttHistogram rtt;
+} NetMonitor;
+
+static volatile sig_atomic_t monitor_stop_signal = 0;
+
+static void monitor_on_signal(int signo)
+{
+    (void)signo;
+    monitor_stop_signal = 1;
+}
+
+static unsigned long long monitor_now_ms(void)
+{
+    return net_now_ns() / 1000000ULL;
+}
+
+/*
+ * Returns a pseudo-random number in [0, range)
+ */
+static unsigned long long monitor_random(NetMonitor *monitor, unsigned long long range)
+{
+    monitor->rng ^= monitor->rng << 13;
+    monitor->rng ^= monitor->rng >> 7;
+    monitor->rng ^= monitor->rng << 17;
+    return range ? monitor->rng % range : 0;
+}
+
+static const char *monitor_state_string(MonitorState state)
+{
+    switch (state)
+    {
+        case MONITOR_UP:       return "up";
+        case MONITOR_DEGRADED: return "degraded";
+        case MONITOR_DOWN:     return "down";
+        default:               return "unknown";
+    }
+}
+
+/*
+ * ============================================================================
+ * TARGETS FILE
+ * ============================================================================
+ */
+
+/*
+ * Parses an interval such as "250ms", "5s", "2m", "1h" or "30" (seconds)
+ *
+ * @param text: Interval text (not necessarily NUL-terminated)
+ * @param len: Text length
+ * @return: Milliseconds, or 0 if invalid
+ */
+unsigned int monitor_parse_interval(const char *text, size_t len)
+{
+    char buf[32];
+    if (len == 0 || len >= sizeof(buf)) return 0;
+    memcpy(buf, text, len);
+    buf[len] = '\0';
+
+    char *unit;
+    double value = strtod(buf, &unit);
+    double scale;
+    if (unit == buf || value <= 0) return 0;
+    if (*unit == '\0' || strcmp(unit, "s") == 0) scale = 1000.0;
+    else if (strcmp(unit, "ms") == 0) scale = 1.0;
+    else if (strcmp(unit, "m") == 0) scale = 60000.0;
+    else if (strcmp(unit, "h") == 0) scale = 3600000.0;
+    else return 0;
+
+    double ms = value * scale;
+    return ms > 4e9 ? 0 : (unsigned int)ms;
+}
+
+/*
+ * Reads the targets file
+ *
+ * @return: 1 if at least one target was loaded, 0 otherwise
+ */
+static int monitor_load_targets(NetMonitor *monitor, const char *path, unsigned int default_interval_ms)
+{
+    LineReader reader;
+    const char *line;
+    size_t len;
+    size_t line_number = 0;
+    size_t capacity = 0;
+
+    if (!line_reader_open(&reader, path)) return 0;
+
+    while (line_reader_next(&reader, &line, &len))
+    {
+        line_number++;
+        while (len > 0 && (*line == ' ' || *line == '\t')) { line++; len--; }
+        while (len > 0 && (line[len - 1] == ' ' || line[len - 1] == '\t' || line[len - 1] == '\r')) len--;
+        if (len == 0 || *line == '#') continue;
+
+        const char *end = line + len;
+        const char *p;
+        unsigned int ip;
+        long port = 0;
+        unsigned int interval_ms = default_interval_ms;
+
+        int valid = net_parse_ipv4_span(line, end, &ip, &p) == NET_OK;
+        if (valid && p < end && *p == ':') {
+            const char *digits = ++p;
+            while (p < end && *p >= '0' && *p <= '9' && port <= 65535) port = port * 10 + (*p++ - '0');
+            valid = p > digits && port >= 1 && port <= 65535;
+        }
+        valid = valid && (p == end || *p == ' ' || *p == '\t');
+        const char *address_end = p;
+
+        // Optional interval ("-" = default), then an optional name
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        const char *field = p;
+        while (p < end && *p != ' ' && *p != '\t') p++;
+        if (valid && p > field && !(p - field == 1 && *field == '-')) {
+            interval_ms = monitor_parse_interval(field, (size_t)(p - field));
+            valid = interval_ms != 0;
+        }
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+
+        if (!valid) {
+            fprintf(stderr, "⚠️  %s:%zu: invalid target \"%.*s\"\n",
+                    path, line_number, (int)(len > 64 ? 64 : len), line);
+            continue;
+        }
+
+        if (monitor->target_count == capacity) {
+            size_t grown_capacity = capacity ? capacity * 2 : 64;
+            MonitorTarget *grown = realloc(monitor->targets, grown_capacity * sizeof(MonitorTarget));
+            if (!grown) {
+                fprintf(stderr, "❌ Memory allocation failed for monitor targets\n");
+                line_reader_close(&reader);
+                return 0;
+            }
+            monitor->targets = grown;
+            capacity = grown_capacity;
+        }
+
+        MonitorTarget *target = &monitor->targets[monitor->target_count++];
+        memset(target, 0, sizeof(*target));
+        target->ip = ip;
+        target->port = (unsigned short)port;
+        target->interval_ms = interval_ms < MONITOR_MIN_INTERVAL_MS ? MONITOR_MIN_INTERVAL_MS : interval_ms;
+
+        // The name defaults to the address as written
+        const char *name = p < end ? p : line;
+        size_t name_len = p < end ? (size_t)(end - p) : (size_t)(address_end - line);
+        if (name_len >= MONITOR_NAME_MAX) name_len = MONITOR_NAME_MAX - 1;
+        memcpy(target->name, name, name_len);
+        target->name[name_len] = '\0';
+
+        if (port) monitor->tcp_count++;
+        else monitor->icmp_count++;
+    }
+    int read_failed = reader.error;
+    line_reader_close(&reader);
+    if (read_failed) return 0;
+
+    if (monitor->target_count == 0) {
+        fprintf(stderr, "❌ No targets in %s\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * ============================================================================
+ * STATE TRACKING
+ * ============================================================================
+ */
+
+/*
+ * Returns the median RTT of the successful probes in the window (0 if none)
+ */
+static unsigned long long monitor_window_median(const MonitorTarget *target, unsigned int *samples)
+{
+    unsigned long long sorted[MONITOR_WINDOW];
+    unsigned int count = 0;
+
+    for (unsigned int i = 0; i < target->window_count; i++)
+    {
+        if (!target->ok[i]) continue;
+        // Insertion sort: the window is tiny
+        unsigned int j = count++;
+        while (j > 0 && sorted[j - 1] > target->rtt_ns[i]) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = target->rtt_ns[i];
+    }
+    *samples = count;
+    return count ? sorted[count / 2] : 0;
+}
+
+/*
+ * Prints one event line
+ */
+static void monitor_emit(NetMonitor *monitor, const MonitorTarget *target, const char *event,
+                         MonitorState previous, unsigned long long median_ns, unsigned long long was_ns)
+{
+    char stamp[32];
+    char address[NET_IPV4_STRLEN + 6];
+    time_t now = time(NULL);
+    struct tm tm_utc;
+    gmtime_r(&now, &tm_utc);
+    strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", &tm_utc);
+
+    size_t n = net_format_ipv4(target->ip, address);
+    if (target->port) snprintf(address + n, sizeof(address) - n, ":%u", target->port);
+
+    unsigned int lost = 0;
+    for (unsigned int i = 0; i < target->window_count; i++) lost += !target->ok[i];
+    double loss = target->window_count ? 100.0 * lost / target->window_count : 0.0;
+
+    printf("time=%s target=%s addr=%s event=%s prev=%s loss=%.1f%% rtt_p50_us=%.1f",
+           stamp, target->name, address, event, monitor_state_string(previous), loss,
+           (double)median_ns / 1e3);
+    if (was_ns) printf(" was_us=%.1f", (double)was_ns / 1e3);
+    printf("\n");
+    fflush(stdout);
+    monitor->events++;
+}
+
+/*
+ * Records a probe outcome and reports any state change
+ */
+static void monitor_record(NetMonitor *monitor, MonitorTarget *target, int ok, unsigned long long rtt_ns)
+{
+    target->in_flight = 0;
+    monitor->probes++;
+    if (ok) rtt_histogram_record(&monitor->rtt, rtt_ns);
+    else monitor->failures++;
+
+    target->ok[target->window_pos] = (unsigned char)ok;
+    target->rtt_ns[target->window_pos] = rtt_ns;
+    target->window_pos = (target->window_pos + 1) % MONITOR_WINDOW;
+    if (target->window_count < MONITOR_WINDOW) target->window_count++;
+
+    if (ok) {
+        target->consecutive_ok++;
+        target->consecutive_fail = 0;
+    } else {
+        target->consecutive_fail++;
+        target->consecutive_ok = 0;
+    }
+
+    unsigned int samples;
+    unsigned long long median_ns = monitor_window_median(target, &samples);
+    unsigned int lost = target->window_count - samples;
+    unsigned int loss_pct = 100U * lost / target->window_count;
+
+    MonitorState state = target->state;
+    if (target->consecutive_fail >= MONITOR_DOWN_AFTER) {
+        state = MONITOR_DOWN;
+    } else if (ok && (state == MONITOR_UNKNOWN ||
+                      (state == MONITOR_DOWN && target->consecutive_ok >= MONITOR_UP_AFTER))) {
+        state = MONITOR_UP;
+    } else if (state == MONITOR_UP && target->window_count >= MONITOR_WINDOW / 2 &&
+               loss_pct >= MONITOR_DEGRADED_LOSS_PCT) {
+        state = MONITOR_DEGRADED;
+    } else if (state == MONITOR_DEGRADED && loss_pct < MONITOR_DEGRADED_LOSS_PCT / 2) {
+        // Half the threshold to recover, so a borderline link does not flap
+        state = MONITOR_UP;
+    }
+
+    if (state != target->state) {
+        MonitorState previous = target->state;
+        target->state = state;
+        if (state == MONITOR_UP && previous != MONITOR_DEGRADED) target->baseline_ns = 0;
+        monitor_emit(monitor, target, monitor_state_string(state), previous, median_ns, 0);
+        return;
+    }
+
+    // Latency shift: compare the window median with the last reported one
+    if (!ok || state == MONITOR_DOWN || samples < MONITOR_LATENCY_MIN_SAMPLES) return;
+    if (target->baseline_ns == 0) {
+        target->baseline_ns = median_ns;
+        return;
+    }
+    unsigned long long base = target->baseline_ns;
+    unsigned long long delta = median_ns > base ? median_ns - base : base - median_ns;
+    if (delta >= MONITOR_LATENCY_MIN_DELTA_US * 1000ULL &&
+        (median_ns >= base * MONITOR_LATENCY_FACTOR || median_ns * MONITOR_LATENCY_FACTOR <= base)) {
+        monitor_emit(monitor, target, "latency", state, median_ns, base);
+        target->baseline_ns = median_ns;
+    }
+}
+
+/*
+ * Schedules the next probe of a target, keeping a fixed rate with jitter
+ */
+static void monitor_schedule_next(NetMonitor *monitor, MonitorTarget *target, unsigned long long now_ms)
+{
+    unsigned long long spread = (unsigned long long)target->interval_ms * MONITOR_JITTER_PERCENT / 100;
+    unsigned long long next = target->due_ms + target->interval_ms - spread + monitor_random(monitor, 2 * spread + 1);
+
+    // Fell behind (e.g. a long probe): start again one interval from now
+    if (next <= now_ms) next = now_ms + target->interval_ms;
+    target->due_ms = next;
+    timer_wheel_add(&monitor->wheel, &target->timer, next);
+}
+
+/*
+ * ============================================================================
+ * PROBES
+ * ============================================================================
+ */
+
+/*
+ * Scanner callback: one TCP probe finished
+ */
+static void monitor_tcp_result(const SweepResult *result, void *context)
+{
+    NetMonitor *monitor = context;
+    MonitorTarget *target = result->tag;
+
+    monitor_record(monitor, target, result->state == SWEEP_OPEN, result->rtt_ns);
+    monitor_schedule_next(monitor, target, monitor_now_ms());
+}
+
+/*
+ * Sends one echo request; the wheel node becomes its reply deadline
+ */
+static void monitor_send_echo(NetMonitor *monitor, MonitorTarget *target, unsigned long long now_ms)
+{
+    PingPacket packet;
+    struct sockaddr_in addr;
+
+    memset(&packet, 0, sizeof(packet));
+    packet.type = PING_ECHO_REQUEST;
+    packet.id = htons(monitor->ident);
+    packet.seq = htons((uint16_t)target->attempt);
+    packet.magic = PING_MAGIC;
+    packet.run_id = monitor->run_id;
+    packet.index = (uint32_t)(target - monitor->targets);
+    packet.attempt = target->attempt;
+    target->sent_ns = net_now_ns();
+    packet.sent_ns = target->sent_ns;
+    // Ping sockets compute the checksum themselves
+    if (monitor->icmp_raw) packet.checksum = calculate_icmp_checksum(&packet, sizeof(packet));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(target->ip);
+
+    if (sendto(monitor->icmp_fd, &packet, sizeof(packet), MSG_DONTWAIT,
+               (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        // No route, full queue...: a failed probe like any other
+        monitor_record(monitor, target, 0, 0);
+        monitor_schedule_next(monitor, target, now_ms);
+        return;
+    }
+    target->in_flight = 1;
+    timer_wheel_add(&monitor->wheel, &target->timer, now_ms + (unsigned long long)monitor->timeout_ms);
+}
+
+/*
+ * Reads every pending echo reply
+ */
+static void monitor_receive_echoes(NetMonitor *monitor)
+{
+    unsigned char buffer[256];
+    char control[CMSG_SPACE(sizeof(struct timespec))];
+    struct sockaddr_in from;
+    struct iovec iov = {buffer, sizeof(buffer)};
+    struct msghdr msg;
+
+    for (;;)
+    {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_name = &from;
+        msg.msg_namelen = sizeof(from);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        ssize_t n = recvmsg(monitor->icmp_fd, &msg, MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        unsigned long long arrival_ns = net_rx_timestamp_ns(&msg, net_now_ns());
+
+        PingPacket reply;
+        if (!ping_parse_reply(buffer, (size_t)n, monitor->icmp_raw, &reply) ||
+            reply.run_id != monitor->run_id || reply.index >= monitor->target_count) continue;
+        if (monitor->icmp_raw && ntohs(reply.id) != monitor->ident) continue;
+
+        // Only the outstanding attempt counts; late replies were already lost
+        MonitorTarget *target = &monitor->targets[reply.index];
+        if (target->port != 0 || !target->in_flight || reply.attempt != target->attempt ||
+            ntohl(from.sin_addr.s_addr) != target->ip) continue;
+
+        timer_wheel_remove(&monitor->wheel, &target->timer);
+        target->attempt++;
+        monitor_record(monitor, target, 1, arrival_ns > target->sent_ns ? arrival_ns - target->sent_ns : 0);
+        monitor_schedule_next(monitor, target, monitor_now_ms());
+    }
+}
+
+/*
+ * Wheel callback: a probe is due, or an echo reply is overdue
+ */
+static void monitor_expire(TimerNode *node, void *context)
+{
+    NetMonitor *monitor = context;
+    // The timer node is the first member of MonitorTarget
+    MonitorTarget *target = (MonitorTarget *)node;
+    unsigned long long now_ms = monitor_now_ms();
+
+    if (target->in_flight) {
+        // Only ICMP probes wait on the wheel; TCP deadlines belong to the scanner
+        target->attempt++;
+        monitor_record(monitor, target, 0, 0);
+        monitor_schedule_next(monitor, target, now_ms);
+        return;
+    }
+
+    if (target->port == 0) {
+        monitor_send_echo(monitor, target, now_ms);
+        return;
+    }
+
+    // Counted before submitting: epoll may report an immediate result inside submit
+    target->in_flight = 1;
+    if (!connect_scanner_submit_tagged(&monitor->scanner, target->ip, target->port, target)) {
+        // Scanner full: try again next tick
+        target->in_flight = 0;
+        timer_wheel_add(&monitor->wheel, &target->timer, now_ms + MONITOR_TICK_MS);
+    }
+}
+
+/*
+ * ============================================================================
+ * MAIN LOOP
+ * ============================================================================
+ */
+
+static void monitor_free(NetMonitor *monitor)
+{
+    if (monitor->has_scanner) connect_scanner_free(&monitor->scanner);
+    if (monitor->icmp_fd >= 0) close(monitor->icmp_fd);
+    if (monitor->wheel.slots) timer_wheel_free(&monitor->wheel);
+    free(monitor->targets);
+}
+
+/*
+ * Monitors every target of a targets file until SIGINT or SIGTERM
+ *
+ * Prints one line per state change on stdout and a summary on stderr.
+ *
+ * @param path: Targets file, or "-" for standard input
+ * @param default_interval_ms: Interval for targets without their own
+ * @param timeout_ms: Probe timeout (TCP connect and echo reply)
+ * @return: Process exit status (0 on success)
+ */
+int run_monitor_mode(const char *path, unsigned int default_interval_ms, int timeout_ms)
+{
+    NetMonitor monitor;
+    memset(&monitor, 0, sizeof(monitor));
+    monitor.icmp_fd = -1;
+    monitor.timeout_ms = timeout_ms > 0 ? timeout_ms : MONITOR_DEFAULT_TIMEOUT_MS;
+    if (default_interval_ms == 0) default_interval_ms = MONITOR_DEFAULT_INTERVAL_MS;
+    rtt_histogram_init(&monitor.rtt);
+
+    if (!monitor_load_targets(&monitor, path, default_interval_ms)) {
+        monitor_free(&monitor);
+        return 1;
+    }
+
+    unsigned long long start_ms = monitor_now_ms();
+    if (!timer_wheel_init(&monitor.wheel, MONITOR_WHEEL_SLOTS, MONITOR_TICK_MS, start_ms)) {
+        monitor_free(&monitor);
+        return 1;
+    }
+
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd < 0) {
+        fprintf(stderr, "❌ epoll_create1 failed: %s\n", strerror(errno));
+        monitor_free(&monitor);
+        return 1;
+    }
+    struct epoll_event event;
+    event.events = EPOLLIN;
+
+    if (monitor.tcp_count > 0) {
+        size_t in_flight = monitor.tcp_count < SWEEP_DEFAULT_INFLIGHT ? monitor.tcp_count : SWEEP_DEFAULT_INFLIGHT;
+        if (!connect_scanner_init(&monitor.scanner, in_flight, monitor.timeout_ms, monitor_tcp_result, &monitor)) {
+            close(epfd);
+            monitor_free(&monitor);
+            return 1;
+        }
+        monitor.has_scanner = 1;
+        event.data.fd = connect_scanner_fd(&monitor.scanner);
+        epoll_ctl(epfd, EPOLL_CTL_ADD, event.data.fd, &event);
+    }
+    if (monitor.icmp_count > 0) {
+        monitor.icmp_fd = ping_open_socket(&monitor.icmp_raw);
+        if (monitor.icmp_fd < 0) {
+            close(epfd);
+            monitor_free(&monitor);
+            return 1;
+        }
+        monitor.ident = (unsigned short)(getpid() & 0xFFFF);
+        monitor.run_id = (unsigned int)(net_now_ns() ^ ((unsigned long long)getpid() << 32));
+        event.data.fd = monitor.icmp_fd;
+        epoll_ctl(epfd, EPOLL_CTL_ADD, monitor.icmp_fd, &event);
+    }
+
+    // First probes spread over one interval
+    monitor.rng = net_now_ns() | 1;
+    for (size_t i = 0; i < monitor.target_count; i++)
+    {
+        MonitorTarget *target = &monitor.targets[i];
+        target->due_ms = start_ms + monitor_random(&monitor, target->interval_ms);
+        timer_wheel_add(&monitor.wheel, &target->timer, target->due_ms);
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = monitor_on_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    fprintf(stderr, "👀 Monitoring %zu targets (%zu TCP, %zu ICMP), %d ms timeout, Ctrl-C to stop\n",
+            monitor.target_count, monitor.tcp_count, monitor.icmp_count, monitor.timeout_ms);
+
+    struct epoll_event events[8];
+    while (!monitor_stop_signal)
+    {
+        int count = epoll_wait(epfd, events, 8, MONITOR_TICK_MS);
+        if (count < 0 && errno != EINTR) {
+            fprintf(stderr, "❌ epoll_wait failed: %s\n", strerror(errno));
+            break;
+        }
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.fd == monitor.icmp_fd) monitor_receive_echoes(&monitor);
+        }
+
+        timer_wheel_advance(&monitor.wheel, monitor_now_ms(), monitor_expire, &monitor);
+
+        // Collects TCP results and pushes the connects just submitted
+        if (monitor.has_scanner && monitor.scanner.inflight > 0) connect_scanner_run_once(&monitor.scanner, 0);
+    }
+    close(epfd);
+
+    size_t up = 0, degraded = 0, down = 0;
+    for (size_t i = 0; i < monitor.target_count; i++) {
+        if (monitor.targets[i].state == MONITOR_UP) up++;
+        else if (monitor.targets[i].state == MONITOR_DEGRADED) degraded++;
+        else if (monitor.targets[i].state == MONITOR_DOWN) down++;
+    }
+
+    char summary[256];
+    rtt_histogram_summary(&monitor.rtt, summary, sizeof(summary));
+    fprintf(stderr, "\n✅ %llu probes (%llu failed), %llu events in %.1f s: %zu up, %zu degraded, %zu down\n",
+            monitor.probes, monitor.failures, monitor.events,
+            (double)(monitor_now_ms() - start_ms) / 1000.0, up, degraded, down);
+    fprintf(stderr, "📊 RTT %s\n", summary);
+
+    monitor_free(&monitor);
+    return 0;
+}
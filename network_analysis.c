@@ -24,84 +24,31 @@
  */
 
 /*
- * Prints comprehensive network analysis for a specific IP and subnet mask
- * 
- * This function calculates and displays:
- * - Network address (first IP in range)
- * - Broadcast address (last IP in range)  
- * - First usable IP (network + 1)
- * - Last usable IP (broadcast - 1)
- * - Total available IP count
+ * Shared body of print_ip_range() and print_ip_range_cidr()
  * 
- * Special handling for:
- * - /32 networks (single host)
- * - /31 networks (point-to-point links)
- * - Normal networks (subtract network and broadcast)
- * 
- * @param network_ip: IP address string (any IP in the network)
- * @param mask_str: Subnet mask string like "255.255.255.0"
+ * @param network_ip: IP address string as given by the user
+ * @param ip: Parsed IP address
+ * @param prefix: Prefix length of the mask (0-32)
  */
-void print_ip_range(const char *network_ip, const char *mask_str)
+static void print_ip_range_values(const char *network_ip, unsigned int ip, int prefix)
 {
-    printf("🎯 Analyzing specific network containing IP: %s\n", network_ip);
-    
-    // ========================================================================
-    // STEP 1: CONVERT STRINGS TO INTEGERS FOR MATHEMATICAL OPERATIONS
-    // ========================================================================
-    
-    unsigned int ip = ip_to_int(network_ip);
-    unsigned int mask = mask_to_int(mask_str);
-    
-    // Validate conversions
-    if (ip == 0 || mask == 0)
-    {
-        printf("❌ Invalid IP address or subnet mask format.\n");
-        printf("   IP: %s → %u\n", network_ip, ip);
-        printf("   Mask: %s → %u\n", mask_str, mask);
-        return;
-    }
+    const PrefixInfo *info = &NET_PREFIX_TABLE[prefix];
+    const char *mask_str = info->dotted;
+    const char *bin_mask = info->binary;
     
     // ========================================================================
     // STEP 2: CALCULATE NETWORK AND BROADCAST ADDRESSES
     // ========================================================================
     
-    unsigned int network = calculate_network_address(ip, mask);
-    unsigned int broadcast = calculate_broadcast_address(network, mask);
+    unsigned int network = calculate_network_address(ip, info->mask);
+    unsigned int broadcast = calculate_broadcast_address(network, info->mask);
     
     // ========================================================================
     // STEP 3: ANALYZE HOST BITS FOR SPECIAL CASES
     // ========================================================================
     
-    // We need to count host bits to handle special cases (/31, /32)
-    char *input_copy = copy_input(mask_str);
-    if (!input_copy) {
-        printf("❌ Memory allocation failed\n");
-        return;
-    }
-    
-    int *mask_array = prepar_mask(input_copy);
-    if (!mask_array) {
-        printf("❌ Failed to parse subnet mask\n");
-        free(input_copy);
-        return;
-    }
-    
-    char *bin_mask = mask_bin_single(mask_array);
-    if (!bin_mask) {
-        printf("❌ Failed to convert mask to binary\n");
-        free(input_copy);
-        return;
-    }
-    
-    // Count host bits (number of 0s from the right)
-    int host_bits = 0;
-    for (int i = 31; i >= 0; i--)
-    {
-        if (bin_mask[i] == '0')
-            host_bits++;
-        else
-            break;  // Stop at first 1 bit from right
-    }
+    // Host bits follow directly from the prefix length of the mask
+    int host_bits = 32 - prefix;
     
     printf("📊 Host bits detected: %d (CIDR: /%d)\n", host_bits, 32 - host_bits);
     
@@ -187,8 +134,90 @@ void print_ip_range(const char *network_ip, const char *mask_str)
     
     if (network_str) free(network_str);
     if (broadcast_str) free(broadcast_str);
-    free(bin_mask);
-    free(input_copy);
+}
+
+/*
+ * Prints comprehensive network analysis for a specific IP and subnet mask
+ * 
+ * This function calculates and displays:
+ * - Network address (first IP in range)
+ * - Broadcast address (last IP in range)  
+ * - First usable IP (network + 1)
+ * - Last usable IP (broadcast - 1)
+ * - Total available IP count
+ * 
+ * Special handling for:
+ * - /32 networks (single host)
+ * - /31 networks (point-to-point links)
+ * - Normal networks (subtract network and broadcast)
+ * 
+ * @param network_ip: IP address string (any IP in the network)
+ * @param mask_str: Subnet mask string like "255.255.255.0"
+ */
+void print_ip_range(const char *network_ip, const char *mask_str)
+{
+    // Records (--format or quiet profile): the same analysis, no trace
+    if (use_result_records())
+    {
+        char input[RESULT_INPUT_MAX];
+        snprintf(input, sizeof(input), "%s %s", network_ip, mask_str);
+        emit_network_result(input);
+        return;
+    }
+    
+    printf("🎯 Analyzing specific network containing IP: %s\n", network_ip);
+    
+    // ========================================================================
+    // STEP 1: CONVERT STRINGS TO INTEGERS FOR MATHEMATICAL OPERATIONS
+    // ========================================================================
+    
+    unsigned int ip = ip_to_int(network_ip);
+    unsigned int mask = mask_to_int(mask_str);
+    
+    // Validate conversions
+    if (ip == 0 || mask == 0)
+    {
+        printf("❌ Invalid IP address or subnet mask format.\n");
+        printf("   IP: %s → %u\n", network_ip, ip);
+        printf("   Mask: %s → %u\n", mask_str, mask);
+        return;
+    }
+    
+    // We need the prefix length to handle special cases (/31, /32)
+    int mask_array[4];
+    int prefix;
+    if (!prepar_mask(mask_str, mask_array, &prefix)) {
+        printf("❌ Failed to parse subnet mask\n");
+        return;
+    }
+    
+    print_ip_range_values(network_ip, ip, prefix);
+}
+
+/*
+ * Prints the same analysis as print_ip_range() for CIDR input
+ * 
+ * The mask, its binary form and the host count are taken from
+ * NET_PREFIX_TABLE, so no mask string is built or parsed.
+ * 
+ * @param network_ip: IP address string (any IP in the network)
+ * @param prefix_len: CIDR prefix length (1-32)
+ */
+void print_ip_range_cidr(const char *network_ip, int prefix_len)
+{
+    printf("🎯 Analyzing specific network containing IP: %s\n", network_ip);
+    
+    unsigned int ip = ip_to_int(network_ip);
+    
+    if (ip == 0 || prefix_len < 1 || prefix_len > 32)
+    {
+        printf("❌ Invalid IP address or prefix length.\n");
+        printf("   IP: %s → %u\n", network_ip, ip);
+        printf("   Prefix: /%d\n", prefix_len);
+        return;
+    }
+    
+    print_ip_range_values(network_ip, ip, prefix_len);
 }
 
 /*
@@ -230,30 +259,15 @@ void print_ip_range_from_mask(const char *mask_str)
     // ANALYZE HOST BITS FOR PATTERN UNDERSTANDING
     // ========================================================================
     
-    char *input_copy = copy_input(mask_str);
-    if (!input_copy) return;
-    
-    int *mask_array = prepar_mask(input_copy);
-    if (!mask_array) {
-        free(input_copy);
-        return;
-    }
+    int mask_array[4];
+    int prefix;
+    if (!prepar_mask(mask_str, mask_array, &prefix)) return;
     
     char *bin_mask = mask_bin_single(mask_array);
-    if (!bin_mask) {
-        free(input_copy);
-        return;
-    }
+    if (!bin_mask) return;
     
-    // Count host bits
-    int host_bits = 0;
-    for (int i = 31; i >= 0; i--)
-    {
-        if (bin_mask[i] == '0')
-            host_bits++;
-        else
-            break;
-    }
+    // Host bits follow directly from the prefix length of the mask
+    int host_bits = 32 - prefix;
     
     // ========================================================================
     // DISPLAY THEORETICAL NETWORK INFORMATION
@@ -340,5 +354,4 @@ void print_ip_range_from_mask(const char *mask_str)
     if (network_str) free(network_str);
     if (broadcast_str) free(broadcast_str);
     free(bin_mask);
-    free(input_copy);
 }
@@ -16,7 +16,7 @@
  * Mathematical Foundation:
  * - TCP Sequence Numbers: Random initial value × state transitions
  * - ICMP Checksum: Sum of 16-bit words, then one's complement
- * - RTT Calculation: (end_time - start_time) in milliseconds
+ * - RTT Calculation: (end_time - start_time) in nanoseconds (CLOCK_MONOTONIC)
  * - Port Status: Based on socket connection result codes
  * 
  * Author: Network Tools Development Team
@@ -27,6 +27,7 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netinet/ip.h>
+#include <linux/icmp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -37,6 +38,9 @@
 #include <limits.h>
 #include <string.h>
 
+static int service_scan_emit(unsigned int target, const unsigned short *ports, size_t count,
+                             int timeout_ms);
+
 /*
  * ============================================================================
  * TCP CONNECTIVITY CHECK
@@ -47,22 +51,6 @@
  * Shows how kernel manages state transitions and sequence numbers.
  */
 
-/*
- * Calculates elapsed time in milliseconds between two timevals
- * Mathematical Formula: (end.tv_sec - start.tv_sec) × 1000 + 
- *                       (end.tv_usec - start.tv_usec) / 1000
- * 
- * @param start: Starting time structure
- * @param end: Ending time structure
- * @return: Elapsed milliseconds
- */
-static long calculate_elapsed_ms(struct timeval start, struct timeval end)
-{
-    long seconds = (end.tv_sec - start.tv_sec) * 1000;
-    long microseconds = (end.tv_usec - start.tv_usec) / 1000;
-    return seconds + microseconds;
-}
-
 /*
  * Performs TCP connection attempt with non-blocking socket and timeout
  * 
@@ -87,9 +75,6 @@ static long calculate_elapsed_ms(struct timeval start, struct timeval end)
  */
 int check_tcp_connectivity(const char *ip, int port, int timeout_sec)
 {
-    struct timeval start_time, end_time;
-    gettimeofday(&start_time, NULL);
-    
     // Validate port range
     if (port < 1 || port > 65535)
     {
@@ -97,6 +82,18 @@ int check_tcp_connectivity(const char *ip, int port, int timeout_sec)
         return 0;
     }
     
+    // Records (--format or quiet profile): a single record, no trace
+    if (use_result_records())
+    {
+        unsigned int host;
+        unsigned short target_port = (unsigned short)port;
+        if (net_parse_ipv4(ip, &host) != NET_OK) {
+            fprintf(stderr, "❌ Invalid IP address: %s\n", ip);
+            return 0;
+        }
+        return service_scan_emit(host, &target_port, 1, timeout_sec * 1000) == 1;
+    }
+    
     print_colored("\033[94m", "┌─ TCP CONNECTIVITY CHECK ─────────────────────────────\n");
     print_colored("\033[94m", "│ Target: ");
     print_colored("\033[97m", "%s:%d\n", ip, port);
@@ -149,6 +146,8 @@ int check_tcp_connectivity(const char *ip, int port, int timeout_sec)
     printf("   Kernel generates random initial sequence number (ISN)\n");
     printf("   Socket enters SYN_SENT state...\n");
     
+    // The clock starts at the SYN, not at the trace output above
+    unsigned long long start_ns = net_now_ns();
     int connect_result = connect(sock, (struct sockaddr *)&server_addr, 
                                  sizeof(server_addr));
     
@@ -176,6 +175,7 @@ int check_tcp_connectivity(const char *ip, int port, int timeout_sec)
     timeout.tv_usec = 0;
     
     int select_result = select(sock + 1, NULL, &write_set, NULL, &timeout);
+    unsigned long long end_ns = net_now_ns();
     
     if (select_result <= 0)
     {
@@ -203,21 +203,21 @@ int check_tcp_connectivity(const char *ip, int port, int timeout_sec)
     printf("   ✅ Connection established (ESTABLISHED state)\n\n");
     
     // Step 7: Calculate RTT
-    gettimeofday(&end_time, NULL);
-    long rtt_ms = calculate_elapsed_ms(start_time, end_time);
+    unsigned long long rtt_ns = end_ns - start_ns;
+    char rtt_text[NET_DURATION_STRLEN];
+    net_format_duration(rtt_ns, rtt_text);
     
     print_colored("\033[96m", "📍 Step 7: Measure Round-Trip Time\n");
-    printf("   Start Time:  %ld.%06ld seconds\n", start_time.tv_sec, 
-           start_time.tv_usec);
-    printf("   End Time:    %ld.%06ld seconds\n", end_time.tv_sec, 
-           end_time.tv_usec);
-    printf("   RTT Formula: (end_sec - start_sec) × 1000 + (end_usec - start_usec) / 1000\n");
-    printf("   RTT Calculation: (elapsed milliseconds) = %ld ms\n\n", rtt_ms);
+    printf("   Clock: CLOCK_MONOTONIC (nanoseconds, unaffected by wall-clock changes)\n");
+    printf("   Start Time:  %llu ns (SYN sent)\n", start_ns);
+    printf("   End Time:    %llu ns (socket writable)\n", end_ns);
+    printf("   RTT Formula: end_ns - start_ns\n");
+    printf("   RTT Calculation: %llu ns = %s\n\n", rtt_ns, rtt_text);
     
     // Step 8: Print success summary
     print_colored("\033[92m", "┌─ TCP CONNECTION SUCCESSFUL ──────────────────────────\n");
     print_colored("\033[92m", "│ ✅ Target is reachable and responding\n");
-    print_colored("\033[92m", "│ 📊 Response Time: %ld milliseconds\n", rtt_ms);
+    print_colored("\033[92m", "│ 📊 Response Time: %s\n", rtt_text);
     print_colored("\033[92m", "│ 🔌 Port %d is OPEN\n", port);
     print_colored("\033[92m", "└────────────────────────────────────────────────────────\n\n");
     
@@ -249,7 +249,7 @@ int check_tcp_connectivity(const char *ip, int port, int timeout_sec)
  * @param len: Length of data in bytes
  * @return: 16-bit checksum value
  */
-static unsigned short calculate_icmp_checksum(void *data, int len)
+unsigned short calculate_icmp_checksum(void *data, int len)
 {
     unsigned short *ptr = (unsigned short *)data;
     unsigned int sum = 0;
@@ -295,7 +295,7 @@ static unsigned short calculate_icmp_checksum(void *data, int len)
  * Educational Trace:
  * - Shows packet construction step-by-step
  * - Calculates checksum with formula
- * - Measures RTT using gettimeofday() precision
+ * - Measures RTT in nanoseconds (CLOCK_MONOTONIC, kernel receive stamps)
  * - Displays time differences mathematically
  * 
  * @param ip: Target IP address string
@@ -323,6 +323,15 @@ int perform_icmp_ping(const char *ip, int packet_count, int timeout_sec)
         return 0;
     }
     
+    // Only echo replies (on loopback the raw socket also sees our own requests)
+    struct icmp_filter filter;
+    filter.data = ~(1U << ICMP_ECHOREPLY);
+    setsockopt(sock, SOL_RAW, ICMP_FILTER, &filter, sizeof(filter));
+    
+    // Ask the kernel to stamp each reply on arrival
+    int stamp = 1;
+    setsockopt(sock, SOL_SOCKET, SO_TIMESTAMPNS, &stamp, sizeof(stamp));
+    
     // Prepare target address
     struct sockaddr_in target_addr;
     memset(&target_addr, 0, sizeof(target_addr));
@@ -346,8 +355,8 @@ int perform_icmp_ping(const char *ip, int packet_count, int timeout_sec)
     
     uint16_t icmp_id = (uint16_t)(getpid() & 0xFFFF);
     int success_count = 0;
-    long min_rtt = LLONG_MAX, max_rtt = 0;
-    long total_rtt = 0;
+    RttHistogram rtt_hist;
+    rtt_histogram_init(&rtt_hist);
     
     print_colored("\033[96m", "📍 Sending ICMP Echo Requests\n\n");
     
@@ -364,7 +373,6 @@ int perform_icmp_ping(const char *ip, int packet_count, int timeout_sec)
         } icmp_packet;
         
         char send_buffer[64];
-        struct timeval send_time, recv_time;
         
         // Clear packet buffer
         memset(&icmp_packet, 0, sizeof(icmp_packet));
@@ -378,8 +386,8 @@ int perform_icmp_ping(const char *ip, int packet_count, int timeout_sec)
         icmp_packet.checksum = 0;      // Will calculate after filling data
         
         // Store current time as payload for RTT calculation
-        gettimeofday(&send_time, NULL);
-        memcpy(&icmp_packet.data, &send_time, sizeof(send_time));
+        unsigned long long send_ns = net_now_ns();
+        memcpy(&icmp_packet.data, &send_ns, sizeof(send_ns));
         
         // Copy to send buffer
         memcpy(send_buffer, &icmp_packet, sizeof(icmp_packet));
@@ -416,32 +424,37 @@ int perform_icmp_ping(const char *ip, int packet_count, int timeout_sec)
         timeout.tv_usec = 0;
         setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
         
-        // Receive ICMP reply
+        // Receive ICMP reply (with the kernel's arrival stamp as control data)
         struct sockaddr_in reply_addr;
-        socklen_t reply_addr_len = sizeof(reply_addr);
         char recv_buffer[256];
+        char control[CMSG_SPACE(sizeof(struct timespec))];
+        struct iovec iov = {recv_buffer, sizeof(recv_buffer)};
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_name = &reply_addr;
+        msg.msg_namelen = sizeof(reply_addr);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
         
-        int bytes_recv = recvfrom(sock, recv_buffer, sizeof(recv_buffer), 0,
-                                  (struct sockaddr *)&reply_addr, &reply_addr_len);
+        int bytes_recv = recvmsg(sock, &msg, 0);
         
         if (bytes_recv > 0)
         {
-            gettimeofday(&recv_time, NULL);
-            long rtt_ms = calculate_elapsed_ms(send_time, recv_time);
+            unsigned long long recv_ns = net_rx_timestamp_ns(&msg, net_now_ns());
+            unsigned long long rtt_ns = recv_ns - send_ns;
+            char rtt_text[NET_DURATION_STRLEN];
             
             printf("   ✅ Echo Reply received from %s\n", ip);
             printf("   📊 RTT Calculation:\n");
-            printf("      Send Time:  %ld.%06ld seconds\n", send_time.tv_sec, 
-                   send_time.tv_usec);
-            printf("      Recv Time:  %ld.%06ld seconds\n", recv_time.tv_sec, 
-                   recv_time.tv_usec);
-            printf("      RTT = (recv_sec - send_sec)×1000 + (recv_usec - send_usec)/1000\n");
-            printf("      RTT = %ld milliseconds\n\n", rtt_ms);
+            printf("      Send Time:  %llu ns (monotonic)\n", send_ns);
+            printf("      Recv Time:  %llu ns (kernel arrival stamp)\n", recv_ns);
+            printf("      RTT = recv_ns - send_ns\n");
+            printf("      RTT = %llu ns = %s\n\n", rtt_ns, net_format_duration(rtt_ns, rtt_text));
             
             success_count++;
-            total_rtt += rtt_ms;
-            if (rtt_ms < min_rtt) min_rtt = rtt_ms;
-            if (rtt_ms > max_rtt) max_rtt = rtt_ms;
+            rtt_histogram_record(&rtt_hist, rtt_ns);
         }
         else
         {
@@ -460,12 +473,10 @@ int perform_icmp_ping(const char *ip, int packet_count, int timeout_sec)
     if (success_count > 0)
     {
         float loss = ((float)(packet_count - success_count) / packet_count) * 100;
-        long avg_rtt = total_rtt / success_count;
         
         printf("   Packet Loss: %.1f%%\n", loss);
-        printf("   Min RTT: %ld ms\n", min_rtt);
-        printf("   Max RTT: %ld ms\n", max_rtt);
-        printf("   Avg RTT: %ld ms\n\n", avg_rtt);
+        rtt_histogram_print(&rtt_hist);
+        printf("\n");
         
         print_colored("\033[92m", "✅ Host is reachable\n\n");
         return 1;
@@ -487,12 +498,6 @@ int perform_icmp_ping(const char *ip, int packet_count, int timeout_sec)
  * and state monitoring. Shows which ports are open/closed/filtered.
  */
 
-typedef struct
-{
-    const char *name;
-    int port;
-} CommonPort;
-
 static const CommonPort COMMON_PORTS[] = {
     {"SSH", 22},
     {"Telnet", 23},
@@ -511,6 +516,114 @@ static const CommonPort COMMON_PORTS[] = {
 
 #define NUM_COMMON_PORTS (sizeof(COMMON_PORTS) / sizeof(COMMON_PORTS[0]))
 
+/*
+ * Returns the table of well-known service ports
+ * 
+ * @param count: Receives the number of entries
+ * @return: Pointer to the static table
+ */
+const CommonPort *get_common_ports(size_t *count)
+{
+    *count = NUM_COMMON_PORTS;
+    return COMMON_PORTS;
+}
+
+/*
+ * Returns the service name of a well-known port
+ * 
+ * @param port: TCP port
+ * @return: Name from the common port table, or NULL if unknown
+ */
+const char *common_port_name(unsigned int port)
+{
+    for (size_t i = 0; i < NUM_COMMON_PORTS; i++)
+    {
+        if ((unsigned int)COMMON_PORTS[i].port == port) return COMMON_PORTS[i].name;
+    }
+    return NULL;
+}
+
+/*
+ * Stores a finished probe at the index passed as its tag
+ */
+static void service_result_store(const SweepResult *result, void *context)
+{
+    SweepResult *results = context;
+    results[(size_t)result->tag] = *result;
+}
+
+/*
+ * Probes ports of one host and writes one ServiceResult record per port
+ * 
+ * Used instead of the educational trace when --format selects
+ * machine-readable output. Records follow the order of the port list.
+ * 
+ * @param target: Host (host byte order)
+ * @param ports: Ports to probe
+ * @param count: Number of ports
+ * @param timeout_ms: Per-connection deadline
+ * @return: Number of open ports, or -1 if the scanner could not start
+ */
+static int service_scan_emit(unsigned int target, const unsigned short *ports, size_t count,
+                             int timeout_ms)
+{
+    SweepResult *results = calloc(count, sizeof(SweepResult));
+    if (!results) {
+        fprintf(stderr, "❌ Memory allocation failed for %zu results\n", count);
+        return -1;
+    }
+    
+    ConnectScanner scanner;
+    if (!connect_scanner_init(&scanner, count, timeout_ms, service_result_store, results)) {
+        free(results);
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        results[i].ip = target;
+        results[i].port = ports[i];
+        results[i].state = SWEEP_ERROR;
+        connect_scanner_submit_tagged(&scanner, target, ports[i], (void *)i);
+    }
+    connect_scanner_drain(&scanner);
+    connect_scanner_free(&scanner);
+    
+    ResultSink sink;
+    int open_count = 0;
+    if (!result_sink_open(&sink, get_result_format(), STDOUT_FILENO)) {
+        free(results);
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        ServiceResult record = {
+            target, results[i].port, sweep_state_string(results[i].state),
+            common_port_name(results[i].port), results[i].rtt_ns
+        };
+        result_sink_emit(&sink, &RESULT_SCHEMA_SERVICE, &record, 0);
+        if (results[i].state == SWEEP_OPEN) open_count++;
+    }
+    result_sink_close(&sink);
+    free(results);
+    return open_count;
+}
+
+/*
+ * Records a finished probe in the slot of its port
+ */
+static void service_scan_record(const SweepResult *result, void *context)
+{
+    SweepResult *results = context;
+    
+    for (size_t i = 0; i < NUM_COMMON_PORTS; i++)
+    {
+        if (COMMON_PORTS[i].port == result->port) {
+            results[i] = *result;
+            return;
+        }
+    }
+}
+
 /*
  * Scans common service ports on target IP with parallel non-blocking approach
  * 
@@ -518,14 +631,30 @@ static const CommonPort COMMON_PORTS[] = {
  * 1. Create socket for each port
  * 2. Set to non-blocking mode
  * 3. Initiate connections in parallel
- * 4. Use select() to check which sockets are connected
+ * 4. Use epoll to learn which sockets finished, with a deadline per socket
  * 5. Classify as OPEN/CLOSED based on connection result
  * 
+ * The work is done by the connect scanner (network_sweep.c), which is
+ * the same engine the --sweep mode uses for whole networks.
+ * 
  * @param ip: Target IP address string
  * @param timeout_sec: Connection timeout
  */
 void scan_services_in_range(const char *ip, int timeout_sec)
 {
+    if (use_result_records())
+    {
+        unsigned int host;
+        unsigned short ports[NUM_COMMON_PORTS];
+        if (net_parse_ipv4(ip, &host) != NET_OK) {
+            fprintf(stderr, "❌ Invalid IP address: %s\n", ip);
+            return;
+        }
+        for (size_t i = 0; i < NUM_COMMON_PORTS; i++) ports[i] = (unsigned short)COMMON_PORTS[i].port;
+        service_scan_emit(host, ports, NUM_COMMON_PORTS, timeout_sec * 1000);
+        return;
+    }
+    
     print_colored("\033[94m", "┌─ SERVICE DISCOVERY SCAN ──────────────────────────────\n");
     print_colored("\033[94m", "│ Target: ");
     print_colored("\033[97m", "%s\n", ip);
@@ -537,111 +666,69 @@ void scan_services_in_range(const char *ip, int timeout_sec)
     print_colored("\033[96m", "📍 Service Discovery Algorithm\n");
     printf("   1. Create non-blocking socket for each port\n");
     printf("   2. Initiate connection attempt (SYN packet)\n");
-    printf("   3. Monitor all sockets with select()\n");
+    printf("   3. Monitor all sockets with epoll (deadline per socket)\n");
     printf("   4. Classify result: OPEN = connected, CLOSED = refused\n\n");
     
-    struct sockaddr_in target_addr;
-    memset(&target_addr, 0, sizeof(target_addr));
-    target_addr.sin_family = AF_INET;
-    
-    if (inet_pton(AF_INET, ip, &target_addr.sin_addr) <= 0)
+    unsigned int target;
+    if (net_parse_ipv4(ip, &target) != NET_OK)
     {
         print_colored("\033[91m", "❌ Invalid IP address: %s\n", ip);
         return;
     }
     
-    int sockets[NUM_COMMON_PORTS];
-    int open_count = 0;
+    SweepResult results[NUM_COMMON_PORTS];
+    memset(results, 0, sizeof(results));
+    for (size_t i = 0; i < NUM_COMMON_PORTS; i++) results[i].state = SWEEP_ERROR;
     
-    // Create non-blocking sockets and initiate connections
-    print_colored("\033[96m", "📍 Initiating Connections\n\n");
-    
-    for (size_t i = 0; i < NUM_COMMON_PORTS; i++)
+    ConnectScanner scanner;
+    if (!connect_scanner_init(&scanner, NUM_COMMON_PORTS, timeout_sec * 1000,
+                              service_scan_record, results))
     {
-        target_addr.sin_port = htons(COMMON_PORTS[i].port);
-        
-        sockets[i] = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-        if (sockets[i] < 0)
-        {
-            printf("   ⚠️  Port %5d: Socket creation failed\n", 
-                   COMMON_PORTS[i].port);
-            sockets[i] = -1;
-            continue;
-        }
-        
-        // Set non-blocking mode
-        int flags = fcntl(sockets[i], F_GETFL, 0);
-        fcntl(sockets[i], F_SETFL, flags | O_NONBLOCK);
-        
-        // Attempt connection
-        int result = connect(sockets[i], (struct sockaddr *)&target_addr, 
-                            sizeof(target_addr));
-        
-        if (result < 0 && errno != EINPROGRESS)
-        {
-            printf("   ❌ Port %5d %-15s: Connection error\n", 
-                   COMMON_PORTS[i].port, COMMON_PORTS[i].name);
-            close(sockets[i]);
-            sockets[i] = -1;
-        }
+        print_colored("\033[91m", "❌ Could not start the connect scanner\n");
+        return;
     }
     
-    printf("\n");
-    
-    // Wait for connections with select()
-    print_colored("\033[96m", "📍 Waiting for Responses (select)\n\n");
-    
-    fd_set write_set;
-    FD_ZERO(&write_set);
+    // Initiate all connections at once
+    print_colored("\033[96m", "📍 Initiating Connections\n\n");
     
-    int max_fd = 0;
     for (size_t i = 0; i < NUM_COMMON_PORTS; i++)
     {
-        if (sockets[i] >= 0)
-        {
-            FD_SET(sockets[i], &write_set);
-            if (sockets[i] > max_fd)
-                max_fd = sockets[i];
-        }
+        connect_scanner_submit(&scanner, target, (unsigned short)COMMON_PORTS[i].port);
     }
     
-    struct timeval timeout;
-    timeout.tv_sec = timeout_sec;
-    timeout.tv_usec = 0;
-    
-    select(max_fd + 1, NULL, &write_set, NULL, &timeout);
+    // Wait until every socket connected, failed or hit its deadline
+    print_colored("\033[96m", "📍 Waiting for Responses (epoll)\n\n");
+    connect_scanner_drain(&scanner);
+    connect_scanner_free(&scanner);
     
-    // Check which ports are open
+    // Report in table order
     print_colored("\033[96m", "📍 Results\n\n");
     
+    size_t open_count = 0;
     for (size_t i = 0; i < NUM_COMMON_PORTS; i++)
     {
-        if (sockets[i] < 0)
-            continue;
-        
-        int error = 0;
-        socklen_t error_len = sizeof(error);
-        getsockopt(sockets[i], SOL_SOCKET, SO_ERROR, &error, &error_len);
-        
-        if (error == 0 && FD_ISSET(sockets[i], &write_set))
+        if (results[i].state == SWEEP_OPEN)
         {
             print_colored("\033[92m", "   ✅ Port %5d %-15s: OPEN\n", 
                          COMMON_PORTS[i].port, COMMON_PORTS[i].name);
             open_count++;
         }
+        else if (results[i].state == SWEEP_ERROR)
+        {
+            printf("   ❌ Port %5d %-15s: Connection error\n", 
+                   COMMON_PORTS[i].port, COMMON_PORTS[i].name);
+        }
         else
         {
             printf("   ❌ Port %5d %-15s: CLOSED/FILTERED\n", 
                    COMMON_PORTS[i].port, COMMON_PORTS[i].name);
         }
-        
-        close(sockets[i]);
     }
     
     printf("\n");
     print_colored("\033[96m", "📊 Summary\n");
     printf("   Total Ports Scanned: %lu\n", NUM_COMMON_PORTS);
-    printf("   Open Ports: %d\n", open_count);
+    printf("   Open Ports: %zu\n", open_count);
     printf("   Closed/Filtered: %lu\n\n", NUM_COMMON_PORTS - open_count);
 }
 
@@ -661,6 +748,13 @@ void scan_services_in_range(const char *ip, int timeout_sec)
  */
 void generate_diagnostics_report(const char *ip)
 {
+    // Records: one ping record, then one service record per common port
+    if (use_result_records())
+    {
+        if (emit_ping_result(ip, 3, 5)) scan_services_in_range(ip, 3);
+        return;
+    }
+    
     draw_header_box("🔧 NETWORK DIAGNOSTICS REPORT", ip);
     
     printf("\n");
@@ -0,0 +1,670 @@
+/*
+ * ============================================================================
+ * NETWORK SWEEP - EPOLL CONNECT SCANNER FOR WHOLE CIDR RANGES
+ * ============================================================================
+ *
+ * This file implements a TCP connect scanner that keeps thousands of
+ * non-blocking connection attempts in flight at once, and the --sweep mode
+ * that drives it over every usable host of a CIDR × a list of ports.
+ *
+ * Why not select()?
+ * - select() is limited to FD_SETSIZE (1024) descriptors
+ * - every call rescans the whole descriptor set: O(n) per wakeup
+ * epoll reports only the sockets that changed, so the cost per completed
+ * connection stays constant no matter how many are in flight.
+ *
+ * Connection life cycle:
+ *   submit → socket() + connect() (non-blocking)
+ *          → immediate result (local RST / connect) or EINPROGRESS
+ *   EPOLLOUT / EPOLLERR → SO_ERROR tells open / refused / unreachable
+ *   deadline on the timer wheel → timeout (filtered)
+ * Every finished attempt is reported through the result callback as soon
+ * as it completes, so results stream out while the sweep continues.
+ *
+ * The scanner is embeddable: callers submit targets, then call
+ * connect_scanner_run_once() from their own loop (its epoll descriptor can
+ * itself be watched by an outer epoll instance).
+ *
+ * Backends: epoll (this file) is always available. Where the kernel
+ * supports it, an io_uring backend (sweep_uring.c) batches the socket,
+ * connect and timeout of many targets into a single system call; it is
+ * chosen automatically, or forced with NET_SWEEP_BACKEND=epoll|io_uring.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+/*
+ * ============================================================================
+ * SCANNER CORE
+ * ============================================================================
+ */
+
+/*
+ * Returns monotonic time in milliseconds
+ */
+static unsigned long long sweep_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000ULL + (unsigned long long)ts.tv_nsec / 1000000ULL;
+}
+
+/*
+ * Maps a connect() error code to a sweep state
+ */
+SweepState sweep_state_from_errno(int error)
+{
+    switch (error)
+    {
+        case 0:            return SWEEP_OPEN;
+        case ECONNREFUSED: return SWEEP_CLOSED;
+        case ETIMEDOUT:    return SWEEP_TIMEOUT;
+        case EHOSTUNREACH:
+        case ENETUNREACH:  return SWEEP_UNREACHABLE;
+        default:           return SWEEP_ERROR;
+    }
+}
+
+/*
+ * Returns the text label of a sweep state
+ */
+const char *sweep_state_string(SweepState state)
+{
+    switch (state)
+    {
+        case SWEEP_OPEN:        return "open";
+        case SWEEP_CLOSED:      return "closed";
+        case SWEEP_TIMEOUT:     return "timeout";
+        case SWEEP_UNREACHABLE: return "unreachable";
+        default:                return "error";
+    }
+}
+
+/*
+ * Returns the text label of a backend
+ */
+const char *sweep_backend_string(SweepBackend backend)
+{
+    switch (backend)
+    {
+        case SWEEP_BACKEND_EPOLL: return "epoll";
+        case SWEEP_BACKEND_URING: return "io_uring";
+        default:                  return "auto";
+    }
+}
+
+/*
+ * Reads the backend override from NET_SWEEP_BACKEND
+ *
+ * @return: The requested backend, or SWEEP_BACKEND_AUTO if unset/unknown
+ */
+static SweepBackend sweep_backend_from_env(void)
+{
+    const char *env = getenv("NET_SWEEP_BACKEND");
+    if (!env) return SWEEP_BACKEND_AUTO;
+    if (strcmp(env, "epoll") == 0) return SWEEP_BACKEND_EPOLL;
+    if (strcmp(env, "io_uring") == 0 || strcmp(env, "uring") == 0) return SWEEP_BACKEND_URING;
+    return SWEEP_BACKEND_AUTO;
+}
+
+/*
+ * Raises the open-file soft limit as far as allowed
+ *
+ * @return: The resulting soft limit
+ */
+static size_t sweep_raise_fd_limit(void)
+{
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) return 1024;
+
+    if (limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+        getrlimit(RLIMIT_NOFILE, &limit);
+    }
+    return limit.rlim_cur == RLIM_INFINITY ? (size_t)1 << 20 : (size_t)limit.rlim_cur;
+}
+
+/*
+ * Initializes a scanner
+ *
+ * The in-flight limit is lowered if the process may not open that many
+ * descriptors.
+ *
+ * The backend comes from NET_SWEEP_BACKEND, otherwise io_uring when the
+ * kernel supports it and epoll when it does not.
+ *
+ * @param scanner: Scanner to initialize
+ * @param max_inflight: Maximum simultaneous connection attempts
+ * @param timeout_ms: Per-connection deadline
+ * @param callback: Receives every finished attempt
+ * @param context: Passed to the callback
+ * @return: 1 if successful, 0 on failure
+ */
+int connect_scanner_init(ConnectScanner *scanner, size_t max_inflight, int timeout_ms,
+                         SweepCallback callback, void *context)
+{
+    return connect_scanner_init_backend(scanner, sweep_backend_from_env(), max_inflight,
+                                        timeout_ms, callback, context);
+}
+
+/*
+ * Initializes a scanner on a specific backend
+ *
+ * SWEEP_BACKEND_URING falls back to epoll (with a warning) if the kernel
+ * lacks the required io_uring operations; SWEEP_BACKEND_AUTO falls back
+ * silently.
+ *
+ * @param scanner: Scanner to initialize
+ * @param backend: Requested backend
+ * @param max_inflight: Maximum simultaneous connection attempts
+ * @param timeout_ms: Per-connection deadline
+ * @param callback: Receives every finished attempt
+ * @param context: Passed to the callback
+ * @return: 1 if successful, 0 on failure
+ */
+int connect_scanner_init_backend(ConnectScanner *scanner, SweepBackend backend, size_t max_inflight,
+                                 int timeout_ms, SweepCallback callback, void *context)
+{
+    memset(scanner, 0, sizeof(*scanner));
+    scanner->epfd = -1;
+
+    size_t fd_limit = sweep_raise_fd_limit();
+    if (fd_limit > SWEEP_RESERVED_FDS && max_inflight > fd_limit - SWEEP_RESERVED_FDS) {
+        fprintf(stderr, "⚠️  Concurrency lowered from %zu to %zu (open file limit)\n",
+                max_inflight, fd_limit - SWEEP_RESERVED_FDS);
+        max_inflight = fd_limit - SWEEP_RESERVED_FDS;
+    }
+    if (max_inflight == 0) max_inflight = 1;
+
+    scanner->connections = calloc(max_inflight, sizeof(SweepConnection));
+    scanner->free_slots = malloc(max_inflight * sizeof(unsigned int));
+    if (!scanner->connections || !scanner->free_slots) {
+        fprintf(stderr, "❌ Memory allocation failed for connect scanner\n");
+        connect_scanner_free(scanner);
+        return 0;
+    }
+
+    for (size_t i = 0; i < max_inflight; i++) {
+        scanner->connections[i].fd = -1;
+        scanner->free_slots[i] = (unsigned int)(max_inflight - 1 - i);
+    }
+    scanner->free_count = max_inflight;
+    scanner->max_inflight = max_inflight;
+    scanner->timeout_ms = timeout_ms > 0 ? timeout_ms : SWEEP_DEFAULT_TIMEOUT_MS;
+    scanner->callback = callback;
+    scanner->context = context;
+
+    if (backend != SWEEP_BACKEND_EPOLL) {
+        if (sweep_uring_init(scanner)) {
+            scanner->backend = SWEEP_BACKEND_URING;
+            return 1;
+        }
+        if (backend == SWEEP_BACKEND_URING) {
+            fprintf(stderr, "⚠️  io_uring connect backend unavailable, using epoll\n");
+        }
+    }
+    scanner->backend = SWEEP_BACKEND_EPOLL;
+
+    scanner->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (scanner->epfd < 0) {
+        fprintf(stderr, "❌ epoll_create1 failed: %s\n", strerror(errno));
+        connect_scanner_free(scanner);
+        return 0;
+    }
+
+    if (!timer_wheel_init(&scanner->wheel, SWEEP_WHEEL_SLOTS, SWEEP_TICK_MS, sweep_now_ms())) {
+        connect_scanner_free(scanner);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Reports a finished attempt through the callback
+ *
+ * The slot stays in use until sweep_release() is called.
+ */
+void sweep_report(ConnectScanner *scanner, SweepConnection *conn, SweepState state, int error)
+{
+    SweepResult result;
+    result.ip = conn->ip;
+    result.port = conn->port;
+    result.state = state;
+    result.error = error;
+    result.tag = conn->tag;
+    result.rtt_ns = net_now_ns() - conn->start_ns;
+
+    scanner->completed++;
+    if (state == SWEEP_OPEN) scanner->open_count++;
+
+    if (scanner->callback) scanner->callback(&result, scanner->context);
+}
+
+/*
+ * Returns a finished attempt's slot to the free stack
+ */
+void sweep_release(ConnectScanner *scanner, SweepConnection *conn)
+{
+    scanner->free_slots[scanner->free_count++] = (unsigned int)(conn - scanner->connections);
+    scanner->inflight--;
+}
+
+/*
+ * Closes the socket of a finished attempt
+ */
+void sweep_close(SweepConnection *conn, SweepState state)
+{
+    if (conn->fd < 0) return;
+
+    if (state == SWEEP_OPEN) {
+        // Reset instead of FIN: no TIME_WAIT left behind per open port
+        struct linger reset = {1, 0};
+        setsockopt(conn->fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+    }
+    close(conn->fd);  // also removes it from the epoll set
+    conn->fd = -1;
+}
+
+/*
+ * Epoll backend: closes, recycles and reports a finished attempt
+ */
+static void sweep_finish(ConnectScanner *scanner, SweepConnection *conn, SweepState state, int error)
+{
+    timer_wheel_remove(&scanner->wheel, &conn->timer);
+    sweep_close(conn, state);
+    sweep_release(scanner, conn);
+    sweep_report(scanner, conn, state, error);
+}
+
+/*
+ * Timer wheel callback: the connection ran past its deadline
+ */
+static void sweep_expire(TimerNode *node, void *context)
+{
+    // The timer node is the first member of SweepConnection
+    sweep_finish(context, (SweepConnection *)node, SWEEP_TIMEOUT, ETIMEDOUT);
+}
+
+/*
+ * Starts one connection attempt
+ *
+ * On epoll, immediate outcomes (e.g. a refused connect to a local
+ * address) are reported through the callback before this function
+ * returns. On io_uring the target is only queued; it reaches the kernel
+ * with the next connect_scanner_run_once().
+ *
+ * @param scanner: Scanner
+ * @param ip: Target address (host byte order)
+ * @param port: Target port
+ * @return: 1 if the target was accepted, 0 if all slots are busy
+ */
+int connect_scanner_submit(ConnectScanner *scanner, unsigned int ip, unsigned short port)
+{
+    return connect_scanner_submit_tagged(scanner, ip, port, NULL);
+}
+
+/*
+ * Starts one connection attempt carrying a caller value
+ *
+ * The tag comes back in SweepResult.tag, so one scanner can serve many
+ * independent requests.
+ *
+ * @param scanner: Scanner
+ * @param ip: Target address (host byte order)
+ * @param port: Target port
+ * @param tag: Any caller value
+ * @return: 1 if the target was accepted, 0 if all slots are busy
+ */
+int connect_scanner_submit_tagged(ConnectScanner *scanner, unsigned int ip, unsigned short port, void *tag)
+{
+    if (scanner->free_count == 0) return 0;
+
+    unsigned int slot = scanner->free_slots[--scanner->free_count];
+    SweepConnection *conn = &scanner->connections[slot];
+    conn->ip = ip;
+    conn->port = port;
+    conn->tag = tag;
+    conn->start_ns = net_now_ns();
+    conn->timer.next = NULL;
+    conn->timer.prev = NULL;
+    scanner->inflight++;
+    scanner->submitted++;
+
+    if (scanner->backend == SWEEP_BACKEND_URING) return sweep_uring_submit(scanner, conn);
+
+    conn->fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+    if (conn->fd < 0) {
+        sweep_finish(scanner, conn, SWEEP_ERROR, errno);
+        return 1;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(ip);
+
+    if (connect(conn->fd, (struct sockaddr *)&addr, sizeof(addr)) == 0) {
+        sweep_finish(scanner, conn, SWEEP_OPEN, 0);
+        return 1;
+    }
+    if (errno != EINPROGRESS) {
+        int error = errno;
+        sweep_finish(scanner, conn, sweep_state_from_errno(error), error);
+        return 1;
+    }
+
+    struct epoll_event event;
+    event.events = EPOLLOUT;
+    event.data.ptr = conn;
+    if (epoll_ctl(scanner->epfd, EPOLL_CTL_ADD, conn->fd, &event) != 0) {
+        sweep_finish(scanner, conn, SWEEP_ERROR, errno);
+        return 1;
+    }
+
+    timer_wheel_add(&scanner->wheel, &conn->timer,
+                    conn->start_ns / 1000000ULL + (unsigned long long)scanner->timeout_ms);
+    return 1;
+}
+
+/*
+ * Waits for connection events and fires expired deadlines
+ *
+ * @param scanner: Scanner
+ * @param max_wait_ms: Longest time to block (0 = poll, -1 = until a tick)
+ * @return: Number of attempts completed during this call
+ */
+size_t connect_scanner_run_once(ConnectScanner *scanner, int max_wait_ms)
+{
+    if (scanner->backend == SWEEP_BACKEND_URING) return sweep_uring_run_once(scanner, max_wait_ms);
+
+    struct epoll_event events[SWEEP_EVENT_BATCH];
+    size_t before = scanner->completed;
+
+    // Never sleep past the next tick while deadlines are pending
+    int wait_ms = max_wait_ms;
+    if (scanner->inflight > 0 && (wait_ms < 0 || wait_ms > SWEEP_TICK_MS)) wait_ms = SWEEP_TICK_MS;
+
+    int count = epoll_wait(scanner->epfd, events, SWEEP_EVENT_BATCH, wait_ms);
+    if (count < 0 && errno != EINTR) {
+        fprintf(stderr, "❌ epoll_wait failed: %s\n", strerror(errno));
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        SweepConnection *conn = events[i].data.ptr;
+        int error = 0;
+        socklen_t error_len = sizeof(error);
+
+        if (getsockopt(conn->fd, SOL_SOCKET, SO_ERROR, &error, &error_len) != 0) error = errno;
+        sweep_finish(scanner, conn, sweep_state_from_errno(error), error);
+    }
+
+    timer_wheel_advance(&scanner->wheel, sweep_now_ms(), sweep_expire, scanner);
+    return scanner->completed - before;
+}
+
+/*
+ * Returns the descriptor an outer event loop should watch
+ *
+ * It becomes readable when connect_scanner_run_once() has completions to
+ * collect: the epoll instance itself, or the io_uring ring descriptor.
+ * Deadlines on the epoll backend still need a call every SWEEP_TICK_MS.
+ *
+ * @param scanner: Scanner
+ * @return: Pollable file descriptor
+ */
+int connect_scanner_fd(const ConnectScanner *scanner)
+{
+    if (scanner->backend == SWEEP_BACKEND_URING) return sweep_uring_fd(scanner);
+    return scanner->epfd;
+}
+
+/*
+ * Runs until every submitted attempt has finished
+ *
+ * @param scanner: Scanner
+ */
+void connect_scanner_drain(ConnectScanner *scanner)
+{
+    while (scanner->inflight > 0) connect_scanner_run_once(scanner, -1);
+}
+
+/*
+ * Closes all sockets and releases scanner memory (no callbacks are made)
+ *
+ * @param scanner: Scanner
+ */
+void connect_scanner_free(ConnectScanner *scanner)
+{
+    // Tearing down the ring cancels its operations before the sockets close
+    sweep_uring_free(scanner);
+    if (scanner->connections) {
+        for (size_t i = 0; i < scanner->max_inflight; i++) {
+            if (scanner->connections[i].fd >= 0) close(scanner->connections[i].fd);
+        }
+    }
+    if (scanner->epfd >= 0) close(scanner->epfd);
+    if (scanner->wheel.slots) timer_wheel_free(&scanner->wheel);
+    free(scanner->connections);
+    free(scanner->free_slots);
+    memset(scanner, 0, sizeof(*scanner));
+    scanner->epfd = -1;
+}
+
+/*
+ * ============================================================================
+ * PORT LISTS
+ * ============================================================================
+ */
+
+/*
+ * Parses a port list such as "22,80,443,8000-8100"
+ *
+ * @param spec: Port list, or NULL for the common service ports
+ * @param ports_out: Receives a malloc'd array of ports (caller frees)
+ * @return: Number of ports, or 0 if the list is invalid
+ */
+size_t parse_port_list(const char *spec, unsigned short **ports_out)
+{
+    *ports_out = NULL;
+
+    if (!spec) {
+        size_t count;
+        const CommonPort *common = get_common_ports(&count);
+        unsigned short *ports = malloc(count * sizeof(unsigned short));
+        if (!ports) return 0;
+        for (size_t i = 0; i < count; i++) ports[i] = (unsigned short)common[i].port;
+        *ports_out = ports;
+        return count;
+    }
+
+    size_t count = 0;
+    size_t capacity = 64;
+    unsigned short *ports = malloc(capacity * sizeof(unsigned short));
+    if (!ports) return 0;
+
+    const char *p = spec;
+    while (*p)
+    {
+        char *end;
+        long first = strtol(p, &end, 10);
+        long last = first;
+        if (end == p) goto invalid;
+        p = end;
+        if (*p == '-') {
+            p++;
+            last = strtol(p, &end, 10);
+            if (end == p) goto invalid;
+            p = end;
+        }
+        if (first < 1 || last > 65535 || first > last) goto invalid;
+
+        for (long port = first; port <= last; port++) {
+            if (count == capacity) {
+                capacity *= 2;
+                unsigned short *grown = realloc(ports, capacity * sizeof(unsigned short));
+                if (!grown) goto invalid;
+                ports = grown;
+            }
+            ports[count++] = (unsigned short)port;
+        }
+
+        if (*p == ',') p++;
+        else if (*p != '\0') goto invalid;
+    }
+
+    *ports_out = ports;
+    return count;
+
+invalid:
+    fprintf(stderr, "❌ Invalid port list: %s (expected e.g. 22,80,8000-8100)\n", spec);
+    free(ports);
+    return 0;
+}
+
+/*
+ * ============================================================================
+ * SWEEP MODE ENTRY POINT
+ * ============================================================================
+ */
+
+typedef struct
+{
+    OutputBuffer *out;
+    ResultSink *sink;            // --format records, NULL for text lines
+    int show_all;
+    RttHistogram rtt;            // Answered probes (open or refused)
+} SweepOutput;
+
+/*
+ * Streams one finished attempt as a result line
+ *
+ * Format: "<ip> port=<port> state=<state> rtt_us=<microseconds, one decimal>"
+ * (or a ServiceResult record with --format jsonl/csv/binary)
+ */
+static void sweep_print_result(const SweepResult *result, void *context)
+{
+    SweepOutput *output = context;
+    if (result->state == SWEEP_OPEN || result->state == SWEEP_CLOSED) {
+        rtt_histogram_record(&output->rtt, result->rtt_ns);
+    }
+    if (result->state != SWEEP_OPEN && !output->show_all) return;
+
+    if (output->sink) {
+        ServiceResult record = {
+            result->ip, result->port, sweep_state_string(result->state),
+            common_port_name(result->port), result->rtt_ns
+        };
+        result_sink_emit(output->sink, &RESULT_SCHEMA_SERVICE, &record, 0);
+    } else {
+        char *w = output_buffer_reserve(output->out, SWEEP_MAX_RESULT_LENGTH);
+        int n = net_format_ipv4(result->ip, w);
+        n += snprintf(w + n, SWEEP_MAX_RESULT_LENGTH - (size_t)n, " port=%u state=%s rtt_us=%.1f\n",
+                      result->port, sweep_state_string(result->state), (double)result->rtt_ns / 1e3);
+        output->out->len += (size_t)n;
+    }
+
+    // Open ports are rare and interesting: show them without delay
+    if (result->state == SWEEP_OPEN) output_buffer_flush(output->out);
+}
+
+/*
+ * Sweeps every usable host of a CIDR against a list of ports
+ *
+ * The host range follows scan_network_range(): network + 1 through
+ * broadcast - 1, or every address for /31 and /32.
+ *
+ * @param cidr_str: Target network, e.g. "10.0.0.0/16"
+ * @param port_spec: Port list, or NULL for the common service ports
+ * @param max_inflight: Simultaneous connection attempts
+ * @param timeout_ms: Per-connection deadline
+ * @param show_all: 1 to print closed/filtered results too
+ * @return: Process exit status (0 on success)
+ */
+int run_sweep_mode(const char *cidr_str, const char *port_spec, size_t max_inflight,
+                   int timeout_ms, int show_all)
+{
+    unsigned int ip;
+    int prefix;
+
+    if (net_parse_cidr_span(cidr_str, cidr_str + strlen(cidr_str), &ip, &prefix, NULL) != NET_OK) {
+        fprintf(stderr, "❌ Invalid CIDR format: %s\n", cidr_str);
+        return 1;
+    }
+
+    unsigned short *ports;
+    size_t port_count = parse_port_list(port_spec, &ports);
+    if (port_count == 0) return 1;
+
+    const PrefixInfo *info = &NET_PREFIX_TABLE[prefix];
+    unsigned int network = ip & info->mask;
+    unsigned int broadcast = network | info->wildcard;
+    unsigned int first = prefix >= 31 ? network : network + 1;
+    unsigned int last = prefix >= 31 ? broadcast : broadcast - 1;
+
+    // Text lines go straight to the buffer; other formats through a result sink
+    ResultSink sink;
+    if (!result_sink_open(&sink, get_result_format(), STDOUT_FILENO)) {
+        free(ports);
+        return 1;
+    }
+    SweepOutput output;
+    output.out = &sink.out;
+    output.sink = get_result_format() == RESULT_FORMAT_TEXT ? NULL : &sink;
+    output.show_all = show_all;
+    rtt_histogram_init(&output.rtt);
+
+    ConnectScanner scanner;
+    if (!connect_scanner_init(&scanner, max_inflight, timeout_ms, sweep_print_result, &output)) {
+        result_sink_close(&sink);
+        free(ports);
+        return 1;
+    }
+
+    fprintf(stderr, "🔍 Sweeping %llu hosts × %zu ports (%zu in flight, %d ms timeout, %s)\n",
+            info->usable, port_count, scanner.max_inflight, scanner.timeout_ms,
+            sweep_backend_string(scanner.backend));
+    unsigned long long start_ms = sweep_now_ms();
+
+    // Host-major order; the loop variable is 64-bit so 255.255.255.255 ends cleanly
+    for (unsigned long long host = first; host <= last; host++)
+    {
+        for (size_t i = 0; i < port_count; i++) {
+            while (!connect_scanner_submit(&scanner, (unsigned int)host, ports[i])) {
+                connect_scanner_run_once(&scanner, -1);
+            }
+        }
+        // Collect whatever is ready without blocking, so results stay timely
+        connect_scanner_run_once(&scanner, 0);
+    }
+    connect_scanner_drain(&scanner);
+    result_sink_flush(&sink);
+
+    double seconds = (double)(sweep_now_ms() - start_ms) / 1000.0;
+    fprintf(stderr, "✅ %zu probes, %zu open, %.2f s (%.0f probes/s)\n",
+            scanner.completed, scanner.open_count, seconds,
+            seconds > 0 ? (double)scanner.completed / seconds : 0.0);
+    if (output.rtt.total > 0) {
+        char summary[256];
+        rtt_histogram_summary(&output.rtt, summary, sizeof(summary));
+        fprintf(stderr, "📊 RTT %s\n", summary);
+    }
+
+    connect_scanner_free(&scanner);
+    result_sink_close(&sink);
+    free(ports);
+    return 0;
+}
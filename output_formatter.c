@@ -8,7 +8,8 @@
  * 
  * Features:
  * - ANSI color support with fallback for non-color terminals
- * - Progress bars and loading animations
+ * - Buffered rendering: one write per call, escape sequences only on change
+ * - Progress bars and loading animations (skipped in the quiet profile)
  * - Beautiful box drawing and table formatting
  * - Customizable themes (dark/light mode)
  * - Eye-friendly spacing and typography
@@ -69,6 +70,152 @@
 static int use_colors = 1;
 static int current_theme = 0; // 0 = default, 1 = dark, 2 = light, 3 = cyberpunk
 
+// TERM is read once: -1 = not checked yet, then 0 or 1
+static int terminal_colors = -1;
+
+// Quiet profile (--quiet/--fast, or stdout not a terminal): no animations,
+// decorative boxes or educational trace lines
+static int quiet_mode = 0;
+
+/*
+ * ============================================================================
+ * OUTPUT BUFFER
+ * ============================================================================
+ * 
+ * Every helper in this file composes its whole output (escape sequences,
+ * box glyphs, padding) in a per-thread buffer and hands it to stdout in
+ * one fwrite(), instead of one printf() per fragment. The buffer is
+ * written out at the end of each public call, so text printed with
+ * printf() elsewhere still appears in order. Long outputs such as big
+ * tables are written every FORMAT_BUFFER_SIZE bytes.
+ * 
+ * Escape sequences are batched: a color is only emitted when it changes,
+ * and reset once at the end of a run, so a border of 60 "═" of one color
+ * costs two sequences instead of 120.
+ */
+
+#define FORMAT_BUFFER_SIZE 16384
+
+typedef struct
+{
+    size_t len;
+    const char *color;           // Color currently active in the buffer, NULL if none
+    char data[FORMAT_BUFFER_SIZE];
+} FormatBuffer;
+
+static __thread FormatBuffer format_buffer;
+
+static void fmt_flush(void)
+{
+    if (format_buffer.len > 0) {
+        fwrite(format_buffer.data, 1, format_buffer.len, stdout);
+        format_buffer.len = 0;
+    }
+}
+
+static void fmt_bytes(const char *text, size_t len)
+{
+    if (len > FORMAT_BUFFER_SIZE - format_buffer.len) {
+        fmt_flush();
+        if (len > FORMAT_BUFFER_SIZE) {
+            fwrite(text, 1, len, stdout);
+            return;
+        }
+    }
+    memcpy(format_buffer.data + format_buffer.len, text, len);
+    format_buffer.len += len;
+}
+
+static void fmt_text(const char *text)
+{
+    fmt_bytes(text, strlen(text));
+}
+
+static void fmt_repeat(const char *glyph, int count)
+{
+    size_t len = strlen(glyph);
+    for (int i = 0; i < count; i++) fmt_bytes(glyph, len);
+}
+
+static void fmt_spaces(int count)
+{
+    static const char spaces[] = "                                ";
+    while (count > 0) {
+        int n = count < (int)sizeof(spaces) - 1 ? count : (int)sizeof(spaces) - 1;
+        fmt_bytes(spaces, (size_t)n);
+        count -= n;
+    }
+}
+
+// Same as printf("%-*s", width, text)
+static void fmt_padded(const char *text, int width)
+{
+    size_t len = strlen(text);
+    fmt_bytes(text, len);
+    if ((int)len < width) fmt_spaces(width - (int)len);
+}
+
+static void fmt_vformat(const char *format, va_list args)
+{
+    va_list retry;
+    va_copy(retry, args);
+
+    size_t room = FORMAT_BUFFER_SIZE - format_buffer.len;
+    int n = vsnprintf(format_buffer.data + format_buffer.len, room, format, args);
+    if (n >= 0 && (size_t)n < room) {
+        format_buffer.len += (size_t)n;
+    } else if (n >= 0) {
+        // Did not fit behind the pending text: write that out and retry
+        fmt_flush();
+        if ((size_t)n < FORMAT_BUFFER_SIZE) {
+            format_buffer.len = (size_t)vsnprintf(format_buffer.data, FORMAT_BUFFER_SIZE, format, retry);
+        } else {
+            vfprintf(stdout, format, retry);
+        }
+    }
+    va_end(retry);
+}
+
+static void fmt_format(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    fmt_vformat(format, args);
+    va_end(args);
+}
+
+static int colors_enabled(void)
+{
+    return use_colors && terminal_supports_colors();
+}
+
+// Switches color, emitting nothing if it is already active
+static void fmt_color(const char *color)
+{
+    if (!colors_enabled()) return;
+    if (format_buffer.color == color) return;
+    if (format_buffer.color && strcmp(format_buffer.color, color) == 0) return;
+    if (format_buffer.color) fmt_text(RESET);  // Drop BOLD/DIM of the previous color
+    fmt_text(color);
+    format_buffer.color = color;
+}
+
+// Back to the terminal's default attributes
+static void fmt_plain(void)
+{
+    if (format_buffer.color) {
+        fmt_text(RESET);
+        format_buffer.color = NULL;
+    }
+}
+
+// Ends a public call: reset attributes and hand everything to stdout
+static void fmt_done(void)
+{
+    fmt_plain();
+    fmt_flush();
+}
+
 /*
  * ============================================================================
  * UTILITY FUNCTIONS
@@ -76,20 +223,19 @@ static int current_theme = 0; // 0 = default, 1 = dark, 2 = light, 3 = cyberpunk
  */
 
 /*
- * Check if terminal supports colors
+ * Check if terminal supports colors (TERM is inspected once per process)
  */
 int terminal_supports_colors(void)
 {
+    if (terminal_colors >= 0) return terminal_colors;
+
     char *term = getenv("TERM");
-    if (!term) return 0;
     
     // Check for common color-supporting terminals
-    if (strstr(term, "color") || strstr(term, "xterm") || 
-        strstr(term, "screen") || strstr(term, "tmux") ||
-        strcmp(term, "linux") == 0) {
-        return 1;
-    }
-    return 0;
+    terminal_colors = term && (strstr(term, "color") || strstr(term, "xterm") ||
+                               strstr(term, "screen") || strstr(term, "tmux") ||
+                               strcmp(term, "linux") == 0);
+    return terminal_colors;
 }
 
 /*
@@ -100,13 +246,9 @@ void print_colored(const char *color, const char *format, ...)
     va_list args;
     va_start(args, format);
     
-    if (use_colors && terminal_supports_colors()) {
-        printf("%s", color);
-        vprintf(format, args);
-        printf("%s", RESET);
-    } else {
-        vprintf(format, args);
-    }
+    fmt_color(color);
+    fmt_vformat(format, args);
+    fmt_done();
     
     va_end(args);
 }
@@ -124,6 +266,19 @@ void set_theme(int theme)
     }
 }
 
+/*
+ * Enable or disable the quiet profile
+ */
+void set_quiet_mode(int quiet)
+{
+    quiet_mode = quiet;
+}
+
+int is_quiet_mode(void)
+{
+    return quiet_mode;
+}
+
 /*
  * ============================================================================
  * ENHANCED BOX DRAWING
@@ -139,43 +294,64 @@ void draw_header_box(const char *title, const char *subtitle)
     int subtitle_len = subtitle ? strlen(subtitle) : 0;
     int box_width = (title_len > subtitle_len ? title_len : subtitle_len) + 8;
     
+    if (quiet_mode) return;
     if (box_width < 60) box_width = 60;
     
     // Top border with gradient effect
-    print_colored(BRIGHT_CYAN, "╔");
+    fmt_color(BRIGHT_CYAN);
+    fmt_text("╔");
     for (int i = 0; i < box_width - 2; i++) {
-        if (i % 4 == 0) print_colored(BRIGHT_BLUE, "═");
-        else if (i % 4 == 1) print_colored(CYAN, "═");
-        else if (i % 4 == 2) print_colored(BLUE, "═");
-        else print_colored(BRIGHT_CYAN, "═");
+        if (i % 4 == 0) fmt_color(BRIGHT_BLUE);
+        else if (i % 4 == 1) fmt_color(CYAN);
+        else if (i % 4 == 2) fmt_color(BLUE);
+        else fmt_color(BRIGHT_CYAN);
+        fmt_text("═");
     }
-    print_colored(BRIGHT_CYAN, "╗\n");
+    fmt_color(BRIGHT_CYAN);
+    fmt_text("╗");
+    fmt_plain();
+    fmt_text("\n");
     
     // Title line
-    print_colored(BRIGHT_CYAN, "║");
+    fmt_color(BRIGHT_CYAN);
+    fmt_text("║");
+    fmt_plain();
     int padding = (box_width - title_len - 2) / 2;
-    for (int i = 0; i < padding; i++) printf(" ");
-    print_colored(BOLD BRIGHT_WHITE, title);
-    for (int i = 0; i < box_width - title_len - 2 - padding; i++) printf(" ");
-    print_colored(BRIGHT_CYAN, "║\n");
+    fmt_spaces(padding);
+    fmt_color(BOLD BRIGHT_WHITE);
+    fmt_text(title);
+    fmt_plain();
+    fmt_spaces(box_width - title_len - 2 - padding);
+    fmt_color(BRIGHT_CYAN);
+    fmt_text("║");
+    fmt_plain();
+    fmt_text("\n");
     
     // Subtitle line (if provided)
     if (subtitle) {
-        print_colored(BRIGHT_CYAN, "║");
+        fmt_color(BRIGHT_CYAN);
+        fmt_text("║");
+        fmt_plain();
         padding = (box_width - subtitle_len - 2) / 2;
-        for (int i = 0; i < padding; i++) printf(" ");
-        print_colored(DIM BRIGHT_WHITE, subtitle);
-        for (int i = 0; i < box_width - subtitle_len - 2 - padding; i++) printf(" ");
-        print_colored(BRIGHT_CYAN, "║\n");
+        fmt_spaces(padding);
+        fmt_color(DIM BRIGHT_WHITE);
+        fmt_text(subtitle);
+        fmt_plain();
+        fmt_spaces(box_width - subtitle_len - 2 - padding);
+        fmt_color(BRIGHT_CYAN);
+        fmt_text("║");
+        fmt_plain();
+        fmt_text("\n");
     }
     
     // Bottom border
-    print_colored(BRIGHT_CYAN, "╚");
-    for (int i = 0; i < box_width - 2; i++) {
-        print_colored(BRIGHT_CYAN, "═");
-    }
-    print_colored(BRIGHT_CYAN, "╝\n");
-    printf("\n");
+    fmt_color(BRIGHT_CYAN);
+    fmt_text("╚");
+    fmt_repeat("═", box_width - 2);
+    fmt_text("╝");
+    fmt_plain();
+    fmt_text("\n\n");
+    fmt_done();
 }
 
 /*
@@ -195,26 +371,36 @@ void draw_info_box(const char *title, const char **lines, int line_count)
     if (box_width < 50) box_width = 50;
     
     // Header
-    print_colored(BRIGHT_GREEN, "┌─");
-    print_colored(BOLD BRIGHT_WHITE, title);
-    for (int i = strlen(title); i < box_width - 4; i++) {
-        print_colored(BRIGHT_GREEN, "─");
-    }
-    print_colored(BRIGHT_GREEN, "─┐\n");
+    fmt_color(BRIGHT_GREEN);
+    fmt_text("┌─");
+    fmt_color(BOLD BRIGHT_WHITE);
+    fmt_text(title);
+    fmt_color(BRIGHT_GREEN);
+    fmt_repeat("─", box_width - 4 - (int)strlen(title));
+    fmt_text("─┐");
+    fmt_plain();
+    fmt_text("\n");
     
     // Content lines
     for (int i = 0; i < line_count; i++) {
-        print_colored(BRIGHT_GREEN, "│ ");
-        printf("%-*s", box_width - 4, lines[i]);
-        print_colored(BRIGHT_GREEN, " │\n");
+        fmt_color(BRIGHT_GREEN);
+        fmt_text("│ ");
+        fmt_plain();
+        fmt_padded(lines[i], box_width - 4);
+        fmt_color(BRIGHT_GREEN);
+        fmt_text(" │");
+        fmt_plain();
+        fmt_text("\n");
     }
     
     // Footer
-    print_colored(BRIGHT_GREEN, "└");
-    for (int i = 0; i < box_width - 2; i++) {
-        print_colored(BRIGHT_GREEN, "─");
-    }
-    print_colored(BRIGHT_GREEN, "┘\n");
+    fmt_color(BRIGHT_GREEN);
+    fmt_text("└");
+    fmt_repeat("─", box_width - 2);
+    fmt_text("┘");
+    fmt_plain();
+    fmt_text("\n");
+    fmt_done();
 }
 
 /*
@@ -232,28 +418,38 @@ void show_progress_bar(const char *label, int progress, int total)
     int filled = (progress * bar_width) / total;
     int percentage = (progress * 100) / total;
     
-    printf("\r");
-    print_colored(BRIGHT_YELLOW, label);
-    printf(" [");
+    if (quiet_mode) return;
+    fmt_text("\r");
+    fmt_color(BRIGHT_YELLOW);
+    fmt_text(label);
+    fmt_plain();
+    fmt_text(" [");
     
     // Draw progress bar
     for (int i = 0; i < bar_width; i++) {
         if (i < filled) {
-            print_colored(BRIGHT_GREEN, "█");
+            fmt_color(BRIGHT_GREEN);
+            fmt_text("█");
         } else if (i == filled && progress < total) {
-            print_colored(YELLOW, "▓");
+            fmt_color(YELLOW);
+            fmt_text("▓");
         } else {
-            print_colored(DIM, "░");
+            fmt_color(DIM);
+            fmt_text("░");
         }
     }
     
-    printf("] ");
-    print_colored(BRIGHT_WHITE, "%d%%", percentage);
-    fflush(stdout);
+    fmt_plain();
+    fmt_text("] ");
+    fmt_color(BRIGHT_WHITE);
+    fmt_format("%d%%", percentage);
+    fmt_plain();
     
     if (progress >= total) {
-        printf("\n");
+        fmt_text("\n");
     }
+    fmt_done();
+    fflush(stdout);
 }
 
 /*
@@ -264,27 +460,36 @@ void show_loading_animation(const char *message, int duration_ms)
     const char *spinner = "⠋⠙⠹⠸⠼⠴⠦⠧⠇⠏";
     int spinner_len = strlen(spinner) / 3; // Each Unicode char is 3 bytes
     
-    printf("\r");
-    print_colored(BRIGHT_CYAN, message);
-    printf(" ");
+    if (quiet_mode) return;  // No delay when nobody is watching
+    fmt_text("\r");
+    fmt_color(BRIGHT_CYAN);
+    fmt_text(message);
+    fmt_plain();
+    fmt_text(" ");
     
     for (int i = 0; i < duration_ms / 100; i++) {
-        printf("\r");
-        print_colored(BRIGHT_CYAN, message);
-        printf(" ");
+        fmt_text("\r");
+        fmt_color(BRIGHT_CYAN);
+        fmt_text(message);
+        fmt_plain();
+        fmt_text(" ");
         
         // Print current spinner character
         int char_index = (i % spinner_len) * 3;
-        printf("%.3s", &spinner[char_index]);
+        fmt_bytes(&spinner[char_index], 3);
         
+        fmt_done();
         fflush(stdout);
         usleep(100000); // 100ms
     }
     
-    printf("\r");
-    print_colored(BRIGHT_GREEN, message);
-    print_colored(BRIGHT_GREEN, " ✓");
-    printf("\n");
+    fmt_text("\r");
+    fmt_color(BRIGHT_GREEN);
+    fmt_text(message);
+    fmt_text(" ✓");
+    fmt_plain();
+    fmt_text("\n");
+    fmt_done();
 }
 
 /*
@@ -293,6 +498,23 @@ void show_loading_animation(const char *message, int duration_ms)
  * ============================================================================
  */
 
+/*
+ * Draws one horizontal rule of a table ("┌──┬──┐", "├──┼──┤", "└──┴──┘")
+ */
+static void fmt_table_rule(const int *col_widths, int cols,
+                           const char *left, const char *middle, const char *right)
+{
+    fmt_color(BRIGHT_BLUE);
+    fmt_text(left);
+    for (int c = 0; c < cols; c++) {
+        fmt_repeat("─", col_widths[c]);
+        if (c < cols - 1) fmt_text(middle);
+    }
+    fmt_text(right);
+    fmt_plain();
+    fmt_text("\n");
+}
+
 /*
  * Draw a beautiful table with alternating row colors
  */
@@ -301,6 +523,10 @@ void draw_data_table(const char *title, const char **headers, const char ***data
 {
     // Calculate column widths
     int *col_widths = malloc(cols * sizeof(int));
+    if (!col_widths) {
+        fprintf(stderr, "❌ Memory allocation failed for table layout\n");
+        return;
+    }
     
     // Initialize with header widths
     for (int c = 0; c < cols; c++) {
@@ -323,60 +549,48 @@ void draw_data_table(const char *title, const char **headers, const char ***data
     }
     
     // Table title
-    printf("\n");
-    print_colored(BOLD BRIGHT_MAGENTA, "📊 %s\n", title);
+    fmt_text("\n");
+    fmt_color(BOLD BRIGHT_MAGENTA);
+    fmt_format("📊 %s\n", title);
+    fmt_plain();
     
     // Top border
-    print_colored(BRIGHT_BLUE, "┌");
-    for (int c = 0; c < cols; c++) {
-        for (int i = 0; i < col_widths[c]; i++) {
-            print_colored(BRIGHT_BLUE, "─");
-        }
-        if (c < cols - 1) print_colored(BRIGHT_BLUE, "┬");
-    }
-    print_colored(BRIGHT_BLUE, "┐\n");
+    fmt_table_rule(col_widths, cols, "┌", "┬", "┐");
     
     // Headers
-    print_colored(BRIGHT_BLUE, "│");
+    fmt_color(BRIGHT_BLUE);
+    fmt_text("│");
     for (int c = 0; c < cols; c++) {
-        print_colored(BOLD BRIGHT_WHITE, "%-*s", col_widths[c], headers[c]);
-        if (c < cols - 1) print_colored(BRIGHT_BLUE, "│");
+        fmt_color(BOLD BRIGHT_WHITE);
+        fmt_padded(headers[c], col_widths[c]);
+        fmt_color(BRIGHT_BLUE);
+        fmt_text("│");
     }
-    print_colored(BRIGHT_BLUE, "│\n");
+    fmt_plain();
+    fmt_text("\n");
     
     // Header separator
-    print_colored(BRIGHT_BLUE, "├");
-    for (int c = 0; c < cols; c++) {
-        for (int i = 0; i < col_widths[c]; i++) {
-            print_colored(BRIGHT_BLUE, "─");
-        }
-        if (c < cols - 1) print_colored(BRIGHT_BLUE, "┼");
-    }
-    print_colored(BRIGHT_BLUE, "┤\n");
+    fmt_table_rule(col_widths, cols, "├", "┼", "┤");
     
     // Data rows with alternating colors
     for (int r = 0; r < rows; r++) {
-        print_colored(BRIGHT_BLUE, "│");
+        const char *row_color = (r % 2 == 0) ? BRIGHT_WHITE : WHITE;
+        fmt_color(BRIGHT_BLUE);
+        fmt_text("│");
         for (int c = 0; c < cols; c++) {
-            if (r % 2 == 0) {
-                print_colored(BRIGHT_WHITE, "%-*s", col_widths[c], data[r][c]);
-            } else {
-                print_colored(WHITE, "%-*s", col_widths[c], data[r][c]);
-            }
-            if (c < cols - 1) print_colored(BRIGHT_BLUE, "│");
+            fmt_color(row_color);
+            fmt_padded(data[r][c], col_widths[c]);
+            fmt_color(BRIGHT_BLUE);
+            fmt_text("│");
         }
-        print_colored(BRIGHT_BLUE, "│\n");
+        fmt_plain();
+        fmt_text("\n");
     }
     
     // Bottom border
-    print_colored(BRIGHT_BLUE, "└");
-    for (int c = 0; c < cols; c++) {
-        for (int i = 0; i < col_widths[c]; i++) {
-            print_colored(BRIGHT_BLUE, "─");
-        }
-        if (c < cols - 1) print_colored(BRIGHT_BLUE, "┴");
-    }
-    print_colored(BRIGHT_BLUE, "┘\n\n");
+    fmt_table_rule(col_widths, cols, "└", "┴", "┘");
+    fmt_text("\n");
+    fmt_done();
     
     free(col_widths);
 }
@@ -392,37 +606,52 @@ void draw_data_table(const char *title, const char **headers, const char ***data
  */
 void draw_network_diagram(const char *network, const char *mask, int host_count)
 {
-    printf("\n");
-    print_colored(BOLD BRIGHT_CYAN, "🌐 Network Topology Visualization\n");
-    printf("\n");
+    if (quiet_mode) return;
+    fmt_text("\n");
+    fmt_color(BOLD BRIGHT_CYAN);
+    fmt_text("🌐 Network Topology Visualization\n");
+    fmt_plain();
+    fmt_text("\n");
     
     // Network box
-    print_colored(BRIGHT_GREEN, "    ┌─────────────────────────────────┐\n");
-    print_colored(BRIGHT_GREEN, "    │ ");
-    print_colored(BOLD BRIGHT_WHITE, "Network: %-19s", network);
-    print_colored(BRIGHT_GREEN, " │\n");
-    print_colored(BRIGHT_GREEN, "    │ ");
-    print_colored(BRIGHT_WHITE, "Mask:    %-19s", mask);
-    print_colored(BRIGHT_GREEN, " │\n");
-    print_colored(BRIGHT_GREEN, "    │ ");
-    print_colored(BRIGHT_YELLOW, "Hosts:   %-19d", host_count);
-    print_colored(BRIGHT_GREEN, " │\n");
-    print_colored(BRIGHT_GREEN, "    └─────────────────────────────────┘\n");
+    fmt_color(BRIGHT_GREEN);
+    fmt_text("    ┌─────────────────────────────────┐\n");
+    fmt_text("    │ ");
+    fmt_color(BOLD BRIGHT_WHITE);
+    fmt_format("Network: %-19s", network);
+    fmt_color(BRIGHT_GREEN);
+    fmt_text(" │\n");
+    fmt_text("    │ ");
+    fmt_color(BRIGHT_WHITE);
+    fmt_format("Mask:    %-19s", mask);
+    fmt_color(BRIGHT_GREEN);
+    fmt_text(" │\n");
+    fmt_text("    │ ");
+    fmt_color(BRIGHT_YELLOW);
+    fmt_format("Hosts:   %-19d", host_count);
+    fmt_color(BRIGHT_GREEN);
+    fmt_text(" │\n");
+    fmt_text("    └─────────────────────────────────┘\n");
     
     // Connection lines
-    print_colored(BRIGHT_BLUE, "                    │\n");
-    print_colored(BRIGHT_BLUE, "            ┌───────┼───────┐\n");
-    print_colored(BRIGHT_BLUE, "            │       │       │\n");
+    fmt_color(BRIGHT_BLUE);
+    fmt_text("                    │\n");
+    fmt_text("            ┌───────┼───────┐\n");
+    fmt_text("            │       │       │\n");
     
     // Host representations
-    print_colored(BRIGHT_MAGENTA, "        ┌─────┐ ┌─────┐ ┌─────┐\n");
-    print_colored(BRIGHT_MAGENTA, "        │Host1│ │Host2│ │Host3│\n");
-    print_colored(BRIGHT_MAGENTA, "        └─────┘ └─────┘ └─────┘\n");
+    fmt_color(BRIGHT_MAGENTA);
+    fmt_text("        ┌─────┐ ┌─────┐ ┌─────┐\n");
+    fmt_text("        │Host1│ │Host2│ │Host3│\n");
+    fmt_text("        └─────┘ └─────┘ └─────┘\n");
     
     if (host_count > 3) {
-        print_colored(DIM, "            ... and %d more hosts\n", host_count - 3);
+        fmt_color(DIM);
+        fmt_format("            ... and %d more hosts\n", host_count - 3);
     }
-    printf("\n");
+    fmt_plain();
+    fmt_text("\n");
+    fmt_done();
 }
 
 /*
@@ -430,14 +659,20 @@ void draw_network_diagram(const char *network, const char *mask, int host_count)
  */
 void display_ip_info_enhanced(const char *label, const char *ip, const char *description)
 {
-    print_colored(BRIGHT_CYAN, "  🔸 ");
-    print_colored(BOLD BRIGHT_WHITE, "%-20s", label);
-    print_colored(BRIGHT_GREEN, "%s", ip);
+    fmt_color(BRIGHT_CYAN);
+    fmt_text("  🔸 ");
+    fmt_color(BOLD BRIGHT_WHITE);
+    fmt_padded(label, 20);
+    fmt_color(BRIGHT_GREEN);
+    fmt_text(ip);
     
     if (description) {
-        print_colored(DIM, " (%s)", description);
+        fmt_color(DIM);
+        fmt_format(" (%s)", description);
     }
-    printf("\n");
+    fmt_plain();
+    fmt_text("\n");
+    fmt_done();
 }
 
 /*
@@ -445,19 +680,28 @@ void display_ip_info_enhanced(const char *label, const char *ip, const char *des
  */
 void show_calculation_steps(const char *title, const char **steps, int step_count)
 {
-    printf("\n");
-    print_colored(BOLD BRIGHT_YELLOW, "🧮 %s\n", title);
-    print_colored(BRIGHT_YELLOW, "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+    if (quiet_mode) return;
+    fmt_text("\n");
+    fmt_color(BOLD BRIGHT_YELLOW);
+    fmt_format("🧮 %s\n", title);
+    fmt_color(BRIGHT_YELLOW);
+    fmt_text("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
     
     for (int i = 0; i < step_count; i++) {
-        print_colored(BRIGHT_CYAN, "  Step %d: ", i + 1);
-        print_colored(BRIGHT_WHITE, "%s\n", steps[i]);
+        fmt_color(BRIGHT_CYAN);
+        fmt_format("  Step %d: ", i + 1);
+        fmt_color(BRIGHT_WHITE);
+        fmt_format("%s\n", steps[i]);
         
         if (i < step_count - 1) {
-            print_colored(DIM, "           ↓\n");
+            fmt_color(DIM);
+            fmt_text("           ↓\n");
         }
     }
     
-    print_colored(BRIGHT_YELLOW, "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
-    printf("\n");
+    fmt_color(BRIGHT_YELLOW);
+    fmt_text("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n");
+    fmt_plain();
+    fmt_text("\n");
+    fmt_done();
 }
@@ -0,0 +1,625 @@
+/*
+ * ============================================================================
+ * PING SWEEP - CONCURRENT MULTI-TARGET ICMP ECHO
+ * ============================================================================
+ *
+ * perform_icmp_ping() sends one echo request and blocks for its reply
+ * before the next one: pinging a /16 that way takes hours. This pinger
+ * keeps ONE ICMP socket open for the whole run:
+ *
+ * - The sending thread walks every target once per round, pacing batches
+ *   of requests to a fixed packet rate
+ * - A receive thread drains replies with recvmmsg() and matches each one
+ *   to its target and attempt through the echo payload
+ * - Per-target loss and RTT statistics are complete after a single pass
+ *
+ * --ping-sweep holds at most PING_SWEEP_WINDOW targets: larger networks
+ * are pinged one window of consecutive hosts at a time, reusing the same
+ * socket and target array, and each window is printed when it finishes.
+ *
+ * Echo payload (the reply carries it back unchanged):
+ *   [magic (4)] [run id (4)] [target index (4)] [attempt (4)] [send time ns (8)]
+ * The index makes matching O(1) with no lookup table; the run id rejects
+ * replies meant for another pinger on the same host; the reply source
+ * address must equal the target's address; a bit per attempt rejects
+ * duplicated replies.
+ *
+ * Timing: each request carries its CLOCK_MONOTONIC send time in
+ * nanoseconds, taken just before that request's own sendto(). One stamp
+ * per sendmmsg() batch would charge every packet with the send time of
+ * the packets queued ahead of it (on loopback the replies are even
+ * generated inside the call), so RTTs would grow with the position in
+ * the batch. Replies are timed by the kernel's SO_TIMESTAMPNS arrival
+ * stamp, so the receive thread's scheduling delay does not inflate the
+ * RTT either. Every RTT goes into one run-wide histogram (percentiles)
+ * and per-target min/avg/max/jitter counters.
+ *
+ * Sockets:
+ * - SOCK_DGRAM + IPPROTO_ICMP ("ping socket"): no privileges needed when
+ *   the group is allowed by net.ipv4.ping_group_range; the kernel fills
+ *   in the identifier and checksum and only delivers our own replies
+ * - SOCK_RAW fallback (root / CAP_NET_RAW): replies include the IP header;
+ *   an ICMP_FILTER keeps everything but echo replies out of the socket
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#define _GNU_SOURCE  // recvmmsg()
+#include "net.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <linux/icmp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+#define PING_RECV_BUFFER    (4 << 20)    // Room for bursts of replies
+#define PING_POLL_MS        50           // Receive thread checks for stop this often
+
+/*
+ * Sleeps until an absolute monotonic time
+ */
+static void ping_sleep_until(unsigned long long deadline_ns)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(deadline_ns / 1000000000ULL);
+    ts.tv_nsec = (long)(deadline_ns % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+}
+
+/*
+ * ============================================================================
+ * SOCKET SETUP
+ * ============================================================================
+ */
+
+/*
+ * Opens an ICMP echo socket: unprivileged ping socket first, raw second
+ *
+ * Raw sockets get an ICMP filter so only echo replies reach them. Both
+ * kinds get kernel receive stamps (SO_TIMESTAMPNS) and a large receive
+ * buffer for bursts of replies.
+ *
+ * @param raw_out: Set to 1 for a raw socket, 0 for a ping socket
+ * @return: Descriptor, or -1 if neither kind can be opened
+ */
+int ping_open_socket(int *raw_out)
+{
+    int raw = 0;
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_ICMP);
+    if (fd < 0) {
+        raw = 1;
+        fd = socket(AF_INET, SOCK_RAW | SOCK_CLOEXEC, IPPROTO_ICMP);
+    }
+    if (fd < 0) {
+        fprintf(stderr, "❌ Cannot open an ICMP socket: %s\n", strerror(errno));
+        fprintf(stderr, "   Allow ping sockets (sysctl net.ipv4.ping_group_range) or run as root\n");
+        return -1;
+    }
+
+    if (raw) {
+        // Only echo replies reach the socket (our own requests on loopback do not)
+        struct icmp_filter filter;
+        filter.data = ~(1U << ICMP_ECHOREPLY);
+        setsockopt(fd, SOL_RAW, ICMP_FILTER, &filter, sizeof(filter));
+    }
+
+    // Arrival stamps taken by the kernel, not when the thread gets to run
+    int stamp = 1;
+    setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &stamp, sizeof(stamp));
+
+    // Thousands of hosts answer in bursts; the privileged variant ignores rmem_max
+    int size = PING_RECV_BUFFER;
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) != 0) {
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    }
+
+    *raw_out = raw;
+    return fd;
+}
+
+/*
+ * Extracts an echo reply carrying our payload from a received datagram
+ *
+ * @param data: Received bytes (starting with the IP header on raw sockets)
+ * @param len: Number of bytes
+ * @param raw: 1 if received on a raw socket
+ * @param reply: Receives the packet
+ * @return: 1 for an echo reply with PING_MAGIC, 0 for anything else
+ */
+int ping_parse_reply(const unsigned char *data, size_t len, int raw, PingPacket *reply)
+{
+    // Raw sockets deliver the IP header first
+    if (raw) {
+        if (len < sizeof(struct iphdr)) return 0;
+        size_t header_len = (size_t)(((const struct iphdr *)data)->ihl) * 4;
+        if (header_len > len) return 0;
+        data += header_len;
+        len -= header_len;
+    }
+
+    if (len < sizeof(*reply)) return 0;
+    memcpy(reply, data, sizeof(*reply));
+    return reply->type == PING_ECHO_REPLY && reply->magic == PING_MAGIC;
+}
+
+/*
+ * ============================================================================
+ * PINGER CORE
+ * ============================================================================
+ */
+
+/*
+ * Initializes a pinger for a list of targets
+ *
+ * @param pinger: Pinger to initialize
+ * @param ips: Target addresses (host byte order), copied; NULL to only
+ *             reserve room for target_count targets (see multi_pinger_set_range)
+ * @param target_count: Number of targets
+ * @param count: Echo requests per target (1-PING_SWEEP_MAX_COUNT)
+ * @param timeout_ms: How long a reply may take after its request
+ * @param rate: Packets per second across all targets
+ * @return: 1 if successful, 0 on failure
+ */
+int multi_pinger_init(MultiPinger *pinger, const unsigned int *ips, size_t target_count,
+                      int count, int timeout_ms, unsigned int rate)
+{
+    memset(pinger, 0, sizeof(*pinger));
+    pinger->fd = -1;
+
+    if (count < 1 || count > PING_SWEEP_MAX_COUNT) {
+        fprintf(stderr, "❌ Echo count must be 1-%d\n", PING_SWEEP_MAX_COUNT);
+        return 0;
+    }
+
+    pinger->targets = calloc(target_count, sizeof(PingTarget));
+    if (!pinger->targets) {
+        fprintf(stderr, "❌ Memory allocation failed for %zu ping targets\n", target_count);
+        return 0;
+    }
+    for (size_t i = 0; ips && i < target_count; i++) {
+        pinger->targets[i].ip = ips[i];
+        pinger->targets[i].rtt_min_ns = ~0ULL;
+    }
+    rtt_histogram_init(&pinger->rtt);
+
+    pinger->fd = ping_open_socket(&pinger->raw);
+    if (pinger->fd < 0) {
+        multi_pinger_free(pinger);
+        return 0;
+    }
+
+    pinger->target_count = ips ? target_count : 0;
+    pinger->target_capacity = target_count;
+    pinger->count = count;
+    pinger->timeout_ms = timeout_ms > 0 ? timeout_ms : PING_SWEEP_DEFAULT_TIMEOUT_MS;
+    pinger->rate = rate > 0 ? rate : PING_SWEEP_DEFAULT_RATE;
+    pinger->ident = (unsigned short)(getpid() & 0xFFFF);
+    pinger->run_id = (unsigned int)(net_now_ns() ^ ((unsigned long long)getpid() << 32));
+    return 1;
+}
+
+/*
+ * Replaces the targets with consecutive addresses for the next pass
+ *
+ * Run-wide counters and the RTT histogram keep accumulating. The run id
+ * changes, so late replies to the previous pass count as foreign instead
+ * of landing on the target that now has their index.
+ *
+ * @param pinger: Pinger initialized with enough room
+ * @param first: First address (host byte order)
+ * @param target_count: Number of targets (at most the reserved room)
+ */
+void multi_pinger_set_range(MultiPinger *pinger, unsigned int first, size_t target_count)
+{
+    if (target_count > pinger->target_capacity) target_count = pinger->target_capacity;
+
+    memset(pinger->targets, 0, target_count * sizeof(PingTarget));
+    for (size_t i = 0; i < target_count; i++) {
+        pinger->targets[i].ip = first + (unsigned int)i;
+        pinger->targets[i].rtt_min_ns = ~0ULL;
+    }
+    pinger->target_count = target_count;
+    pinger->run_id++;
+}
+
+/*
+ * Matches one received echo reply to its target and records it
+ *
+ * Runs on the receive thread only, which owns every received_* field.
+ */
+static void pinger_record_reply(MultiPinger *pinger, const unsigned char *data, size_t len,
+                                const struct sockaddr_in *from, unsigned long long arrival_ns)
+{
+    PingPacket reply;
+    if (!ping_parse_reply(data, len, pinger->raw, &reply) || reply.run_id != pinger->run_id) {
+        pinger->foreign++;
+        return;
+    }
+    if (pinger->raw && ntohs(reply.id) != pinger->ident) {
+        pinger->foreign++;
+        return;
+    }
+    if (reply.index >= pinger->target_count || reply.attempt >= (uint32_t)pinger->count ||
+        ntohs(reply.seq) != (uint16_t)reply.attempt) {
+        pinger->foreign++;
+        return;
+    }
+
+    PingTarget *target = &pinger->targets[reply.index];
+    if (ntohl(from->sin_addr.s_addr) != target->ip) {
+        pinger->foreign++;
+        return;
+    }
+
+    unsigned long long bit = 1ULL << reply.attempt;
+    if (target->received_mask & bit) {
+        target->duplicates++;
+        return;
+    }
+
+    unsigned long long rtt_ns = arrival_ns > reply.sent_ns ? arrival_ns - reply.sent_ns : 0;
+    if (rtt_ns > (unsigned long long)pinger->timeout_ms * 1000000ULL) {
+        pinger->late++;
+        return;
+    }
+
+    // RFC 3550 jitter over this target's consecutive replies
+    if (target->received > 0) {
+        double delta = rtt_ns > target->last_rtt_ns ? (double)(rtt_ns - target->last_rtt_ns)
+                                                    : (double)(target->last_rtt_ns - rtt_ns);
+        target->jitter_ns += (delta - target->jitter_ns) / 16.0;
+    }
+    target->last_rtt_ns = rtt_ns;
+
+    target->received_mask |= bit;
+    target->received++;
+    target->rtt_sum_ns += rtt_ns;
+    if (rtt_ns < target->rtt_min_ns) target->rtt_min_ns = rtt_ns;
+    if (rtt_ns > target->rtt_max_ns) target->rtt_max_ns = rtt_ns;
+    rtt_histogram_record(&pinger->rtt, rtt_ns);
+    pinger->replies++;
+}
+
+/*
+ * Receive thread: drains the socket in batches until asked to stop
+ */
+static void *pinger_receive_loop(void *arg)
+{
+    MultiPinger *pinger = arg;
+    unsigned char buffers[PING_SWEEP_BATCH][128];
+    struct sockaddr_in sources[PING_SWEEP_BATCH];
+    char controls[PING_SWEEP_BATCH][CMSG_SPACE(sizeof(struct timespec))];
+    struct iovec iov[PING_SWEEP_BATCH];
+    struct mmsghdr messages[PING_SWEEP_BATCH];
+
+    for (int i = 0; i < PING_SWEEP_BATCH; i++) {
+        iov[i].iov_base = buffers[i];
+        iov[i].iov_len = sizeof(buffers[i]);
+    }
+
+    struct pollfd pfd = {pinger->fd, POLLIN, 0};
+    while (!__atomic_load_n(&pinger->stop, __ATOMIC_ACQUIRE))
+    {
+        if (poll(&pfd, 1, PING_POLL_MS) <= 0) continue;
+
+        for (;;)
+        {
+            memset(messages, 0, sizeof(messages));
+            for (int i = 0; i < PING_SWEEP_BATCH; i++) {
+                messages[i].msg_hdr.msg_iov = &iov[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+                messages[i].msg_hdr.msg_name = &sources[i];
+                messages[i].msg_hdr.msg_namelen = sizeof(sources[i]);
+                messages[i].msg_hdr.msg_control = controls[i];
+                messages[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+            }
+
+            int received = recvmmsg(pinger->fd, messages, PING_SWEEP_BATCH, MSG_DONTWAIT, NULL);
+            if (received <= 0) break;
+
+            unsigned long long now_ns = net_now_ns();
+            for (int i = 0; i < received; i++) {
+                unsigned long long arrival_ns = net_rx_timestamp_ns(&messages[i].msg_hdr, now_ns);
+                pinger_record_reply(pinger, buffers[i], messages[i].msg_len, &sources[i], arrival_ns);
+            }
+            if (received < PING_SWEEP_BATCH) break;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Sends one batch of echo requests, retrying when the send queue is full
+ *
+ * Each request is stamped (and, on raw sockets, checksummed) right before
+ * its own sendto(), and again before a retry, so sent_ns is the time the
+ * request was handed to the kernel.
+ */
+static void pinger_send_batch(MultiPinger *pinger, PingPacket *packets,
+                              const struct sockaddr_in *addrs, int batch)
+{
+    for (int i = 0; i < batch; i++)
+    {
+        PingPacket *packet = &packets[i];
+
+        for (;;)
+        {
+            packet->sent_ns = net_now_ns();
+            // Ping sockets compute the checksum themselves
+            packet->checksum = 0;
+            if (pinger->raw) packet->checksum = calculate_icmp_checksum(packet, sizeof(*packet));
+
+            if (sendto(pinger->fd, packet, sizeof(*packet), 0, (const struct sockaddr *)&addrs[i],
+                       sizeof(addrs[i])) >= 0) {
+                pinger->targets[packet->index].sent++;
+                break;
+            }
+            if (errno == ENOBUFS || errno == EAGAIN || errno == EINTR) {
+                ping_sleep_until(net_now_ns() + 1000000ULL);  // Let the queue drain
+                continue;
+            }
+            // Unsendable target (e.g. no route): skip it, it will show full loss
+            pinger->send_errors++;
+            break;
+        }
+    }
+}
+
+/*
+ * Runs one complete pass: every round to every target, then the reply window
+ *
+ * @param pinger: Initialized pinger
+ * @return: 1 if successful, 0 if the receive thread could not start
+ */
+int multi_pinger_run(MultiPinger *pinger)
+{
+    __atomic_store_n(&pinger->stop, 0, __ATOMIC_RELAXED);  // Left set by a previous pass
+    if (pthread_create(&pinger->receiver, NULL, pinger_receive_loop, pinger) != 0) {
+        fprintf(stderr, "❌ Cannot start the ping receive thread\n");
+        return 0;
+    }
+
+    PingPacket packets[PING_SWEEP_BATCH];
+    struct sockaddr_in addrs[PING_SWEEP_BATCH];
+
+    memset(addrs, 0, sizeof(addrs));
+    for (int i = 0; i < PING_SWEEP_BATCH; i++) addrs[i].sin_family = AF_INET;
+
+    // Batches leave at rate / PING_SWEEP_BATCH per second
+    unsigned long long batch_ns = 1000000000ULL * PING_SWEEP_BATCH / pinger->rate;
+    unsigned long long start_ns = net_now_ns();
+    unsigned long long next_ns = start_ns;
+
+    for (int attempt = 0; attempt < pinger->count; attempt++)
+    {
+        // Rounds to the same target are at least PING_SWEEP_INTERVAL_MS apart
+        unsigned long long round_ns = start_ns + (unsigned long long)attempt * PING_SWEEP_INTERVAL_MS * 1000000ULL;
+        if (next_ns < round_ns) next_ns = round_ns;
+
+        size_t index = 0;
+        while (index < pinger->target_count)
+        {
+            int batch = 0;
+            ping_sleep_until(next_ns);
+            next_ns += batch_ns;
+
+            for (; batch < PING_SWEEP_BATCH && index < pinger->target_count; batch++, index++)
+            {
+                PingPacket *packet = &packets[batch];
+                memset(packet, 0, sizeof(*packet));
+                packet->type = PING_ECHO_REQUEST;
+                packet->id = htons(pinger->ident);
+                packet->seq = htons((uint16_t)attempt);
+                packet->magic = PING_MAGIC;
+                packet->run_id = pinger->run_id;
+                packet->index = (uint32_t)index;
+                packet->attempt = (uint32_t)attempt;
+                addrs[batch].sin_addr.s_addr = htonl(pinger->targets[index].ip);
+            }
+            pinger_send_batch(pinger, packets, addrs, batch);
+        }
+    }
+
+    // Replies to the last requests may take up to the timeout
+    ping_sleep_until(net_now_ns() + (unsigned long long)pinger->timeout_ms * 1000000ULL);
+    __atomic_store_n(&pinger->stop, 1, __ATOMIC_RELEASE);
+    pthread_join(pinger->receiver, NULL);
+    return 1;
+}
+
+/*
+ * Closes the socket and releases the targets
+ *
+ * @param pinger: Pinger
+ */
+void multi_pinger_free(MultiPinger *pinger)
+{
+    if (pinger->fd >= 0) close(pinger->fd);
+    free(pinger->targets);
+    memset(pinger, 0, sizeof(*pinger));
+    pinger->fd = -1;
+}
+
+/*
+ * ============================================================================
+ * PING SWEEP MODE ENTRY POINT
+ * ============================================================================
+ */
+
+/*
+ * Writes the statistics of one target as a PingResult record
+ */
+static void ping_emit_target(ResultSink *sink, const PingTarget *target)
+{
+    PingResult record = { target->ip, target->sent, target->received, 100.0, 0, 0, 0, 0 };
+
+    if (target->sent) {
+        record.loss_pct = 100.0 * (double)(target->sent - target->received) / (double)target->sent;
+    }
+    if (target->received > 0) {
+        record.rtt_min_ns = target->rtt_min_ns;
+        record.rtt_avg_ns = target->rtt_sum_ns / target->received;
+        record.rtt_max_ns = target->rtt_max_ns;
+        record.jitter_ns = (unsigned long long)target->jitter_ns;
+    }
+    result_sink_emit(sink, &RESULT_SCHEMA_PING, &record, target->received > 0 ? 0 : PING_RESULT_RTT);
+}
+
+/*
+ * Pings one host and writes a single PingResult record (--ping without the trace)
+ *
+ * @param ip_str: Target address
+ * @param count: Echo requests
+ * @param timeout_sec: Reply deadline per request
+ * @return: 1 if the host answered, 0 otherwise
+ */
+int emit_ping_result(const char *ip_str, int count, int timeout_sec)
+{
+    unsigned int ip;
+    if (net_parse_ipv4(ip_str, &ip) != NET_OK) {
+        fprintf(stderr, "❌ Invalid IP address: %s\n", ip_str);
+        return 0;
+    }
+
+    MultiPinger pinger;
+    if (!multi_pinger_init(&pinger, &ip, 1, count, timeout_sec * 1000, PING_SWEEP_DEFAULT_RATE)) return 0;
+    if (!multi_pinger_run(&pinger)) {
+        multi_pinger_free(&pinger);
+        return 0;
+    }
+
+    ResultSink sink;
+    int alive = pinger.targets[0].received > 0;
+    if (result_sink_open(&sink, get_result_format(), STDOUT_FILENO)) {
+        ping_emit_target(&sink, &pinger.targets[0]);
+        result_sink_close(&sink);
+    }
+    multi_pinger_free(&pinger);
+    return alive;
+}
+
+/*
+ * Prints the targets of one finished pass and adds them to the run totals
+ *
+ * Only responding hosts are printed unless show_all is set.
+ */
+static void ping_emit_pass(ResultSink *sink, const MultiPinger *pinger, int show_all,
+                           size_t *alive, size_t *sent)
+{
+    OutputBuffer *out = &sink->out;
+
+    for (size_t i = 0; i < pinger->target_count; i++)
+    {
+        const PingTarget *target = &pinger->targets[i];
+        *sent += target->sent;
+        if (target->received > 0) (*alive)++;
+        if (target->received == 0 && !show_all) continue;
+
+        double loss = target->sent ? 100.0 * (double)(target->sent - target->received) / (double)target->sent : 100.0;
+        if (sink->format != RESULT_FORMAT_TEXT) {
+            ping_emit_target(sink, target);
+            continue;
+        }
+
+        char *w = output_buffer_reserve(out, PING_SWEEP_MAX_RESULT_LENGTH);
+        int n = net_format_ipv4(target->ip, w);
+        n += snprintf(w + n, PING_SWEEP_MAX_RESULT_LENGTH - (size_t)n, " sent=%u received=%u loss=%.1f%%",
+                      target->sent, target->received, loss);
+        if (target->received > 0) {
+            n += snprintf(w + n, PING_SWEEP_MAX_RESULT_LENGTH - (size_t)n,
+                          " rtt_min_us=%.1f rtt_avg_us=%.1f rtt_max_us=%.1f jitter_us=%.1f",
+                          (double)target->rtt_min_ns / 1e3,
+                          (double)target->rtt_sum_ns / 1e3 / (double)target->received,
+                          (double)target->rtt_max_ns / 1e3, target->jitter_ns / 1e3);
+        }
+        w[n++] = '\n';
+        out->len += (size_t)n;
+    }
+}
+
+/*
+ * Pings every usable host of a CIDR and prints per-target statistics
+ *
+ * Format: "<ip> sent=<n> received=<n> loss=<pct>% rtt_min_us=.. rtt_avg_us=.. rtt_max_us=.. jitter_us=.."
+ * (microseconds with one decimal), or one PingResult record per host with
+ * --format, followed by a run-wide percentile summary on stderr.
+ * Only responding hosts are printed unless show_all is set.
+ *
+ * @param cidr_str: Target network, e.g. "10.0.0.0/16"
+ * @param count: Echo requests per host
+ * @param timeout_ms: Reply deadline per request
+ * @param rate: Packets per second
+ * @param show_all: 1 to print hosts that never answered
+ * @return: Process exit status (0 on success)
+ */
+int run_ping_sweep_mode(const char *cidr_str, int count, int timeout_ms, unsigned int rate, int show_all)
+{
+    unsigned int ip;
+    int prefix;
+
+    if (net_parse_cidr_span(cidr_str, cidr_str + strlen(cidr_str), &ip, &prefix, NULL) != NET_OK) {
+        fprintf(stderr, "❌ Invalid CIDR format: %s\n", cidr_str);
+        return 1;
+    }
+
+    // Same host range as scan_network_range() and --sweep
+    const PrefixInfo *info = &NET_PREFIX_TABLE[prefix];
+    unsigned int network = ip & info->mask;
+    unsigned int first = prefix >= 31 ? network : network + 1;
+    unsigned long long host_count = info->usable;
+    size_t window = host_count < PING_SWEEP_WINDOW ? (size_t)host_count : PING_SWEEP_WINDOW;
+
+    // Targets live for the whole pass: only one window of them at a time
+    MultiPinger pinger;
+    if (!multi_pinger_init(&pinger, NULL, window, count, timeout_ms, rate)) return 1;
+
+    fprintf(stderr, "🔍 Pinging %llu hosts × %d (%u packets/s, %d ms timeout, %s socket)\n",
+            host_count, pinger.count, pinger.rate, pinger.timeout_ms, pinger.raw ? "raw" : "ping");
+    if (host_count > window) {
+        fprintf(stderr, "   %llu passes of up to %zu hosts\n", (host_count + window - 1) / window, window);
+    }
+    unsigned long long start_ns = net_now_ns();
+
+    // Text lines go straight to the buffer; other formats through a result sink
+    ResultSink sink;
+    if (!result_sink_open(&sink, get_result_format(), STDOUT_FILENO)) {
+        multi_pinger_free(&pinger);
+        return 1;
+    }
+
+    size_t alive = 0;
+    size_t sent = 0;
+    int status = 0;
+    for (unsigned long long done = 0; done < host_count; done += pinger.target_count)
+    {
+        size_t left = host_count - done < window ? (size_t)(host_count - done) : window;
+        multi_pinger_set_range(&pinger, first + (unsigned int)done, left);
+        if (!multi_pinger_run(&pinger)) {
+            status = 1;
+            break;
+        }
+        ping_emit_pass(&sink, &pinger, show_all, &alive, &sent);
+    }
+    result_sink_flush(&sink);
+
+    double seconds = (double)(net_now_ns() - start_ns) / 1e9;
+    fprintf(stderr, "✅ %zu/%llu hosts alive, %zu requests, %zu replies, %.2f s\n",
+            alive, host_count, sent, pinger.replies, seconds);
+    if (pinger.rtt.total > 0) {
+        char summary[256];
+        rtt_histogram_summary(&pinger.rtt, summary, sizeof(summary));
+        fprintf(stderr, "📊 RTT %s\n", summary);
+    }
+    if (pinger.late || pinger.send_errors) {
+        fprintf(stderr, "⚠️  %zu late replies, %zu send errors\n", pinger.late, pinger.send_errors);
+    }
+
+    result_sink_close(&sink);
+    multi_pinger_free(&pinger);
+    return status;
+}
@@ -0,0 +1,88 @@
+/*
+ * ============================================================================
+ * PREFIX LENGTH TABLE - ALL 33 IPv4 PREFIXES PRECOMPUTED
+ * ============================================================================
+ *
+ * There are only 33 possible IPv4 prefix lengths (/0 to /32), so every
+ * value derived from a prefix is stored once in a read-only table instead
+ * of being recomputed (and formatted with malloc + sprintf) on each call:
+ *
+ * - mask:     32-bit subnet mask        (/24 → 0xFFFFFF00)
+ * - wildcard: inverted mask             (/24 → 0x000000FF)
+ * - dotted:   mask as text              (/24 → "255.255.255.0")
+ * - binary:   mask as 32 '0'/'1' chars  (/24 → "111...000")
+ * - total:    addresses in the block    (/24 → 256)
+ * - usable:   host addresses            (/24 → 254, /31 → 2, /32 → 1)
+ *
+ * The table is a constant initializer, so it lives in read-only data and
+ * needs no setup at startup. Any thread can read it.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+
+const PrefixInfo NET_PREFIX_TABLE[NET_PREFIX_COUNT] = {
+    //  mask         wildcard     dotted             binary                              total           usable
+    { 0x00000000U, 0xFFFFFFFFU, "0.0.0.0",         "00000000000000000000000000000000", 4294967296ULL, 4294967294ULL },  // /0
+    { 0x80000000U, 0x7FFFFFFFU, "128.0.0.0",       "10000000000000000000000000000000", 2147483648ULL, 2147483646ULL },  // /1
+    { 0xC0000000U, 0x3FFFFFFFU, "192.0.0.0",       "11000000000000000000000000000000", 1073741824ULL, 1073741822ULL },  // /2
+    { 0xE0000000U, 0x1FFFFFFFU, "224.0.0.0",       "11100000000000000000000000000000", 536870912ULL,   536870910ULL },  // /3
+    { 0xF0000000U, 0x0FFFFFFFU, "240.0.0.0",       "11110000000000000000000000000000", 268435456ULL,   268435454ULL },  // /4
+    { 0xF8000000U, 0x07FFFFFFU, "248.0.0.0",       "11111000000000000000000000000000", 134217728ULL,   134217726ULL },  // /5
+    { 0xFC000000U, 0x03FFFFFFU, "252.0.0.0",       "11111100000000000000000000000000", 67108864ULL,     67108862ULL },  // /6
+    { 0xFE000000U, 0x01FFFFFFU, "254.0.0.0",       "11111110000000000000000000000000", 33554432ULL,     33554430ULL },  // /7
+    { 0xFF000000U, 0x00FFFFFFU, "255.0.0.0",       "11111111000000000000000000000000", 16777216ULL,     16777214ULL },  // /8
+    { 0xFF800000U, 0x007FFFFFU, "255.128.0.0",     "11111111100000000000000000000000", 8388608ULL,       8388606ULL },  // /9
+    { 0xFFC00000U, 0x003FFFFFU, "255.192.0.0",     "11111111110000000000000000000000", 4194304ULL,       4194302ULL },  // /10
+    { 0xFFE00000U, 0x001FFFFFU, "255.224.0.0",     "11111111111000000000000000000000", 2097152ULL,       2097150ULL },  // /11
+    { 0xFFF00000U, 0x000FFFFFU, "255.240.0.0",     "11111111111100000000000000000000", 1048576ULL,       1048574ULL },  // /12
+    { 0xFFF80000U, 0x0007FFFFU, "255.248.0.0",     "11111111111110000000000000000000", 524288ULL,         524286ULL },  // /13
+    { 0xFFFC0000U, 0x0003FFFFU, "255.252.0.0",     "11111111111111000000000000000000", 262144ULL,         262142ULL },  // /14
+    { 0xFFFE0000U, 0x0001FFFFU, "255.254.0.0",     "11111111111111100000000000000000", 131072ULL,         131070ULL },  // /15
+    { 0xFFFF0000U, 0x0000FFFFU, "255.255.0.0",     "11111111111111110000000000000000", 65536ULL,           65534ULL },  // /16
+    { 0xFFFF8000U, 0x00007FFFU, "255.255.128.0",   "11111111111111111000000000000000", 32768ULL,           32766ULL },  // /17
+    { 0xFFFFC000U, 0x00003FFFU, "255.255.192.0",   "11111111111111111100000000000000", 16384ULL,           16382ULL },  // /18
+    { 0xFFFFE000U, 0x00001FFFU, "255.255.224.0",   "11111111111111111110000000000000", 8192ULL,             8190ULL },  // /19
+    { 0xFFFFF000U, 0x00000FFFU, "255.255.240.0",   "11111111111111111111000000000000", 4096ULL,             4094ULL },  // /20
+    { 0xFFFFF800U, 0x000007FFU, "255.255.248.0",   "11111111111111111111100000000000", 2048ULL,             2046ULL },  // /21
+    { 0xFFFFFC00U, 0x000003FFU, "255.255.252.0",   "11111111111111111111110000000000", 1024ULL,             1022ULL },  // /22
+    { 0xFFFFFE00U, 0x000001FFU, "255.255.254.0",   "11111111111111111111111000000000", 512ULL,               510ULL },  // /23
+    { 0xFFFFFF00U, 0x000000FFU, "255.255.255.0",   "11111111111111111111111100000000", 256ULL,               254ULL },  // /24
+    { 0xFFFFFF80U, 0x0000007FU, "255.255.255.128", "11111111111111111111111110000000", 128ULL,               126ULL },  // /25
+    { 0xFFFFFFC0U, 0x0000003FU, "255.255.255.192", "11111111111111111111111111000000", 64ULL,                 62ULL },  // /26
+    { 0xFFFFFFE0U, 0x0000001FU, "255.255.255.224", "11111111111111111111111111100000", 32ULL,                 30ULL },  // /27
+    { 0xFFFFFFF0U, 0x0000000FU, "255.255.255.240", "11111111111111111111111111110000", 16ULL,                 14ULL },  // /28
+    { 0xFFFFFFF8U, 0x00000007U, "255.255.255.248", "11111111111111111111111111111000", 8ULL,                   6ULL },  // /29
+    { 0xFFFFFFFCU, 0x00000003U, "255.255.255.252", "11111111111111111111111111111100", 4ULL,                   2ULL },  // /30
+    { 0xFFFFFFFEU, 0x00000001U, "255.255.255.254", "11111111111111111111111111111110", 2ULL,                   2ULL },  // /31
+    { 0xFFFFFFFFU, 0x00000000U, "255.255.255.255", "11111111111111111111111111111111", 1ULL,                   1ULL },  // /32
+};
+
+/*
+ * Returns the precomputed information for a prefix length
+ *
+ * @param prefix: CIDR prefix length
+ * @return: Table entry, or NULL if prefix is not 0-32
+ */
+const PrefixInfo *net_prefix_info(int prefix)
+{
+    if (prefix < 0 || prefix > 32) return NULL;
+    return &NET_PREFIX_TABLE[prefix];
+}
+
+/*
+ * Converts a prefix length directly to its 32-bit subnet mask
+ *
+ * @param prefix: CIDR prefix length
+ * @param mask_out: Receives the mask
+ * @return: NET_OK, NET_ERR_NULL or NET_ERR_RANGE
+ */
+NetStatus net_prefix_to_mask(int prefix, unsigned int *mask_out)
+{
+    if (!mask_out) return NET_ERR_NULL;
+    if (prefix < 0 || prefix > 32) return NET_ERR_RANGE;
+    *mask_out = NET_PREFIX_TABLE[prefix].mask;
+    return NET_OK;
+}
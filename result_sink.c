@@ -0,0 +1,693 @@
+/*
+ * ============================================================================
+ * RESULT SINK - MACHINE-READABLE OUTPUT
+ * ============================================================================
+ *
+ * The educational modes print through printf() and print_colored() with
+ * emoji and box drawing, which is meant for people. For pipelines, each
+ * analysis can instead fill a result struct (NetworkResult, ServiceResult,
+ * PingResult) and hand it to a sink selected with --format:
+ *
+ *   jsonl   {"record":"network","input":"10.0.0.0/8","ip":"10.0.0.0",...}
+ *   csv     header line, then one RFC 4180 row per record
+ *   binary  fixed-width little-endian records (layout below)
+ *   text    "<first field> key=value ..." (the --batch layout)
+ *
+ * Each struct is described once by a ResultSchema: field names, types
+ * and offsets. The writers walk the schema, so adding a result type means
+ * adding a struct and a field table, not a serializer per format.
+ *
+ * Records are formatted straight into an OutputBuffer, so bulk runs make
+ * one write() per megabyte of output rather than one per field.
+ *
+ * Binary layout (all integers little-endian):
+ *   stream header: "NETR", u16 version, u16 reserved
+ *   record header: u16 schema id, u16 payload bytes, u32 present-field bits
+ *   payload:       fields in schema order; U32/IPV4 = 4 bytes, U64 = 8,
+ *                  F64 = IEEE 754 double (8), strings = width bytes NUL-padded;
+ *                  absent fields are zero-filled
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <stddef.h>
+#include <unistd.h>
+
+static ResultFormat result_format = RESULT_FORMAT_TEXT;
+
+// --timing: start of the run, cleared once the first record is reported
+static unsigned long long timing_start_ns = 0;
+
+/*
+ * ============================================================================
+ * SCHEMAS
+ * ============================================================================
+ */
+
+#define FIELD(type, member, kind, width) { #member, kind, offsetof(type, member), width }
+
+static const ResultField NETWORK_FIELDS[] = {
+    FIELD(NetworkResult, input, RESULT_FIELD_CHARS, RESULT_INPUT_MAX),
+    FIELD(NetworkResult, ip, RESULT_FIELD_IPV4, 4),
+    { "class", RESULT_FIELD_STR, offsetof(NetworkResult, net_class), 12 },
+    FIELD(NetworkResult, type, RESULT_FIELD_STR, 12),
+    FIELD(NetworkResult, network, RESULT_FIELD_IPV4, 4),
+    FIELD(NetworkResult, prefix, RESULT_FIELD_U32, 4),
+    FIELD(NetworkResult, mask, RESULT_FIELD_IPV4, 4),
+    FIELD(NetworkResult, broadcast, RESULT_FIELD_IPV4, 4),
+    FIELD(NetworkResult, first, RESULT_FIELD_IPV4, 4),
+    FIELD(NetworkResult, last, RESULT_FIELD_IPV4, 4),
+    FIELD(NetworkResult, usable, RESULT_FIELD_U64, 8),
+    FIELD(NetworkResult, error, RESULT_FIELD_STR, 16)
+};
+
+static const ResultField SERVICE_FIELDS[] = {
+    FIELD(ServiceResult, ip, RESULT_FIELD_IPV4, 4),
+    FIELD(ServiceResult, port, RESULT_FIELD_U32, 4),
+    FIELD(ServiceResult, state, RESULT_FIELD_STR, 12),
+    FIELD(ServiceResult, service, RESULT_FIELD_STR, 16),
+    FIELD(ServiceResult, rtt_ns, RESULT_FIELD_U64, 8)
+};
+
+static const ResultField PING_FIELDS[] = {
+    FIELD(PingResult, ip, RESULT_FIELD_IPV4, 4),
+    FIELD(PingResult, sent, RESULT_FIELD_U32, 4),
+    FIELD(PingResult, received, RESULT_FIELD_U32, 4),
+    FIELD(PingResult, loss_pct, RESULT_FIELD_F64, 8),
+    FIELD(PingResult, rtt_min_ns, RESULT_FIELD_U64, 8),
+    FIELD(PingResult, rtt_avg_ns, RESULT_FIELD_U64, 8),
+    FIELD(PingResult, rtt_max_ns, RESULT_FIELD_U64, 8),
+    FIELD(PingResult, jitter_ns, RESULT_FIELD_U64, 8)
+};
+
+static const ResultField CHECK_FIELDS[] = {
+    FIELD(CheckResult, ip, RESULT_FIELD_IPV4, 4),
+    FIELD(CheckResult, network, RESULT_FIELD_IPV4, 4),
+    FIELD(CheckResult, prefix, RESULT_FIELD_U32, 4),
+    FIELD(CheckResult, in_range, RESULT_FIELD_U32, 4)
+};
+
+static const ResultField CONVERSION_FIELDS[] = {
+    FIELD(ConversionResult, ip, RESULT_FIELD_IPV4, 4),
+    { "int", RESULT_FIELD_U32, offsetof(ConversionResult, value), 4 },
+    FIELD(ConversionResult, hex, RESULT_FIELD_CHARS, 11),
+    FIELD(ConversionResult, binary, RESULT_FIELD_CHARS, 36)
+};
+
+static const ResultField NETWORK6_FIELDS[] = {
+    FIELD(Network6Result, input, RESULT_FIELD_CHARS, RESULT_INPUT_MAX),
+    FIELD(Network6Result, ip, RESULT_FIELD_CHARS, NET_IPV6_STRLEN),
+    FIELD(Network6Result, type, RESULT_FIELD_STR, 16),
+    FIELD(Network6Result, network, RESULT_FIELD_CHARS, NET_IPV6_STRLEN),
+    FIELD(Network6Result, prefix, RESULT_FIELD_U32, 4),
+    FIELD(Network6Result, last, RESULT_FIELD_CHARS, NET_IPV6_STRLEN),
+    FIELD(Network6Result, host_bits, RESULT_FIELD_U32, 4),
+    FIELD(Network6Result, ipv4, RESULT_FIELD_IPV4, 4),
+    FIELD(Network6Result, error, RESULT_FIELD_STR, 16)
+};
+
+static const ResultField CHECK6_FIELDS[] = {
+    FIELD(Check6Result, ip, RESULT_FIELD_CHARS, NET_IPV6_STRLEN),
+    FIELD(Check6Result, network, RESULT_FIELD_CHARS, NET_IPV6_STRLEN),
+    FIELD(Check6Result, prefix, RESULT_FIELD_U32, 4),
+    FIELD(Check6Result, in_range, RESULT_FIELD_U32, 4)
+};
+
+#define FIELD_COUNT(fields) (sizeof(fields) / sizeof(fields[0]))
+
+const ResultSchema RESULT_SCHEMA_NETWORK = {
+    "network", 1, NETWORK_FIELDS, FIELD_COUNT(NETWORK_FIELDS),
+    RESULT_INPUT_MAX + 12 + 12 + 4 * 7 + 8 + 16
+};
+
+const ResultSchema RESULT_SCHEMA_SERVICE = {
+    "service", 2, SERVICE_FIELDS, FIELD_COUNT(SERVICE_FIELDS),
+    4 + 4 + 12 + 16 + 8
+};
+
+const ResultSchema RESULT_SCHEMA_PING = {
+    "ping", 3, PING_FIELDS, FIELD_COUNT(PING_FIELDS),
+    4 * 3 + 8 * 5
+};
+
+const ResultSchema RESULT_SCHEMA_CHECK = {
+    "check", 4, CHECK_FIELDS, FIELD_COUNT(CHECK_FIELDS),
+    4 * 4
+};
+
+const ResultSchema RESULT_SCHEMA_CONVERSION = {
+    "conversion", 5, CONVERSION_FIELDS, FIELD_COUNT(CONVERSION_FIELDS),
+    4 + 4 + 11 + 36
+};
+
+const ResultSchema RESULT_SCHEMA_NETWORK6 = {
+    "network6", 6, NETWORK6_FIELDS, FIELD_COUNT(NETWORK6_FIELDS),
+    RESULT_INPUT_MAX + NET_IPV6_STRLEN * 3 + 16 + 4 * 3 + 16
+};
+
+const ResultSchema RESULT_SCHEMA_CHECK6 = {
+    "check6", 7, CHECK6_FIELDS, FIELD_COUNT(CHECK6_FIELDS),
+    NET_IPV6_STRLEN * 2 + 4 * 2
+};
+
+/*
+ * ============================================================================
+ * FORMAT SELECTION
+ * ============================================================================
+ */
+
+void set_result_format(ResultFormat format)
+{
+    result_format = format;
+}
+
+ResultFormat get_result_format(void)
+{
+    return result_format;
+}
+
+/*
+ * Returns 1 when modes should write records instead of their trace
+ */
+int use_result_records(void)
+{
+    return result_format != RESULT_FORMAT_TEXT || is_quiet_mode();
+}
+
+/*
+ * Arms the startup-to-first-result report
+ *
+ * @param start_ns: net_now_ns() at program start
+ */
+void result_timing_start(unsigned long long start_ns)
+{
+    timing_start_ns = start_ns;
+}
+
+/*
+ * Parses a --format argument
+ *
+ * @param name: "text", "jsonl" (or "json"), "csv" or "binary"
+ * @param format: Receives the format
+ * @return: 1 if recognized, 0 otherwise
+ */
+int result_format_parse(const char *name, ResultFormat *format)
+{
+    if (strcmp(name, "text") == 0) *format = RESULT_FORMAT_TEXT;
+    else if (strcmp(name, "jsonl") == 0 || strcmp(name, "json") == 0) *format = RESULT_FORMAT_JSONL;
+    else if (strcmp(name, "csv") == 0) *format = RESULT_FORMAT_CSV;
+    else if (strcmp(name, "binary") == 0) *format = RESULT_FORMAT_BINARY;
+    else return 0;
+    return 1;
+}
+
+/*
+ * ============================================================================
+ * FIELD ACCESS
+ * ============================================================================
+ */
+
+static const void *field_ptr(const void *record, const ResultField *field)
+{
+    return (const char *)record + field->offset;
+}
+
+/*
+ * Returns a string field (NULL when absent)
+ */
+static const char *field_text(const void *record, const ResultField *field)
+{
+    if (field->type == RESULT_FIELD_CHARS) return field_ptr(record, field);
+    return *(const char *const *)field_ptr(record, field);
+}
+
+/*
+ * Formats a scalar field as text (strings are handled by the writers)
+ *
+ * @return: Number of bytes written
+ */
+static size_t format_scalar(const void *record, const ResultField *field, char *w)
+{
+    const void *value = field_ptr(record, field);
+
+    switch (field->type)
+    {
+        case RESULT_FIELD_U32:
+            return (size_t)sprintf(w, "%u", *(const unsigned int *)value);
+        case RESULT_FIELD_U64:
+            return (size_t)sprintf(w, "%llu", *(const unsigned long long *)value);
+        case RESULT_FIELD_F64:
+            return (size_t)sprintf(w, "%.3f", *(const double *)value);
+        case RESULT_FIELD_IPV4:
+            return net_format_ipv4(*(const unsigned int *)value, w);
+        default:
+            return 0;
+    }
+}
+
+static int field_is_string(const ResultField *field)
+{
+    return field->type == RESULT_FIELD_STR || field->type == RESULT_FIELD_CHARS;
+}
+
+/*
+ * ============================================================================
+ * WRITERS
+ * ============================================================================
+ *
+ * Each writer appends one complete record to sink->out. Records fit in
+ * RESULT_MAX_RECORD: the only free-form text is the echoed input, at most
+ * RESULT_INPUT_MAX - 1 bytes (6 bytes each once JSON-escaped).
+ */
+
+static char *put_string(char *w, const char *text)
+{
+    while (*text) *w++ = *text++;
+    return w;
+}
+
+/*
+ * "<first field> key=value key=value ..." — the --batch layout
+ */
+static void write_text(ResultSink *sink, const ResultSchema *schema,
+                       const void *record, unsigned int omit)
+{
+    char *start = output_buffer_reserve(&sink->out, RESULT_MAX_RECORD);
+    char *w = start;
+
+    for (size_t i = 0; i < schema->field_count; i++)
+    {
+        const ResultField *field = &schema->fields[i];
+        if (omit & (1u << i)) continue;
+        if (field_is_string(field) && !field_text(record, field)) continue;
+
+        if (w != start) *w++ = ' ';
+        if (i > 0) {
+            w = put_string(w, field->name);
+            *w++ = '=';
+        }
+        if (field_is_string(field)) w = put_string(w, field_text(record, field));
+        else w += format_scalar(record, field, w);
+    }
+    *w++ = '\n';
+    sink->out.len += (size_t)(w - start);
+}
+
+/*
+ * Appends a JSON string literal with the mandatory escapes
+ */
+static char *put_json_string(char *w, const char *text)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    *w++ = '"';
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++)
+    {
+        if (*p == '"' || *p == '\\') {
+            *w++ = '\\';
+            *w++ = (char)*p;
+        } else if (*p < 0x20) {
+            w = put_string(w, "\\u00");
+            *w++ = hex[*p >> 4];
+            *w++ = hex[*p & 15];
+        } else {
+            *w++ = (char)*p;
+        }
+    }
+    *w++ = '"';
+    return w;
+}
+
+/*
+ * {"record":"<schema>","field":value,...} — absent fields are left out
+ *
+ * The schema key is "record", not "type": network records already have
+ * a "type" field, and JSON parsers keep only the last duplicate key.
+ */
+static void write_jsonl(ResultSink *sink, const ResultSchema *schema,
+                        const void *record, unsigned int omit)
+{
+    char *start = output_buffer_reserve(&sink->out, RESULT_MAX_RECORD);
+    char *w = start;
+
+    w = put_string(w, "{\"record\":\"");
+    w = put_string(w, schema->name);
+    *w++ = '"';
+
+    for (size_t i = 0; i < schema->field_count; i++)
+    {
+        const ResultField *field = &schema->fields[i];
+        if (omit & (1u << i)) continue;
+        if (field_is_string(field) && !field_text(record, field)) continue;
+
+        *w++ = ',';
+        *w++ = '"';
+        w = put_string(w, field->name);
+        *w++ = '"';
+        *w++ = ':';
+
+        if (field_is_string(field)) {
+            w = put_json_string(w, field_text(record, field));
+        } else if (field->type == RESULT_FIELD_IPV4) {
+            *w++ = '"';
+            w += format_scalar(record, field, w);
+            *w++ = '"';
+        } else {
+            w += format_scalar(record, field, w);
+        }
+    }
+    *w++ = '}';
+    *w++ = '\n';
+    sink->out.len += (size_t)(w - start);
+}
+
+/*
+ * Appends a CSV cell, quoted only when it contains a separator,
+ * a quote or a line break (RFC 4180)
+ */
+static char *put_csv_string(char *w, const char *text)
+{
+    if (!strpbrk(text, ",\"\r\n")) return put_string(w, text);
+
+    *w++ = '"';
+    for (; *text; text++) {
+        if (*text == '"') *w++ = '"';
+        *w++ = *text;
+    }
+    *w++ = '"';
+    return w;
+}
+
+/*
+ * Header line whenever the schema changes, then one row per record;
+ * absent fields are empty cells
+ */
+static void write_csv(ResultSink *sink, const ResultSchema *schema,
+                      const void *record, unsigned int omit)
+{
+    if (sink->header_schema != schema)
+    {
+        char *start = output_buffer_reserve(&sink->out, RESULT_MAX_RECORD);
+        char *w = start;
+        for (size_t i = 0; i < schema->field_count; i++) {
+            if (i > 0) *w++ = ',';
+            w = put_string(w, schema->fields[i].name);
+        }
+        *w++ = '\n';
+        sink->out.len += (size_t)(w - start);
+        sink->header_schema = schema;
+    }
+
+    char *start = output_buffer_reserve(&sink->out, RESULT_MAX_RECORD);
+    char *w = start;
+
+    for (size_t i = 0; i < schema->field_count; i++)
+    {
+        const ResultField *field = &schema->fields[i];
+        if (i > 0) *w++ = ',';
+        if (omit & (1u << i)) continue;
+
+        if (field_is_string(field)) {
+            const char *text = field_text(record, field);
+            if (text) w = put_csv_string(w, text);
+        } else {
+            w += format_scalar(record, field, w);
+        }
+    }
+    *w++ = '\n';
+    sink->out.len += (size_t)(w - start);
+}
+
+static unsigned char *put_le(unsigned char *w, unsigned long long value, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        *w++ = (unsigned char)value;
+        value >>= 8;
+    }
+    return w;
+}
+
+/*
+ * Fixed-width record: header, then every field at its schema width
+ */
+static void write_binary(ResultSink *sink, const ResultSchema *schema,
+                         const void *record, unsigned int omit)
+{
+    unsigned char *start = (unsigned char *)output_buffer_reserve(&sink->out, 8 + schema->binary_size);
+    unsigned char *w = start;
+    unsigned int present = ~omit & (unsigned int)((1ULL << schema->field_count) - 1);
+
+    w = put_le(w, schema->id, 2);
+    w = put_le(w, schema->binary_size, 2);
+    w += 4;  // Present bits, known once string fields are checked
+
+    for (size_t i = 0; i < schema->field_count; i++)
+    {
+        const ResultField *field = &schema->fields[i];
+        const void *value = field_ptr(record, field);
+
+        if (field_is_string(field) && !field_text(record, field)) present &= ~(1u << i);
+        if (!(present & (1u << i))) {
+            memset(w, 0, field->width);
+            w += field->width;
+            continue;
+        }
+
+        switch (field->type)
+        {
+            case RESULT_FIELD_U32:
+            case RESULT_FIELD_IPV4:
+                w = put_le(w, *(const unsigned int *)value, 4);
+                break;
+            case RESULT_FIELD_U64:
+                w = put_le(w, *(const unsigned long long *)value, 8);
+                break;
+            case RESULT_FIELD_F64: {
+                unsigned long long bits;
+                memcpy(&bits, value, sizeof(bits));
+                w = put_le(w, bits, 8);
+                break;
+            }
+            default: {
+                const char *text = field_text(record, field);
+                size_t len = strnlen(text, field->width - 1);
+                memcpy(w, text, len);
+                memset(w + len, 0, field->width - len);
+                w += field->width;
+                break;
+            }
+        }
+    }
+    put_le(start + 4, present, 4);
+    sink->out.len += 8 + schema->binary_size;
+}
+
+/*
+ * ============================================================================
+ * SINK LIFECYCLE
+ * ============================================================================
+ */
+
+/*
+ * Opens a sink on a file descriptor
+ *
+ * @param sink: Sink to initialize
+ * @param format: Serialization format
+ * @param fd: Destination (usually STDOUT_FILENO)
+ * @return: 1 if successful, 0 on allocation failure
+ */
+int result_sink_open(ResultSink *sink, ResultFormat format, int fd)
+{
+    static void (*const writers[])(ResultSink *, const ResultSchema *, const void *, unsigned int) = {
+        [RESULT_FORMAT_TEXT] = write_text,
+        [RESULT_FORMAT_JSONL] = write_jsonl,
+        [RESULT_FORMAT_CSV] = write_csv,
+        [RESULT_FORMAT_BINARY] = write_binary
+    };
+
+    if (!output_buffer_init(&sink->out, fd, OUTPUT_BUFFER_SIZE)) return 0;
+    sink->format = format;
+    sink->header_schema = NULL;
+    sink->write = writers[format];
+
+    // Anything already printed through stdio must come first
+    fflush(stdout);
+
+    if (format == RESULT_FORMAT_BINARY) {
+        unsigned char *w = (unsigned char *)output_buffer_reserve(&sink->out, 8);
+        memcpy(w, RESULT_BINARY_MAGIC, 4);
+        put_le(w + 4, RESULT_BINARY_VERSION, 2);
+        put_le(w + 6, 0, 2);
+        sink->out.len += 8;
+    }
+    return 1;
+}
+
+/*
+ * Serializes one record
+ *
+ * @param sink: Open sink
+ * @param schema: Layout of the record struct
+ * @param record: Result struct
+ * @param omit: Bit n set = field n is absent
+ */
+void result_sink_emit(ResultSink *sink, const ResultSchema *schema,
+                      const void *record, unsigned int omit)
+{
+    sink->write(sink, schema, record, omit);
+
+    if (timing_start_ns) {
+        char duration[NET_DURATION_STRLEN];
+        fprintf(stderr, "⏱️  First result after %s\n",
+                net_format_duration(net_now_ns() - timing_start_ns, duration));
+        timing_start_ns = 0;
+    }
+}
+
+void result_sink_flush(ResultSink *sink)
+{
+    output_buffer_flush(&sink->out);
+}
+
+/*
+ * Flushes pending records and releases the buffer
+ */
+void result_sink_close(ResultSink *sink)
+{
+    output_buffer_free(&sink->out);
+}
+
+/*
+ * Writes the analysis of one input as a single record in the global format
+ *
+ * Used by the single-shot modes (--cidr, "ip mask") in place of the trace.
+ *
+ * @param input: IP, CIDR or "ip mask" string
+ * @return: 1 if the input was valid, 0 otherwise
+ */
+int emit_network_result(const char *input)
+{
+    ResultSink sink;
+    NetworkResult result;
+
+    if (strchr(input, ':')) return emit_network6_result(input);
+    if (!result_sink_open(&sink, result_format, STDOUT_FILENO)) return 0;
+    unsigned int omit = network_result_parse(input, strlen(input), &result);
+    result_sink_emit(&sink, &RESULT_SCHEMA_NETWORK, &result, omit);
+    result_sink_close(&sink);
+    return result.error == NULL;
+}
+
+/*
+ * Writes an IPv6 address or prefix analysis as a single network6 record
+ *
+ * @param input: IPv6 address or "addr/len"
+ * @return: 1 if the input was valid, 0 otherwise
+ */
+int emit_network6_result(const char *input)
+{
+    ResultSink sink;
+    Network6Result result;
+
+    if (!result_sink_open(&sink, result_format, STDOUT_FILENO)) return 0;
+    unsigned int omit = network6_result_parse(input, strlen(input), &result);
+    result_sink_emit(&sink, &RESULT_SCHEMA_NETWORK6, &result, omit);
+    result_sink_close(&sink);
+    return result.error == NULL;
+}
+
+/*
+ * IPv6 form of emit_check_result(): a single check6 record
+ */
+static int emit_check6_result(const char *ip_str, const char *cidr_str)
+{
+    Check6Result result;
+    NetIpv6 ip, network;
+    int prefix;
+
+    if (net_parse_ipv6(ip_str, &ip) != NET_OK) {
+        fprintf(stderr, "❌ Invalid IPv6 address: %s\n", ip_str);
+        return 0;
+    }
+    if (net_parse_ipv6_cidr(cidr_str, &network, &prefix) != NET_OK) {
+        fprintf(stderr, "❌ Invalid CIDR format: %s\n", cidr_str);
+        return 0;
+    }
+
+    NetIpv6 masked = net_ipv6_network(&network, prefix);
+    net_format_ipv6(&ip, result.ip);
+    net_format_ipv6(&masked, result.network);
+    result.prefix = (unsigned int)prefix;
+    result.in_range = (unsigned int)net_ipv6_in_prefix(&ip, &network, prefix);
+
+    ResultSink sink;
+    if (!result_sink_open(&sink, result_format, STDOUT_FILENO)) return 0;
+    result_sink_emit(&sink, &RESULT_SCHEMA_CHECK6, &result, 0);
+    result_sink_close(&sink);
+    return 1;
+}
+
+/*
+ * Writes whether an address belongs to a CIDR network as a single record
+ *
+ * @param ip_str: Address to test
+ * @param cidr_str: Network, e.g. "10.0.0.0/8" (IPv6 inputs give a check6 record)
+ * @return: 1 if successful, 0 if an input is invalid
+ */
+int emit_check_result(const char *ip_str, const char *cidr_str)
+{
+    CheckResult result;
+    int prefix;
+
+    if (strchr(ip_str, ':') || strchr(cidr_str, ':')) return emit_check6_result(ip_str, cidr_str);
+
+    if (net_parse_ipv4(ip_str, &result.ip) != NET_OK) {
+        fprintf(stderr, "❌ Invalid IP address: %s\n", ip_str);
+        return 0;
+    }
+    if (net_parse_cidr(cidr_str, &result.network, &prefix) != NET_OK) {
+        fprintf(stderr, "❌ Invalid CIDR format: %s\n", cidr_str);
+        return 0;
+    }
+
+    unsigned int mask = NET_PREFIX_TABLE[prefix].mask;
+    result.network &= mask;
+    result.prefix = (unsigned int)prefix;
+    result.in_range = (result.ip & mask) == result.network;
+
+    ResultSink sink;
+    if (!result_sink_open(&sink, result_format, STDOUT_FILENO)) return 0;
+    result_sink_emit(&sink, &RESULT_SCHEMA_CHECK, &result, 0);
+    result_sink_close(&sink);
+    return 1;
+}
+
+/*
+ * Writes the integer, hexadecimal and binary forms of an address as a record
+ *
+ * @param ip_str: Dotted-quad address
+ * @return: 1 if successful, 0 if the address is invalid
+ */
+int emit_conversion_result(const char *ip_str)
+{
+    ConversionResult result;
+
+    if (net_parse_ipv4(ip_str, &result.ip) != NET_OK) {
+        fprintf(stderr, "❌ Invalid IP address: %s\n", ip_str);
+        return 0;
+    }
+    result.value = result.ip;
+    snprintf(result.hex, sizeof(result.hex), "0x%08X", result.ip);
+    for (int octet = 0; octet < 4; octet++) {
+        net_octet_to_binary((result.ip >> (24 - 8 * octet)) & 255, result.binary + octet * 9);
+        if (octet < 3) result.binary[octet * 9 + 8] = '.';
+    }
+
+    ResultSink sink;
+    if (!result_sink_open(&sink, result_format, STDOUT_FILENO)) return 0;
+    result_sink_emit(&sink, &RESULT_SCHEMA_CONVERSION, &result, 0);
+    result_sink_close(&sink);
+    return 1;
+}
@@ -0,0 +1,298 @@
+/*
+ * ============================================================================
+ * RTT HISTOGRAM - NANOSECOND TIMING AND LOG-LINEAR LATENCY HISTOGRAMS
+ * ============================================================================
+ *
+ * Round-trip times on a LAN or loopback are tens of microseconds, so
+ * whole-millisecond gettimeofday() arithmetic reports them all as 0 ms.
+ * This file provides:
+ *
+ * 1. Timing: CLOCK_MONOTONIC in nanoseconds (immune to wall-clock jumps),
+ *    plus conversion of kernel receive timestamps (SO_TIMESTAMPNS, taken
+ *    when the packet arrives, before any scheduling delay) to that clock
+ *
+ * 2. RttHistogram: an HDR-style log-linear histogram
+ *    - Values below 2^S are counted exactly
+ *    - Above that, every power of two [2^e, 2^(e+1)) is split into
+ *      2^(S-1) equal sub-buckets, so the relative error stays below
+ *      1 / 2^(S-1) (1.6% with S = 7) from nanoseconds to hours
+ *    - Recording is O(1): one bit scan and a shift; memory is fixed
+ *
+ *    Bucket index for value v (e = position of the highest set bit):
+ *      v < 2^S:  index = v
+ *      else:     index = 2^S + (e - S) × 2^(S-1) + (v >> (e - S + 1)) - 2^(S-1)
+ *
+ * 3. Jitter: the RFC 3550 estimator, J += (|RTT(i) - RTT(i-1)| - J) / 16
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <sys/socket.h>
+#include <time.h>
+
+#define RTT_SUB_COUNT (1ULL << RTT_HISTOGRAM_SUB_BITS)
+#define RTT_HALF_SUB  (1ULL << (RTT_HISTOGRAM_SUB_BITS - 1))
+#define RTT_CLOCK_PAIR_ATTEMPTS 4      // Tries for an uninterrupted clock pair read
+#define RTT_CLOCK_PAIR_MAX_NS   1000   // Widest bracket accepted as uninterrupted
+
+/*
+ * ============================================================================
+ * TIMING
+ * ============================================================================
+ */
+
+/*
+ * Returns monotonic time in nanoseconds
+ */
+unsigned long long net_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+/*
+ * Extracts the kernel receive timestamp of a message, on the monotonic clock
+ *
+ * The socket must have SO_TIMESTAMPNS enabled. The kernel stamps packets
+ * with CLOCK_REALTIME; the stamp is moved to CLOCK_MONOTONIC through the
+ * current offset between the two clocks. A preemption between reading
+ * the two clocks would shift that offset (and the RTT) by the time the
+ * thread was off the CPU, so the pair is re-read until it is tight.
+ *
+ * @param msg: Received message with its control data
+ * @param now_ns: Fallback time, returned if there is no usable stamp
+ * @return: Arrival time in monotonic nanoseconds
+ */
+unsigned long long net_rx_timestamp_ns(const struct msghdr *msg, unsigned long long now_ns)
+{
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR((struct msghdr *)msg); cmsg;
+         cmsg = CMSG_NXTHDR((struct msghdr *)msg, cmsg))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_TIMESTAMPNS) continue;
+
+        // Bracket the realtime read between two monotonic reads; a wide
+        // bracket means the thread was preempted in between, so read again
+        struct timespec stamp;
+        struct timespec real;
+        unsigned long long mono_ns = 0;
+        memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+        for (int attempt = 0; attempt < RTT_CLOCK_PAIR_ATTEMPTS; attempt++) {
+            unsigned long long before_ns = net_now_ns();
+            clock_gettime(CLOCK_REALTIME, &real);
+            unsigned long long after_ns = net_now_ns();
+            mono_ns = before_ns + (after_ns - before_ns) / 2;
+            if (after_ns - before_ns <= RTT_CLOCK_PAIR_MAX_NS) break;
+        }
+
+        long long age_ns = (long long)(real.tv_sec - stamp.tv_sec) * 1000000000LL +
+                           (long long)(real.tv_nsec - stamp.tv_nsec);
+        if (age_ns < 0 || (unsigned long long)age_ns > mono_ns) return now_ns;
+        return mono_ns - (unsigned long long)age_ns;
+    }
+    return now_ns;
+}
+
+/*
+ * Formats a duration with a unit suited to its size
+ *
+ * Examples: "850 ns", "41.3 us", "12.48 ms", "1.503 s"
+ *
+ * @param ns: Duration in nanoseconds
+ * @param out: Buffer of at least NET_DURATION_STRLEN bytes
+ * @return: out
+ */
+char *net_format_duration(unsigned long long ns, char *out)
+{
+    if (ns < 1000ULL) {
+        snprintf(out, NET_DURATION_STRLEN, "%llu ns", ns);
+    } else if (ns < 1000000ULL) {
+        snprintf(out, NET_DURATION_STRLEN, "%.1f us", (double)ns / 1e3);
+    } else if (ns < 1000000000ULL) {
+        snprintf(out, NET_DURATION_STRLEN, "%.2f ms", (double)ns / 1e6);
+    } else {
+        snprintf(out, NET_DURATION_STRLEN, "%.3f s", (double)ns / 1e9);
+    }
+    return out;
+}
+
+/*
+ * ============================================================================
+ * HISTOGRAM
+ * ============================================================================
+ */
+
+/*
+ * Maps a value to its bucket index
+ */
+static size_t rtt_bucket_index(unsigned long long value)
+{
+    if (value < RTT_SUB_COUNT) return (size_t)value;
+
+    unsigned int e = 63U - (unsigned int)__builtin_clzll(value);
+    unsigned int shift = e - RTT_HISTOGRAM_SUB_BITS + 1;
+    return (size_t)(RTT_SUB_COUNT + (e - RTT_HISTOGRAM_SUB_BITS) * RTT_HALF_SUB +
+                    (value >> shift) - RTT_HALF_SUB);
+}
+
+/*
+ * Returns the largest value that maps to a bucket
+ */
+static unsigned long long rtt_bucket_upper(size_t index)
+{
+    if (index < RTT_SUB_COUNT) return index;
+
+    size_t offset = index - RTT_SUB_COUNT;
+    unsigned int e = (unsigned int)(offset / RTT_HALF_SUB) + RTT_HISTOGRAM_SUB_BITS;
+    unsigned int shift = e - RTT_HISTOGRAM_SUB_BITS + 1;
+    unsigned long long sub = RTT_HALF_SUB + offset % RTT_HALF_SUB;
+    return ((sub + 1) << shift) - 1;
+}
+
+/*
+ * Resets a histogram
+ *
+ * @param hist: Histogram
+ */
+void rtt_histogram_init(RttHistogram *hist)
+{
+    memset(hist, 0, sizeof(*hist));
+    hist->min_ns = ~0ULL;
+}
+
+/*
+ * Records one round-trip time
+ *
+ * @param hist: Histogram
+ * @param ns: Round-trip time in nanoseconds
+ */
+void rtt_histogram_record(RttHistogram *hist, unsigned long long ns)
+{
+    hist->counts[rtt_bucket_index(ns)]++;
+
+    if (hist->total > 0) {
+        double delta = ns > hist->last_ns ? (double)(ns - hist->last_ns) : (double)(hist->last_ns - ns);
+        hist->jitter_ns += (delta - hist->jitter_ns) / 16.0;
+    }
+    hist->last_ns = ns;
+
+    hist->total++;
+    hist->sum_ns += ns;
+    if (ns < hist->min_ns) hist->min_ns = ns;
+    if (ns > hist->max_ns) hist->max_ns = ns;
+}
+
+/*
+ * Adds every sample of src to dst (jitter keeps the larger estimate)
+ *
+ * @param dst: Destination histogram
+ * @param src: Source histogram
+ */
+void rtt_histogram_merge(RttHistogram *dst, const RttHistogram *src)
+{
+    if (src->total == 0) return;
+
+    for (size_t i = 0; i < RTT_HISTOGRAM_BUCKETS; i++) dst->counts[i] += src->counts[i];
+    dst->total += src->total;
+    dst->sum_ns += src->sum_ns;
+    if (src->min_ns < dst->min_ns) dst->min_ns = src->min_ns;
+    if (src->max_ns > dst->max_ns) dst->max_ns = src->max_ns;
+    if (src->jitter_ns > dst->jitter_ns) dst->jitter_ns = src->jitter_ns;
+}
+
+/*
+ * Returns the value at a percentile
+ *
+ * The result is the upper edge of the bucket holding the requested rank,
+ * clamped to the largest recorded value.
+ *
+ * @param hist: Histogram
+ * @param percentile: 0-100 (e.g. 99.9)
+ * @return: Value in nanoseconds, 0 if the histogram is empty
+ */
+unsigned long long rtt_histogram_percentile(const RttHistogram *hist, double percentile)
+{
+    if (hist->total == 0) return 0;
+
+    unsigned long long rank = (unsigned long long)(percentile / 100.0 * (double)hist->total + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > hist->total) rank = hist->total;
+
+    unsigned long long seen = 0;
+    for (size_t i = 0; i < RTT_HISTOGRAM_BUCKETS; i++)
+    {
+        seen += hist->counts[i];
+        if (seen >= rank) {
+            unsigned long long upper = rtt_bucket_upper(i);
+            if (upper > hist->max_ns) upper = hist->max_ns;
+            if (upper < hist->min_ns) upper = hist->min_ns;
+            return upper;
+        }
+    }
+    return hist->max_ns;
+}
+
+/*
+ * Returns the mean round-trip time
+ */
+unsigned long long rtt_histogram_mean(const RttHistogram *hist)
+{
+    return hist->total ? hist->sum_ns / hist->total : 0;
+}
+
+/*
+ * Writes a one-line summary
+ *
+ * Format: "n=<count> min=.. p50=.. p90=.. p99=.. p99.9=.. max=.. jitter=.."
+ *
+ * @param hist: Histogram
+ * @param out: Output buffer
+ * @param size: Buffer size
+ * @return: Characters written (as snprintf)
+ */
+int rtt_histogram_summary(const RttHistogram *hist, char *out, size_t size)
+{
+    if (hist->total == 0) return snprintf(out, size, "n=0");
+
+    char min[NET_DURATION_STRLEN], p50[NET_DURATION_STRLEN], p90[NET_DURATION_STRLEN];
+    char p99[NET_DURATION_STRLEN], p999[NET_DURATION_STRLEN], max[NET_DURATION_STRLEN];
+    char jitter[NET_DURATION_STRLEN];
+
+    return snprintf(out, size, "n=%llu min=%s p50=%s p90=%s p99=%s p99.9=%s max=%s jitter=%s",
+                    hist->total,
+                    net_format_duration(hist->min_ns, min),
+                    net_format_duration(rtt_histogram_percentile(hist, 50.0), p50),
+                    net_format_duration(rtt_histogram_percentile(hist, 90.0), p90),
+                    net_format_duration(rtt_histogram_percentile(hist, 99.0), p99),
+                    net_format_duration(rtt_histogram_percentile(hist, 99.9), p999),
+                    net_format_duration(hist->max_ns, max),
+                    net_format_duration((unsigned long long)hist->jitter_ns, jitter));
+}
+
+/*
+ * Prints the latency distribution report used by the diagnostics modes
+ *
+ * @param hist: Histogram
+ */
+void rtt_histogram_print(const RttHistogram *hist)
+{
+    char a[NET_DURATION_STRLEN], b[NET_DURATION_STRLEN], c[NET_DURATION_STRLEN];
+
+    if (hist->total == 0) {
+        printf("   No round-trip samples\n");
+        return;
+    }
+
+    printf("   Samples: %llu\n", hist->total);
+    printf("   Min / Avg / Max: %s / %s / %s\n", net_format_duration(hist->min_ns, a),
+           net_format_duration(rtt_histogram_mean(hist), b), net_format_duration(hist->max_ns, c));
+    printf("   p50: %s   p90: %s   p99: %s\n",
+           net_format_duration(rtt_histogram_percentile(hist, 50.0), a),
+           net_format_duration(rtt_histogram_percentile(hist, 90.0), b),
+           net_format_duration(rtt_histogram_percentile(hist, 99.0), c));
+    printf("   p99.9: %s   Jitter (RFC 3550): %s\n",
+           net_format_duration(rtt_histogram_percentile(hist, 99.9), a),
+           net_format_duration((unsigned long long)hist->jitter_ns, b));
+}
@@ -0,0 +1,255 @@
+/*
+ * ============================================================================
+ * STREAMING I/O UTILITIES
+ * ============================================================================
+ *
+ * This file contains the buffered reader and writer used by the bulk modes
+ * (batch processing, table loading, enumeration). They work directly on file
+ * descriptors with large buffers so that millions of lines can be processed
+ * without one system call per line.
+ *
+ * Design:
+ * - LineReader: read() in large chunks, split on '\n' with memchr()
+ * - OutputBuffer: accumulate output, write() in large chunks
+ * - Neither structure performs per-line heap allocation
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+/*
+ * ============================================================================
+ * BUFFERED LINE READER
+ * ============================================================================
+ */
+
+/*
+ * Opens a line reader on a file path or on standard input
+ *
+ * @param reader: Reader structure to initialize
+ * @param path: File path, or NULL / "-" for standard input
+ * @return: 1 if opened successfully, 0 on failure
+ */
+int line_reader_open(LineReader *reader, const char *path)
+{
+    memset(reader, 0, sizeof(*reader));
+
+    if (!path || strcmp(path, "-") == 0) {
+        reader->fd = STDIN_FILENO;
+    } else {
+        reader->fd = open(path, O_RDONLY);
+        if (reader->fd < 0) {
+            fprintf(stderr, "❌ Cannot open %s: %s\n", path, strerror(errno));
+            return 0;
+        }
+    }
+
+    reader->cap = LINE_READER_BUFFER_SIZE;
+    reader->buf = malloc(reader->cap);
+    if (!reader->buf) {
+        fprintf(stderr, "❌ Memory allocation failed for line reader\n");
+        if (reader->fd != STDIN_FILENO) close(reader->fd);
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Returns the next line from the reader without copying it
+ *
+ * The returned pointer stays valid until the next call. The trailing
+ * '\n' (and '\r' for CRLF input) is not included in the length.
+ * Lines longer than the buffer are returned truncated and the remainder
+ * of that line is discarded.
+ *
+ * @param reader: Open line reader
+ * @param line: Receives pointer to the first character of the line
+ * @param len: Receives line length in bytes
+ * @return: 1 if a line was returned, 0 at end of input or on a read
+ *          error (reader->error is then set, and the partial line dropped)
+ */
+int line_reader_next(LineReader *reader, const char **line, size_t *len)
+{
+    for (;;)
+    {
+        char *data = reader->buf + reader->start;
+        size_t avail = reader->end - reader->start;
+        char *newline = memchr(data, '\n', avail);
+
+        if (newline) {
+            reader->start += (size_t)(newline - data) + 1;
+            if (reader->skip_line) {
+                reader->skip_line = 0;
+                continue;
+            }
+            *line = data;
+            *len = (size_t)(newline - data);
+            if (*len > 0 && data[*len - 1] == '\r') (*len)--;
+            return 1;
+        }
+
+        if (reader->eof) {
+            if (avail == 0 || reader->skip_line) {
+                reader->start = reader->end;
+                return 0;
+            }
+            *line = data;
+            *len = avail;
+            if (*len > 0 && data[*len - 1] == '\r') (*len)--;
+            reader->start = reader->end;
+            return 1;
+        }
+
+        // Move the partial line to the front of the buffer
+        if (reader->start > 0) {
+            memmove(reader->buf, data, avail);
+            reader->start = 0;
+            reader->end = avail;
+        }
+
+        // Buffer full without a newline: return what we have
+        if (reader->end == reader->cap) {
+            reader->start = reader->end;
+            if (reader->skip_line) continue;
+            reader->skip_line = 1;
+            *line = reader->buf;
+            *len = reader->end;
+            return 1;
+        }
+
+        ssize_t n = read(reader->fd, reader->buf + reader->end, reader->cap - reader->end);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "❌ Read error: %s\n", strerror(errno));
+            reader->error = 1;
+            reader->eof = 1;
+            reader->start = reader->end;
+            return 0;
+        } else if (n == 0) {
+            reader->eof = 1;
+        } else {
+            reader->end += (size_t)n;
+        }
+    }
+}
+
+/*
+ * Releases reader resources (does not close standard input)
+ *
+ * @param reader: Reader to close
+ */
+void line_reader_close(LineReader *reader)
+{
+    if (reader->fd > STDIN_FILENO) close(reader->fd);
+    free(reader->buf);
+    reader->buf = NULL;
+}
+
+/*
+ * ============================================================================
+ * BUFFERED OUTPUT WRITER
+ * ============================================================================
+ */
+
+/*
+ * Initializes an output buffer that writes to a file descriptor
+ *
+ * @param out: Buffer structure to initialize
+ * @param fd: Destination file descriptor (e.g. STDOUT_FILENO)
+ * @param cap: Buffer capacity in bytes
+ * @return: 1 if successful, 0 on allocation failure
+ */
+int output_buffer_init(OutputBuffer *out, int fd, size_t cap)
+{
+    out->fd = fd;
+    out->len = 0;
+    out->cap = cap;
+    out->buf = malloc(cap);
+    if (!out->buf) {
+        fprintf(stderr, "❌ Memory allocation failed for output buffer\n");
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Writes all pending bytes to the file descriptor
+ *
+ * @param out: Output buffer
+ */
+void output_buffer_flush(OutputBuffer *out)
+{
+    size_t done = 0;
+
+    while (done < out->len)
+    {
+        ssize_t n = write(out->fd, out->buf + done, out->len - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;  // Reader went away (e.g. EPIPE): drop the output
+        }
+        done += (size_t)n;
+    }
+    out->len = 0;
+}
+
+/*
+ * Reserves space for direct formatting into the buffer
+ *
+ * The caller formats at most 'n' bytes at the returned pointer and then
+ * advances out->len by the number of bytes actually written.
+ *
+ * @param out: Output buffer
+ * @param n: Number of bytes needed (must not exceed capacity)
+ * @return: Pointer to free space of at least n bytes
+ */
+char *output_buffer_reserve(OutputBuffer *out, size_t n)
+{
+    if (out->cap - out->len < n) output_buffer_flush(out);
+    return out->buf + out->len;
+}
+
+/*
+ * Appends bytes to the output buffer
+ *
+ * @param out: Output buffer
+ * @param data: Bytes to append
+ * @param len: Number of bytes
+ */
+void output_buffer_write(OutputBuffer *out, const char *data, size_t len)
+{
+    if (out->cap - out->len < len) {
+        output_buffer_flush(out);
+        if (len > out->cap) {
+            // Larger than the whole buffer: write straight through
+            size_t saved_len = out->len;
+            char *saved_buf = out->buf;
+            out->buf = (char *)data;
+            out->len = len;
+            output_buffer_flush(out);
+            out->buf = saved_buf;
+            out->len = saved_len;
+            return;
+        }
+    }
+    memcpy(out->buf + out->len, data, len);
+    out->len += len;
+}
+
+/*
+ * Flushes and releases the output buffer
+ *
+ * @param out: Output buffer
+ */
+void output_buffer_free(OutputBuffer *out)
+{
+    output_buffer_flush(out);
+    free(out->buf);
+    out->buf = NULL;
+}
@@ -0,0 +1,475 @@
+/*
+ * ============================================================================
+ * SWEEP URING - IO_URING BACKEND FOR THE CONNECT SCANNER
+ * ============================================================================
+ *
+ * The epoll backend still costs several system calls per probe: socket(),
+ * connect(), epoll_ctl(), getsockopt() and close(), plus the epoll_wait()
+ * wakeups. This backend hands the whole life cycle to the kernel through
+ * the shared io_uring submission/completion rings:
+ *
+ *   submit   → SOCKET                          (queued, no system call)
+ *   socket   → CONNECT ─linked─ LINK_TIMEOUT   (the kernel enforces the deadline)
+ *   connect  → result reported, CLOSE queued
+ *   all CQEs for a slot seen → slot recycled
+ *
+ * Every connect_scanner_run_once() pushes all queued operations and reaps
+ * all completions with one or two io_uring_enter() calls, however many
+ * targets are in flight. Open ports still get a synchronous SO_LINGER
+ * reset before their close is queued (they are rare in a sweep), so no
+ * TIME_WAIT state is left behind.
+ *
+ * The rings are driven with raw system calls (no liburing dependency).
+ * Requires IORING_OP_SOCKET (Linux 5.19+); sweep_uring_init() probes the
+ * kernel and returns 0 otherwise so the scanner falls back to epoll.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+
+// Operation tag stored in the low bits of user_data (slot index above)
+#define URING_OP_SOCKET   0
+#define URING_OP_CONNECT  1
+#define URING_OP_TIMEOUT  2
+#define URING_OP_CLOSE    3
+#define URING_OP_BITS     2
+#define URING_OP_MASK     3
+
+// Per-slot state the kernel may still reference
+typedef struct
+{
+    struct sockaddr_in addr;     // CONNECT target
+    unsigned int pending;        // Operations not yet completed
+    int reported;                // Result already passed to the callback
+} UringSlot;
+
+typedef struct
+{
+    int ring_fd;
+
+    // Submission ring
+    unsigned int *sq_head;
+    unsigned int *sq_tail;
+    unsigned int *sq_mask;
+    unsigned int sq_entries;
+    unsigned int sq_local_tail;  // Entries filled but not yet published
+    struct io_uring_sqe *sqes;
+
+    // Completion ring
+    unsigned int *cq_head;
+    unsigned int *cq_tail;
+    unsigned int *cq_mask;
+    struct io_uring_cqe *cqes;
+
+    void *sq_ring;
+    size_t sq_ring_size;
+    void *cq_ring;               // Same as sq_ring with IORING_FEAT_SINGLE_MMAP
+    size_t cq_ring_size;
+    size_t sqes_size;
+
+    struct __kernel_timespec timeout;  // Shared LINK_TIMEOUT value
+    UringSlot *slots;
+} SweepUring;
+
+/*
+ * ============================================================================
+ * RING SETUP
+ * ============================================================================
+ */
+
+/*
+ * Checks that the kernel implements every operation the backend issues
+ */
+static int uring_supports_ops(int ring_fd)
+{
+    size_t size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe *probe = calloc(1, size);
+    if (!probe) return 0;
+
+    int ok = 0;
+    if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, 256) == 0) {
+        static const int required[] = {IORING_OP_SOCKET, IORING_OP_CONNECT,
+                                       IORING_OP_LINK_TIMEOUT, IORING_OP_CLOSE};
+        ok = 1;
+        for (size_t i = 0; i < sizeof(required) / sizeof(required[0]); i++) {
+            if (required[i] > probe->last_op || !(probe->ops[required[i]].flags & IO_URING_OP_SUPPORTED)) {
+                ok = 0;
+            }
+        }
+    }
+    free(probe);
+    return ok;
+}
+
+/*
+ * Releases the rings and slot table
+ */
+static void uring_destroy(SweepUring *ring)
+{
+    if (ring->sqes) munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring && ring->cq_ring != ring->sq_ring) munmap(ring->cq_ring, ring->cq_ring_size);
+    if (ring->sq_ring) munmap(ring->sq_ring, ring->sq_ring_size);
+    if (ring->ring_fd >= 0) close(ring->ring_fd);  // cancels outstanding operations
+    free(ring->slots);
+    free(ring);
+}
+
+/*
+ * Creates the rings and attaches them to the scanner
+ *
+ * @param scanner: Scanner with its slots already allocated
+ * @return: 1 if io_uring is usable, 0 to fall back to epoll
+ */
+int sweep_uring_init(ConnectScanner *scanner)
+{
+    SweepUring *ring = calloc(1, sizeof(SweepUring));
+    if (!ring) return 0;
+    ring->ring_fd = -1;
+
+    ring->slots = calloc(scanner->max_inflight, sizeof(UringSlot));
+    if (!ring->slots) {
+        uring_destroy(ring);
+        return 0;
+    }
+
+    // Up to two entries (CONNECT + LINK_TIMEOUT) are queued per slot between calls
+    unsigned int entries = 8;
+    while (entries < SWEEP_URING_MAX_ENTRIES && entries < 2 * scanner->max_inflight) entries <<= 1;
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+    params.cq_entries = entries * 2;
+
+    ring->ring_fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->ring_fd < 0 && errno == EINVAL) {
+        // Older kernels reject the optional flags
+        memset(&params, 0, sizeof(params));
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = entries * 2;
+        ring->ring_fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    }
+    if (ring->ring_fd < 0 || !(params.features & IORING_FEAT_EXT_ARG) ||
+        !uring_supports_ops(ring->ring_fd)) {
+        uring_destroy(ring);
+        return 0;
+    }
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_ring_size > ring->sq_ring_size) ring->sq_ring_size = ring->cq_ring_size;
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring->ring_fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ring == MAP_FAILED) {
+        ring->sq_ring = NULL;
+        uring_destroy(ring);
+        return 0;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ring = ring->sq_ring;
+    } else {
+        ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             ring->ring_fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ring == MAP_FAILED) {
+            ring->cq_ring = NULL;
+            uring_destroy(ring);
+            return 0;
+        }
+    }
+
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring->ring_fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        uring_destroy(ring);
+        return 0;
+    }
+
+    char *sq = ring->sq_ring;
+    char *cq = ring->cq_ring;
+    ring->sq_head = (unsigned int *)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned int *)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned int *)(sq + params.sq_off.ring_mask);
+    ring->sq_entries = params.sq_entries;
+    ring->sq_local_tail = *ring->sq_tail;
+    ring->cq_head = (unsigned int *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned int *)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned int *)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+
+    // Submission entry i always lives in sqes[i]: the index array is the identity
+    unsigned int *array = (unsigned int *)(sq + params.sq_off.array);
+    for (unsigned int i = 0; i < params.sq_entries; i++) array[i] = i;
+
+    ring->timeout.tv_sec = scanner->timeout_ms / 1000;
+    ring->timeout.tv_nsec = (long long)(scanner->timeout_ms % 1000) * 1000000LL;
+
+    scanner->uring = ring;
+    return 1;
+}
+
+/*
+ * Returns the ring descriptor (readable while completions are waiting)
+ */
+int sweep_uring_fd(const ConnectScanner *scanner)
+{
+    const SweepUring *ring = scanner->uring;
+    return ring ? ring->ring_fd : -1;
+}
+
+/*
+ * Tears down the rings (outstanding operations are cancelled by the kernel)
+ *
+ * @param scanner: Scanner (no effect on the epoll backend)
+ */
+void sweep_uring_free(ConnectScanner *scanner)
+{
+    if (!scanner->uring) return;
+    uring_destroy(scanner->uring);
+    scanner->uring = NULL;
+}
+
+/*
+ * ============================================================================
+ * SUBMISSION AND COMPLETION
+ * ============================================================================
+ */
+
+/*
+ * Publishes queued entries and optionally waits for completions
+ *
+ * @param ring: Ring
+ * @param wait_ms: 0 = do not wait, -1 = wait for one completion, >0 = bounded wait
+ * @return: 0 on success, negative errno on failure (ETIME/EINTR are not failures)
+ */
+static int uring_enter(SweepUring *ring, int wait_ms)
+{
+    __atomic_store_n(ring->sq_tail, ring->sq_local_tail, __ATOMIC_RELEASE);
+    unsigned int to_submit = ring->sq_local_tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    if (to_submit == 0 && wait_ms == 0) return 0;
+
+    unsigned int flags = wait_ms != 0 ? IORING_ENTER_GETEVENTS : 0;
+    unsigned int min_complete = wait_ms != 0 ? 1 : 0;
+    struct __kernel_timespec ts;
+    struct io_uring_getevents_arg arg;
+    void *argp = NULL;
+    size_t argsz = 0;
+
+    if (wait_ms > 0) {
+        ts.tv_sec = wait_ms / 1000;
+        ts.tv_nsec = (long long)(wait_ms % 1000) * 1000000LL;
+        memset(&arg, 0, sizeof(arg));
+        arg.ts = (unsigned long long)(uintptr_t)&ts;
+        flags |= IORING_ENTER_EXT_ARG;
+        argp = &arg;
+        argsz = sizeof(arg);
+    }
+
+    if (syscall(__NR_io_uring_enter, ring->ring_fd, to_submit, min_complete, flags, argp, argsz) < 0) {
+        if (errno == ETIME || errno == EINTR) return 0;
+        return -errno;
+    }
+    return 0;
+}
+
+/*
+ * Makes room for count submission entries, flushing once if the queue is full
+ *
+ * @return: 1 if the entries are available, 0 if the queue stays full
+ */
+static int uring_reserve(SweepUring *ring, unsigned int count)
+{
+    unsigned int head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    if (ring->sq_local_tail - head + count <= ring->sq_entries) return 1;
+
+    uring_enter(ring, 0);
+    head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    return ring->sq_local_tail - head + count <= ring->sq_entries;
+}
+
+/*
+ * Takes the next reserved entry and tags it with its slot and operation
+ */
+static struct io_uring_sqe *uring_take(SweepUring *ring, unsigned int slot, unsigned int op)
+{
+    struct io_uring_sqe *sqe = &ring->sqes[ring->sq_local_tail & *ring->sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->user_data = ((unsigned long long)slot << URING_OP_BITS) | op;
+    ring->sq_local_tail++;
+    ring->slots[slot].pending++;
+    return sqe;
+}
+
+/*
+ * Queues the socket creation for one target
+ *
+ * @param scanner: Scanner
+ * @param conn: Slot already filled in by connect_scanner_submit()
+ * @return: 1 (the target is always accepted once it has a slot)
+ */
+int sweep_uring_submit(ConnectScanner *scanner, SweepConnection *conn)
+{
+    SweepUring *ring = scanner->uring;
+    unsigned int slot = (unsigned int)(conn - scanner->connections);
+    UringSlot *state = &ring->slots[slot];
+
+    memset(&state->addr, 0, sizeof(state->addr));
+    state->addr.sin_family = AF_INET;
+    state->addr.sin_port = htons(conn->port);
+    state->addr.sin_addr.s_addr = htonl(conn->ip);
+    state->pending = 0;
+    state->reported = 0;
+
+    if (!uring_reserve(ring, 1)) {
+        sweep_report(scanner, conn, SWEEP_ERROR, EAGAIN);
+        sweep_release(scanner, conn);
+        return 1;
+    }
+
+    // Blocking socket: io_uring arms a poll for the connect internally
+    struct io_uring_sqe *sqe = uring_take(ring, slot, URING_OP_SOCKET);
+    sqe->opcode = IORING_OP_SOCKET;
+    sqe->fd = AF_INET;
+    sqe->off = SOCK_STREAM | SOCK_CLOEXEC;
+    sqe->len = IPPROTO_TCP;
+    return 1;
+}
+
+/*
+ * Reports a result and queues the socket's close
+ */
+static void uring_finish(ConnectScanner *scanner, SweepConnection *conn, SweepState state, int error)
+{
+    SweepUring *ring = scanner->uring;
+    unsigned int slot = (unsigned int)(conn - scanner->connections);
+
+    ring->slots[slot].reported = 1;
+    sweep_report(scanner, conn, state, error);
+
+    if (conn->fd < 0) return;
+    if (state == SWEEP_OPEN || !uring_reserve(ring, 1)) {
+        // Open ports need the linger reset first; both paths are rare
+        sweep_close(conn, state);
+        return;
+    }
+    struct io_uring_sqe *sqe = uring_take(ring, slot, URING_OP_CLOSE);
+    sqe->opcode = IORING_OP_CLOSE;
+    sqe->fd = conn->fd;
+    conn->fd = -1;
+}
+
+/*
+ * Handles one completion
+ */
+static void uring_complete(ConnectScanner *scanner, const struct io_uring_cqe *cqe)
+{
+    SweepUring *ring = scanner->uring;
+    unsigned int slot = (unsigned int)(cqe->user_data >> URING_OP_BITS);
+    unsigned int op = (unsigned int)(cqe->user_data & URING_OP_MASK);
+    SweepConnection *conn = &scanner->connections[slot];
+    UringSlot *state = &ring->slots[slot];
+
+    state->pending--;
+
+    switch (op)
+    {
+        case URING_OP_SOCKET:
+        {
+            if (cqe->res < 0) {
+                uring_finish(scanner, conn, SWEEP_ERROR, -cqe->res);
+                break;
+            }
+            conn->fd = cqe->res;
+            if (!uring_reserve(ring, 2)) {
+                uring_finish(scanner, conn, SWEEP_ERROR, EAGAIN);
+                break;
+            }
+            struct io_uring_sqe *sqe = uring_take(ring, slot, URING_OP_CONNECT);
+            sqe->opcode = IORING_OP_CONNECT;
+            sqe->fd = conn->fd;
+            sqe->addr = (unsigned long long)(uintptr_t)&state->addr;
+            sqe->off = sizeof(state->addr);
+            sqe->flags = IOSQE_IO_LINK;
+
+            sqe = uring_take(ring, slot, URING_OP_TIMEOUT);
+            sqe->opcode = IORING_OP_LINK_TIMEOUT;
+            sqe->addr = (unsigned long long)(uintptr_t)&ring->timeout;
+            sqe->len = 1;
+            break;
+        }
+
+        case URING_OP_CONNECT:
+            // The linked timeout cancels a connect that runs past the deadline
+            if (cqe->res == -ECANCELED) {
+                uring_finish(scanner, conn, SWEEP_TIMEOUT, ETIMEDOUT);
+            } else {
+                uring_finish(scanner, conn, sweep_state_from_errno(-cqe->res), -cqe->res);
+            }
+            break;
+
+        default:
+            // LINK_TIMEOUT and CLOSE only release their reference
+            break;
+    }
+
+    if (state->pending == 0 && state->reported) {
+        state->reported = 0;
+        sweep_release(scanner, conn);
+    }
+}
+
+/*
+ * Pushes queued operations to the kernel and reaps completions
+ *
+ * @param scanner: Scanner
+ * @param max_wait_ms: Longest time to block (0 = poll, -1 = until one completes)
+ * @return: Number of attempts completed during this call
+ */
+size_t sweep_uring_run_once(ConnectScanner *scanner, int max_wait_ms)
+{
+    SweepUring *ring = scanner->uring;
+    size_t before = scanner->completed;
+
+    // Only block when something is outstanding and nothing is ready yet
+    int wait_ms = max_wait_ms;
+    if (scanner->inflight == 0 ||
+        __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE) != *ring->cq_head) {
+        wait_ms = 0;
+    }
+
+    int status = uring_enter(ring, wait_ms);
+    if (status < 0 && status != -EBUSY) {
+        fprintf(stderr, "❌ io_uring_enter failed: %s\n", strerror(-status));
+    }
+
+    unsigned int head = *ring->cq_head;
+    unsigned int tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    while (head != tail)
+    {
+        uring_complete(scanner, &ring->cqes[head & *ring->cq_mask]);
+        head++;
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+        if (head == tail) tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    }
+
+    // Hand over the connects and closes queued while reaping
+    uring_enter(ring, 0);
+    return scanner->completed - before;
+}
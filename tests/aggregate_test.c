@@ -0,0 +1,230 @@
+/*
+ * ============================================================================
+ * AGGREGATE TEST - --aggregate WITH A MULTI-PASS EXTERNAL MERGE
+ * ============================================================================
+ *
+ * Writes a random CIDR list large enough that a 1 MB sort budget spills
+ * more than AGG_MERGE_FANIN chunks, so cidr_aggregate.c has to merge runs
+ * in more than one pass. The list goes through run_aggregate_mode() twice,
+ * once with 1 MB (external sort) and once with the default budget (one
+ * in-memory chunk), with stdout and stderr sent to temporary files.
+ *
+ * Both outputs must equal a reference built the simple way: sort the
+ * (first, last) ranges, merge overlapping and adjacent ones, and cover
+ * each merged range with the largest aligned blocks that fit. The
+ * summary line must report the spill and at least two merge passes.
+ *
+ * Usage: tests/aggregate_test [seed]
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "test_util.h"
+#include <unistd.h>
+#include <fcntl.h>
+
+#define AGG_TEST_FANIN          64           // AGG_MERGE_FANIN in cidr_aggregate.c
+#define AGG_TEST_CHUNK          65536        // Prefixes per chunk with a 1 MB budget
+#define AGG_TEST_PREFIXES       ((AGG_TEST_FANIN + 3) * AGG_TEST_CHUNK)
+#define AGG_TEST_INVALID_EVERY  1000003      // One malformed line per this many prefixes
+#define AGG_TEST_LINE_MAX       20           // "255.255.255.255/32\n"
+
+typedef struct
+{
+    unsigned int first;
+    unsigned int last;
+} TestRange;
+
+static int range_compare(const void *left, const void *right)
+{
+    const TestRange *a = left, *b = right;
+    if (a->first != b->first) return a->first < b->first ? -1 : 1;
+    return a->last < b->last ? -1 : a->last > b->last;
+}
+
+/*
+ * Creates an empty temporary file and returns its descriptor
+ */
+static int temp_file(char *path, size_t size, const char *name)
+{
+    const char *tmpdir = getenv("TMPDIR");
+    snprintf(path, size, "%s/net-agg-test-%s-XXXXXX", tmpdir && *tmpdir ? tmpdir : "/tmp", name);
+    return mkstemp(path);
+}
+
+static char *read_file(const char *path, size_t *len)
+{
+    FILE *file = fopen(path, "rb");
+    char *data = NULL;
+
+    *len = 0;
+    if (!file) return NULL;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long size = ftell(file);
+        data = malloc((size_t)size + 1);
+        rewind(file);
+        if (data && fread(data, 1, (size_t)size, file) == (size_t)size) {
+            data[size] = '\0';
+            *len = (size_t)size;
+        } else {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(file);
+    return data;
+}
+
+/*
+ * Runs run_aggregate_mode() with stdout and stderr redirected to files
+ *
+ * @return: Exit status of the mode
+ */
+static int run_aggregate(const char *input, size_t memory_mb, const char *out_path,
+                         const char *err_path)
+{
+    int out = open(out_path, O_WRONLY | O_TRUNC);
+    int err = open(err_path, O_WRONLY | O_TRUNC);
+    int saved_out = dup(STDOUT_FILENO), saved_err = dup(STDERR_FILENO);
+
+    fflush(stdout);
+    fflush(stderr);
+    dup2(out, STDOUT_FILENO);
+    dup2(err, STDERR_FILENO);
+    int status = run_aggregate_mode(input, memory_mb);
+    fflush(stdout);
+    fflush(stderr);
+    dup2(saved_out, STDOUT_FILENO);
+    dup2(saved_err, STDERR_FILENO);
+    close(out);
+    close(err);
+    close(saved_out);
+    close(saved_err);
+    return status;
+}
+
+/*
+ * Builds the minimal CIDR cover of the merged ranges, one "a.b.c.d/n" per line
+ *
+ * @return: Malloc'd text (NULL if out of memory), its length in *len
+ */
+static char *reference_cover(const TestRange *ranges, size_t count, size_t *len)
+{
+    size_t cap = count * AGG_TEST_LINE_MAX + AGG_TEST_LINE_MAX, used = 0;
+    char *text = malloc(cap);
+
+    for (size_t i = 0; text && i < count; i++)
+    {
+        uint64_t start = ranges[i].first, end = (uint64_t)ranges[i].last + 1;
+
+        while (start < end) {
+            // Largest block aligned at start that does not pass end
+            int host_bits = start ? __builtin_ctzll(start) : 32;
+            while ((1ULL << host_bits) > end - start) host_bits--;
+
+            if (cap - used < AGG_TEST_LINE_MAX) {
+                char *grown = realloc(text, cap * 2);
+                if (!grown) {
+                    free(text);
+                    return NULL;
+                }
+                text = grown;
+                cap *= 2;
+            }
+            used += net_format_ipv4((unsigned int)start, text + used);
+            used += (size_t)sprintf(text + used, "/%d\n", 32 - host_bits);
+            start += 1ULL << host_bits;
+        }
+    }
+    *len = used;
+    return text;
+}
+
+int main(int argc, char **argv)
+{
+    char input_path[4096], out_path[4096], err_path[4096], invalid_note[64];
+    size_t invalid = 0;
+    TestRange *ranges = malloc(AGG_TEST_PREFIXES * sizeof(TestRange));
+
+    test_seed(argc, argv);
+    printf("🧪 Aggregation: %d prefixes, spilled with a 1 MB budget\n", AGG_TEST_PREFIXES);
+
+    int input_fd = temp_file(input_path, sizeof(input_path), "in");
+    int out_fd = temp_file(out_path, sizeof(out_path), "out");
+    int err_fd = temp_file(err_path, sizeof(err_path), "err");
+    FILE *input = input_fd >= 0 ? fdopen(input_fd, "w") : NULL;
+    CHECK(ranges && input && out_fd >= 0 && err_fd >= 0, "cannot create temporary files");
+    if (out_fd >= 0) close(out_fd);
+    if (err_fd >= 0) close(err_fd);
+    if (test_failures) return test_finish("aggregate_test");
+
+    // Mostly /24-/32 inside 10.0.0.0/10 so neighbours merge, plus some wide prefixes
+    for (size_t i = 0; i < AGG_TEST_PREFIXES; i++) {
+        int prefix = test_rand_below(64) == 0 ? 8 + (int)test_rand_below(16) : 24 + (int)test_rand_below(9);
+        unsigned int ip = 0x0A000000U | ((unsigned int)test_rand() & 0x003FFFFFU);
+        if (prefix < 16) ip = (unsigned int)test_rand();
+        char text[NET_IPV4_STRLEN];
+
+        net_format_ipv4(ip, text);
+        fprintf(input, "%s/%d\n", text, prefix);
+        ranges[i].first = ip & NET_PREFIX_TABLE[prefix].mask;
+        ranges[i].last = ranges[i].first | NET_PREFIX_TABLE[prefix].wildcard;
+
+        if (i % AGG_TEST_INVALID_EVERY == 0) {
+            fprintf(input, "# comment\n10.0.0.0/33\nnot-a-prefix\n");
+            invalid += 2;
+        }
+    }
+    CHECK(fclose(input) == 0, "cannot write %s", input_path);
+
+    // Reference: sort, merge overlapping and adjacent ranges, cover
+    qsort(ranges, AGG_TEST_PREFIXES, sizeof(TestRange), range_compare);
+    size_t merged = 0;
+    for (size_t i = 0; i < AGG_TEST_PREFIXES; i++) {
+        if (merged > 0 && (uint64_t)ranges[i].first <= (uint64_t)ranges[merged - 1].last + 1) {
+            if (ranges[i].last > ranges[merged - 1].last) ranges[merged - 1].last = ranges[i].last;
+        } else {
+            ranges[merged++] = ranges[i];
+        }
+    }
+    size_t expected_len = 0;
+    char *expected = reference_cover(ranges, merged, &expected_len);
+    free(ranges);
+    snprintf(invalid_note, sizeof(invalid_note), "%zu invalid line(s) skipped", invalid);
+
+    static const size_t budgets[] = { 1, AGGREGATE_MEMORY_MB };
+    for (size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); b++)
+    {
+        size_t out_len, err_len;
+        int status = run_aggregate(input_path, budgets[b], out_path, err_path);
+        char *out = read_file(out_path, &out_len);
+        char *err = read_file(err_path, &err_len);
+
+        CHECK(status == 0, "%zu MB: exit status %d", budgets[b], status);
+        CHECK(out && expected && out_len == expected_len && memcmp(out, expected, out_len) == 0,
+              "%zu MB: output differs from the reference (%zu vs %zu bytes)", budgets[b], out_len,
+              expected_len);
+
+        const char *spill = err ? strstr(err, "external sort: ") : NULL;
+        size_t chunks = 0, passes = 0;
+        if (spill) sscanf(spill, "external sort: %zu chunks spilled, %zu merge passes", &chunks, &passes);
+        if (budgets[b] == 1) {
+            CHECK(chunks > AGG_TEST_FANIN && passes >= 2,
+                  "1 MB: expected more than %d chunks and 2+ merge passes, got %zu and %zu",
+                  AGG_TEST_FANIN, chunks, passes);
+        } else {
+            CHECK(spill == NULL, "%zu MB: input should fit in memory", budgets[b]);
+        }
+        CHECK(err && strstr(err, invalid_note), "%zu MB: expected \"%s\" on stderr", budgets[b],
+              invalid_note);
+        free(out);
+        free(err);
+    }
+
+    free(expected);
+    unlink(input_path);
+    unlink(out_path);
+    unlink(err_path);
+    return test_finish("aggregate_test");
+}
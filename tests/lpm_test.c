@@ -0,0 +1,289 @@
+/*
+ * ============================================================================
+ * LPM TEST - DIR-24-8 AND IPv6 RANGE TABLES VS A LINEAR SCAN
+ * ============================================================================
+ *
+ * Builds random route tables and checks every lookup against the
+ * obvious reference: scan all routes in load order and keep the longest
+ * prefix that contains the address (a later duplicate of the same
+ * network and length wins, as in the tables).
+ *
+ * - IPv4: lpm_lookup and lpm_lookup_batch on a built table, and the same
+ *   routes compiled with lpm_table_save() and mapped back with
+ *   lpm_table_map() (deduplicated, so routes are compared by value).
+ * - IPv6: lpm6_lookup and lpm6_lookup_batch.
+ *
+ * Routes are partly derived from earlier ones (a longer prefix inside an
+ * existing route, or an exact duplicate) so nesting, tbl8 groups and
+ * range splits are exercised. Queries are random addresses, addresses
+ * inside a route, and the first, last and neighbouring addresses of
+ * every route.
+ *
+ * Usage: tests/lpm_test [seed]
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "test_util.h"
+#include <unistd.h>
+
+#define LPM_TEST_ROUTES         3000
+#define LPM_TEST_RANDOM_QUERIES 20000
+#define LPM_TEST_LABEL_SIZE     16
+
+typedef struct
+{
+    unsigned int network;
+    int prefix;
+    char label[LPM_TEST_LABEL_SIZE];
+} TestRoute4;
+
+typedef struct
+{
+    NetIpv6 network;
+    int prefix;
+} TestRoute6;
+
+/*
+ * ============================================================================
+ * IPv4 (DIR-24-8)
+ * ============================================================================
+ */
+
+static unsigned int last_of(unsigned int network, int prefix)
+{
+    return network | NET_PREFIX_TABLE[prefix].wildcard;
+}
+
+/*
+ * Reference: load index of the longest matching route, or -1
+ */
+static long reference_lookup4(const TestRoute4 *routes, size_t count, unsigned int ip)
+{
+    long best = -1;
+
+    for (size_t i = 0; i < count; i++) {
+        const TestRoute4 *route = &routes[i];
+        if ((ip & NET_PREFIX_TABLE[route->prefix].mask) != route->network) continue;
+        if (best < 0 || route->prefix >= routes[best].prefix) best = (long)i;
+    }
+    return best;
+}
+
+/*
+ * Random route: fresh, nested in an earlier one, or an exact duplicate
+ */
+static void random_route4(TestRoute4 *routes, size_t i)
+{
+    TestRoute4 *route = &routes[i];
+    unsigned int kind = i > 0 ? test_rand_below(10) : 0;
+
+    if (kind == 0 || kind > 3) {
+        // Fresh: lengths of every size, weighted towards /8-/32
+        route->prefix = test_rand_below(4) == 0 ? (int)test_rand_below(33)
+                                                : 8 + (int)test_rand_below(25);
+        route->network = (unsigned int)test_rand() & NET_PREFIX_TABLE[route->prefix].mask;
+    } else {
+        const TestRoute4 *parent = &routes[test_rand_below((unsigned int)i)];
+        route->prefix = parent->prefix;
+        route->network = parent->network;
+        if (kind != 3 && parent->prefix < 32) {
+            route->prefix += 1 + (int)test_rand_below((unsigned int)(32 - parent->prefix));
+            route->network = (parent->network | ((unsigned int)test_rand() & NET_PREFIX_TABLE[parent->prefix].wildcard)) &
+                             NET_PREFIX_TABLE[route->prefix].mask;
+        }
+    }
+    snprintf(route->label, sizeof(route->label), "r%zu", i);
+}
+
+/*
+ * Checks one address on the built table, the mapped table and the batch API
+ */
+static void check_query4(const TestRoute4 *routes, size_t count, const LpmTable *built,
+                         const LpmTable *mapped, unsigned int ip)
+{
+    long expected = reference_lookup4(routes, count, ip);
+    const LpmRoute *route = lpm_lookup(built, ip);
+    long got = route ? (long)(route - built->routes) : -1;
+    char text[NET_IPV4_STRLEN];
+
+    net_format_ipv4(ip, text);
+    CHECK(got == expected, "ipv4 %s: route %ld, linear scan %ld", text, got, expected);
+
+    const LpmRoute *batch = NULL;
+    lpm_lookup_batch(built, &ip, 1, &batch);
+    CHECK(batch == route, "ipv4 %s: batch lookup differs", text);
+
+    // The compiled table holds one route per (network, prefix), with its label
+    const LpmRoute *compiled = lpm_lookup(mapped, ip);
+    if (expected < 0) {
+        CHECK(compiled == NULL, "ipv4 %s: compiled table matches, linear scan does not", text);
+        return;
+    }
+    const TestRoute4 *want = &routes[expected];
+    CHECK(compiled && compiled->network == want->network && (int)compiled->prefix == want->prefix &&
+          compiled->label_len == strlen(want->label) &&
+          memcmp(mapped->labels + compiled->label_offset, want->label, compiled->label_len) == 0,
+          "ipv4 %s: compiled table gives a different route than %s", text, want->label);
+}
+
+static void test_ipv4(void)
+{
+    static TestRoute4 routes[LPM_TEST_ROUTES];
+    LpmTable built, staged, mapped;
+    char path[4096];
+    const char *tmpdir = getenv("TMPDIR");
+
+    lpm_table_init(&built);
+    lpm_table_init(&staged);
+    for (size_t i = 0; i < LPM_TEST_ROUTES; i++) {
+        random_route4(routes, i);
+        size_t len = strlen(routes[i].label);
+        CHECK(lpm_table_add(&built, routes[i].network, routes[i].prefix, routes[i].label, len) == NET_OK &&
+              lpm_table_add(&staged, routes[i].network, routes[i].prefix, routes[i].label, len) == NET_OK,
+              "lpm_table_add %s", routes[i].label);
+    }
+    CHECK(lpm_table_build(&built), "lpm_table_build");
+
+    // Compile and map the same routes the way --compile-table does
+    snprintf(path, sizeof(path), "%s/net-lpm-test-XXXXXX", tmpdir && *tmpdir ? tmpdir : "/tmp");
+    int fd = mkstemp(path);
+    CHECK(fd >= 0, "mkstemp %s", path);
+    if (fd >= 0) close(fd);
+    CHECK(lpm_table_dedup(&staged) >= 0 && lpm_table_build(&staged), "dedup and build");
+    CHECK(lpm_table_save(&staged, path), "lpm_table_save");
+    CHECK(lpm_table_map(&mapped, path), "lpm_table_map");
+    unlink(path);
+    lpm_table_free(&staged);
+    if (test_failures) return;
+
+    for (int i = 0; i < LPM_TEST_RANDOM_QUERIES; i++) {
+        unsigned int ip = (unsigned int)test_rand();
+        check_query4(routes, LPM_TEST_ROUTES, &built, &mapped, ip);
+
+        const TestRoute4 *route = &routes[test_rand_below(LPM_TEST_ROUTES)];
+        ip = route->network | (ip & NET_PREFIX_TABLE[route->prefix].wildcard);
+        check_query4(routes, LPM_TEST_ROUTES, &built, &mapped, ip);
+    }
+    for (size_t i = 0; i < LPM_TEST_ROUTES; i++) {
+        unsigned int first = routes[i].network, last = last_of(first, routes[i].prefix);
+        check_query4(routes, LPM_TEST_ROUTES, &built, &mapped, first);
+        check_query4(routes, LPM_TEST_ROUTES, &built, &mapped, last);
+        check_query4(routes, LPM_TEST_ROUTES, &built, &mapped, first - 1);
+        check_query4(routes, LPM_TEST_ROUTES, &built, &mapped, last + 1);
+    }
+
+    lpm_table_free(&built);
+    lpm_table_free(&mapped);
+}
+
+/*
+ * ============================================================================
+ * IPv6 (RANGE TABLE)
+ * ============================================================================
+ */
+
+static long reference_lookup6(const TestRoute6 *routes, size_t count, const NetIpv6 *ip)
+{
+    long best = -1;
+
+    for (size_t i = 0; i < count; i++) {
+        if (!net_ipv6_in_prefix(ip, &routes[i].network, routes[i].prefix)) continue;
+        if (best < 0 || routes[i].prefix >= routes[best].prefix) best = (long)i;
+    }
+    return best;
+}
+
+/*
+ * Address inside network/prefix with random host bits
+ */
+static NetIpv6 random_inside6(const NetIpv6 *network, int prefix)
+{
+    NetIpv6 mask = net_ipv6_mask(prefix);
+    NetIpv6 ip = { network->hi | (test_rand() & ~mask.hi), network->lo | (test_rand() & ~mask.lo) };
+    return ip;
+}
+
+static void random_route6(TestRoute6 *routes, size_t i)
+{
+    TestRoute6 *route = &routes[i];
+    unsigned int kind = i > 0 ? test_rand_below(10) : 0;
+
+    if (kind == 0 || kind > 3) {
+        // Fresh: mostly inside 2000::/3, lengths of every size
+        NetIpv6 ip = { (test_rand() >> 3) | 0x2000000000000000ULL, test_rand() };
+        route->prefix = test_rand_below(4) == 0 ? (int)test_rand_below(129)
+                                                : 16 + (int)test_rand_below(49);
+        route->network = net_ipv6_network(&ip, route->prefix);
+    } else {
+        const TestRoute6 *parent = &routes[test_rand_below((unsigned int)i)];
+        *route = *parent;
+        if (kind != 3 && parent->prefix < 128) {
+            NetIpv6 ip = random_inside6(&parent->network, parent->prefix);
+            route->prefix += 1 + (int)test_rand_below((unsigned int)(128 - parent->prefix));
+            route->network = net_ipv6_network(&ip, route->prefix);
+        }
+    }
+}
+
+static void check_query6(const TestRoute6 *routes, size_t count, const Lpm6Table *table,
+                         const NetIpv6 *ip)
+{
+    long expected = reference_lookup6(routes, count, ip);
+    const Lpm6Route *route = lpm6_lookup(table, ip);
+    long got = route ? (long)(route - table->routes) : -1;
+    char text[NET_IPV6_STRLEN];
+
+    net_format_ipv6(ip, text);
+    CHECK(got == expected, "ipv6 %s: route %ld, linear scan %ld", text, got, expected);
+
+    const Lpm6Route *batch = NULL;
+    lpm6_lookup_batch(table, ip, 1, &batch);
+    CHECK(batch == route, "ipv6 %s: batch lookup differs", text);
+}
+
+static void test_ipv6(void)
+{
+    static TestRoute6 routes[LPM_TEST_ROUTES];
+    Lpm6Table table;
+
+    lpm6_table_init(&table);
+    for (size_t i = 0; i < LPM_TEST_ROUTES; i++) {
+        random_route6(routes, i);
+        CHECK(lpm6_table_add(&table, &routes[i].network, routes[i].prefix, NULL, 0) == NET_OK,
+              "lpm6_table_add %zu", i);
+    }
+    CHECK(lpm6_table_build(&table), "lpm6_table_build");
+    if (test_failures) return;
+
+    for (int i = 0; i < LPM_TEST_RANDOM_QUERIES; i++) {
+        const TestRoute6 *route = &routes[test_rand_below(LPM_TEST_ROUTES)];
+        NetIpv6 ip = random_inside6(&route->network, route->prefix);
+        check_query6(routes, LPM_TEST_ROUTES, &table, &ip);
+
+        ip.hi = test_rand();
+        ip.lo = test_rand();
+        check_query6(routes, LPM_TEST_ROUTES, &table, &ip);
+    }
+    for (size_t i = 0; i < LPM_TEST_ROUTES; i++) {
+        NetIpv6 first = routes[i].network, last = net_ipv6_last(&first, routes[i].prefix);
+        NetIpv6 before = net_ipv6_sub(&first, 1), after = net_ipv6_add(&last, 1);
+        check_query6(routes, LPM_TEST_ROUTES, &table, &first);
+        check_query6(routes, LPM_TEST_ROUTES, &table, &last);
+        check_query6(routes, LPM_TEST_ROUTES, &table, &before);
+        check_query6(routes, LPM_TEST_ROUTES, &table, &after);
+    }
+
+    lpm6_table_free(&table);
+}
+
+int main(int argc, char **argv)
+{
+    test_seed(argc, argv);
+    printf("🧪 LPM tables: %d random routes per family\n", LPM_TEST_ROUTES);
+
+    test_ipv4();
+    test_ipv6();
+    return test_finish("lpm_test");
+}
@@ -0,0 +1,243 @@
+/*
+ * ============================================================================
+ * PARSE TEST - SIMD VS SCALAR ADDRESS PARSERS, AND VS THE C LIBRARY
+ * ============================================================================
+ *
+ * Differential test of the address parsers:
+ * - net_parse_ipv4 / net_parse_ipv4_span (SSE4.1/AVX2 when the CPU has
+ *   them) must return exactly what the scalar reference returns: status,
+ *   value and stop position, for valid and for mutated input.
+ * - net_parse_ipv6 (SSE2 hex path) must agree with net_parse_ipv6_scalar.
+ * - Both must accept exactly what inet_pton() accepts and produce the same
+ *   bytes. Two documented differences are skipped: net accepts leading
+ *   zeros in an octet ("010.1.1.1"), and net_format_ipv6 never prints the
+ *   deprecated IPv4-compatible form "::a.b.c.d" that glibc's inet_ntop()
+ *   uses for ::/96 (RFC 5952 keeps the dotted tail for ::ffff:0:0/96 only).
+ * - net_format_ipv4 / net_format_ipv6 must match inet_ntop().
+ *
+ * Inputs are random addresses in text form with up to three random
+ * edits (replace, insert, delete) from an alphabet of the characters the
+ * parsers treat specially. The run is deterministic for a given seed.
+ *
+ * Usage: tests/parse_test [seed]
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "test_util.h"
+#include <arpa/inet.h>
+
+#define PARSE_ITERATIONS        400000
+#define PARSE_MAX_EDITS         3
+#define PARSE_TEXT_SIZE         64           // Slack for SIMD loads past the text
+
+static const char parse_alphabet[] = "0123456789abcdefABCDEF.:/% x-";
+
+/*
+ * Applies up to PARSE_MAX_EDITS random edits to a NUL-terminated text
+ */
+static void mutate(char *text)
+{
+    size_t len = strlen(text);
+    unsigned int edits = test_rand_below(PARSE_MAX_EDITS + 1);
+
+    for (unsigned int i = 0; i < edits; i++) {
+        size_t pos = len ? test_rand_below((unsigned int)len) : 0;
+        char c = parse_alphabet[test_rand_below(sizeof(parse_alphabet) - 1)];
+
+        switch (test_rand_below(3)) {
+            case 0:
+                if (len) text[pos] = c;
+                break;
+            case 1:
+                if (len + 1 < PARSE_TEXT_SIZE / 2) {
+                    memmove(text + pos + 1, text + pos, len - pos + 1);
+                    text[pos] = c;
+                    len++;
+                }
+                break;
+            default:
+                if (len) {
+                    memmove(text + pos, text + pos + 1, len - pos);
+                    len--;
+                }
+                break;
+        }
+    }
+}
+
+/*
+ * 1 if an octet or group of the text starts with a leading zero ("01")
+ */
+static int has_leading_zero(const char *text)
+{
+    for (const char *p = text; *p; p++) {
+        int starts = p == text || p[-1] == '.' || p[-1] == ':';
+        if (starts && p[0] == '0' && p[1] >= '0' && p[1] <= '9') return 1;
+    }
+    return 0;
+}
+
+/*
+ * Random IPv6 address with zero groups likely, so "::" runs of every
+ * length and position, and IPv4-mapped addresses, show up often
+ */
+static NetIpv6 random_ipv6(void)
+{
+    NetIpv6 ip = { test_rand(), test_rand() };
+
+    if (test_rand_below(8) == 0) {
+        ip.hi = 0;
+        ip.lo = 0xFFFF00000000ULL | (test_rand() & 0xFFFFFFFFULL);
+        return ip;
+    }
+    for (int group = 0; group < 8; group++) {
+        if (test_rand_below(3) != 0) continue;
+        uint64_t *half = group < 4 ? &ip.hi : &ip.lo;
+        *half &= ~(0xFFFFULL << (48 - 16 * (group & 3)));
+    }
+    return ip;
+}
+
+static void ipv6_to_bytes(const NetIpv6 *ip, unsigned char *bytes)
+{
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = (unsigned char)(ip->hi >> (56 - 8 * i));
+        bytes[8 + i] = (unsigned char)(ip->lo >> (56 - 8 * i));
+    }
+}
+
+/*
+ * ============================================================================
+ * IPv4
+ * ============================================================================
+ */
+
+static void check_ipv4_text(const char *text)
+{
+    unsigned int fast = 0, slow = 0;
+    NetStatus fast_status = net_parse_ipv4(text, &fast);
+    NetStatus slow_status = net_parse_ipv4_scalar(text, &slow);
+
+    CHECK(fast_status == slow_status && (fast_status != NET_OK || fast == slow),
+          "ipv4 \"%s\": %s parser %s/%08x, scalar %s/%08x", text, net_parse_ipv4_backend(),
+          net_status_string(fast_status), fast, net_status_string(slow_status), slow);
+
+    // Span form: the text followed by "/24", parsed without a NUL at the end
+    char line[PARSE_TEXT_SIZE];
+    int len = snprintf(line, sizeof(line), "%s/24", text);
+    unsigned int fast_span = 0, slow_span = 0;
+    const char *fast_stop = NULL, *slow_stop = NULL;
+    NetStatus fast_span_status = net_parse_ipv4_span(line, line + len, &fast_span, &fast_stop);
+    NetStatus slow_span_status = net_parse_ipv4_span_scalar(line, line + len, &slow_span, &slow_stop);
+    CHECK(fast_span_status == slow_span_status &&
+          (fast_span_status != NET_OK || (fast_span == slow_span && fast_stop == slow_stop)),
+          "ipv4 span \"%s\": %s/%s", line, net_status_string(fast_span_status),
+          net_status_string(slow_span_status));
+
+    if (has_leading_zero(text)) return;
+    struct in_addr libc;
+    int libc_ok = inet_pton(AF_INET, text, &libc) == 1;
+    CHECK(libc_ok == (slow_status == NET_OK) &&
+          (!libc_ok || ntohl(libc.s_addr) == slow),
+          "ipv4 \"%s\": inet_pton %s, net %s", text, libc_ok ? "accepts" : "rejects",
+          net_status_string(slow_status));
+}
+
+static void test_ipv4(void)
+{
+    for (int i = 0; i < PARSE_ITERATIONS; i++)
+    {
+        unsigned int ip = (unsigned int)test_rand();
+        char text[PARSE_TEXT_SIZE] = {0};
+        char libc[INET_ADDRSTRLEN];
+        struct in_addr addr = { htonl(ip) };
+
+        net_format_ipv4(ip, text);
+        inet_ntop(AF_INET, &addr, libc, sizeof(libc));
+        CHECK(strcmp(text, libc) == 0, "format %08x: net \"%s\", inet_ntop \"%s\"", ip, text, libc);
+
+        mutate(text);
+        check_ipv4_text(text);
+    }
+
+    // The batch API must match one call per string
+    const char *strs[] = { "1.2.3.4", "255.255.255.255", "1.2.3", "0.0.0.0", "256.1.1.1", "" };
+    size_t count = sizeof(strs) / sizeof(strs[0]);
+    unsigned int out[6];
+    NetStatus status[6];
+    size_t valid = net_parse_ipv4_batch(strs, count, out, status), expected = 0;
+    for (size_t i = 0; i < count; i++) {
+        unsigned int one = 0;
+        NetStatus one_status = net_parse_ipv4_scalar(strs[i], &one);
+        if (one_status == NET_OK) expected++;
+        CHECK(status[i] == one_status && out[i] == (one_status == NET_OK ? one : 0),
+              "batch \"%s\"", strs[i]);
+    }
+    CHECK(valid == expected, "batch valid count %zu, expected %zu", valid, expected);
+}
+
+/*
+ * ============================================================================
+ * IPv6
+ * ============================================================================
+ */
+
+static void check_ipv6_text(const char *text)
+{
+    NetIpv6 fast = {0, 0}, slow = {0, 0};
+    NetStatus fast_status = net_parse_ipv6(text, &fast);
+    NetStatus slow_status = net_parse_ipv6_scalar(text, &slow);
+
+    CHECK(fast_status == slow_status &&
+          (fast_status != NET_OK || (fast.hi == slow.hi && fast.lo == slow.lo)),
+          "ipv6 \"%s\": fast %s, scalar %s", text, net_status_string(fast_status),
+          net_status_string(slow_status));
+
+    if (has_leading_zero(text)) return;
+    unsigned char libc[16], mine[16];
+    int libc_ok = inet_pton(AF_INET6, text, libc) == 1;
+    ipv6_to_bytes(&slow, mine);
+    CHECK(libc_ok == (slow_status == NET_OK) && (!libc_ok || memcmp(libc, mine, 16) == 0),
+          "ipv6 \"%s\": inet_pton %s, net %s", text, libc_ok ? "accepts" : "rejects",
+          net_status_string(slow_status));
+}
+
+static void test_ipv6(void)
+{
+    for (int i = 0; i < PARSE_ITERATIONS; i++)
+    {
+        NetIpv6 ip = random_ipv6();
+        unsigned char bytes[16];
+        char text[PARSE_TEXT_SIZE] = {0};
+        char full[PARSE_TEXT_SIZE] = {0};
+        char libc[INET6_ADDRSTRLEN];
+
+        ipv6_to_bytes(&ip, bytes);
+        inet_ntop(AF_INET6, bytes, libc, sizeof(libc));
+        net_format_ipv6(&ip, text);
+        if (ip.hi != 0 || (ip.lo >> 32) != 0) {
+            CHECK(strcmp(text, libc) == 0, "format: net \"%s\", inet_ntop \"%s\"", text, libc);
+        }
+
+        // Canonical and fully expanded forms read back to the same address
+        NetIpv6 back;
+        net_format_ipv6_full(&ip, full);
+        CHECK(net_parse_ipv6(full, &back) == NET_OK && back.hi == ip.hi && back.lo == ip.lo,
+              "round trip \"%s\"", full);
+
+        mutate(text);
+        check_ipv6_text(text);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    test_seed(argc, argv);
+    printf("🧪 Parsers: ipv4 backend %s\n", net_parse_ipv4_backend());
+
+    test_ipv4();
+    test_ipv6();
+    return test_finish("parse_test");
+}
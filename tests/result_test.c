@@ -0,0 +1,96 @@
+/*
+ * ============================================================================
+ * RESULT TEST - BINARY RECORD LAYOUT OF EVERY RESULT SCHEMA
+ * ============================================================================
+ *
+ * Binary records are fixed-width: a reader skips a record by the payload
+ * size in its header, so that size must be exactly the bytes written.
+ *
+ * - Every schema's binary_size must equal the sum of its field widths.
+ * - One record per schema (and --batch-style network records for valid
+ *   and invalid input) goes through a binary sink into a temporary file;
+ *   walking the file by the header sizes must land on every record start
+ *   and end exactly at the end of the file.
+ *
+ * Usage: tests/result_test
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "test_util.h"
+#include <unistd.h>
+
+static const ResultSchema *const schemas[] = {
+    &RESULT_SCHEMA_NETWORK, &RESULT_SCHEMA_SERVICE, &RESULT_SCHEMA_PING, &RESULT_SCHEMA_CHECK,
+    &RESULT_SCHEMA_CONVERSION, &RESULT_SCHEMA_NETWORK6, &RESULT_SCHEMA_CHECK6
+};
+
+#define SCHEMA_COUNT (sizeof(schemas) / sizeof(schemas[0]))
+
+static size_t field_widths(const ResultSchema *schema)
+{
+    size_t sum = 0;
+    for (size_t i = 0; i < schema->field_count; i++) sum += schema->fields[i].width;
+    return sum;
+}
+
+static unsigned int get_le(const unsigned char *p, int bytes)
+{
+    unsigned int value = 0;
+    for (int i = bytes - 1; i >= 0; i--) value = value << 8 | p[i];
+    return value;
+}
+
+int main(void)
+{
+    static const char *const inputs[] = { "10.1.2.3/24", "192.168.1.1 255.255.255.0", "not-an-ip" };
+    static unsigned char record[4096];   // Zeroed: NULL strings, empty char arrays
+    static unsigned char data[1 << 16];
+    char path[4096];
+    const char *tmpdir = getenv("TMPDIR");
+
+    printf("🧪 Result records: %zu schemas\n", SCHEMA_COUNT);
+
+    for (size_t s = 0; s < SCHEMA_COUNT; s++) {
+        CHECK(field_widths(schemas[s]) == schemas[s]->binary_size,
+              "%s: binary_size %zu, field widths add up to %zu", schemas[s]->name,
+              schemas[s]->binary_size, field_widths(schemas[s]));
+    }
+
+    snprintf(path, sizeof(path), "%s/net-result-test-XXXXXX", tmpdir && *tmpdir ? tmpdir : "/tmp");
+    int fd = mkstemp(path);
+    ResultSink sink;
+    CHECK(fd >= 0 && result_sink_open(&sink, RESULT_FORMAT_BINARY, fd), "cannot open a binary sink");
+    if (test_failures) return test_finish("result_test");
+
+    for (size_t s = 0; s < SCHEMA_COUNT; s++) result_sink_emit(&sink, schemas[s], record, 0);
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+        NetworkResult result;
+        unsigned int omit = network_result_parse(inputs[i], strlen(inputs[i]), &result);
+        result_sink_emit(&sink, &RESULT_SCHEMA_NETWORK, &result, omit);
+    }
+    result_sink_close(&sink);
+
+    ssize_t len = pread(fd, data, sizeof(data), 0);
+    close(fd);
+    unlink(path);
+    CHECK(len >= 8 && memcmp(data, RESULT_BINARY_MAGIC, 4) == 0, "missing stream header");
+
+    // Walk the records by their header sizes
+    size_t pos = 8, records = 0;
+    while (len >= 8 && pos + 8 <= (size_t)len)
+    {
+        unsigned int id = get_le(data + pos, 2), size = get_le(data + pos + 2, 2);
+        size_t expected = records < SCHEMA_COUNT ? records : 0;  // Then the network records
+        CHECK(id == schemas[expected]->id && size == field_widths(schemas[expected]),
+              "record %zu: id %u size %u, expected id %u size %zu", records, id, size,
+              schemas[expected]->id, field_widths(schemas[expected]));
+        pos += 8 + size;
+        records++;
+    }
+    CHECK(len >= 8 && pos == (size_t)len, "records end at %zu, file has %zd bytes", pos, len);
+    CHECK(records == SCHEMA_COUNT + sizeof(inputs) / sizeof(inputs[0]), "%zu records read back", records);
+
+    return test_finish("result_test");
+}
@@ -0,0 +1,189 @@
+/*
+ * ============================================================================
+ * SET TEST - ip_set_combine WITH BITMAP BLOCKS VS A PER-ADDRESS REFERENCE
+ * ============================================================================
+ *
+ * Builds random pairs of sets over four /16 blocks (10.0.0.0-10.3.255.255)
+ * and checks union, intersection and difference address by address
+ * against plain byte arrays.
+ *
+ * Each block of each set is picked as dense (scattered hosts, so
+ * ip_set_compact packs it into a bitmap), sparse (a few runs), full or
+ * empty, and a few runs cross block boundaries, so the combine loops see
+ * bitmap vs bitmap, bitmap vs run and runs that end inside a packed block.
+ * The test makes sure both inputs and results really contain bitmaps, then
+ * checks ip_set_contains, ip_set_size and the run iterator of every result.
+ *
+ * Usage: tests/set_test [seed]
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "test_util.h"
+
+#define SET_TEST_BASE           0x0A000000U  // 10.0.0.0
+#define SET_TEST_BLOCKS         4
+#define SET_TEST_SIZE           (SET_TEST_BLOCKS * 65536U)
+#define SET_TEST_ROUNDS         8
+#define SET_TEST_MAX_RUNS       8192
+
+typedef struct
+{
+    unsigned int first;
+    unsigned int last;
+} TestRun;
+
+static int run_compare(const void *left, const void *right)
+{
+    const TestRun *a = left, *b = right;
+    return a->first < b->first ? -1 : a->first > b->first;
+}
+
+static void add_run(TestRun *runs, size_t *count, unsigned char *member,
+                    unsigned int first, unsigned int last)
+{
+    if (*count == SET_TEST_MAX_RUNS) return;
+    runs[(*count)++] = (TestRun){ SET_TEST_BASE + first, SET_TEST_BASE + last };
+    memset(member + first, 1, last - first + 1);
+}
+
+/*
+ * Random set over the test blocks, mirrored into member[] (one byte per address)
+ */
+static void build_set(IpSet *set, unsigned char *member)
+{
+    static TestRun runs[SET_TEST_MAX_RUNS];
+    size_t count = 0;
+
+    memset(member, 0, SET_TEST_SIZE);
+    for (unsigned int block = 0; block < SET_TEST_BLOCKS; block++)
+    {
+        unsigned int base = block * 65536U;
+
+        switch (test_rand_below(4)) {
+            case 0:     // Dense: well over IPSET_DENSE_RUNS short runs
+                for (unsigned int i = 0; i < 4 * IPSET_DENSE_RUNS; i++) {
+                    unsigned int first = base + test_rand_below(65536);
+                    unsigned int last = first + test_rand_below(4);
+                    if (last >= base + 65536) last = base + 65535;
+                    add_run(runs, &count, member, first, last);
+                }
+                break;
+            case 1:     // Sparse: a few longer runs
+                for (unsigned int i = 0; i < 1 + test_rand_below(8); i++) {
+                    unsigned int first = base + test_rand_below(65536);
+                    unsigned int last = first + test_rand_below(4096);
+                    if (last >= base + 65536) last = base + 65535;
+                    add_run(runs, &count, member, first, last);
+                }
+                break;
+            case 2:     // Full block
+                add_run(runs, &count, member, base, base + 65535);
+                break;
+            default:    // Empty
+                break;
+        }
+    }
+
+    // Runs across block boundaries, ending inside possibly packed blocks
+    for (unsigned int i = 0; i < 2; i++) {
+        unsigned int edge = (1 + test_rand_below(SET_TEST_BLOCKS - 1)) * 65536U;
+        add_run(runs, &count, member, edge - 1 - test_rand_below(300), edge + test_rand_below(300));
+    }
+
+    qsort(runs, count, sizeof(TestRun), run_compare);
+    ip_set_init(set);
+    for (size_t i = 0; i < count; i++) {
+        CHECK(ip_set_append(set, runs[i].first, runs[i].last), "ip_set_append");
+    }
+    ip_set_compact(set);
+}
+
+static size_t bitmap_segments(const IpSet *set)
+{
+    size_t bitmaps = 0;
+    for (size_t i = 0; i < set->count; i++) bitmaps += set->segments[i].bits != NULL;
+    return bitmaps;
+}
+
+/*
+ * Checks a result against the expected membership of every test address
+ */
+static void check_result(const IpSet *set, const unsigned char *expected, const char *op)
+{
+    unsigned long long size = 0;
+
+    for (unsigned int offset = 0; offset < SET_TEST_SIZE; offset++) {
+        int in = ip_set_contains(set, SET_TEST_BASE + offset);
+        size += expected[offset];
+        if (in != expected[offset]) {
+            CHECK(0, "%s: 10.%u.%u.%u is %s the result", op, offset >> 16, (offset >> 8) & 255,
+                  offset & 255, in ? "wrongly in" : "missing from");
+            return;
+        }
+    }
+    CHECK(!ip_set_contains(set, SET_TEST_BASE - 1) &&
+          !ip_set_contains(set, SET_TEST_BASE + SET_TEST_SIZE), "%s: address outside the inputs", op);
+    CHECK(ip_set_size(set) == size, "%s: size %llu, expected %llu", op, ip_set_size(set), size);
+
+    // The iterator yields ascending, disjoint runs covering the same addresses
+    IpSetIter iter;
+    unsigned int first, last, previous_last = 0;
+    unsigned long long covered = 0;
+    int started = 0;
+    ip_set_iter_init(&iter, set);
+    while (ip_set_iter_next(&iter, &first, &last)) {
+        CHECK(first <= last && (!started || first > previous_last), "%s: runs out of order", op);
+        covered += (unsigned long long)last - first + 1;
+        previous_last = last;
+        started = 1;
+    }
+    CHECK(covered == size, "%s: iterator covers %llu addresses, expected %llu", op, covered, size);
+}
+
+int main(int argc, char **argv)
+{
+    static unsigned char a_member[SET_TEST_SIZE], b_member[SET_TEST_SIZE], expected[SET_TEST_SIZE];
+    static const IpSetOp ops[] = { IPSET_UNION, IPSET_INTERSECT, IPSET_DIFF };
+    static const char *const op_names[] = { "union", "intersect", "diff" };
+    size_t input_bitmaps = 0, result_bitmaps = 0;
+
+    test_seed(argc, argv);
+    printf("🧪 IP sets: %d random pairs over %d /16 blocks\n", SET_TEST_ROUNDS, SET_TEST_BLOCKS);
+
+    for (int round = 0; round < SET_TEST_ROUNDS; round++)
+    {
+        IpSet a, b;
+        build_set(&a, a_member);
+        build_set(&b, b_member);
+        input_bitmaps += bitmap_segments(&a) + bitmap_segments(&b);
+        check_result(&a, a_member, "input a");
+        check_result(&b, b_member, "input b");
+
+        for (size_t op = 0; op < sizeof(ops) / sizeof(ops[0]); op++)
+        {
+            for (unsigned int i = 0; i < SET_TEST_SIZE; i++) {
+                switch (ops[op]) {
+                    case IPSET_UNION:     expected[i] = a_member[i] | b_member[i]; break;
+                    case IPSET_INTERSECT: expected[i] = a_member[i] & b_member[i]; break;
+                    case IPSET_DIFF:      expected[i] = a_member[i] & !b_member[i]; break;
+                }
+            }
+
+            IpSet out;
+            ip_set_init(&out);
+            CHECK(ip_set_combine(&a, &b, ops[op], &out), "%s: ip_set_combine failed", op_names[op]);
+            result_bitmaps += bitmap_segments(&out);
+            check_result(&out, expected, op_names[op]);
+            ip_set_free(&out);
+        }
+        ip_set_free(&a);
+        ip_set_free(&b);
+    }
+
+    // Without bitmaps on both sides the test would not cover what it claims
+    CHECK(input_bitmaps > 0 && result_bitmaps > 0, "no bitmap blocks: %zu in inputs, %zu in results",
+          input_bitmaps, result_bitmaps);
+    return test_finish("set_test");
+}
@@ -0,0 +1,78 @@
+/*
+ * ============================================================================
+ * TEST UTILITIES - SHARED BY THE tests/ HARNESSES
+ * ============================================================================
+ *
+ * A seeded xorshift generator (same seed → same inputs, so a failure can
+ * be replayed) and a CHECK macro that counts failures and prints the
+ * first few. Every harness ends with test_finish(), whose return value
+ * is the process exit status used by make test.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include "net.h"
+
+#define TEST_DEFAULT_SEED       0x9E3779B97F4A7C15ULL
+#define TEST_MAX_REPORTED       10           // Failures printed per harness
+
+static uint64_t test_rng_state = TEST_DEFAULT_SEED;
+static unsigned long test_checks;
+static unsigned long test_failures;
+
+/*
+ * Seeds the generator from argv[1] (decimal or 0x...), if given
+ */
+static inline void test_seed(int argc, char **argv)
+{
+    if (argc > 1) test_rng_state = strtoull(argv[1], NULL, 0);
+    if (test_rng_state == 0) test_rng_state = TEST_DEFAULT_SEED;
+}
+
+// xorshift64: fast, and good enough to drive test inputs
+static inline uint64_t test_rand(void)
+{
+    test_rng_state ^= test_rng_state << 13;
+    test_rng_state ^= test_rng_state >> 7;
+    test_rng_state ^= test_rng_state << 17;
+    return test_rng_state;
+}
+
+// Uniform value in [0, n)
+static inline unsigned int test_rand_below(unsigned int n)
+{
+    return (unsigned int)(test_rand() % n);
+}
+
+#define CHECK(cond, ...)                                                      \
+    do {                                                                      \
+        test_checks++;                                                        \
+        if (!(cond)) {                                                        \
+            if (++test_failures <= TEST_MAX_REPORTED) {                       \
+                fprintf(stderr, "   ❌ %s:%d: ", __FILE__, __LINE__);         \
+                fprintf(stderr, __VA_ARGS__);                                 \
+                fputc('\n', stderr);                                          \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+/*
+ * Prints the summary line of a harness
+ *
+ * @return: Process exit status (0 if every check passed)
+ */
+static inline int test_finish(const char *name)
+{
+    if (test_failures == 0) {
+        printf("✅ %s: %lu checks passed\n", name, test_checks);
+        return 0;
+    }
+    printf("❌ %s: %lu of %lu checks failed\n", name, test_failures, test_checks);
+    return 1;
+}
+
+#endif
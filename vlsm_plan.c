@@ -0,0 +1,442 @@
+/*
+ * ============================================================================
+ * VLSM PLANNER - BEST-FIT BUDDY ALLOCATION OF HOST REQUIREMENTS
+ * ============================================================================
+ *
+ * This file implements the --vlsm mode: a parent block and a list of
+ * required host counts (any number of entries, any sizes) are turned into
+ * one subnet per requirement, the leftover space as its minimal CIDR list,
+ * and the utilization.
+ *
+ *   ./net --vlsm 10.0.0.0/16 hosts.txt        one "hosts [label]" per line
+ *   ./net --vlsm 10.0.0.0/24 100,50,20,2      inline list
+ *
+ * Sizing: each requirement gets the longest prefix whose usable host
+ * count covers it (NET_PREFIX_TABLE: /31 → 2, /32 → 1), i.e. a block of
+ * 2^order addresses.
+ *
+ * Allocation: a buddy allocator over the parent block. Free blocks are
+ * kept in one list per order (0..32). A request of order k takes a block
+ * from the smallest non-empty list >= k (best fit) and splits it down,
+ * each split leaving the upper half (its buddy) on the next list down.
+ * Requests are served largest first, so a block is only split when no
+ * free block of the exact size exists, every block is naturally aligned,
+ * and the allocations pack from the bottom of the parent with no holes.
+ *
+ * Cost: one O(n log n) sort by size, then at most 32 list operations per
+ * request, and one O(n log n) sort of the free blocks for the report.
+ *
+ * Output (stdout, address order):
+ *   10.0.0.0/25 need=100 usable=126 label=servers
+ *   10.0.0.192/26 free
+ *   need=70000 label=big error=no-space
+ * The summary on stderr gives address and host utilization.
+ *
+ * Author: Network Tools Development Team
+ * ============================================================================
+ */
+
+#include "net.h"
+#include <unistd.h>
+
+// Free blocks of one order (stack of block start addresses)
+typedef struct
+{
+    unsigned int *starts;
+    size_t count;
+    size_t capacity;
+} VlsmFreeList;
+
+typedef struct
+{
+    VlsmFreeList lists[NET_PREFIX_COUNT];   // Indexed by order (log2 of block size)
+} VlsmBuddy;
+
+/*
+ * ============================================================================
+ * BUDDY ALLOCATOR
+ * ============================================================================
+ */
+
+static int vlsm_push(VlsmBuddy *buddy, int order, unsigned int start)
+{
+    VlsmFreeList *list = &buddy->lists[order];
+
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 16;
+        unsigned int *grown = realloc(list->starts, capacity * sizeof(*grown));
+        if (!grown) return 0;
+        list->starts = grown;
+        list->capacity = capacity;
+    }
+    list->starts[list->count++] = start;
+    return 1;
+}
+
+static void vlsm_buddy_free(VlsmBuddy *buddy)
+{
+    for (int order = 0; order < NET_PREFIX_COUNT; order++) free(buddy->lists[order].starts);
+    memset(buddy, 0, sizeof(*buddy));
+}
+
+/*
+ * Takes a block of 2^order addresses (best fit, splitting larger blocks)
+ *
+ * @param buddy: Allocator
+ * @param order: log2 of the block size
+ * @param start: Receives the block start address
+ * @return: 1 if allocated, 0 if no free block is large enough, -1 on
+ *          allocation failure
+ */
+static int vlsm_alloc(VlsmBuddy *buddy, int order, unsigned int *start)
+{
+    int found = order;
+
+    while (found < NET_PREFIX_COUNT && buddy->lists[found].count == 0) found++;
+    if (found == NET_PREFIX_COUNT) return 0;
+
+    unsigned int block = buddy->lists[found].starts[--buddy->lists[found].count];
+    while (found > order) {
+        found--;
+        if (!vlsm_push(buddy, found, block + (unsigned int)(1ULL << found))) return -1;
+    }
+    *start = block;
+    return 1;
+}
+
+/*
+ * ============================================================================
+ * REQUIREMENTS
+ * ============================================================================
+ */
+
+typedef struct
+{
+    unsigned long long need;     // Required host addresses
+    unsigned int start;          // Allocated block start
+    int order;                   // log2 of the block size
+    int placed;                  // 1 once allocated
+    size_t index;                // Input position (stable ordering)
+    char label[32];
+} VlsmRequest;
+
+typedef struct
+{
+    VlsmRequest *items;
+    size_t count;
+    size_t capacity;
+} VlsmRequestList;
+
+/*
+ * Appends one requirement
+ *
+ * @return: 1 if successful, 0 on allocation failure
+ */
+static int vlsm_add_request(VlsmRequestList *list, unsigned long long need,
+                            const char *label, size_t label_len)
+{
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 256;
+        VlsmRequest *grown = realloc(list->items, capacity * sizeof(*grown));
+        if (!grown) return 0;
+        list->items = grown;
+        list->capacity = capacity;
+    }
+
+    VlsmRequest *request = &list->items[list->count];
+    memset(request, 0, sizeof(*request));
+    request->need = need;
+    request->index = list->count;
+    if (label_len >= sizeof(request->label)) label_len = sizeof(request->label) - 1;
+    memcpy(request->label, label, label_len);
+    list->count++;
+    return 1;
+}
+
+/*
+ * Parses a host count at the start of text
+ *
+ * @return: Characters consumed (0 if text does not start with a count >= 1)
+ */
+static size_t vlsm_parse_count(const char *text, size_t len, unsigned long long *need)
+{
+    size_t i = 0;
+    unsigned long long value = 0;
+
+    while (i < len && text[i] >= '0' && text[i] <= '9') {
+        value = value * 10 + (unsigned long long)(text[i] - '0');
+        if (value > NET_PREFIX_TABLE[0].total) return 0;
+        i++;
+    }
+    if (i == 0 || value == 0) return 0;
+    *need = value;
+    return i;
+}
+
+/*
+ * Reads "hosts [label]" lines from a file or standard input
+ *
+ * @return: 1 if successful, 0 on failure
+ */
+static int vlsm_load_file(VlsmRequestList *list, const char *path)
+{
+    LineReader reader;
+    const char *line;
+    size_t len, line_number = 0, invalid = 0;
+
+    if (!line_reader_open(&reader, path)) return 0;
+
+    while (line_reader_next(&reader, &line, &len))
+    {
+        unsigned long long need;
+        size_t used;
+
+        line_number++;
+        while (len > 0 && (*line == ' ' || *line == '\t')) { line++; len--; }
+        while (len > 0 && (line[len - 1] == ' ' || line[len - 1] == '\t')) len--;
+        if (len == 0 || *line == '#') continue;
+
+        used = vlsm_parse_count(line, len, &need);
+        if (used == 0 || (used < len && line[used] != ' ' && line[used] != '\t')) {
+            if (invalid++ < IPSET_MAX_REPORTED_ERRORS) {
+                fprintf(stderr, "⚠️  %s:%zu: invalid host count \"%.*s\"\n",
+                        path, line_number, (int)(len > 64 ? 64 : len), line);
+            }
+            continue;
+        }
+
+        const char *label = line + used;
+        size_t label_len = len - used;
+        while (label_len > 0 && (*label == ' ' || *label == '\t')) { label++; label_len--; }
+
+        if (!vlsm_add_request(list, need, label, label_len)) {
+            fprintf(stderr, "❌ Memory allocation failed while loading %s\n", path);
+            line_reader_close(&reader);
+            return 0;
+        }
+    }
+    int read_failed = reader.error;
+    line_reader_close(&reader);
+    if (read_failed) return 0;
+
+    if (invalid > 0) fprintf(stderr, "⚠️  %s: %zu invalid line(s) skipped\n", path, invalid);
+    return 1;
+}
+
+/*
+ * Reads an inline "100,50,20" list
+ *
+ * @return: 1 if successful, 0 if the list is malformed
+ */
+static int vlsm_load_inline(VlsmRequestList *list, const char *text)
+{
+    const char *p = text;
+
+    for (;;) {
+        unsigned long long need;
+        size_t used = vlsm_parse_count(p, strlen(p), &need);
+
+        if (used == 0 || (p[used] != ',' && p[used] != '\0')) {
+            fprintf(stderr, "❌ Invalid host list: %s\n", text);
+            return 0;
+        }
+        if (!vlsm_add_request(list, need, "", 0)) {
+            fprintf(stderr, "❌ Memory allocation failed\n");
+            return 0;
+        }
+        if (p[used] == '\0') return 1;
+        p += used + 1;
+    }
+}
+
+// Largest block first; input order among equal sizes
+static int vlsm_by_size(const void *a, const void *b)
+{
+    const VlsmRequest *x = a;
+    const VlsmRequest *y = b;
+
+    if (x->order != y->order) return x->order > y->order ? -1 : 1;
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+// Placed requests in address order, then unplaced ones in input order
+static int vlsm_by_address(const void *a, const void *b)
+{
+    const VlsmRequest *x = a;
+    const VlsmRequest *y = b;
+
+    if (x->placed != y->placed) return x->placed ? -1 : 1;
+    if (x->placed && x->start != y->start) return x->start < y->start ? -1 : 1;
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+// Free blocks in address order
+static int vlsm_by_start(const void *a, const void *b)
+{
+    unsigned int x = ((const VlsmRequest *)a)->start;
+    unsigned int y = ((const VlsmRequest *)b)->start;
+
+    return (x > y) - (x < y);
+}
+
+/*
+ * ============================================================================
+ * VLSM MODE
+ * ============================================================================
+ */
+
+/*
+ * Writes "A.B.C.D/N" for a block of 2^order addresses
+ *
+ * @return: Bytes written
+ */
+static size_t vlsm_format_block(char *w, unsigned int start, int order)
+{
+    size_t n = net_format_ipv4(start, w);
+    return n + (size_t)snprintf(w + n, 5, "/%d", 32 - order);
+}
+
+/*
+ * Writes the leftover free blocks, one prefix per line
+ *
+ * A block is only split to serve an allocation from its lower half, so
+ * the two halves of a split block are never both free: the free blocks
+ * are already the minimal CIDR cover of the leftover space.
+ *
+ * @return: Number of free blocks, or (size_t)-1 on allocation failure
+ */
+static size_t vlsm_write_free(VlsmBuddy *buddy, OutputBuffer *out, unsigned long long *free_addresses)
+{
+    size_t total = 0, n = 0;
+
+    *free_addresses = 0;
+    for (int order = 0; order < NET_PREFIX_COUNT; order++) total += buddy->lists[order].count;
+    if (total == 0) return 0;
+
+    VlsmRequest *blocks = malloc(total * sizeof(*blocks));
+    if (!blocks) return (size_t)-1;
+    for (int order = 0; order < NET_PREFIX_COUNT; order++) {
+        for (size_t i = 0; i < buddy->lists[order].count; i++) {
+            blocks[n].start = buddy->lists[order].starts[i];
+            blocks[n].order = order;
+            *free_addresses += 1ULL << order;
+            n++;
+        }
+    }
+    qsort(blocks, n, sizeof(*blocks), vlsm_by_start);
+
+    for (size_t i = 0; i < n; i++) {
+        char *w = output_buffer_reserve(out, NET_IPV4_STRLEN + 16);
+        size_t len = vlsm_format_block(w, blocks[i].start, blocks[i].order);
+        memcpy(w + len, " free\n", 6);
+        out->len += len + 6;
+    }
+    free(blocks);
+    return n;
+}
+
+/*
+ * Plans one subnet per host requirement inside a parent block
+ *
+ * @param parent: Parent CIDR
+ * @param requirements: "hosts [label]" file ("-" = standard input), or an
+ *                      inline comma-separated list of host counts
+ * @return: Process exit status (0 if every requirement was placed)
+ */
+int run_vlsm_mode(const char *parent, const char *requirements)
+{
+    const char *end = parent + strlen(parent);
+    const char *p;
+    unsigned int ip;
+    int prefix;
+    VlsmRequestList list = {0};
+    VlsmBuddy buddy;
+    OutputBuffer out;
+    size_t placed = 0, free_blocks;
+    unsigned long long allocated = 0, needed = 0, usable = 0, free_addresses;
+    int status = 1;
+
+    if (net_parse_cidr_span(parent, end, &ip, &prefix, &p) != NET_OK || p != end) {
+        fprintf(stderr, "❌ Invalid parent network: %s\n", parent);
+        return 1;
+    }
+
+    int inline_list = requirements[0] != '\0' &&
+                      strspn(requirements, "0123456789,") == strlen(requirements);
+    if (!(inline_list ? vlsm_load_inline(&list, requirements)
+                      : vlsm_load_file(&list, requirements))) {
+        free(list.items);
+        return 1;
+    }
+
+    // Block size per requirement: longest prefix with enough usable hosts
+    for (size_t i = 0; i < list.count; i++) {
+        int len = 32;
+        while (len > 0 && NET_PREFIX_TABLE[len].usable < list.items[i].need) len--;
+        list.items[i].order = 32 - len;
+        // More than even a /0 holds: an order no free list has, so it gets error=no-space
+        if (NET_PREFIX_TABLE[len].usable < list.items[i].need) list.items[i].order = NET_PREFIX_COUNT;
+    }
+    qsort(list.items, list.count, sizeof(*list.items), vlsm_by_size);
+
+    memset(&buddy, 0, sizeof(buddy));
+    if (!vlsm_push(&buddy, 32 - prefix, ip & NET_PREFIX_TABLE[prefix].mask)) goto oom;
+
+    for (size_t i = 0; i < list.count; i++) {
+        VlsmRequest *request = &list.items[i];
+        int result = vlsm_alloc(&buddy, request->order, &request->start);
+
+        if (result < 0) goto oom;
+        if (result == 0) continue;
+        request->placed = 1;
+        placed++;
+        allocated += 1ULL << request->order;
+        needed += request->need;
+        usable += NET_PREFIX_TABLE[32 - request->order].usable;
+    }
+    qsort(list.items, list.count, sizeof(*list.items), vlsm_by_address);
+
+    if (!output_buffer_init(&out, STDOUT_FILENO, OUTPUT_BUFFER_SIZE)) goto done;
+    for (size_t i = 0; i < list.count; i++) {
+        const VlsmRequest *request = &list.items[i];
+        char *w = output_buffer_reserve(&out, 160);
+        size_t len = 0;
+
+        if (request->placed) {
+            len = vlsm_format_block(w, request->start, request->order);
+            len += (size_t)snprintf(w + len, 160 - len, " need=%llu usable=%llu", request->need,
+                                    NET_PREFIX_TABLE[32 - request->order].usable);
+        } else {
+            len = (size_t)snprintf(w, 160, "need=%llu", request->need);
+        }
+        if (request->label[0]) len += (size_t)snprintf(w + len, 160 - len, " label=%s", request->label);
+        if (!request->placed) len += (size_t)snprintf(w + len, 160 - len, " error=no-space");
+        w[len++] = '\n';
+        out.len += len;
+    }
+    free_blocks = vlsm_write_free(&buddy, &out, &free_addresses);
+    output_buffer_free(&out);
+    if (free_blocks == (size_t)-1) goto oom;
+
+    unsigned long long total = NET_PREFIX_TABLE[prefix].total;
+    fprintf(stderr, "📊 %zu of %zu requirements placed in %s; %llu of %llu addresses allocated "
+            "(%.1f%%), %llu free in %zu prefixes\n", placed, list.count, parent, allocated, total,
+            100.0 * (double)allocated / (double)total, free_addresses, free_blocks);
+    if (placed > 0) {
+        fprintf(stderr, "📊 Host utilization: %llu needed of %llu usable (%.1f%%)\n",
+                needed, usable, 100.0 * (double)needed / (double)usable);
+    }
+    if (placed < list.count) {
+        fprintf(stderr, "⚠️  %zu requirement(s) did not fit (error=no-space)\n", list.count - placed);
+    } else {
+        status = 0;
+    }
+    goto done;
+
+oom:
+    fprintf(stderr, "❌ Memory allocation failed\n");
+done:
+    vlsm_buddy_free(&buddy);
+    free(list.items);
+    return status;
+}